@@ -0,0 +1,347 @@
+/* nuklear - headless benchmarks
+ *
+ * Runs synthetic workloads against a rawfb context which renders into a
+ * memory buffer. For every frame the time spent building the UI, converting
+ * the command list into vertices (into a sink of fixed scratch memory which is
+ * overwritten every frame) and rasterizing it with rawfb is measured
+ * separately and reported as ns/frame.
+ *
+ * usage: bench [-frames N] [-warmup N] [-json] [workload...]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define NK_INCLUDE_FIXED_TYPES
+#define NK_INCLUDE_STANDARD_IO
+#define NK_INCLUDE_STANDARD_VARARGS
+#define NK_INCLUDE_DEFAULT_ALLOCATOR
+#define NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+#define NK_INCLUDE_FONT_BAKING
+#define NK_INCLUDE_DEFAULT_FONT
+#define NK_INCLUDE_SOFTWARE_FONT
+#define NK_UINT_DRAW_INDEX
+#define NK_IMPLEMENTATION
+#define NK_RAWFB_IMPLEMENTATION
+#include "../nuklear.h"
+#include "../demo/rawfb/nuklear_rawfb.h"
+
+#define WINDOW_WIDTH    1280
+#define WINDOW_HEIGHT   800
+
+/* scratch memory nk_convert writes into */
+#define SINK_COMMANDS   (4 * 1024 * 1024)
+#define SINK_VERTICES   (64 * 1024 * 1024)
+#define SINK_INDICES    (32 * 1024 * 1024)
+
+#define UNUSED(a) (void)a
+#define LEN(a) (sizeof(a)/sizeof(a)[0])
+
+#include "../demo/common/overview.c"
+#include "../demo/common/node_editor.c"
+
+/* ===============================================================
+ *
+ *                          WORKLOADS
+ *
+ * ===============================================================*/
+#define LABEL_COUNT     10000
+#define WINDOW_COUNT    1000
+#define TREE_DEPTH      11
+#define EDIT_SIZE       (64 * 1024)
+
+static char label_text[LABEL_COUNT][16];
+static char window_name[WINDOW_COUNT][16];
+static char edit_buffer[EDIT_SIZE];
+static int edit_len;
+
+static void
+setup(void)
+{
+    int i;
+    for (i = 0; i < LABEL_COUNT; ++i)
+        sprintf(label_text[i], "label %d", i);
+    for (i = 0; i < WINDOW_COUNT; ++i)
+        sprintf(window_name[i], "window %d", i);
+    for (edit_len = 0, i = 0; edit_len < EDIT_SIZE - 80; ++i)
+        edit_len += sprintf(edit_buffer + edit_len,
+            "%05d the quick brown fox jumps over the lazy dog\n", i);
+}
+static void
+run_overview(struct nk_context *ctx)
+{
+    overview(ctx);
+}
+static void
+run_node_editor(struct nk_context *ctx)
+{
+    node_editor(ctx);
+}
+static void
+run_labels(struct nk_context *ctx)
+{
+    int i;
+    if (nk_begin(ctx, "Labels", nk_rect(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT),
+        NK_WINDOW_BORDER|NK_WINDOW_TITLE)) {
+        nk_layout_row_dynamic(ctx, 18, 4);
+        for (i = 0; i < LABEL_COUNT; ++i)
+            nk_label(ctx, label_text[i], NK_TEXT_LEFT);
+    }
+    nk_end(ctx);
+}
+static void
+run_windows(struct nk_context *ctx)
+{
+    int i;
+    for (i = 0; i < WINDOW_COUNT; ++i) {
+        struct nk_rect bounds;
+        bounds.x = (float)((i % 40) * 30);
+        bounds.y = (float)((i / 40) * 28);
+        bounds.w = 160;
+        bounds.h = 90;
+        if (nk_begin(ctx, window_name[i], bounds,
+            NK_WINDOW_BORDER|NK_WINDOW_TITLE|NK_WINDOW_MOVABLE)) {
+            nk_layout_row_dynamic(ctx, 20, 2);
+            nk_label(ctx, window_name[i], NK_TEXT_LEFT);
+            nk_button_label(ctx, "button");
+        }
+        nk_end(ctx);
+    }
+}
+static void
+tree(struct nk_context *ctx, int depth, int *id)
+{
+    const char *hash = "bench tree";
+    const int node = (*id)++;
+    if (!depth) {
+        nk_layout_row_dynamic(ctx, 18, 1);
+        nk_label(ctx, label_text[node % LABEL_COUNT], NK_TEXT_LEFT);
+        return;
+    }
+    if (nk_tree_push_hashed(ctx, NK_TREE_NODE, label_text[node % LABEL_COUNT],
+        NK_MAXIMIZED, hash, (int)strlen(hash), node)) {
+        tree(ctx, depth - 1, id);
+        tree(ctx, depth - 1, id);
+        nk_tree_pop(ctx);
+    }
+}
+static void
+run_tree(struct nk_context *ctx)
+{
+    int id = 0;
+    if (nk_begin(ctx, "Tree", nk_rect(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT),
+        NK_WINDOW_BORDER|NK_WINDOW_TITLE))
+        tree(ctx, TREE_DEPTH, &id);
+    nk_end(ctx);
+}
+static void
+run_edit(struct nk_context *ctx)
+{
+    if (nk_begin(ctx, "Edit", nk_rect(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT),
+        NK_WINDOW_BORDER|NK_WINDOW_TITLE)) {
+        nk_layout_row_dynamic(ctx, WINDOW_HEIGHT - 80, 1);
+        nk_edit_string(ctx, NK_EDIT_BOX, edit_buffer, &edit_len, EDIT_SIZE, 0);
+    }
+    nk_end(ctx);
+}
+
+struct workload {
+    const char *name;
+    void (*run)(struct nk_context*);
+};
+static const struct workload workloads[] = {
+    {"overview", run_overview},
+    {"node_editor", run_node_editor},
+    {"labels_10k", run_labels},
+    {"windows_1k", run_windows},
+    {"tree_deep", run_tree},
+    {"edit_64k", run_edit}
+};
+
+/* ===============================================================
+ *
+ *                          BENCHMARK
+ *
+ * ===============================================================*/
+struct result {
+    double build, convert, raster;
+    unsigned long commands, vertices;
+};
+
+static double
+timestamp(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+struct vertex {
+    float position[2];
+    float uv[2];
+    nk_byte col[4];
+};
+
+static int
+measure(const struct workload *w, int frames, int warmup, struct result *res)
+{
+    static unsigned char tex_scratch[512 * 512];
+    static const struct nk_draw_vertex_layout_element vertex_layout[] = {
+        {NK_VERTEX_POSITION, NK_FORMAT_FLOAT, NK_OFFSETOF(struct vertex, position)},
+        {NK_VERTEX_TEXCOORD, NK_FORMAT_FLOAT, NK_OFFSETOF(struct vertex, uv)},
+        {NK_VERTEX_COLOR, NK_FORMAT_R8G8B8A8, NK_OFFSETOF(struct vertex, col)},
+        {NK_VERTEX_LAYOUT_END}
+    };
+    static unsigned char *sink[3];
+    struct nk_convert_config config;
+    struct nk_buffer cmds, verts, idx;
+    struct rawfb_context *rawfb;
+    struct rawfb_pl pl;
+    void *fb;
+    int frame;
+    nk_flags status = NK_CONVERT_SUCCESS;
+
+    /* the sink is allocated once and shared by all workloads */
+    if (!sink[0]) sink[0] = (unsigned char*)malloc(SINK_COMMANDS);
+    if (!sink[1]) sink[1] = (unsigned char*)malloc(SINK_VERTICES);
+    if (!sink[2]) sink[2] = (unsigned char*)malloc(SINK_INDICES);
+    if (!sink[0] || !sink[1] || !sink[2]) return 0;
+
+    /* rawfb draws into plain memory */
+    pl.bytesPerPixel = 4;
+    pl.rshift = 0; pl.gshift = 8; pl.bshift = 16; pl.ashift = 24;
+    pl.rloss = pl.gloss = pl.bloss = pl.aloss = 0;
+    fb = calloc(WINDOW_WIDTH * WINDOW_HEIGHT, 4);
+    if (!fb) return 0;
+    rawfb = nk_rawfb_init(fb, tex_scratch, WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_WIDTH * 4, pl);
+    if (!rawfb) {
+        free(fb);
+        return 0;
+    }
+
+    /* nk_convert writes into the sink and its output is never drawn */
+    memset(&config, 0, sizeof(config));
+    config.vertex_layout = vertex_layout;
+    config.vertex_size = sizeof(struct vertex);
+    config.vertex_alignment = NK_ALIGNOF(struct vertex);
+    config.circle_segment_count = 22;
+    config.curve_segment_count = 22;
+    config.arc_segment_count = 22;
+    config.global_alpha = 1.0f;
+    config.shape_AA = NK_ANTI_ALIASING_ON;
+    config.line_AA = NK_ANTI_ALIASING_ON;
+    nk_buffer_init_fixed(&cmds, sink[0], SINK_COMMANDS);
+    nk_buffer_init_fixed(&verts, sink[1], SINK_VERTICES);
+    nk_buffer_init_fixed(&idx, sink[2], SINK_INDICES);
+
+    memset(res, 0, sizeof(*res));
+    for (frame = 0; frame < warmup + frames; ++frame) {
+        struct nk_context *ctx = &rawfb->ctx;
+        const struct nk_command *cmd;
+        double t0, t1, t2, t3;
+        float a = (float)frame * 0.05f;
+
+        /* move the mouse around so hover states change */
+        nk_input_begin(ctx);
+        nk_input_motion(ctx, (int)(WINDOW_WIDTH/2 + cos(a) * 300),
+            (int)(WINDOW_HEIGHT/2 + sin(a) * 200));
+        nk_input_end(ctx);
+
+        t0 = timestamp();
+        w->run(ctx);
+        t1 = timestamp();
+        nk_buffer_clear(&cmds);
+        nk_buffer_clear(&verts);
+        nk_buffer_clear(&idx);
+        status |= nk_convert(ctx, &cmds, &verts, &idx, &config);
+        t2 = timestamp();
+        if (frame >= warmup) {
+            nk_foreach(cmd, ctx) res->commands++;
+            res->vertices += (unsigned long)(verts.needed / sizeof(struct vertex));
+        }
+        t3 = timestamp();
+        nk_rawfb_render(rawfb, nk_rgb(30,30,30), 1);
+        if (frame >= warmup) {
+            res->build += t1 - t0;
+            res->convert += t2 - t1;
+            res->raster += timestamp() - t3;
+        }
+    }
+    res->build /= frames;
+    res->convert /= frames;
+    res->raster /= frames;
+    res->commands /= (unsigned long)frames;
+    res->vertices /= (unsigned long)frames;
+
+    nk_rawfb_shutdown(rawfb);
+    free(fb);
+    return status == NK_CONVERT_SUCCESS;
+}
+
+static int
+selected(const char *name, int argc, char **argv)
+{
+    int i, any = 0;
+    for (i = 1; i < argc; ++i) {
+        if (argv[i][0] == '-') {
+            /* skip option values */
+            if (strcmp(argv[i], "-json")) ++i;
+            continue;
+        }
+        any = 1;
+        if (!strcmp(argv[i], name)) return 1;
+    }
+    return !any;
+}
+
+int
+main(int argc, char **argv)
+{
+    int frames = 200;
+    int warmup = 10;
+    int json = 0;
+    int first = 1;
+    int i;
+
+    for (i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-json")) json = 1;
+        else if (!strcmp(argv[i], "-frames") && i + 1 < argc) frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-warmup") && i + 1 < argc) warmup = atoi(argv[++i]);
+        else if (argv[i][0] == '-') {
+            fprintf(stderr, "usage: %s [-frames N] [-warmup N] [-json] [workload...]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (frames < 1) frames = 1;
+    if (warmup < 0) warmup = 0;
+    setup();
+
+    if (json) printf("{\n  \"frames\": %d,\n  \"width\": %d,\n  \"height\": %d,\n  \"results\": [",
+        frames, WINDOW_WIDTH, WINDOW_HEIGHT);
+    else printf("%-12s %14s %14s %14s %10s %10s\n", "workload",
+        "build ns", "convert ns", "raster ns", "commands", "vertices");
+
+    for (i = 0; i < (int)LEN(workloads); ++i) {
+        struct result res;
+        if (!selected(workloads[i].name, argc, argv)) continue;
+        if (!measure(&workloads[i], frames, warmup, &res)) {
+            fprintf(stderr, "%s: failed to set up rawfb or convert\n", workloads[i].name);
+            return EXIT_FAILURE;
+        }
+        if (json) {
+            printf("%s\n    {\"name\": \"%s\", \"build_ns\": %.0f, \"convert_ns\": %.0f, "
+                "\"raster_ns\": %.0f, \"commands\": %lu, \"vertices\": %lu}",
+                first ? "": ",", workloads[i].name, res.build, res.convert,
+                res.raster, res.commands, res.vertices);
+        } else {
+            printf("%-12s %14.0f %14.0f %14.0f %10lu %10lu\n", workloads[i].name,
+                res.build, res.convert, res.raster, res.commands, res.vertices);
+        }
+        fflush(stdout);
+        first = 0;
+    }
+    if (json) printf("\n  ]\n}\n");
+    return EXIT_SUCCESS;
+}
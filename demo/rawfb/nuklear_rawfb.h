@@ -43,8 +43,16 @@ struct rawfb_pl {
 /* All functions are thread-safe */
 NK_API struct rawfb_context *nk_rawfb_init(void *fb, void *tex_mem, const unsigned int w, const unsigned int h, const unsigned int pitch, const struct rawfb_pl pl);
 NK_API void                  nk_rawfb_render(const struct rawfb_context *rawfb, const struct nk_color clear, const unsigned char enable_clear);
+NK_API int                   nk_rawfb_render_damage(struct rawfb_context *rawfb, const struct nk_color clear, const unsigned char enable_clear, const int buffer_age, const struct nk_rect **damage);
 NK_API void                  nk_rawfb_shutdown(struct rawfb_context *rawfb);
 NK_API void                  nk_rawfb_resize_fb(struct rawfb_context *rawfb, void *fb, const unsigned int w, const unsigned int h, const unsigned int pitch, const struct rawfb_pl pl);
+NK_API void                  nk_rawfb_set_fb(struct rawfb_context *rawfb, void *fb);
+NK_API void                  nk_rawfb_set_anti_aliasing(struct rawfb_context *rawfb, enum nk_anti_aliasing aa);
+NK_API struct nk_image       nk_rawfb_image_load(struct rawfb_context *rawfb, const void *rgba, const int w, const int h);
+NK_API void                  nk_rawfb_image_free(struct rawfb_context *rawfb, const struct nk_image img);
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+NK_API void                  nk_rawfb_render_triangles(struct rawfb_context *rawfb, const struct nk_color clear, const unsigned char enable_clear);
+#endif
 
 #endif
 /*
@@ -58,18 +66,65 @@ NK_API void                  nk_rawfb_resize_fb(struct rawfb_context *rawfb, voi
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <math.h>
 
 struct rawfb_image {
     void *pixels;
     int w, h, pitch;
     struct rawfb_pl pl;
+    unsigned char *alpha;
+};
+struct rawfb_edge {
+    float x0, y0, x1, y1;
+    float dxdy, dir;
+};
+struct rawfb_raster {
+    float *cells;
+    int cell_count;
+    struct rawfb_edge *edges;
+    int *active;
+    int edge_count, edge_cap;
+    struct nk_vec2 first, last;
+};
+struct rawfb_glyph {
+    const void *font;
+    float height;
+    nk_rune rune;
+    float x, y, xadvance;
+    short w, h;
+    int coverage;
+};
+struct rawfb_glyphs {
+    struct rawfb_glyph *slots;
+    int count, cap;
+    unsigned char *coverage;
+    int used, size;
+};
+#define NK_RAWFB_MAX_DAMAGE 8
+#define NK_RAWFB_DAMAGE_FRAMES 4
+struct rawfb_damage {
+    struct nk_rect rects[NK_RAWFB_MAX_DAMAGE];
+    int count;
 };
 struct rawfb_context {
     struct nk_context ctx;
     struct nk_rect scissors;
+    struct nk_rect region;
     struct rawfb_image fb;
     struct rawfb_image font_tex;
     struct nk_font_atlas atlas;
+    struct nk_draw_null_texture tex_null;
+    struct rawfb_image *images;
+    int image_count;
+    struct rawfb_raster raster;
+    struct rawfb_glyphs glyphs;
+    enum nk_anti_aliasing aa;
+    struct nk_frame_delta delta;
+    struct rawfb_damage damage[NK_RAWFB_DAMAGE_FRAMES];
+    int damage_frames;
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+    struct nk_buffer cmds, vertices, elements;
+#endif
 };
 typedef unsigned int rawfb_color;
 
@@ -219,6 +274,135 @@ nk_rawfb_img_blendpixel(const struct rawfb_image *img,
     nk_rawfb_img_setpixel(img, x0, y0, col);
 }
 
+static rawfb_color
+nk_rawfb_row_getpixel(const struct rawfb_image *img, const unsigned char *row, const int x)
+{
+    if (img->pl.bytesPerPixel == sizeof(unsigned int))
+        return ((const unsigned int *)row)[x];
+    else if (img->pl.bytesPerPixel == sizeof(unsigned short))
+        return ((const unsigned short *)row)[x];
+    return row[x];
+}
+
+static void
+nk_rawfb_row_setpixel(const struct rawfb_image *img, unsigned char *row,
+    const int x, const rawfb_color col)
+{
+    if (img->pl.bytesPerPixel == sizeof(unsigned int))
+        ((unsigned int *)row)[x] = col;
+    else if (img->pl.bytesPerPixel == sizeof(unsigned short))
+        ((unsigned short *)row)[x] = (unsigned short)col;
+    else row[x] = (unsigned char)col;
+}
+
+static void
+nk_rawfb_row_blendpixel(const struct rawfb_image *img, unsigned char *row,
+    const int x, struct nk_color col)
+{
+    struct nk_color dst;
+    unsigned int inv_a, t;
+    if (col.a == 0) return;
+    if (col.a == 0xff) {
+        nk_rawfb_row_setpixel(img, row, x, nk_rawfb_color2int(col, &img->pl));
+        return;
+    }
+    /* x/255 rounded as ((x + 128) + ((x + 128) >> 8)) >> 8 */
+    inv_a = 0xff - col.a;
+    dst = nk_rawfb_int2color(nk_rawfb_row_getpixel(img, row, x), &img->pl);
+    t = col.r * col.a + dst.r * inv_a + 128; col.r = (nk_byte)((t + (t >> 8)) >> 8);
+    t = col.g * col.a + dst.g * inv_a + 128; col.g = (nk_byte)((t + (t >> 8)) >> 8);
+    t = col.b * col.a + dst.b * inv_a + 128; col.b = (nk_byte)((t + (t >> 8)) >> 8);
+    t = col.a * 0xff + dst.a * inv_a + 128; col.a = (nk_byte)((t + (t >> 8)) >> 8);
+    nk_rawfb_row_setpixel(img, row, x, nk_rawfb_color2int(col, &img->pl));
+}
+
+static struct nk_color
+nk_rawfb_modulate(struct nk_color col, const struct nk_color texel)
+{
+    unsigned int t;
+    t = col.r * texel.r + 128; col.r = (nk_byte)((t + (t >> 8)) >> 8);
+    t = col.g * texel.g + 128; col.g = (nk_byte)((t + (t >> 8)) >> 8);
+    t = col.b * texel.b + 128; col.b = (nk_byte)((t + (t >> 8)) >> 8);
+    t = col.a * texel.a + 128; col.a = (nk_byte)((t + (t >> 8)) >> 8);
+    return col;
+}
+
+/* Solid colors are prepared once per primitive. Opaque colors are filled
+ * as framebuffer words, translucent ones are blended from a precomputed
+ * premultiplied source. Formats with one byte per channel blend two
+ * channels per multiply inside a single word */
+struct rawfb_paint {
+    rawfb_color word;
+    unsigned int inv_a;
+    unsigned int pre[4];
+    unsigned int pre_rb, pre_ag;
+    int packed;
+};
+
+static struct rawfb_paint
+nk_rawfb_paint(struct nk_color col, const struct rawfb_pl *pl)
+{
+    struct rawfb_paint p;
+    memset(&p, 0, sizeof(p));
+    p.word = nk_rawfb_color2int(col, pl);
+    p.inv_a = 0xff - col.a;
+    p.pre[0] = col.r * col.a + 128;
+    p.pre[1] = col.g * col.a + 128;
+    p.pre[2] = col.b * col.a + 128;
+    p.pre[3] = 0xff * col.a + 128;
+    p.packed = pl->bytesPerPixel == 4 && !pl->rloss && !pl->gloss && !pl->bloss &&
+        (!pl->aloss || pl->aloss == 8) && !((pl->rshift | pl->gshift | pl->bshift | pl->ashift) & 7);
+    if (p.packed) {
+        unsigned int src;
+        col.a = 0xff;
+        src = nk_rawfb_color2int(col, pl);
+        p.pre_rb = (src & 0x00ff00ff) * (0xff - p.inv_a) + 0x00800080;
+        p.pre_ag = ((src >> 8) & 0x00ff00ff) * (0xff - p.inv_a) + 0x00800080;
+    }
+    return p;
+}
+
+static rawfb_color
+nk_rawfb_paint_blend(const struct rawfb_paint *p, const struct rawfb_pl *pl,
+    const rawfb_color dst)
+{
+    struct nk_color d = nk_rawfb_int2color(dst, pl);
+    unsigned int t;
+    t = p->pre[0] + d.r * p->inv_a; d.r = (nk_byte)((t + (t >> 8)) >> 8);
+    t = p->pre[1] + d.g * p->inv_a; d.g = (nk_byte)((t + (t >> 8)) >> 8);
+    t = p->pre[2] + d.b * p->inv_a; d.b = (nk_byte)((t + (t >> 8)) >> 8);
+    t = p->pre[3] + d.a * p->inv_a; d.a = (nk_byte)((t + (t >> 8)) >> 8);
+    return nk_rawfb_color2int(d, pl);
+}
+
+static void
+nk_rawfb_fill_span(const struct rawfb_context *rawfb, const short x0,
+    const short y, const short x1, const struct rawfb_paint *p)
+{
+    /* Same contract as nk_rawfb_line_horizontal, the caller clips */
+    unsigned char *row = (unsigned char*)rawfb->fb.pixels + y * rawfb->fb.pitch;
+    int x;
+
+    if (!p->inv_a) {
+        nk_rawfb_line_horizontal(rawfb, x0, y, x1, p->word);
+    } else if (p->inv_a == 0xff) {
+        return;
+    } else if (p->packed) {
+        unsigned int *pixels = (unsigned int*)row;
+        for (x = x0; x < x1; ++x) {
+            unsigned int rb = (pixels[x] & 0x00ff00ff) * p->inv_a + p->pre_rb;
+            unsigned int ag = ((pixels[x] >> 8) & 0x00ff00ff) * p->inv_a + p->pre_ag;
+            rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+            ag = (ag + ((ag >> 8) & 0x00ff00ff)) & 0xff00ff00;
+            pixels[x] = rb | ag;
+        }
+    } else {
+        for (x = x0; x < x1; ++x)
+            nk_rawfb_row_setpixel(&rawfb->fb, row, x, nk_rawfb_paint_blend(p,
+                &rawfb->fb.pl, nk_rawfb_row_getpixel(&rawfb->fb, row, x)));
+    }
+}
+
 static void
 nk_rawfb_scissor(struct rawfb_context *rawfb,
                  const float x,
@@ -226,10 +410,358 @@ nk_rawfb_scissor(struct rawfb_context *rawfb,
                  const float w,
                  const float h)
 {
-    rawfb->scissors.x = MIN(MAX(x, 0), rawfb->fb.w);
-    rawfb->scissors.y = MIN(MAX(y, 0), rawfb->fb.h);
-    rawfb->scissors.w = MIN(MAX(w + x, 0), rawfb->fb.w);
-    rawfb->scissors.h = MIN(MAX(h + y, 0), rawfb->fb.h);
+    /* the region holds the part of the framebuffer currently being
+     * redrawn in the same x0, y0, x1, y1 form as the scissors */
+    rawfb->scissors.x = MIN(MAX(x, rawfb->region.x), rawfb->region.w);
+    rawfb->scissors.y = MIN(MAX(y, rawfb->region.y), rawfb->region.h);
+    rawfb->scissors.w = MIN(MAX(w + x, rawfb->region.x), rawfb->region.w);
+    rawfb->scissors.h = MIN(MAX(h + y, rawfb->region.y), rawfb->region.h);
+}
+
+static void
+nk_rawfb_region(struct rawfb_context *rawfb, const struct nk_rect r)
+{
+    rawfb->region.x = 0;
+    rawfb->region.y = 0;
+    rawfb->region.w = rawfb->fb.w;
+    rawfb->region.h = rawfb->fb.h;
+    nk_rawfb_scissor(rawfb, r.x, r.y, r.w, r.h);
+    rawfb->region = rawfb->scissors;
+}
+
+/* ===============================================================
+ *
+ *                      COVERAGE RASTERIZER
+ *
+ * ===============================================================*/
+/* Anti-aliased shapes are turned into a list of edges and rasterized one
+ * scanline at a time. Every edge crossing a row adds the exact area it
+ * covers to a row of signed area cells and the running sum over that row
+ * is the coverage of each pixel. Edges are sorted by their top so each row
+ * only visits the active ones, and only the part of the row touched by an
+ * edge is resolved and cleared again. Fully covered runs are filled like
+ * the aliased shapes, only the partially covered pixels are blended.
+ * Without anti-aliasing coverage is rounded to all or nothing, which is
+ * used for translucent shapes so each pixel is blended exactly once. */
+#define NK_RAWFB_AA_MAX_ERROR 0.25f
+#define NK_RAWFB_PI 3.14159265358979323846
+
+static struct rawfb_edge*
+nk_rawfb_raster_reserve(struct rawfb_raster *r)
+{
+    if (r->edge_count == r->edge_cap) {
+        const int cap = MAX(r->edge_cap * 2, 64);
+        void *edges = realloc(r->edges, (size_t)cap * sizeof(struct rawfb_edge));
+        void *active = realloc(r->active, (size_t)cap * sizeof(int));
+        if (edges) r->edges = edges;
+        if (active) r->active = active;
+        if (!edges || !active) return NULL;
+        r->edge_cap = cap;
+    } return &r->edges[r->edge_count++];
+}
+
+static void
+nk_rawfb_raster_line_to(struct rawfb_raster *r, const float x, const float y)
+{
+    struct rawfb_edge *e;
+    if (r->last.y != y) {
+        e = nk_rawfb_raster_reserve(r);
+        if (e && r->last.y < y) {
+            e->x0 = r->last.x; e->y0 = r->last.y;
+            e->x1 = x; e->y1 = y; e->dir = 1.0f;
+        } else if (e) {
+            e->x0 = x; e->y0 = y;
+            e->x1 = r->last.x; e->y1 = r->last.y; e->dir = -1.0f;
+        }
+        if (e) e->dxdy = (e->x1 - e->x0) / (e->y1 - e->y0);
+    }
+    r->last.x = x;
+    r->last.y = y;
+}
+
+static void
+nk_rawfb_raster_move_to(struct rawfb_raster *r, const float x, const float y)
+{
+    r->first.x = r->last.x = x;
+    r->first.y = r->last.y = y;
+}
+
+static void
+nk_rawfb_raster_close(struct rawfb_raster *r)
+{
+    nk_rawfb_raster_line_to(r, r->first.x, r->first.y);
+}
+
+static int
+nk_rawfb_raster_segments(const float rx, const float ry)
+{
+    /* number of segments for a full ellipse so the polygon never strays
+     * further than NK_RAWFB_AA_MAX_ERROR from the real outline */
+    const float radius = MAX(rx, ry);
+    int segments;
+    if (radius <= NK_RAWFB_AA_MAX_ERROR * 2)
+        return 8;
+    segments = (int)ceil(2.0 * NK_RAWFB_PI / (2.0 * acos(1.0 - NK_RAWFB_AA_MAX_ERROR / radius)));
+    return MIN(MAX(segments, 8), 512);
+}
+
+static void
+nk_rawfb_raster_arc(struct rawfb_raster *r, const float cx, const float cy,
+    const float rx, const float ry, const float a_min, const float a_max,
+    const int segments)
+{
+    int i;
+    for (i = 0; i <= segments; ++i) {
+        const double a = a_min + (a_max - a_min) * (double)i / (double)segments;
+        nk_rawfb_raster_line_to(r, cx + rx * (float)cos(a), cy + ry * (float)sin(a));
+    }
+}
+
+static int
+nk_rawfb_raster_cmp(const void *a, const void *b)
+{
+    const float ya = ((const struct rawfb_edge*)a)->y0;
+    const float yb = ((const struct rawfb_edge*)b)->y0;
+    return (ya < yb) ? -1 : (ya > yb);
+}
+
+static void
+nk_rawfb_raster_accumulate(float *cells, const float xa, const float xb, const float d)
+{
+    /* Adds the area right of a line crossing a single row. `xa` and `xb`
+     * are relative to the first cell and `d` is the signed row height */
+    const float x0 = MIN(xa, xb);
+    const float x1 = MAX(xa, xb);
+    const int x0i = (int)x0;
+    int x1i = (int)x1, xi;
+    if ((float)x1i < x1) x1i++;
+
+    if (x1i <= x0i + 1) {
+        const float xm = 0.5f * (xa + xb) - (float)x0i;
+        cells[x0i] += d - d * xm;
+        cells[x0i + 1] += d * xm;
+    } else {
+        const float s = 1.0f / (x1 - x0);
+        const float x0f = x0 - (float)x0i;
+        const float x1f = x1 - (float)x1i + 1.0f;
+        const float a0 = 0.5f * s * (1.0f - x0f) * (1.0f - x0f);
+        const float am = 0.5f * s * x1f * x1f;
+        cells[x0i] += d * a0;
+        if (x1i == x0i + 2) {
+            cells[x0i + 1] += d * (1.0f - a0 - am);
+        } else {
+            const float a1 = s * (1.5f - x0f);
+            const float a2 = a1 + (float)(x1i - x0i - 3) * s;
+            cells[x0i + 1] += d * (a1 - a0);
+            for (xi = x0i + 2; xi < x1i - 1; ++xi)
+                cells[xi] += d * s;
+            cells[x1i - 1] += d * (1.0f - a2 - am);
+        }
+        cells[x1i] += d * am;
+    }
+}
+
+static void
+nk_rawfb_raster_accumulate_clipped(float *cells, float xa, float xb, float d,
+    const float w)
+{
+    /* Splits a line at the clip bounds `0` and `w` so the visible part
+     * keeps its slope. Parts left of the row cover every cell, parts
+     * right of it are dropped */
+    float t;
+    if (xa > xb) {
+        t = xa; xa = xb; xb = t;
+    }
+    if (xa >= w) return;
+    if (xb <= 0) {
+        nk_rawfb_raster_accumulate(cells, 0, 0, d);
+        return;
+    }
+    if (xa < 0) {
+        t = d * -xa / (xb - xa);
+        nk_rawfb_raster_accumulate(cells, 0, 0, t);
+        d -= t; xa = 0;
+    }
+    if (xb > w) {
+        d *= (w - xa) / (xb - xa);
+        xb = w;
+    }
+    nk_rawfb_raster_accumulate(cells, xa, xb, d);
+}
+
+static void
+nk_rawfb_raster_fill(const struct rawfb_context *rawfb, struct nk_color col)
+{
+    struct rawfb_raster *r = (struct rawfb_raster*)&rawfb->raster;
+    const int left = (int)rawfb->scissors.x;
+    const int right = (int)rawfb->scissors.w;
+    const struct rawfb_paint paint = nk_rawfb_paint(col, &rawfb->fb.pl);
+    const nk_byte alpha = col.a;
+    float top = (float)rawfb->fb.h, bottom = 0;
+    int i, n, y, y0, y1, next = 0, active = 0;
+
+    if (!r->edge_count || left >= right)
+        goto done;
+    if (r->cell_count < rawfb->fb.w + 2) {
+        free(r->cells);
+        r->cell_count = rawfb->fb.w + 2;
+        r->cells = calloc((size_t)r->cell_count, sizeof(float));
+        if (!r->cells) {
+            r->cell_count = 0;
+            goto done;
+        }
+    }
+
+    for (i = 0; i < r->edge_count; ++i) {
+        top = MIN(top, r->edges[i].y0);
+        bottom = MAX(bottom, r->edges[i].y1);
+    }
+    y0 = MAX((int)floor(top), (int)rawfb->scissors.y);
+    y1 = MIN((int)ceil(bottom), (int)rawfb->scissors.h);
+    qsort(r->edges, (size_t)r->edge_count, sizeof(struct rawfb_edge), nk_rawfb_raster_cmp);
+
+    for (y = y0; y < y1; ++y) {
+        unsigned char *row = (unsigned char*)rawfb->fb.pixels + y * rawfb->fb.pitch;
+        int min_x = right - left, max_x = 0, x, run = -1;
+        float acc = 0;
+
+        /* update the active edge list */
+        for (i = 0, n = 0; i < active; ++i)
+            if (r->edges[r->active[i]].y1 > (float)y)
+                r->active[n++] = r->active[i];
+        for (active = n; next < r->edge_count && r->edges[next].y0 < (float)(y + 1); ++next)
+            if (r->edges[next].y1 > (float)y)
+                r->active[active++] = next;
+        if (!active) continue;
+
+        /* accumulate the area covered by each edge inside this row */
+        for (i = 0; i < active; ++i) {
+            const struct rawfb_edge *e = &r->edges[r->active[i]];
+            const float ey0 = MAX(e->y0, (float)y);
+            const float ey1 = MIN(e->y1, (float)(y + 1));
+            float xa = e->x0 + (ey0 - e->y0) * e->dxdy;
+            float xb = e->x0 + (ey1 - e->y0) * e->dxdy;
+            if (ey1 <= ey0) continue;
+            xa -= (float)left;
+            xb -= (float)left;
+            nk_rawfb_raster_accumulate_clipped(r->cells, xa, xb,
+                (ey1 - ey0) * e->dir, (float)(right - left));
+            xa = MIN(MAX(xa, 0), (float)(right - left));
+            xb = MIN(MAX(xb, 0), (float)(right - left));
+            min_x = MIN(min_x, (int)MIN(xa, xb));
+            max_x = MAX(max_x, (int)MAX(xa, xb) + 2);
+        }
+
+        /* resolve coverage into full runs and blended pixels */
+        max_x = MIN(max_x, r->cell_count);
+        for (x = min_x; x < max_x; ++x) {
+            unsigned int cover;
+            acc += r->cells[x];
+            r->cells[x] = 0;
+            cover = (unsigned int)(MIN(acc < 0 ? -acc : acc, 1.0f) * 255.0f + 0.5f);
+            if (rawfb->aa != NK_ANTI_ALIASING_ON)
+                cover = (cover >= 128) ? 0xff : 0;
+            if (cover == 0xff && x + left < right) {
+                if (run < 0) run = x;
+                continue;
+            }
+            if (run >= 0) {
+                nk_rawfb_fill_span(rawfb, (short)(run + left), (short)y,
+                    (short)(x + left), &paint);
+                run = -1;
+            }
+            if (cover && x + left < right) {
+                const unsigned int t = alpha * cover + 128;
+                col.a = (nk_byte)((t + (t >> 8)) >> 8);
+                nk_rawfb_row_blendpixel(&rawfb->fb, row, x + left, col);
+            }
+        }
+        if (run >= 0)
+            nk_rawfb_fill_span(rawfb, (short)(run + left), (short)y,
+                (short)(max_x + left), &paint);
+    }
+done:
+    r->edge_count = 0;
+}
+
+static void
+nk_rawfb_raster_fill_ellipse(const struct rawfb_context *rawfb,
+    const float x, const float y, const float w, const float h,
+    const struct nk_color col)
+{
+    struct rawfb_raster *r = (struct rawfb_raster*)&rawfb->raster;
+    const float rx = w * 0.5f, ry = h * 0.5f;
+    nk_rawfb_raster_move_to(r, x + w, y + ry);
+    nk_rawfb_raster_arc(r, x + rx, y + ry, rx, ry, 0, 2 * NK_RAWFB_PI,
+        nk_rawfb_raster_segments(rx, ry));
+    nk_rawfb_raster_close(r);
+    nk_rawfb_raster_fill(rawfb, col);
+}
+
+static void
+nk_rawfb_raster_fill_rect(const struct rawfb_context *rawfb,
+    const float x, const float y, const float w, const float h,
+    float rounding, const struct nk_color col)
+{
+    struct rawfb_raster *r = (struct rawfb_raster*)&rawfb->raster;
+    int segments;
+    rounding = MIN(rounding, MIN(w, h) * 0.5f);
+    segments = (nk_rawfb_raster_segments(rounding, rounding) + 3) / 4;
+    nk_rawfb_raster_move_to(r, x + rounding, y);
+    nk_rawfb_raster_arc(r, x + w - rounding, y + rounding, rounding, rounding,
+        1.5f * NK_RAWFB_PI, 2 * NK_RAWFB_PI, segments);
+    nk_rawfb_raster_arc(r, x + w - rounding, y + h - rounding, rounding, rounding,
+        0, 0.5f * NK_RAWFB_PI, segments);
+    nk_rawfb_raster_arc(r, x + rounding, y + h - rounding, rounding, rounding,
+        0.5f * NK_RAWFB_PI, NK_RAWFB_PI, segments);
+    nk_rawfb_raster_arc(r, x + rounding, y + rounding, rounding, rounding,
+        NK_RAWFB_PI, 1.5f * NK_RAWFB_PI, segments);
+    nk_rawfb_raster_close(r);
+    nk_rawfb_raster_fill(rawfb, col);
+}
+
+static void
+nk_rawfb_raster_fill_polygon(const struct rawfb_context *rawfb,
+    const struct nk_vec2i *pnts, const int count, const struct nk_color col)
+{
+    struct rawfb_raster *r = (struct rawfb_raster*)&rawfb->raster;
+    int i;
+    if (count < 3) return;
+    nk_rawfb_raster_move_to(r, pnts[0].x, pnts[0].y);
+    for (i = 1; i < count; ++i)
+        nk_rawfb_raster_line_to(r, pnts[i].x, pnts[i].y);
+    nk_rawfb_raster_close(r);
+    nk_rawfb_raster_fill(rawfb, col);
+}
+
+static void
+nk_rawfb_raster_stroke_line(const struct rawfb_context *rawfb,
+    const short x0, const short y0, const short x1, const short y1,
+    const unsigned int line_thickness, const struct nk_color col)
+{
+    /* Lines are filled as a quad with square caps centered on the pixels
+     * of both end points, so thin lines cover the same pixels as the
+     * aliased ones and only their slanted edges get blended */
+    struct rawfb_raster *r = (struct rawfb_raster*)&rawfb->raster;
+    const float half = (float)MAX(line_thickness, 1) * 0.5f;
+    float dx = (float)(x1 - x0), dy = (float)(y1 - y0);
+    const float len = (float)sqrt(dx * dx + dy * dy);
+    const float ax = x0 + 0.5f, ay = y0 + 0.5f;
+    const float bx = x1 + 0.5f, by = y1 + 0.5f;
+
+    if (len > 0) {
+        dx = dx / len * half;
+        dy = dy / len * half;
+    } else {
+        dx = half;
+        dy = 0;
+    }
+    nk_rawfb_raster_move_to(r, ax - dx + dy, ay - dy - dx);
+    nk_rawfb_raster_line_to(r, bx + dx + dy, by + dy - dx);
+    nk_rawfb_raster_line_to(r, bx + dx - dy, by + dy + dx);
+    nk_rawfb_raster_line_to(r, ax - dx - dy, ay - dy + dx);
+    nk_rawfb_raster_close(r);
+    nk_rawfb_raster_fill(rawfb, col);
 }
 
 static void
@@ -240,13 +772,11 @@ nk_rawfb_stroke_line(const struct rawfb_context *rawfb,
     short tmp;
     int dy, dx, stepx, stepy;
 
-    NK_UNUSED(line_thickness);
-
     dy = y1 - y0;
     dx = x1 - x0;
 
-    /* fast path */
-    if (dy == 0) {
+    /* fast path, thin horizontal lines are exact without anti-aliasing */
+    if (dy == 0 && (line_thickness <= 1 || rawfb->aa != NK_ANTI_ALIASING_ON)) {
         if (dx == 0 || y0 >= rawfb->scissors.h || y0 < rawfb->scissors.y)
             return;
 
@@ -263,6 +793,11 @@ nk_rawfb_stroke_line(const struct rawfb_context *rawfb,
         nk_rawfb_line_horizontal(rawfb, x0, y0, x1, col);
         return;
     }
+    if (rawfb->aa == NK_ANTI_ALIASING_ON) {
+        nk_rawfb_raster_stroke_line(rawfb, x0, y0, x1, y1, line_thickness,
+            nk_rawfb_int2color(col, &rawfb->fb.pl));
+        return;
+    }
     if (dy < 0) {
         dy = -dy;
         stepy = -1;
@@ -304,14 +839,19 @@ nk_rawfb_stroke_line(const struct rawfb_context *rawfb,
 
 static void
 nk_rawfb_fill_polygon(const struct rawfb_context *rawfb,
-    const struct nk_vec2i *pnts, int count, const rawfb_color col)
+    const struct nk_vec2i *pnts, int count, const struct nk_color col)
 {
     int i = 0;
     #define MAX_POINTS 64
     int left = 10000, top = 10000, bottom = 0, right = 0;
-    int nodes, nodeX[MAX_POINTS], pixelX, pixelY, j, swap ;
+    int nodes, nodeX[MAX_POINTS], pixelY, j, swap ;
+    const rawfb_color word = nk_rawfb_color2int(col, &rawfb->fb.pl);
 
     if (count == 0) return;
+    if (rawfb->aa == NK_ANTI_ALIASING_ON || col.a != 0xff) {
+        nk_rawfb_raster_fill_polygon(rawfb, pnts, count, col);
+        return;
+    }
     if (count > MAX_POINTS)
         count = MAX_POINTS;
 
@@ -352,13 +892,18 @@ nk_rawfb_fill_polygon(const struct rawfb_context *rawfb,
             } else i++;
         }
         /*  Fill the pixels between node pairs. */
+        if (pixelY < rawfb->scissors.y || pixelY >= rawfb->scissors.h)
+            continue;
         for (i = 0; i < nodes; i += 2) {
             if (nodeX[i+0] >= right) break;
             if (nodeX[i+1] > left) {
                 if (nodeX[i+0] < left) nodeX[i+0] = left ;
                 if (nodeX[i+1] > right) nodeX[i+1] = right;
-                for (pixelX = nodeX[i]; pixelX < nodeX[i + 1]; pixelX++)
-                    nk_rawfb_ctx_setpixel(rawfb, pixelX, pixelY, col);
+                nodeX[i+0] = MAX(nodeX[i+0], (int)rawfb->scissors.x);
+                nodeX[i+1] = MIN(nodeX[i+1], (int)rawfb->scissors.w);
+                if (nodeX[i+0] < nodeX[i+1])
+                    nk_rawfb_line_horizontal(rawfb, (short)nodeX[i+0], (short)pixelY,
+                        (short)nodeX[i+1], word);
             }
         }
     }
@@ -421,7 +966,7 @@ nk_rawfb_stroke_arc(const struct rawfb_context *rawfb,
 
 static void
 nk_rawfb_fill_arc(const struct rawfb_context *rawfb, short x0, short y0,
-    short w, short h, const short s, const rawfb_color col)
+    short w, short h, const short s, const struct nk_color col)
 {
     /* Bresenham's ellipses - modified to fill one quarter */
     const int a2 = (w * w) / 4;
@@ -518,12 +1063,19 @@ nk_rawfb_stroke_rect(const struct rawfb_context *rawfb,
 static void
 nk_rawfb_fill_rect(const struct rawfb_context *rawfb,
     const short x, const short y, const short w, const short h,
-    const short r, const rawfb_color col)
+    const short r, const struct nk_color col)
 {
-    int i;
     if (r == 0) {
-        for (i = 0; i < h; i++)
-            nk_rawfb_stroke_line(rawfb, x, y + i, x + w, y + i, 1, col);
+        const struct rawfb_paint paint = nk_rawfb_paint(col, &rawfb->fb.pl);
+        const int x0 = MAX(x, (int)rawfb->scissors.x);
+        const int x1 = MIN(x + w, (int)rawfb->scissors.w);
+        const int y1 = MIN(y + h, (int)rawfb->scissors.h);
+        int i = MAX(y, (int)rawfb->scissors.y);
+        if (x0 < x1)
+            for (; i < y1; i++)
+                nk_rawfb_fill_span(rawfb, (short)x0, (short)i, (short)x1, &paint);
+    } else if (rawfb->aa == NK_ANTI_ALIASING_ON || col.a != 0xff) {
+        nk_rawfb_raster_fill_rect(rawfb, x, y, w, h, r, col);
     } else {
         const short xc = x + r;
         const short yc = y + r;
@@ -577,80 +1129,60 @@ nk_rawfb_draw_rect_multi_color(const struct rawfb_context *rawfb,
     const short x, const short y, const short w, const short h, struct nk_color tl,
     struct nk_color tr, struct nk_color br, struct nk_color bl)
 {
-    int i, j;
-    struct nk_color *edge_buf;
-    struct nk_color *edge_t;
-    struct nk_color *edge_b;
-    struct nk_color *edge_l;
-    struct nk_color *edge_r;
-    struct nk_color pixel;
-
-    edge_buf = malloc(((2*w) + (2*h)) * sizeof(struct nk_color));
-    if (edge_buf == NULL)
+    /* Bilinear gradient stepped in 16.16 fixed point. Both side edges are
+     * advanced once per row and every row is walked with a constant step,
+     * so the inner loop is a handful of integer adds per pixel */
+    const int x0 = MAX(x, (int)rawfb->scissors.x);
+    const int y0 = MAX(y, (int)rawfb->scissors.y);
+    const int x1 = MIN(x + w, (int)rawfb->scissors.w);
+    const int y1 = MIN(y + h, (int)rawfb->scissors.h);
+    const int opaque = (tl.a & tr.a & br.a & bl.a) == 0xff;
+    const int dw = MAX(w - 1, 1), dh = MAX(h - 1, 1);
+    int left[4], right[4], dleft[4], dright[4];
+    int i, px, py;
+
+    if (x0 >= x1 || y0 >= y1)
         return;
 
-    edge_t = edge_buf;
-    edge_b = edge_buf + w;
-    edge_l = edge_buf + (w*2);
-    edge_r = edge_buf + (w*2) + h;
-
-    /* Top and bottom edge gradients */
-    for (i=0; i<w; i++)
-    {
-        edge_t[i].r = (((((float)tr.r - tl.r)/(w-1))*i) + 0.5) + tl.r;
-        edge_t[i].g = (((((float)tr.g - tl.g)/(w-1))*i) + 0.5) + tl.g;
-        edge_t[i].b = (((((float)tr.b - tl.b)/(w-1))*i) + 0.5) + tl.b;
-        edge_t[i].a = (((((float)tr.a - tl.a)/(w-1))*i) + 0.5) + tl.a;
-
-        edge_b[i].r = (((((float)br.r - bl.r)/(w-1))*i) + 0.5) + bl.r;
-        edge_b[i].g = (((((float)br.g - bl.g)/(w-1))*i) + 0.5) + bl.g;
-        edge_b[i].b = (((((float)br.b - bl.b)/(w-1))*i) + 0.5) + bl.b;
-        edge_b[i].a = (((((float)br.a - bl.a)/(w-1))*i) + 0.5) + bl.a;
-    }
-
-    /* Left and right edge gradients */
-    for (i=0; i<h; i++)
-    {
-        edge_l[i].r = (((((float)bl.r - tl.r)/(h-1))*i) + 0.5) + tl.r;
-        edge_l[i].g = (((((float)bl.g - tl.g)/(h-1))*i) + 0.5) + tl.g;
-        edge_l[i].b = (((((float)bl.b - tl.b)/(h-1))*i) + 0.5) + tl.b;
-        edge_l[i].a = (((((float)bl.a - tl.a)/(h-1))*i) + 0.5) + tl.a;
-
-        edge_r[i].r = (((((float)br.r - tr.r)/(h-1))*i) + 0.5) + tr.r;
-        edge_r[i].g = (((((float)br.g - tr.g)/(h-1))*i) + 0.5) + tr.g;
-        edge_r[i].b = (((((float)br.b - tr.b)/(h-1))*i) + 0.5) + tr.b;
-        edge_r[i].a = (((((float)br.a - tr.a)/(h-1))*i) + 0.5) + tr.a;
-    }
-
-    for (i=0; i<h; i++) {
-        for (j=0; j<w; j++) {
-            if (i==0) {
-                nk_rawfb_img_blendpixel(&rawfb->fb, x+j, y+i, edge_t[j]);
-            } else if (i==h-1) {
-                nk_rawfb_img_blendpixel(&rawfb->fb, x+j, y+i, edge_b[j]);
-            } else {
-                if (j==0) {
-                    nk_rawfb_img_blendpixel(&rawfb->fb, x+j, y+i, edge_l[i]);
-                } else if (j==w-1) {
-                    nk_rawfb_img_blendpixel(&rawfb->fb, x+j, y+i, edge_r[i]);
-                } else {
-                    pixel.r = (((((float)edge_r[i].r - edge_l[i].r)/(w-1))*j) + 0.5) + edge_l[i].r;
-                    pixel.g = (((((float)edge_r[i].g - edge_l[i].g)/(w-1))*j) + 0.5) + edge_l[i].g;
-                    pixel.b = (((((float)edge_r[i].b - edge_l[i].b)/(w-1))*j) + 0.5) + edge_l[i].b;
-                    pixel.a = (((((float)edge_r[i].a - edge_l[i].a)/(w-1))*j) + 0.5) + edge_l[i].a;
-                    nk_rawfb_img_blendpixel(&rawfb->fb, x+j, y+i, pixel);
-                }
-            }
+    #define NK_RAWFB_EDGE(k, c) \
+        dleft[k] = (bl.c - tl.c) * 65536 / dh; \
+        dright[k] = (br.c - tr.c) * 65536 / dh; \
+        left[k] = tl.c * 65536 + 32768 + dleft[k] * (y0 - y); \
+        right[k] = tr.c * 65536 + 32768 + dright[k] * (y0 - y)
+    NK_RAWFB_EDGE(0, r);
+    NK_RAWFB_EDGE(1, g);
+    NK_RAWFB_EDGE(2, b);
+    NK_RAWFB_EDGE(3, a);
+    #undef NK_RAWFB_EDGE
+
+    for (py = y0; py < y1; ++py) {
+        unsigned char *row = (unsigned char*)rawfb->fb.pixels + py * rawfb->fb.pitch;
+        int value[4], step[4];
+        for (i = 0; i < 4; ++i) {
+            step[i] = (right[i] - left[i]) / dw;
+            value[i] = left[i] + step[i] * (x0 - x);
+            left[i] += dleft[i];
+            right[i] += dright[i];
+        }
+        for (px = x0; px < x1; ++px) {
+            struct nk_color c;
+            c.r = (nk_byte)(value[0] >> 16);
+            c.g = (nk_byte)(value[1] >> 16);
+            c.b = (nk_byte)(value[2] >> 16);
+            c.a = (nk_byte)(value[3] >> 16);
+            if (opaque)
+                nk_rawfb_row_setpixel(&rawfb->fb, row, px, nk_rawfb_color2int(c, &rawfb->fb.pl));
+            else nk_rawfb_row_blendpixel(&rawfb->fb, row, px, c);
+            value[0] += step[0]; value[1] += step[1];
+            value[2] += step[2]; value[3] += step[3];
         }
     }
-
-    free(edge_buf);
 }
 
 static void
 nk_rawfb_fill_triangle(const struct rawfb_context *rawfb,
     const short x0, const short y0, const short x1, const short y1,
-    const short x2, const short y2, const rawfb_color col)
+    const short x2, const short y2, const struct nk_color col)
 {
     struct nk_vec2i pnts[3];
     pnts[0].x = x0;
@@ -699,7 +1231,7 @@ nk_rawfb_stroke_polyline(const struct rawfb_context *rawfb,
 
 static void
 nk_rawfb_fill_circle(const struct rawfb_context *rawfb,
-    short x0, short y0, short w, short h, const rawfb_color col)
+    short x0, short y0, short w, short h, const struct nk_color col)
 {
     /* Bresenham's ellipses */
     const int a2 = (w * w) / 4;
@@ -707,6 +1239,13 @@ nk_rawfb_fill_circle(const struct rawfb_context *rawfb,
     const int fa2 = 4 * a2, fb2 = 4 * b2;
     int x, y, sigma;
 
+    const rawfb_color word = nk_rawfb_color2int(col, &rawfb->fb.pl);
+
+    if (rawfb->aa == NK_ANTI_ALIASING_ON || col.a != 0xff) {
+        nk_rawfb_raster_fill_ellipse(rawfb, x0, y0, w, h, col);
+        return;
+    }
+
     /* Convert upper left to center */
     h = (h + 1) / 2;
     w = (w + 1) / 2;
@@ -715,8 +1254,8 @@ nk_rawfb_fill_circle(const struct rawfb_context *rawfb,
 
     /* First half */
     for (x = 0, y = h, sigma = 2*b2+a2*(1-2*h); b2*x <= a2*y; x++) {
-        nk_rawfb_stroke_line(rawfb, x0 - x, y0 + y, x0 + x, y0 + y, 1, col);
-        nk_rawfb_stroke_line(rawfb, x0 - x, y0 - y, x0 + x, y0 - y, 1, col);
+        nk_rawfb_stroke_line(rawfb, x0 - x, y0 + y, x0 + x, y0 + y, 1, word);
+        nk_rawfb_stroke_line(rawfb, x0 - x, y0 - y, x0 + x, y0 - y, 1, word);
         if (sigma >= 0) {
             sigma += fa2 * (1 - y);
             y--;
@@ -724,8 +1263,8 @@ nk_rawfb_fill_circle(const struct rawfb_context *rawfb,
     }
     /* Second half */
     for (x = w, y = 0, sigma = 2*a2+b2*(1-2*w); a2*y <= b2*x; y++) {
-        nk_rawfb_stroke_line(rawfb, x0 - x, y0 + y, x0 + x, y0 + y, 1, col);
-        nk_rawfb_stroke_line(rawfb, x0 - x, y0 - y, x0 + x, y0 - y, 1, col);
+        nk_rawfb_stroke_line(rawfb, x0 - x, y0 + y, x0 + x, y0 + y, 1, word);
+        nk_rawfb_stroke_line(rawfb, x0 - x, y0 - y, x0 + x, y0 - y, 1, word);
         if (sigma >= 0) {
             sigma += fb2 * (1 - x);
             x--;
@@ -807,7 +1346,10 @@ nk_rawfb_stroke_curve(const struct rawfb_context *rawfb,
 static void
 nk_rawfb_clear(const struct rawfb_context *rawfb, const rawfb_color col)
 {
-    nk_rawfb_fill_rect(rawfb, 0, 0, rawfb->fb.w, rawfb->fb.h, 0, col);
+    int i;
+    for (i = (int)rawfb->region.y; i < (int)rawfb->region.h; i++)
+        nk_rawfb_line_horizontal(rawfb, (short)rawfb->region.x, (short)i,
+            (short)rawfb->region.w, col);
 }
 
 NK_API struct rawfb_context*
@@ -855,11 +1397,18 @@ nk_rawfb_init(void *fb, void *tex_mem, const unsigned int w, const unsigned int
 
     rawfb->font_tex.pitch = rawfb->font_tex.w * 1;
     memcpy(rawfb->font_tex.pixels, tex, rawfb->font_tex.pitch * rawfb->font_tex.h);
-    nk_font_atlas_end(&rawfb->atlas, nk_handle_ptr(NULL), NULL);
+    nk_font_atlas_end(&rawfb->atlas, nk_handle_ptr(NULL), &rawfb->tex_null);
     if (rawfb->atlas.default_font)
         nk_style_set_font(&rawfb->ctx, &rawfb->atlas.default_font->handle);
     nk_style_load_all_cursors(&rawfb->ctx, rawfb->atlas.cursors);
+    nk_rawfb_region(rawfb, nk_rect(0, 0, rawfb->fb.w, rawfb->fb.h));
     nk_rawfb_scissor(rawfb, 0, 0, rawfb->fb.w, rawfb->fb.h);
+    nk_frame_delta_init_default(&rawfb->delta);
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+    nk_buffer_init_default(&rawfb->cmds);
+    nk_buffer_init_default(&rawfb->vertices);
+    nk_buffer_init_default(&rawfb->elements);
+#endif
 
     return rawfb;
 }
@@ -881,10 +1430,12 @@ nk_rawfb_stretch_image(const struct rawfb_image *dst,
     for (j = 0; j < (short)dst_rect->h; j++) {
         for (i = 0; i < (short)dst_rect->w; i++) {
             if (dst_scissors) {
-                if (i + (int)(dst_rect->x + 0.5f) < dst_scissors->x || i + (int)(dst_rect->x + 0.5f) >= dst_scissors->w)
-                    continue;
-                if (j + (int)(dst_rect->y + 0.5f) < dst_scissors->y || j + (int)(dst_rect->y + 0.5f) >= dst_scissors->h)
+                /* clipped pixels still advance through the source */
+                if (i + (int)(dst_rect->x + 0.5f) < dst_scissors->x || i + (int)(dst_rect->x + 0.5f) >= dst_scissors->w ||
+                    j + (int)(dst_rect->y + 0.5f) < dst_scissors->y || j + (int)(dst_rect->y + 0.5f) >= dst_scissors->h) {
+                    xoff += xinc;
                     continue;
+                }
             }
             col = nk_rawfb_img_getpixel(src, (int)xoff, (int) yoff);
             if (col.r || col.g || col.b)
@@ -901,6 +1452,196 @@ nk_rawfb_stretch_image(const struct rawfb_image *dst,
     }
 }
 
+static struct nk_color
+nk_rawfb_texture_fetch(const struct rawfb_image *tex, const unsigned char *row,
+    const int x, const int y)
+{
+    /* premultiplied color of a registered image, alpha is stored apart
+     * because the framebuffer format usually has no alpha channel */
+    struct nk_color c = nk_rawfb_int2color(nk_rawfb_row_getpixel(tex, row, x), &tex->pl);
+    c.a = tex->alpha ? tex->alpha[y * tex->w + x] : 0xff;
+    return c;
+}
+
+static struct nk_color
+nk_rawfb_tint_premultiplied(struct nk_color c, const struct nk_color tint)
+{
+    unsigned int t;
+    c = nk_rawfb_modulate(c, tint);
+    t = c.r * tint.a + 128; c.r = (nk_byte)((t + (t >> 8)) >> 8);
+    t = c.g * tint.a + 128; c.g = (nk_byte)((t + (t >> 8)) >> 8);
+    t = c.b * tint.a + 128; c.b = (nk_byte)((t + (t >> 8)) >> 8);
+    return c;
+}
+
+static void
+nk_rawfb_row_blendpremultiplied(const struct rawfb_image *img, unsigned char *row,
+    const int x, struct nk_color col)
+{
+    struct nk_color dst;
+    unsigned int inv_a, t;
+    if (col.a == 0) return;
+    inv_a = 0xff - col.a;
+    dst = nk_rawfb_int2color(nk_rawfb_row_getpixel(img, row, x), &img->pl);
+    t = dst.r * inv_a + 128; col.r = (nk_byte)MIN(col.r + ((t + (t >> 8)) >> 8), 0xff);
+    t = dst.g * inv_a + 128; col.g = (nk_byte)MIN(col.g + ((t + (t >> 8)) >> 8), 0xff);
+    t = dst.b * inv_a + 128; col.b = (nk_byte)MIN(col.b + ((t + (t >> 8)) >> 8), 0xff);
+    t = dst.a * inv_a + 128; col.a = (nk_byte)MIN(col.a + ((t + (t >> 8)) >> 8), 0xff);
+    nk_rawfb_row_setpixel(img, row, x, nk_rawfb_color2int(col, &img->pl));
+}
+
+static void
+nk_rawfb_blit_image(const struct rawfb_context *rawfb, const struct rawfb_image *tex,
+    const struct nk_rect dst, const int sx, const int sy,
+    const struct nk_color tint)
+{
+    /* 1:1 copy. Opaque images in the framebuffer format are copied a row
+     * at a time, everything else is blended per pixel */
+    const int bpp = rawfb->fb.pl.bytesPerPixel;
+    const int x0 = MAX((int)dst.x, (int)rawfb->scissors.x);
+    const int y0 = MAX((int)dst.y, (int)rawfb->scissors.y);
+    const int x1 = MIN((int)(dst.x + dst.w), (int)rawfb->scissors.w);
+    const int y1 = MIN((int)(dst.y + dst.h), (int)rawfb->scissors.h);
+    const int white = (tint.r & tint.g & tint.b & tint.a) == 0xff;
+    const int same = !memcmp(&tex->pl, &rawfb->fb.pl, sizeof(tex->pl));
+    int x, y;
+
+    if (x0 >= x1)
+        return;
+    for (y = y0; y < y1; ++y) {
+        const int v = sy + y - (int)dst.y;
+        const unsigned char *src = (const unsigned char*)tex->pixels + v * tex->pitch;
+        unsigned char *row = (unsigned char*)rawfb->fb.pixels + y * rawfb->fb.pitch;
+        if (white && same && !tex->alpha) {
+            memcpy(row + x0 * bpp, src + (sx + x0 - (int)dst.x) * bpp, (size_t)((x1 - x0) * bpp));
+            continue;
+        }
+        for (x = x0; x < x1; ++x) {
+            const int u = sx + x - (int)dst.x;
+            struct nk_color c;
+            if (tex->alpha && !tex->alpha[v * tex->w + u])
+                continue;
+            if (white && same && (!tex->alpha || tex->alpha[v * tex->w + u] == 0xff)) {
+                nk_rawfb_row_setpixel(&rawfb->fb, row, x, nk_rawfb_row_getpixel(tex, src, u));
+                continue;
+            }
+            c = nk_rawfb_texture_fetch(tex, src, u, v);
+            if (!white) c = nk_rawfb_tint_premultiplied(c, tint);
+            nk_rawfb_row_blendpremultiplied(&rawfb->fb, row, x, c);
+        }
+    }
+}
+
+static void
+nk_rawfb_blit_image_bilinear(const struct rawfb_context *rawfb,
+    const struct rawfb_image *tex, const struct nk_rect dst,
+    const struct nk_rect src, const struct nk_color tint)
+{
+    /* Scaled copy with bilinear filtering. Texture coordinates step in
+     * 16.16 fixed point from pixel center to pixel center and the four
+     * premultiplied taps are weighted with 8 bit fractions */
+    const int x0 = MAX((int)dst.x, (int)rawfb->scissors.x);
+    const int y0 = MAX((int)dst.y, (int)rawfb->scissors.y);
+    const int x1 = MIN((int)(dst.x + dst.w), (int)rawfb->scissors.w);
+    const int y1 = MIN((int)(dst.y + dst.h), (int)rawfb->scissors.h);
+    const int white = (tint.r & tint.g & tint.b & tint.a) == 0xff;
+    const int du = (int)(src.w * 65536.0f / dst.w);
+    const int dv = (int)(src.h * 65536.0f / dst.h);
+    const int umin = (int)src.x, umax = (int)(src.x + src.w) - 1;
+    const int vmin = (int)src.y, vmax = (int)(src.y + src.h) - 1;
+    const int ubase = (int)(src.x * 65536.0f) + du / 2 - 32768 - (int)dst.x * du;
+    int x, y, v = (int)(src.y * 65536.0f) + dv / 2 - 32768 + (y0 - (int)dst.y) * dv;
+
+    for (y = y0; y < y1; ++y, v += dv) {
+        unsigned char *row = (unsigned char*)rawfb->fb.pixels + y * rawfb->fb.pitch;
+        const int vi = (v < (vmin << 16)) ? vmin : MIN(v >> 16, vmax);
+        const int vj = MIN(vi + 1, vmax);
+        const unsigned int fv = (v < (vmin << 16)) ? 0 : (unsigned int)(v >> 8) & 0xff;
+        const unsigned char *r0 = (const unsigned char*)tex->pixels + vi * tex->pitch;
+        const unsigned char *r1 = (const unsigned char*)tex->pixels + vj * tex->pitch;
+        int u = ubase + x0 * du;
+        for (x = x0; x < x1; ++x, u += du) {
+            const int ui = (u < (umin << 16)) ? umin : MIN(u >> 16, umax);
+            const int uj = MIN(ui + 1, umax);
+            const unsigned int fu = (u < (umin << 16)) ? 0 : (unsigned int)(u >> 8) & 0xff;
+            const unsigned int w00 = (256 - fu) * (256 - fv), w10 = fu * (256 - fv);
+            const unsigned int w01 = (256 - fu) * fv, w11 = fu * fv;
+            const struct nk_color c00 = nk_rawfb_texture_fetch(tex, r0, ui, vi);
+            const struct nk_color c10 = nk_rawfb_texture_fetch(tex, r0, uj, vi);
+            const struct nk_color c01 = nk_rawfb_texture_fetch(tex, r1, ui, vj);
+            const struct nk_color c11 = nk_rawfb_texture_fetch(tex, r1, uj, vj);
+            struct nk_color c;
+            c.r = (nk_byte)((c00.r * w00 + c10.r * w10 + c01.r * w01 + c11.r * w11 + 32768) >> 16);
+            c.g = (nk_byte)((c00.g * w00 + c10.g * w10 + c01.g * w01 + c11.g * w11 + 32768) >> 16);
+            c.b = (nk_byte)((c00.b * w00 + c10.b * w10 + c01.b * w01 + c11.b * w11 + 32768) >> 16);
+            c.a = (nk_byte)((c00.a * w00 + c10.a * w10 + c01.a * w01 + c11.a * w11 + 32768) >> 16);
+            if (!white) c = nk_rawfb_tint_premultiplied(c, tint);
+            if (c.a == 0xff)
+                nk_rawfb_row_setpixel(&rawfb->fb, row, x, nk_rawfb_color2int(c, &rawfb->fb.pl));
+            else nk_rawfb_row_blendpremultiplied(&rawfb->fb, row, x, c);
+        }
+    }
+}
+
+NK_API struct nk_image
+nk_rawfb_image_load(struct rawfb_context *rawfb, const void *rgba,
+    const int w, const int h)
+{
+    /* Converts a RGBA image into the framebuffer format with premultiplied
+     * colors and registers it. The returned image refers to it by id */
+    const unsigned char *src = rgba;
+    struct rawfb_image *img = NULL;
+    int i, opaque = 1;
+
+    for (i = 0; i < rawfb->image_count; ++i)
+        if (!rawfb->images[i].pixels) img = &rawfb->images[i];
+    if (!img) {
+        void *images = realloc(rawfb->images, (size_t)(rawfb->image_count + 1) * sizeof(struct rawfb_image));
+        if (!images) return nk_subimage_id(-1, 0, 0, nk_rect(0,0,0,0));
+        rawfb->images = images;
+        img = &rawfb->images[rawfb->image_count++];
+    }
+    memset(img, 0, sizeof(*img));
+    img->w = w;
+    img->h = h;
+    img->pl = rawfb->fb.pl;
+    img->pitch = w * img->pl.bytesPerPixel;
+    img->pixels = malloc((size_t)(img->pitch * h));
+    img->alpha = malloc((size_t)(w * h));
+    if (!img->pixels || !img->alpha) {
+        free(img->pixels);
+        free(img->alpha);
+        memset(img, 0, sizeof(*img));
+        return nk_subimage_id(-1, 0, 0, nk_rect(0,0,0,0));
+    }
+    for (i = 0; i < w * h; ++i, src += 4) {
+        struct nk_color c;
+        c.r = src[0]; c.g = src[1]; c.b = src[2]; c.a = src[3];
+        c = nk_rawfb_tint_premultiplied(nk_rgba(0xff,0xff,0xff,0xff), c);
+        nk_rawfb_row_setpixel(img, (unsigned char*)img->pixels + (i / w) * img->pitch,
+            i % w, nk_rawfb_color2int(c, &img->pl));
+        img->alpha[i] = src[3];
+        opaque = opaque && src[3] == 0xff;
+    }
+    if (opaque) {
+        free(img->alpha);
+        img->alpha = NULL;
+    }
+    return nk_subimage_id((int)(img - rawfb->images) + 1, (nk_ushort)w, (nk_ushort)h, nk_rect(0, 0, w, h));
+}
+
+NK_API void
+nk_rawfb_image_free(struct rawfb_context *rawfb, const struct nk_image img)
+{
+    struct rawfb_image *tex;
+    if (img.handle.id <= 0 || img.handle.id > rawfb->image_count)
+        return;
+    tex = &rawfb->images[img.handle.id - 1];
+    free(tex->pixels);
+    free(tex->alpha);
+    memset(tex, 0, sizeof(*tex));
+}
+
 static void
 nk_rawfb_font_query_font_glyph(nk_handle handle, const float height,
     struct nk_user_font_glyph *glyph, const nk_rune codepoint,
@@ -928,6 +1669,187 @@ nk_rawfb_font_query_font_glyph(nk_handle handle, const float height,
     glyph->uv[1] = nk_vec2(g->u1, g->v1);
 }
 
+/* ===============================================================
+ *
+ *                          GLYPH CACHE
+ *
+ * ===============================================================*/
+/* Glyphs are resampled from the alpha atlas once for every font height
+ * they are drawn at and kept as one coverage byte per pixel. Drawing text
+ * then only blends the cached coverage with the text color. The cache is
+ * an open addressed table that is flushed as a whole once its coverage
+ * grows past NK_RAWFB_GLYPH_CACHE_SIZE bytes. */
+#ifndef NK_RAWFB_GLYPH_CACHE_SIZE
+#define NK_RAWFB_GLYPH_CACHE_SIZE (512 * 1024)
+#endif
+
+static unsigned int
+nk_rawfb_glyph_hash(const void *font, const float height, const nk_rune rune)
+{
+    unsigned int h = (unsigned int)(nk_size)font;
+    h ^= (unsigned int)(height * 64.0f) * 0x9E3779B1u;
+    h ^= rune * 0x85EBCA77u;
+    return h ^ (h >> 15);
+}
+
+static struct rawfb_glyph*
+nk_rawfb_glyph_slot(struct rawfb_glyphs *cache, const void *font,
+    const float height, const nk_rune rune)
+{
+    /* returns the matching slot or the empty one to insert into */
+    unsigned int i = nk_rawfb_glyph_hash(font, height, rune);
+    for (;; ++i) {
+        struct rawfb_glyph *g = &cache->slots[i & (unsigned int)(cache->cap - 1)];
+        if (!g->font || (g->font == font && g->height == height && g->rune == rune))
+            return g;
+    }
+}
+
+static int
+nk_rawfb_glyph_reserve(struct rawfb_glyphs *cache, const int bytes)
+{
+    if (cache->used + bytes > NK_RAWFB_GLYPH_CACHE_SIZE) {
+        /* flush, glyphs still in use are resampled again */
+        memset(cache->slots, 0, sizeof(struct rawfb_glyph) * (size_t)cache->cap);
+        cache->count = 0;
+        cache->used = 0;
+    }
+    if (cache->used + bytes > cache->size) {
+        const int size = MAX(MAX(cache->size * 2, cache->used + bytes), 4096);
+        unsigned char *coverage = realloc(cache->coverage, (size_t)size);
+        if (!coverage) return 0;
+        cache->coverage = coverage;
+        cache->size = size;
+    }
+    if ((cache->count + 1) * 2 > cache->cap) {
+        const struct rawfb_glyph *old = cache->slots;
+        const int old_cap = cache->cap;
+        int i;
+        cache->cap = MAX(old_cap * 2, 256);
+        cache->slots = calloc((size_t)cache->cap, sizeof(struct rawfb_glyph));
+        if (!cache->slots) {
+            cache->slots = (struct rawfb_glyph*)old;
+            cache->cap = old_cap;
+            return 0;
+        }
+        for (i = 0; i < old_cap; ++i)
+            if (old[i].font)
+                *nk_rawfb_glyph_slot(cache, old[i].font, old[i].height, old[i].rune) = old[i];
+        free((void*)old);
+    }
+    return 1;
+}
+
+static void
+nk_rawfb_glyph_resample(unsigned char *dst, const int w, const int h,
+    const struct rawfb_image *atlas, const struct nk_rect src)
+{
+    /* box filter: every destination pixel averages the atlas area it
+     * covers, which also folds horizontally oversampled glyphs */
+    const float sx = src.w / (float)w, sy = src.h / (float)h;
+    const float norm = 255.0f / (sx * sy);
+    int i, j, u, v;
+    for (j = 0; j < h; ++j) {
+        const float v0 = src.y + (float)j * sy, v1 = v0 + sy;
+        for (i = 0; i < w; ++i) {
+            const float u0 = src.x + (float)i * sx, u1 = u0 + sx;
+            float sum = 0;
+            for (v = (int)v0; (float)v < v1; ++v) {
+                const float wv = MIN((float)(v + 1), v1) - MAX((float)v, v0);
+                const unsigned char *row = (const unsigned char*)atlas->pixels + v * atlas->pitch;
+                if (v < 0 || v >= atlas->h) continue;
+                for (u = (int)u0; (float)u < u1; ++u) {
+                    const float wu = MIN((float)(u + 1), u1) - MAX((float)u, u0);
+                    if (u < 0 || u >= atlas->w) continue;
+                    sum += wu * wv * (float)row[u];
+                }
+            }
+            dst[j * w + i] = (unsigned char)MIN(sum * norm / 255.0f + 0.5f, 255.0f);
+        }
+    }
+}
+
+static const struct rawfb_glyph*
+nk_rawfb_glyph_find(const struct rawfb_context *rawfb, const struct nk_user_font *font,
+    const float height, const nk_rune rune)
+{
+    struct rawfb_glyphs *cache = (struct rawfb_glyphs*)&rawfb->glyphs;
+    struct nk_user_font_glyph info;
+    struct rawfb_glyph *g;
+    struct nk_rect src;
+    int w, h;
+
+    if (cache->cap) {
+        g = nk_rawfb_glyph_slot(cache, font->userdata.ptr, height, rune);
+        if (g->font) return g;
+    }
+
+    nk_rawfb_font_query_font_glyph(font->userdata, height, &info, rune, 0);
+    w = (int)ceil(info.width);
+    h = (int)ceil(info.height);
+    if (w <= 0 || h <= 0)
+        w = h = 0;
+    if (!nk_rawfb_glyph_reserve(cache, w * h))
+        return NULL;
+
+    g = nk_rawfb_glyph_slot(cache, font->userdata.ptr, height, rune);
+    g->font = font->userdata.ptr;
+    g->height = height;
+    g->rune = rune;
+    g->x = info.offset.x;
+    g->y = info.offset.y;
+    g->xadvance = info.xadvance;
+    g->w = (short)w;
+    g->h = (short)h;
+    g->coverage = cache->used;
+    src.x = info.uv[0].x * rawfb->font_tex.w;
+    src.y = info.uv[0].y * rawfb->font_tex.h;
+    src.w = info.uv[1].x * rawfb->font_tex.w - src.x;
+    src.h = info.uv[1].y * rawfb->font_tex.h - src.y;
+    if (w) nk_rawfb_glyph_resample(cache->coverage + g->coverage, w, h, &rawfb->font_tex, src);
+    cache->used += w * h;
+    cache->count++;
+    return g;
+}
+
+static void
+nk_rawfb_draw_glyph(const struct rawfb_context *rawfb, const struct rawfb_glyph *g,
+    const int x, const int y, const struct nk_color fg, const struct rawfb_paint *paint)
+{
+    const int x0 = MAX(x, (int)rawfb->scissors.x);
+    const int y0 = MAX(y, (int)rawfb->scissors.y);
+    const int x1 = MIN(x + g->w, (int)rawfb->scissors.w);
+    const int y1 = MIN(y + g->h, (int)rawfb->scissors.h);
+    const unsigned char *coverage = rawfb->glyphs.coverage + g->coverage;
+    struct nk_color col = fg;
+    int i, j;
+
+    for (j = y0; j < y1; ++j) {
+        const unsigned char *src = coverage + (j - y) * g->w - x;
+        unsigned char *row = (unsigned char*)rawfb->fb.pixels + j * rawfb->fb.pitch;
+        for (i = x0; i < x1; ++i) {
+            unsigned int a = src[i], t;
+            if (!a) continue;
+            t = a * fg.a + 128;
+            a = (t + (t >> 8)) >> 8;
+            if (a == 0xff) {
+                nk_rawfb_row_setpixel(&rawfb->fb, row, i, paint->word);
+            } else if (paint->packed) {
+                /* pre_rb and pre_ag hold the opaque text color */
+                unsigned int *pixel = (unsigned int*)row + i;
+                unsigned int rb = (*pixel & 0x00ff00ff) * (0xff - a) + paint->pre_rb * a + 0x00800080;
+                unsigned int ag = ((*pixel >> 8) & 0x00ff00ff) * (0xff - a) + paint->pre_ag * a + 0x00800080;
+                rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+                ag = (ag + ((ag >> 8) & 0x00ff00ff)) & 0xff00ff00;
+                *pixel = rb | ag;
+            } else {
+                col.a = (nk_byte)a;
+                nk_rawfb_row_blendpixel(&rawfb->fb, row, i, col);
+            }
+        }
+    }
+}
+
 NK_API void
 nk_rawfb_draw_text(const struct rawfb_context *rawfb,
     const struct nk_user_font *font, const struct nk_rect rect,
@@ -936,49 +1858,38 @@ nk_rawfb_draw_text(const struct rawfb_context *rawfb,
 {
     float x = 0;
     int text_len = 0;
-    nk_rune unicode = 0;
-    nk_rune next = 0;
-    int glyph_len = 0;
-    int next_glyph_len = 0;
-    struct nk_user_font_glyph g;
-    if (!len || !text) return;
-
-    x = 0;
-    glyph_len = nk_utf_decode(text, &unicode, len);
-    if (!glyph_len) return;
-
-    /* draw every glyph image */
-    while (text_len < len && glyph_len) {
-        struct nk_rect src_rect;
-        struct nk_rect dst_rect;
-        float char_width = 0;
-        if (unicode == NK_UTF_INVALID) break;
-
-        /* query currently drawn glyph information */
-        next_glyph_len = nk_utf_decode(text + text_len + glyph_len, &next, (int)len - text_len);
-        nk_rawfb_font_query_font_glyph(font->userdata, font_height, &g, unicode,
-                    (next == NK_UTF_INVALID) ? '\0' : next);
-
-        /* calculate and draw glyph drawing rectangle and image */
-        char_width = g.xadvance;
-        src_rect.x = g.uv[0].x * rawfb->font_tex.w;
-        src_rect.y = g.uv[0].y * rawfb->font_tex.h;
-        src_rect.w = g.uv[1].x * rawfb->font_tex.w - g.uv[0].x * rawfb->font_tex.w;
-        src_rect.h = g.uv[1].y * rawfb->font_tex.h - g.uv[0].y * rawfb->font_tex.h;
-
-        dst_rect.x = x + g.offset.x + rect.x;
-        dst_rect.y = g.offset.y + rect.y;
-        dst_rect.w = ceil(g.width);
-        dst_rect.h = ceil(g.height);
-
-        /* Use software rescaling to blit glyph from font_text to framebuffer */
-        nk_rawfb_stretch_image(&rawfb->fb, &rawfb->font_tex, &dst_rect, &src_rect, &rawfb->scissors, &fg);
-
-        /* offset next glyph */
-        text_len += glyph_len;
-        x += char_width;
-        glyph_len = next_glyph_len;
-        unicode = next;
+    nk_rune runes[64];
+    int run_len, count, i;
+    struct nk_color opaque = fg;
+    struct rawfb_paint paint;
+    if (!len || !text || !fg.a) return;
+
+    /* the packed blend in nk_rawfb_draw_glyph mixes the opaque color */
+    opaque.a = 0xff;
+    paint = nk_rawfb_paint(opaque, &rawfb->fb.pl);
+    if (paint.packed) {
+        paint.pre_rb = paint.word & 0x00ff00ff;
+        paint.pre_ag = (paint.word >> 8) & 0x00ff00ff;
+    }
+
+    while (text_len < len) {
+        count = nk_utf_decode_run(text + text_len, len - text_len, runes,
+            (int)(sizeof(runes) / sizeof(runes[0])), &run_len);
+        for (i = 0; i < count; ++i) {
+            const struct rawfb_glyph *g;
+            if (runes[i] == NK_UTF_INVALID) return;
+
+            g = nk_rawfb_glyph_find(rawfb, font, font_height, runes[i]);
+            if (!g) return;
+            if (g->w)
+                nk_rawfb_draw_glyph(rawfb, g, (int)(rect.x + x + g->x + 0.5f),
+                    (int)(rect.y + g->y + 0.5f), fg, &paint);
+
+            /* offset next glyph */
+            x += g->xadvance;
+        }
+        if (!run_len) break;
+        text_len += run_len;
     }
 }
 
@@ -989,6 +1900,7 @@ nk_rawfb_drawimage(const struct rawfb_context *rawfb,
 {
     struct nk_rect src_rect;
     struct nk_rect dst_rect;
+    const struct rawfb_image *tex = NULL;
 
     src_rect.x = img->region[0];
     src_rect.y = img->region[1];
@@ -999,13 +1911,49 @@ nk_rawfb_drawimage(const struct rawfb_context *rawfb,
     dst_rect.y = y;
     dst_rect.w = w;
     dst_rect.h = h;
-    nk_rawfb_stretch_image(&rawfb->fb, &rawfb->font_tex, &dst_rect, &src_rect, &rawfb->scissors, col);
+
+    if (img->handle.id > 0 && img->handle.id <= rawfb->image_count)
+        tex = &rawfb->images[img->handle.id - 1];
+    if (!tex || !tex->pixels) {
+        nk_rawfb_stretch_image(&rawfb->fb, &rawfb->font_tex, &dst_rect, &src_rect, &rawfb->scissors, col);
+        return;
+    }
+
+    /* registered image, pick the cheapest blitter for this draw */
+    if (!nk_image_is_subimage(img) || src_rect.w <= 0 || src_rect.h <= 0)
+        src_rect = nk_rect(0, 0, tex->w, tex->h);
+    src_rect.x = MIN(MAX(src_rect.x, 0), tex->w);
+    src_rect.y = MIN(MAX(src_rect.y, 0), tex->h);
+    src_rect.w = MIN(src_rect.w, tex->w - src_rect.x);
+    src_rect.h = MIN(src_rect.h, tex->h - src_rect.y);
+    if (src_rect.w <= 0 || src_rect.h <= 0 || w <= 0 || h <= 0)
+        return;
+    if ((int)src_rect.w == w && (int)src_rect.h == h)
+        nk_rawfb_blit_image(rawfb, tex, dst_rect, (int)src_rect.x, (int)src_rect.y, *col);
+    else nk_rawfb_blit_image_bilinear(rawfb, tex, dst_rect, src_rect, *col);
 }
 
 NK_API void
 nk_rawfb_shutdown(struct rawfb_context *rawfb)
 {
     if (rawfb) {
+        int i;
+        for (i = 0; i < rawfb->image_count; ++i) {
+            free(rawfb->images[i].pixels);
+            free(rawfb->images[i].alpha);
+        }
+        free(rawfb->images);
+        free(rawfb->raster.cells);
+        free(rawfb->raster.edges);
+        free(rawfb->raster.active);
+        free(rawfb->glyphs.slots);
+        free(rawfb->glyphs.coverage);
+        nk_frame_delta_free(&rawfb->delta);
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+        nk_buffer_free(&rawfb->cmds);
+        nk_buffer_free(&rawfb->vertices);
+        nk_buffer_free(&rawfb->elements);
+#endif
         nk_free(&rawfb->ctx);
         memset(rawfb, 0, sizeof(struct rawfb_context));
         free(rawfb);
@@ -1025,25 +1973,45 @@ nk_rawfb_resize_fb(struct rawfb_context *rawfb,
     rawfb->fb.pixels = fb;
     rawfb->fb.pitch = pitch;
     rawfb->fb.pl = pl;
+    rawfb->damage_frames = 0;
+    nk_rawfb_region(rawfb, nk_rect(0, 0, w, h));
 }
 
 NK_API void
-nk_rawfb_render(const struct rawfb_context *rawfb,
-                const struct nk_color clear,
-                const unsigned char enable_clear)
+nk_rawfb_set_fb(struct rawfb_context *rawfb, void *fb)
+{
+    /* Switches to another buffer of the same size and format, keeping the
+     * damage history so double buffered hosts only redraw what changed */
+    rawfb->fb.pixels = fb;
+}
+
+NK_API void
+nk_rawfb_set_anti_aliasing(struct rawfb_context *rawfb, enum nk_anti_aliasing aa)
+{
+    /* Circles, rounded rectangles, polygons and lines are drawn with
+     * exact area coverage instead of aliased scanlines */
+    rawfb->aa = aa;
+}
+
+static void
+nk_rawfb_render_commands(const struct rawfb_context *rawfb)
 {
     const struct rawfb_pl *pl = &rawfb->fb.pl;
     const struct nk_command *cmd;
-
-    if (enable_clear)
-        nk_rawfb_clear(rawfb, nk_rawfb_color2int(clear, pl));
+    int visible = rawfb->scissors.x < rawfb->scissors.w &&
+        rawfb->scissors.y < rawfb->scissors.h;
 
     nk_foreach(cmd, (struct nk_context*)&rawfb->ctx) {
+        /* everything up to the next scissor is clipped away */
+        if (!visible && cmd->type != NK_COMMAND_SCISSOR)
+            continue;
         switch (cmd->type) {
         case NK_COMMAND_NOP: break;
         case NK_COMMAND_SCISSOR: {
             const struct nk_command_scissor *s =(const struct nk_command_scissor*)cmd;
             nk_rawfb_scissor((struct rawfb_context *)rawfb, s->x, s->y, s->w, s->h);
+            visible = rawfb->scissors.x < rawfb->scissors.w &&
+                rawfb->scissors.y < rawfb->scissors.h;
         } break;
         case NK_COMMAND_LINE: {
             const struct nk_command_line *l = (const struct nk_command_line *)cmd;
@@ -1059,7 +2027,7 @@ nk_rawfb_render(const struct rawfb_context *rawfb,
         case NK_COMMAND_RECT_FILLED: {
             const struct nk_command_rect_filled *r = (const struct nk_command_rect_filled *)cmd;
             nk_rawfb_fill_rect(rawfb, r->x, r->y, r->w, r->h,
-                (unsigned short)r->rounding, nk_rawfb_color2int(r->color, pl));
+                (unsigned short)r->rounding, r->color);
         } break;
         case NK_COMMAND_CIRCLE: {
             const struct nk_command_circle *c = (const struct nk_command_circle *)cmd;
@@ -1068,8 +2036,7 @@ nk_rawfb_render(const struct rawfb_context *rawfb,
         } break;
         case NK_COMMAND_CIRCLE_FILLED: {
             const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled *)cmd;
-            nk_rawfb_fill_circle(rawfb, c->x, c->y, c->w, c->h,
-                                 nk_rawfb_color2int(c->color, pl));
+            nk_rawfb_fill_circle(rawfb, c->x, c->y, c->w, c->h, c->color);
         } break;
         case NK_COMMAND_TRIANGLE: {
             const struct nk_command_triangle*t = (const struct nk_command_triangle*)cmd;
@@ -1079,7 +2046,7 @@ nk_rawfb_render(const struct rawfb_context *rawfb,
         case NK_COMMAND_TRIANGLE_FILLED: {
             const struct nk_command_triangle_filled *t = (const struct nk_command_triangle_filled *)cmd;
             nk_rawfb_fill_triangle(rawfb, t->a.x, t->a.y, t->b.x, t->b.y,
-                t->c.x, t->c.y, nk_rawfb_color2int(t->color, pl));
+                t->c.x, t->c.y, t->color);
         } break;
         case NK_COMMAND_POLYGON: {
             const struct nk_command_polygon *p =(const struct nk_command_polygon*)cmd;
@@ -1088,7 +2055,7 @@ nk_rawfb_render(const struct rawfb_context *rawfb,
         } break;
         case NK_COMMAND_POLYGON_FILLED: {
             const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled *)cmd;
-            nk_rawfb_fill_polygon(rawfb, p->points, p->point_count, nk_rawfb_color2int(p->color, pl));
+            nk_rawfb_fill_polygon(rawfb, p->points, p->point_count, p->color);
         } break;
         case NK_COMMAND_POLYLINE: {
             const struct nk_command_polyline *p = (const struct nk_command_polyline *)cmd;
@@ -1120,7 +2087,425 @@ nk_rawfb_render(const struct rawfb_context *rawfb,
         } break;
         default: break;
         }
-    } nk_clear((struct nk_context*)&rawfb->ctx);
+    }
 }
+
+NK_API void
+nk_rawfb_render(const struct rawfb_context *rawfb,
+                const struct nk_color clear,
+                const unsigned char enable_clear)
+{
+    if (enable_clear)
+        nk_rawfb_clear(rawfb, nk_rawfb_color2int(clear, &rawfb->fb.pl));
+    nk_rawfb_render_commands(rawfb);
+    nk_clear((struct nk_context*)&rawfb->ctx);
+    /* buffers drawn by nk_rawfb_render_damage are no longer known */
+    ((struct rawfb_context *)rawfb)->damage_frames = 0;
+}
+
+/* ===============================================================
+ *
+ *                          DAMAGE
+ *
+ * ===============================================================*/
+/* Only windows whose draw commands changed since the previous frame are
+ * redrawn. The changed window bounds of the last few frames are kept so a
+ * host presenting from more than one buffer can bring a buffer that is
+ * several frames old up to date. */
+static int
+nk_rawfb_damage_overlap(const struct nk_rect a, const struct nk_rect b)
+{
+    return a.x <= b.x + b.w && b.x <= a.x + a.w &&
+        a.y <= b.y + b.h && b.y <= a.y + a.h;
+}
+
+static struct nk_rect
+nk_rawfb_damage_union(const struct nk_rect a, const struct nk_rect b)
+{
+    const float x0 = MIN(a.x, b.x), y0 = MIN(a.y, b.y);
+    const float x1 = MAX(a.x + a.w, b.x + b.w), y1 = MAX(a.y + a.h, b.y + b.h);
+    return nk_rect(x0, y0, x1 - x0, y1 - y0);
+}
+
+static void
+nk_rawfb_damage_add(struct rawfb_damage *damage, struct nk_rect r)
+{
+    int i;
+    if (r.w <= 0 || r.h <= 0)
+        return;
+    for (;;) {
+        float best_area = 0;
+        int best = -1;
+
+        /* rects touching the new one are merged into it */
+        for (i = 0; i < damage->count;) {
+            if (nk_rawfb_damage_overlap(damage->rects[i], r)) {
+                r = nk_rawfb_damage_union(damage->rects[i], r);
+                damage->rects[i] = damage->rects[--damage->count];
+                i = 0;
+            } else ++i;
+        }
+        if (damage->count < NK_RAWFB_MAX_DAMAGE) {
+            damage->rects[damage->count++] = r;
+            return;
+        }
+        /* list is full: merge into the rect that grows the least */
+        for (i = 0; i < damage->count; ++i) {
+            const struct nk_rect u = nk_rawfb_damage_union(damage->rects[i], r);
+            const float area = u.w * u.h - damage->rects[i].w * damage->rects[i].h;
+            if (best < 0 || area < best_area) {
+                best_area = area;
+                best = i;
+            }
+        }
+        r = nk_rawfb_damage_union(damage->rects[best], r);
+        damage->rects[best] = damage->rects[--damage->count];
+    }
+}
+
+static struct nk_rect
+nk_rawfb_damage_rect(const struct rawfb_context *rawfb, const struct nk_rect r)
+{
+    /* whole pixels, one extra around for glyphs reaching past their
+     * command bounds, clipped to the framebuffer */
+    const float x0 = MAX((float)floor(r.x) - 1, 0);
+    const float y0 = MAX((float)floor(r.y) - 1, 0);
+    const float x1 = MIN((float)ceil(r.x + r.w) + 1, (float)rawfb->fb.w);
+    const float y1 = MIN((float)ceil(r.y + r.h) + 1, (float)rawfb->fb.h);
+    return nk_rect(x0, y0, MAX(x1 - x0, 0), MAX(y1 - y0, 0));
+}
+
+NK_API int
+nk_rawfb_render_damage(struct rawfb_context *rawfb,
+                       const struct nk_color clear,
+                       const unsigned char enable_clear,
+                       const int buffer_age,
+                       const struct nk_rect **damage)
+{
+    /* `buffer_age` is the number of frames since the framebuffer was last
+     * drawn: 1 when drawing into the same buffer every frame, 2 for
+     * double buffering and 0 if its content is unknown. Returns the rects
+     * that changed since the previous frame for the host to present. */
+    const struct nk_rect full = nk_rect(0, 0, rawfb->fb.w, rawfb->fb.h);
+    const struct nk_window_delta *deltas;
+    const int synced = rawfb->delta.synced;
+    struct rawfb_damage redraw;
+    int count, i, j;
+
+    memmove(&rawfb->damage[1], &rawfb->damage[0],
+        sizeof(rawfb->damage[0]) * (NK_RAWFB_DAMAGE_FRAMES - 1));
+    rawfb->damage[0].count = 0;
+    deltas = nk_frame_delta(&rawfb->delta, &rawfb->ctx, &count);
+    if (!deltas || !synced || !rawfb->damage_frames) {
+        /* nothing reliable to compare against */
+        nk_rawfb_damage_add(&rawfb->damage[0], full);
+    } else {
+        for (i = 0; i < count; ++i) {
+            if (deltas[i].status == NK_WINDOW_DELTA_UNCHANGED)
+                continue;
+            nk_rawfb_damage_add(&rawfb->damage[0],
+                nk_rawfb_damage_rect(rawfb, deltas[i].bounds));
+        }
+    }
+    rawfb->damage_frames = MIN(rawfb->damage_frames + 1, NK_RAWFB_DAMAGE_FRAMES);
+
+    redraw.count = 0;
+    if (buffer_age <= 0 || buffer_age > rawfb->damage_frames) {
+        nk_rawfb_damage_add(&redraw, full);
+    } else {
+        for (i = 0; i < buffer_age; ++i)
+            for (j = 0; j < rawfb->damage[i].count; ++j)
+                nk_rawfb_damage_add(&redraw, rawfb->damage[i].rects[j]);
+    }
+
+    for (i = 0; i < redraw.count; ++i) {
+        const struct nk_rect r = redraw.rects[i];
+        nk_rawfb_region(rawfb, r);
+        nk_rawfb_scissor(rawfb, r.x, r.y, r.w, r.h);
+        if (enable_clear)
+            nk_rawfb_clear(rawfb, nk_rawfb_color2int(clear, &rawfb->fb.pl));
+        nk_rawfb_render_commands(rawfb);
+    }
+    nk_rawfb_region(rawfb, full);
+    nk_clear(&rawfb->ctx);
+
+    if (damage)
+        *damage = rawfb->damage[0].rects;
+    return rawfb->damage[0].count;
+}
+
+#ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+/* ===============================================================
+ *
+ *                      TRIANGLE RASTERIZER
+ *
+ * ===============================================================*/
+/* Second render path drawing the triangles produced by `nk_convert`.
+ * Triangles are walked in blocks of 8x8 pixels with half-space edge
+ * functions on a grid of 1/16 pixel. Blocks outside of one edge are
+ * skipped and blocks inside of all edges are filled without per pixel
+ * edge tests, so the cost mostly depends on the number of covered pixels.
+ * Colors and texture coordinates are interpolated in 16.16 fixed point. */
+#define NK_RAWFB_SUBPIXEL 16
+#define NK_RAWFB_BLOCK 8
+
+struct rawfb_vertex {
+    float position[2];
+    float uv[2];
+    nk_byte col[4];
+};
+
+static struct nk_color
+nk_rawfb_sample(const struct rawfb_image *tex, int u, int v, struct nk_color col)
+{
+    struct nk_color texel;
+    unsigned int t;
+    u = MIN(MAX(u, 0), tex->w - 1);
+    v = MIN(MAX(v, 0), tex->h - 1);
+    if (tex->pl.bytesPerPixel == 1 && tex->pl.rloss == 8) {
+        /* alpha only texture like the font atlas */
+        t = col.a * ((const unsigned char *)tex->pixels)[v * tex->pitch + u] + 128;
+        col.a = (nk_byte)((t + (t >> 8)) >> 8);
+        return col;
+    }
+    texel = nk_rawfb_img_getpixel(tex, u, v);
+    if (tex->alpha) {
+        /* registered images are premultiplied */
+        texel.a = tex->alpha[v * tex->w + u];
+        if (texel.a && texel.a != 0xff) {
+            texel.r = (nk_byte)MIN(texel.r * 0xff / texel.a, 0xff);
+            texel.g = (nk_byte)MIN(texel.g * 0xff / texel.a, 0xff);
+            texel.b = (nk_byte)MIN(texel.b * 0xff / texel.a, 0xff);
+        }
+    }
+    return nk_rawfb_modulate(col, texel);
+}
+
+static int
+nk_rawfb_fixed(const double value, const int limit)
+{
+    /* 16.16 fixed point. Slivers can have huge gradients, so values are
+     * clamped to stay in range while stepping over a whole block */
+    return (int)(MIN(MAX(value, -limit), limit) * 65536.0);
+}
+
+static void
+nk_rawfb_raster_triangle(const struct rawfb_context *rawfb,
+    const struct rawfb_vertex *v0, const struct rawfb_vertex *v1,
+    const struct rawfb_vertex *v2, const struct rawfb_image *tex,
+    const int clip_x0, const int clip_y0, const int clip_x1, const int clip_y1)
+{
+    const struct rawfb_vertex *v[3];
+    double x[3], y[3], f[3][6];
+    double ea[3], eb[3], ec[3], dfdx[6], dfdy[6];
+    double area, minx, miny, maxx, maxy;
+    int bias[3], i, k, flat, uv_flat, tex_white;
+    int bx0, by0, bx1, by1, bx, by;
+    struct nk_color flat_col, tex_col;
+    rawfb_color flat_pixel = 0;
+
+    v[0] = v0; v[1] = v1; v[2] = v2;
+    for (i = 0; i < 3; ++i) {
+        x[i] = floor(v[i]->position[0] * NK_RAWFB_SUBPIXEL + 0.5f);
+        y[i] = floor(v[i]->position[1] * NK_RAWFB_SUBPIXEL + 0.5f);
+    }
+    area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+    if (area == 0) return;
+    if (area < 0) {
+        /* make the winding positive for the edge functions below */
+        double t;
+        const struct rawfb_vertex *tv = v[1]; v[1] = v[2]; v[2] = tv;
+        t = x[1]; x[1] = x[2]; x[2] = t;
+        t = y[1]; y[1] = y[2]; y[2] = t;
+        area = -area;
+    }
+    minx = MIN(x[0], MIN(x[1], x[2])); maxx = MAX(x[0], MAX(x[1], x[2]));
+    miny = MIN(y[0], MIN(y[1], y[2])); maxy = MAX(y[0], MAX(y[1], y[2]));
+    bx0 = MAX(clip_x0, (int)floor(minx / NK_RAWFB_SUBPIXEL));
+    by0 = MAX(clip_y0, (int)floor(miny / NK_RAWFB_SUBPIXEL));
+    bx1 = MIN(clip_x1, (int)ceil(maxx / NK_RAWFB_SUBPIXEL) + 1);
+    by1 = MIN(clip_y1, (int)ceil(maxy / NK_RAWFB_SUBPIXEL) + 1);
+    if (bx0 >= bx1 || by0 >= by1) return;
+
+    /* edge i lies opposite of vertex i and is positive inside. Pixels exactly
+     * on an edge belong to only one of two triangles sharing it */
+    for (i = 0; i < 3; ++i) {
+        const int j = (i + 1) % 3, n = (i + 2) % 3;
+        ea[i] = y[j] - y[n];
+        eb[i] = x[n] - x[j];
+        ec[i] = -(ea[i] * x[j] + eb[i] * y[j]);
+        bias[i] = (ea[i] > 0 || (ea[i] == 0 && eb[i] > 0)) ? 0: -1;
+    }
+
+    /* attribute planes: r, g, b, a, u, v */
+    for (i = 0; i < 3; ++i) {
+        for (k = 0; k < 4; ++k)
+            f[i][k] = v[i]->col[k];
+        f[i][4] = v[i]->uv[0] * tex->w;
+        f[i][5] = v[i]->uv[1] * tex->h;
+    }
+    flat = uv_flat = 1;
+    for (k = 0; k < 6; ++k) {
+        const double d1 = f[1][k] - f[0][k], d2 = f[2][k] - f[0][k];
+        dfdx[k] = (d1 * (y[2] - y[0]) - d2 * (y[1] - y[0])) / area * NK_RAWFB_SUBPIXEL;
+        dfdy[k] = (d2 * (x[1] - x[0]) - d1 * (x[2] - x[0])) / area * NK_RAWFB_SUBPIXEL;
+        if (d1 != 0 || d2 != 0) {
+            flat = 0;
+            if (k >= 4) uv_flat = 0;
+        }
+    }
+    /* shapes use a single white texel, so it only has to be looked up once */
+    tex_col = nk_rawfb_sample(tex, (int)floor(f[0][4]), (int)floor(f[0][5]), nk_rgba(0xff,0xff,0xff,0xff));
+    tex_white = uv_flat && tex_col.r == 0xff && tex_col.g == 0xff && tex_col.b == 0xff && tex_col.a == 0xff;
+    if (flat) {
+        flat_col = nk_rgba(v[0]->col[0], v[0]->col[1], v[0]->col[2], v[0]->col[3]);
+        flat_col = nk_rawfb_modulate(flat_col, tex_col);
+        if (flat_col.a == 0) return;
+        flat_pixel = nk_rawfb_color2int(flat_col, &rawfb->fb.pl);
+    }
+
+    for (by = by0; by < by1; by += NK_RAWFB_BLOCK) {
+        const int bh = MIN(NK_RAWFB_BLOCK, by1 - by);
+        for (bx = bx0; bx < bx1; bx += NK_RAWFB_BLOCK) {
+            const int bw = MIN(NK_RAWFB_BLOCK, bx1 - bx);
+            const double cx = bx * NK_RAWFB_SUBPIXEL + NK_RAWFB_SUBPIXEL / 2;
+            const double cy = by * NK_RAWFB_SUBPIXEL + NK_RAWFB_SUBPIXEL / 2;
+            int e[3], edx[3], edy[3], val[6], vdx[6], vdy[6];
+            int partial = 0, outside = 0, px, py;
+
+            /* edge functions are linear so the block corners bound them.
+             * Edges not crossing the block are left out of the pixel test */
+            for (i = 0; i < 3 && !outside; ++i) {
+                const double e0 = ea[i] * cx + eb[i] * cy + ec[i] + bias[i];
+                const double sx = ea[i] * NK_RAWFB_SUBPIXEL * (bw - 1);
+                const double sy = eb[i] * NK_RAWFB_SUBPIXEL * (bh - 1);
+                e[i] = edx[i] = edy[i] = 0;
+                if (e0 + MAX(sx, 0) + MAX(sy, 0) < 0) {
+                    outside = 1;
+                } else if (e0 + MIN(sx, 0) + MIN(sy, 0) < 0) {
+                    e[i] = (int)e0;
+                    edx[i] = (int)(ea[i] * NK_RAWFB_SUBPIXEL);
+                    edy[i] = (int)(eb[i] * NK_RAWFB_SUBPIXEL);
+                    partial = 1;
+                }
+            }
+            if (outside) continue;
+            if (!flat) {
+                for (k = 0; k < 6; ++k) {
+                    const double s = f[0][k] + (dfdx[k] * (cx - x[0]) +
+                        dfdy[k] * (cy - y[0])) / NK_RAWFB_SUBPIXEL;
+                    val[k] = nk_rawfb_fixed(s, 1 << 13);
+                    vdx[k] = nk_rawfb_fixed(dfdx[k], 1 << 9);
+                    vdy[k] = nk_rawfb_fixed(dfdy[k], 1 << 9);
+                }
+            }
+            for (py = 0; py < bh; ++py) {
+                unsigned char *row = (unsigned char *)rawfb->fb.pixels + (by + py) * rawfb->fb.pitch;
+                int w0 = 0, w1 = 0, w2 = 0, a[6];
+                if (partial) {
+                    w0 = e[0] + edy[0] * py;
+                    w1 = e[1] + edy[1] * py;
+                    w2 = e[2] + edy[2] * py;
+                }
+                if (flat && !partial && flat_col.a == 0xff) {
+                    nk_rawfb_line_horizontal(rawfb, (short)bx, (short)(by + py),
+                        (short)(bx + bw), flat_pixel);
+                    continue;
+                }
+                if (!flat) {
+                    for (k = 0; k < 6; ++k)
+                        a[k] = val[k] + vdy[k] * py;
+                }
+                for (px = 0; px < bw; ++px) {
+                    if (!partial || (w0 | w1 | w2) >= 0) {
+                        if (flat) {
+                            if (flat_col.a == 0xff)
+                                nk_rawfb_row_setpixel(&rawfb->fb, row, bx + px, flat_pixel);
+                            else nk_rawfb_row_blendpixel(&rawfb->fb, row, bx + px, flat_col);
+                        } else {
+                            struct nk_color col;
+                            col.r = (nk_byte)MIN(MAX(a[0] >> 16, 0), 0xff);
+                            col.g = (nk_byte)MIN(MAX(a[1] >> 16, 0), 0xff);
+                            col.b = (nk_byte)MIN(MAX(a[2] >> 16, 0), 0xff);
+                            col.a = (nk_byte)MIN(MAX(a[3] >> 16, 0), 0xff);
+                            if (!uv_flat)
+                                col = nk_rawfb_sample(tex, a[4] >> 16, a[5] >> 16, col);
+                            else if (!tex_white)
+                                col = nk_rawfb_modulate(col, tex_col);
+                            nk_rawfb_row_blendpixel(&rawfb->fb, row, bx + px, col);
+                        }
+                    }
+                    w0 += edx[0]; w1 += edx[1]; w2 += edx[2];
+                    if (!flat) {
+                        for (k = 0; k < 6; ++k)
+                            a[k] += vdx[k];
+                    }
+                }
+            }
+        }
+    }
+}
+
+NK_API void
+nk_rawfb_render_triangles(struct rawfb_context *rawfb,
+                          const struct nk_color clear,
+                          const unsigned char enable_clear)
+{
+    static const struct nk_draw_vertex_layout_element vertex_layout[] = {
+        {NK_VERTEX_POSITION, NK_FORMAT_FLOAT, NK_OFFSETOF(struct rawfb_vertex, position)},
+        {NK_VERTEX_TEXCOORD, NK_FORMAT_FLOAT, NK_OFFSETOF(struct rawfb_vertex, uv)},
+        {NK_VERTEX_COLOR, NK_FORMAT_R8G8B8A8, NK_OFFSETOF(struct rawfb_vertex, col)},
+        {NK_VERTEX_LAYOUT_END}
+    };
+    struct nk_convert_config config;
+    const struct nk_draw_command *cmd;
+    const struct rawfb_vertex *vertices;
+    const nk_draw_index *offset;
+
+    nk_rawfb_scissor(rawfb, 0, 0, rawfb->fb.w, rawfb->fb.h);
+    if (enable_clear)
+        nk_rawfb_clear(rawfb, nk_rawfb_color2int(clear, &rawfb->fb.pl));
+    rawfb->damage_frames = 0;
+
+    memset(&config, 0, sizeof(config));
+    config.vertex_layout = vertex_layout;
+    config.vertex_size = sizeof(struct rawfb_vertex);
+    config.vertex_alignment = NK_ALIGNOF(struct rawfb_vertex);
+    config.tex_null = rawfb->tex_null;
+    config.circle_segment_count = 22;
+    config.curve_segment_count = 22;
+    config.arc_segment_count = 22;
+    config.max_segment_error = 0.25f;
+    config.global_alpha = 1.0f;
+    config.shape_AA = NK_ANTI_ALIASING_ON;
+    config.line_AA = NK_ANTI_ALIASING_ON;
+
+    nk_buffer_clear(&rawfb->cmds);
+    nk_buffer_clear(&rawfb->vertices);
+    nk_buffer_clear(&rawfb->elements);
+    nk_convert(&rawfb->ctx, &rawfb->cmds, &rawfb->vertices, &rawfb->elements, &config);
+
+    vertices = (const struct rawfb_vertex *)nk_buffer_memory_const(&rawfb->vertices);
+    offset = (const nk_draw_index *)nk_buffer_memory_const(&rawfb->elements);
+    nk_draw_foreach(cmd, &rawfb->ctx, &rawfb->cmds) {
+        const int x0 = MAX((int)cmd->clip_rect.x, 0);
+        const int y0 = MAX((int)cmd->clip_rect.y, 0);
+        const int x1 = MIN((int)(cmd->clip_rect.x + cmd->clip_rect.w), rawfb->fb.w);
+        const int y1 = MIN((int)(cmd->clip_rect.y + cmd->clip_rect.h), rawfb->fb.h);
+        const struct rawfb_image *tex = &rawfb->font_tex;
+        unsigned int i;
+        if (cmd->texture.id > 0 && cmd->texture.id <= rawfb->image_count &&
+            rawfb->images[cmd->texture.id - 1].pixels)
+            tex = &rawfb->images[cmd->texture.id - 1];
+        if (x0 < x1 && y0 < y1) {
+            for (i = 0; i + 2 < cmd->elem_count; i += 3)
+                nk_rawfb_raster_triangle(rawfb, &vertices[offset[i]], &vertices[offset[i+1]],
+                    &vertices[offset[i+2]], tex, x0, y0, x1, y1);
+        }
+        offset += cmd->elem_count;
+    }
+    nk_clear(&rawfb->ctx);
+}
+#endif
 #endif
 
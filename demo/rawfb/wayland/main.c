@@ -36,9 +36,11 @@ struct nk_wayland {
     struct wl_surface *surface;
     struct xdg_surface *xdg_surface;
     struct xdg_toplevel *xdg_toplevel;
-    struct wl_buffer *front_buffer;
+    struct wl_buffer *buffers[2];
 
-    int32_t *data;
+    int32_t *data[2];
+    int busy[2];
+    int back;
     int mouse_pointer_x;
     int mouse_pointer_y;
     uint8_t tex_scratch[512 * 512];
@@ -415,39 +417,58 @@ static void nk_wayland_surf_clear(struct nk_wayland* win)
     for (y = 0; y < HEIGHT; y++){
         for (x = 0; x < WIDTH; x++){
             pix_idx = y * WIDTH + x;
-            win->data[pix_idx] = 0xFF000000;
+            win->data[0][pix_idx] = 0xFF000000;
         }
     }
 }
 
-//This causes the screen to refresh
-static const struct wl_callback_listener frame_listener;
+//The compositor is done reading from a buffer
+static void nk_wayland_buffer_release(void *data, struct wl_buffer *buffer)
+{
+    struct nk_wayland* win = (struct nk_wayland*)data;
+    win->busy[buffer == win->buffers[1]] = 0;
+}
+
+static const struct wl_buffer_listener buffer_listener = {
+    nk_wayland_buffer_release
+};
 
+//The compositor is ready for the next frame
 static void redraw(void *data, struct wl_callback *callback, uint32_t time)
 {
-  //  printf("redrawing.. 1\n");
     struct nk_wayland* win = (struct nk_wayland*)data;
 
-    NK_UNUSED(callback);
     NK_UNUSED(time);
 
-    wl_callback_destroy(win->frame_callback);
-    wl_surface_damage(win->surface, 0, 0, WIDTH, HEIGHT);
-
-
-
-    win->frame_callback = wl_surface_frame(win->surface);
-    wl_surface_attach(win->surface, win->front_buffer, 0, 0);
-    wl_callback_add_listener(win->frame_callback, &frame_listener, win);
-    wl_surface_commit(win->surface);
-
+    wl_callback_destroy(callback);
+    win->frame_callback = NULL;
 }
 
-
 static const struct wl_callback_listener frame_listener = {
     redraw
 };
 
+//This causes the screen to refresh
+static void nk_wayland_present(struct nk_wayland* win, const struct nk_rect *damage, int count)
+{
+    int i;
+
+    //only the changed parts of the back buffer are damaged
+    if (count) {
+        wl_surface_attach(win->surface, win->buffers[win->back], 0, 0);
+        for (i = 0; i < count; ++i)
+            wl_surface_damage(win->surface, (int32_t)damage[i].x, (int32_t)damage[i].y,
+                (int32_t)damage[i].w, (int32_t)damage[i].h);
+        win->busy[win->back] = 1;
+        win->back = !win->back;
+    }
+    if (!win->frame_callback) {
+        win->frame_callback = wl_surface_frame(win->surface);
+        wl_callback_add_listener(win->frame_callback, &frame_listener, win);
+    }
+    wl_surface_commit(win->surface);
+}
+
 int main ()
 {
     long dt;
@@ -456,12 +477,16 @@ int main ()
     struct wl_registry *registry;
     int running = 1;
     struct rawfb_pl pl;
+    const struct nk_rect *damage;
+    int damage_count;
 
     #ifdef INCLUDE_CONFIGURATOR
     static struct nk_color color_table[NK_COLOR_COUNT];
     memcpy(color_table, nk_default_color_style, sizeof(color_table));
     #endif
 
+    memset(&nk_wayland_ctx, 0, sizeof(nk_wayland_ctx));
+
     //1. Initialize display
 	nk_wayland_ctx.display = wl_display_connect (NULL);
     if (nk_wayland_ctx.display == NULL) {
@@ -488,13 +513,18 @@ int main ()
 
     wl_surface_commit (nk_wayland_ctx.surface);
 
+	//two buffers: one is drawn into while the compositor reads the other
 	size_t size = WIDTH * HEIGHT * 4;
 	char *xdg_runtime_dir = getenv ("XDG_RUNTIME_DIR");
 	int fd = open (xdg_runtime_dir, O_TMPFILE|O_RDWR|O_EXCL, 0600);
-	ftruncate (fd, size);
-	nk_wayland_ctx.data = mmap (NULL, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
-	struct wl_shm_pool *pool = wl_shm_create_pool (nk_wayland_ctx.wl_shm, fd, size);
-	nk_wayland_ctx.front_buffer = wl_shm_pool_create_buffer (pool, 0, WIDTH, HEIGHT, WIDTH*4, WL_SHM_FORMAT_XRGB8888);
+	ftruncate (fd, size * 2);
+	nk_wayland_ctx.data[0] = mmap (NULL, size * 2, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+	nk_wayland_ctx.data[1] = nk_wayland_ctx.data[0] + WIDTH * HEIGHT;
+	struct wl_shm_pool *pool = wl_shm_create_pool (nk_wayland_ctx.wl_shm, fd, size * 2);
+	for (int i = 0; i < 2; ++i) {
+		nk_wayland_ctx.buffers[i] = wl_shm_pool_create_buffer (pool, i * size, WIDTH, HEIGHT, WIDTH*4, WL_SHM_FORMAT_XRGB8888);
+		wl_buffer_add_listener (nk_wayland_ctx.buffers[i], &buffer_listener, &nk_wayland_ctx);
+	}
 	wl_shm_pool_destroy (pool);
 	close (fd);
 
@@ -503,8 +533,10 @@ int main ()
 
     //3. Clear window and start rendering loop
 	nk_wayland_surf_clear(&nk_wayland_ctx);
-    wl_surface_attach (nk_wayland_ctx.surface, nk_wayland_ctx.front_buffer, 0, 0);
+    wl_surface_attach (nk_wayland_ctx.surface, nk_wayland_ctx.buffers[0], 0, 0);
     wl_surface_commit (nk_wayland_ctx.surface);
+    nk_wayland_ctx.busy[0] = 1;
+    nk_wayland_ctx.back = 1;
 
     pl.bytesPerPixel = 4;
     pl.ashift = 24;
@@ -516,7 +548,8 @@ int main ()
     pl.gloss = 0;
     pl.bloss = 0;
 
-    nk_rawfb_init(nk_wayland_ctx.data, nk_wayland_ctx.tex_scratch, WIDTH, HEIGHT, WIDTH*4, pl);
+    nk_wayland_ctx.rawfb = nk_rawfb_init(nk_wayland_ctx.data[nk_wayland_ctx.back], nk_wayland_ctx.tex_scratch, WIDTH, HEIGHT, WIDTH*4, pl);
+    if (!nk_wayland_ctx.rawfb) running = 0;
 
 
     //4. rendering UI
@@ -563,14 +596,16 @@ int main ()
         #endif
         /* ----------------------------------------- */
 
-        // Draw framebuffer
-        nk_rawfb_render(nk_wayland_ctx.rawfb, nk_rgb(30,30,30), 1);
-
+        // Draw framebuffer, double buffered so the back buffer is two frames old
+        damage_count = nk_rawfb_render_damage(nk_wayland_ctx.rawfb, nk_rgb(30,30,30), 1, 2, &damage);
+        nk_wayland_present(&nk_wayland_ctx, damage, damage_count);
 
-        //handle wayland stuff (send display to FB & get inputs)
+        //handle wayland stuff (get inputs, wait for the next frame and the back buffer)
         nk_input_begin(&(nk_wayland_ctx.rawfb->ctx));
-        wl_display_dispatch(nk_wayland_ctx.display);
+        while ((nk_wayland_ctx.frame_callback || nk_wayland_ctx.busy[nk_wayland_ctx.back]) &&
+            wl_display_dispatch(nk_wayland_ctx.display) != -1);
         nk_input_end(&(nk_wayland_ctx.rawfb->ctx));
+        nk_rawfb_set_fb(nk_wayland_ctx.rawfb, nk_wayland_ctx.data[nk_wayland_ctx.back]);
 
         // Timing
         dt = timestamp() - started;
@@ -45,6 +45,9 @@
 #define NK_INCLUDE_FONT_BAKING
 #define NK_INCLUDE_DEFAULT_FONT
 #define NK_INCLUDE_SOFTWARE_FONT
+/* Rasterize the converted triangle list instead of the draw commands.
+ * Uncomment to render through nk_rawfb_render_triangles */
+/*#define NK_INCLUDE_VERTEX_BUFFER_OUTPUT */
 
 #include "../../../nuklear.h"
 #include "../nuklear_rawfb.h"
@@ -202,6 +205,7 @@ main(void)
     /* GUI */
     rawfb = nk_rawfb_init(fb, tex_scratch, xw.width, xw.height, xw.width * 4, pl);
     if (!rawfb) running = 0;
+    else nk_rawfb_set_anti_aliasing(rawfb, NK_ANTI_ALIASING_ON);
 
     while (running) {
         /* Input */
@@ -253,11 +257,20 @@ main(void)
         /* ----------------------------------------- */
 
         /* Draw framebuffer */
-        nk_rawfb_render(rawfb, nk_rgb(30,30,30), 1);
+        #ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
+        nk_rawfb_render_triangles(rawfb, nk_rgb(30,30,30), 1);
 
         /* Emulate framebuffer */
         XClearWindow(xw.dpy, xw.win);
         nk_xlib_render(xw.win);
+        #else
+        {const struct nk_rect *damage;
+        /* double buffered: the image drawn into is two frames old */
+        int count = nk_rawfb_render_damage(rawfb, nk_rgb(30,30,30), 1, 2, &damage);
+
+        /* Emulate framebuffer, only changed parts are copied */
+        nk_rawfb_set_fb(rawfb, nk_xlib_present(xw.win, damage, count));}
+        #endif
         XFlush(xw.dpy);
 
         /* Timing */
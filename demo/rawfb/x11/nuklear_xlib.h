@@ -38,6 +38,7 @@
 NK_API int  nk_xlib_init(Display *dpy, Visual *vis, int screen, Window root, unsigned int w, unsigned int h, void **fb, struct rawfb_pl *pl);
 NK_API int  nk_xlib_handle_event(Display *dpy, int screen, Window win, XEvent *evt, struct rawfb_context *rawfb);
 NK_API void nk_xlib_render(Drawable screen);
+NK_API void *nk_xlib_present(Drawable screen, const struct nk_rect *damage, int count);
 NK_API void nk_xlib_shutdown(void);
 
 #endif
@@ -66,17 +67,72 @@ static struct  {
     Cursor cursor;
     Display *dpy;
     Window root;
-    XImage *ximg;
-    XShmSegmentInfo xsi;
+    XImage *ximg[2];
+    XShmSegmentInfo xsi[2];
+    char pending[2];
+    int back;
+    int completion;
     char fallback;
     GC gc;
 } xlib;
 
+static int
+nk_xlib_shm_image(Display *dpy, Visual *vis, unsigned int depth,
+    unsigned int w, unsigned int h, int i)
+{
+    /* Initialize shared memory according to:
+     * https://www.x.org/archive/X11R7.5/doc/Xext/mit-shm.html */
+    XShmSegmentInfo *xsi = &xlib.xsi[i];
+    int status;
+    xlib.ximg[i] = XShmCreateImage(dpy, vis, depth, ZPixmap, NULL, xsi, w, h);
+    if (!xlib.ximg[i])
+        return 0;
+    xsi->shmid = shmget(IPC_PRIVATE, xlib.ximg[i]->bytes_per_line * xlib.ximg[i]->height, IPC_CREAT | 0777);
+    if (xsi->shmid < 0) {
+        XDestroyImage(xlib.ximg[i]);
+        xlib.ximg[i] = NULL;
+        return 0;
+    }
+    xsi->shmaddr = xlib.ximg[i]->data = shmat(xsi->shmid, NULL, 0);
+    if ((intptr_t)xsi->shmaddr < 0) {
+        XDestroyImage(xlib.ximg[i]);
+        xlib.ximg[i] = NULL;
+        return 0;
+    }
+    xsi->readOnly = False;
+    status = XShmAttach(dpy, xsi);
+    if (!status) {
+        shmdt(xsi->shmaddr);
+        XDestroyImage(xlib.ximg[i]);
+        xlib.ximg[i] = NULL;
+        return 0;
+    } XSync(dpy, False);
+    shmctl(xsi->shmid, IPC_RMID, NULL);
+    return 1;
+}
+
+static void
+nk_xlib_free_image(int i)
+{
+    if (!xlib.ximg[i])
+        return;
+    if (xlib.fallback) {
+        /* also releases the pixel data */
+        XDestroyImage(xlib.ximg[i]);
+    } else {
+        XShmDetach(xlib.dpy, &xlib.xsi[i]);
+        XDestroyImage(xlib.ximg[i]);
+        shmdt(xlib.xsi[i].shmaddr);
+        shmctl(xlib.xsi[i].shmid, IPC_RMID, NULL);
+    } xlib.ximg[i] = NULL;
+}
+
 NK_API int
 nk_xlib_init(Display *dpy, Visual *vis, int screen, Window root,
     unsigned int w, unsigned int h, void **fb, struct rawfb_pl *pl)
 {
     unsigned int depth = XDefaultDepth(dpy, screen);
+    int i;
     xlib.dpy = dpy;
     xlib.root = root;
 
@@ -91,61 +147,40 @@ nk_xlib_init(Display *dpy, Visual *vis, int screen, Window root,
     xlib.cursor = XCreatePixmapCursor(dpy, blank, blank, &dummy, &dummy, 0, 0);
     XFreePixmap(dpy, blank);}
 
+    /* two images: one is drawn into while the server reads the other */
     xlib.fallback = False;
-    do {/* Initialize shared memory according to:
-         * https://www.x.org/archive/X11R7.5/doc/Xext/mit-shm.html */
-        int status;
-        if (!XShmQueryExtension(dpy)) {
-            printf("No XShm Extension available.\n");
-            xlib.fallback = True;
-            break;
-        }
-        xlib.ximg = XShmCreateImage(dpy, vis, depth, ZPixmap, NULL, &xlib.xsi, w, h);
-        if (!xlib.ximg) {
-            xlib.fallback = True;
-            break;
-        }
-        xlib.xsi.shmid = shmget(IPC_PRIVATE, xlib.ximg->bytes_per_line * xlib.ximg->height, IPC_CREAT | 0777);
-        if (xlib.xsi.shmid < 0) {
-            XDestroyImage(xlib.ximg);
-            xlib.fallback = True;
-            break;
-        }
-        xlib.xsi.shmaddr = xlib.ximg->data = shmat(xlib.xsi.shmid, NULL, 0);
-        if ((intptr_t)xlib.xsi.shmaddr < 0) {
-            XDestroyImage(xlib.ximg);
-            xlib.fallback = True;
-            break;
-        }
-        xlib.xsi.readOnly = False;
-        status = XShmAttach(dpy, &xlib.xsi);
-        if (!status) {
-            shmdt(xlib.xsi.shmaddr);
-            XDestroyImage(xlib.ximg);
-            xlib.fallback = True;
-            break;
-        } XSync(dpy, False);
-        shmctl(xlib.xsi.shmid, IPC_RMID, NULL);
-    } while(0);
+    if (!XShmQueryExtension(dpy)) {
+        printf("No XShm Extension available.\n");
+        xlib.fallback = True;
+    } else if (!nk_xlib_shm_image(dpy, vis, depth, w, h, 0)) {
+        xlib.fallback = True;
+    } else if (!nk_xlib_shm_image(dpy, vis, depth, w, h, 1)) {
+        nk_xlib_free_image(0);
+        xlib.fallback = True;
+    }
 
     if (xlib.fallback) {
-        xlib.ximg = XCreateImage(dpy, vis, depth, ZPixmap, 0, NULL, w, h, 32, 0);
-        if (!xlib.ximg) return 0;
-        xlib.ximg->data = malloc(h * xlib.ximg->bytes_per_line);
-        if (!xlib.ximg->data)
-            return 0;
-    }
+        for (i = 0; i < 2; ++i) {
+            xlib.ximg[i] = XCreateImage(dpy, vis, depth, ZPixmap, 0, NULL, w, h, 32, 0);
+            if (!xlib.ximg[i]) return 0;
+            xlib.ximg[i]->data = malloc(h * xlib.ximg[i]->bytes_per_line);
+            if (!xlib.ximg[i]->data)
+                return 0;
+        }
+    } else xlib.completion = XShmGetEventBase(dpy) + ShmCompletion;
+    xlib.back = 0;
+    xlib.pending[0] = xlib.pending[1] = False;
     xlib.gc = XDefaultGC(dpy, screen);
-    *fb = xlib.ximg->data;
+    *fb = xlib.ximg[0]->data;
 
-    pl->bytesPerPixel = xlib.ximg->bits_per_pixel / 8;
-    pl->rshift = __builtin_ctzl(xlib.ximg->red_mask);
-    pl->gshift = __builtin_ctzl(xlib.ximg->green_mask);
-    pl->bshift = __builtin_ctzl(xlib.ximg->blue_mask);
+    pl->bytesPerPixel = xlib.ximg[0]->bits_per_pixel / 8;
+    pl->rshift = __builtin_ctzl(xlib.ximg[0]->red_mask);
+    pl->gshift = __builtin_ctzl(xlib.ximg[0]->green_mask);
+    pl->bshift = __builtin_ctzl(xlib.ximg[0]->blue_mask);
     pl->ashift = 0;
-    pl->rloss = 8 - __builtin_popcount(xlib.ximg->red_mask);
-    pl->gloss = 8 - __builtin_popcount(xlib.ximg->green_mask);
-    pl->bloss = 8 - __builtin_popcount(xlib.ximg->blue_mask);
+    pl->rloss = 8 - __builtin_popcount(xlib.ximg[0]->red_mask);
+    pl->gloss = 8 - __builtin_popcount(xlib.ximg[0]->green_mask);
+    pl->bloss = 8 - __builtin_popcount(xlib.ximg[0]->blue_mask);
     pl->aloss = 8;
 
     return 1;
@@ -275,25 +310,59 @@ NK_API void
 nk_xlib_shutdown(void)
 {
     XFreeCursor(xlib.dpy, xlib.cursor);
-    if (xlib.fallback) {
-        free(xlib.ximg->data);
-        XDestroyImage(xlib.ximg);
-    } else {
-        XShmDetach(xlib.dpy, &xlib.xsi);
-        XDestroyImage(xlib.ximg);
-        shmdt(xlib.xsi.shmaddr);
-        shmctl(xlib.xsi.shmid, IPC_RMID, NULL);
-    } memset(&xlib, 0, sizeof(xlib));
+    nk_xlib_free_image(0);
+    nk_xlib_free_image(1);
+    memset(&xlib, 0, sizeof(xlib));
 }
 
 NK_API void
 nk_xlib_render(Drawable screen)
 {
+    XImage *img = xlib.ximg[xlib.back];
     if (xlib.fallback)
-        XPutImage(xlib.dpy, screen, xlib.gc, xlib.ximg,
-            0, 0, 0, 0, xlib.ximg->width, xlib.ximg->height);
-    else XShmPutImage(xlib.dpy, screen, xlib.gc, xlib.ximg,
-            0, 0, 0, 0, xlib.ximg->width, xlib.ximg->height, False);
+        XPutImage(xlib.dpy, screen, xlib.gc, img,
+            0, 0, 0, 0, img->width, img->height);
+    else XShmPutImage(xlib.dpy, screen, xlib.gc, img,
+            0, 0, 0, 0, img->width, img->height, False);
+}
+
+static Bool
+nk_xlib_is_completion(Display *dpy, XEvent *evt, XPointer arg)
+{
+    const XShmSegmentInfo *xsi = (const XShmSegmentInfo*)arg;
+    (void)dpy;
+    return evt->type == xlib.completion &&
+        ((XShmCompletionEvent*)evt)->shmseg == xsi->shmseg;
+}
+
+NK_API void*
+nk_xlib_present(Drawable screen, const struct nk_rect *damage, int count)
+{
+    /* Copies the damaged parts of the image that was drawn into, swaps
+     * images and returns the pixels to draw the next frame into. The
+     * server may still read from the returned image until its
+     * ShmCompletion event arrives, so wait for that first. */
+    XImage *img = xlib.ximg[xlib.back];
+    int i;
+    for (i = 0; i < count; ++i) {
+        const int x = (int)damage[i].x, y = (int)damage[i].y;
+        const unsigned int w = (unsigned int)damage[i].w;
+        const unsigned int h = (unsigned int)damage[i].h;
+        if (xlib.fallback)
+            XPutImage(xlib.dpy, screen, xlib.gc, img, x, y, x, y, w, h);
+        else XShmPutImage(xlib.dpy, screen, xlib.gc, img, x, y, x, y, w, h,
+            i == count - 1);
+    }
+    if (count && !xlib.fallback)
+        xlib.pending[xlib.back] = True;
+
+    xlib.back = !xlib.back;
+    if (xlib.pending[xlib.back]) {
+        XEvent evt;
+        XIfEvent(xlib.dpy, &evt, nk_xlib_is_completion, (XPointer)&xlib.xsi[xlib.back]);
+        xlib.pending[xlib.back] = False;
+    }
+    return xlib.ximg[xlib.back]->data;
 }
 #endif
 
@@ -105,6 +105,9 @@ NK_INCLUDE_VERTEX_BUFFER_OUTPUT | Defining this adds a vertex draw command list
 NK_INCLUDE_FONT_BAKING          | Defining this adds `stb_truetype` and `stb_rect_pack` implementation to this library and provides font baking and rendering. If you already have font handling or do not want to use this font handler you don't have to define it.
 NK_INCLUDE_DEFAULT_FONT         | Defining this adds the default font: ProggyClean.ttf into this library which can be loaded into a font atlas and allows using this library without having a truetype font
 NK_INCLUDE_COMMAND_USERDATA     | Defining this adds a userdata pointer into each command. Can be useful for example if you want to provide custom shaders depending on the used widget. Can be combined with the style structures.
+NK_INCLUDE_FRAME_STATS          | Defining this records per window and group counters (commands, vertices, table lookups, text measurements, cached value texts) and memory high-water marks each frame. They can be read by `nk_frame_stats` or shown with `nk_frame_stats_window`.
+NK_INCLUDE_INPUT_RECORDING      | Defining this adds `nk_input_record_begin` and `nk_input_replay_frame` to record all input into a binary log and replay it frame by frame, e.g. for deterministic profiling runs.
+NK_INCLUDE_COMMAND_STREAM       | Defining this adds `nk_command_stream_encode` and `nk_command_stream_decode` to send the draw commands of each frame as a compact byte stream to a remote renderer.
 NK_BUTTON_TRIGGER_ON_RELEASE    | Different platforms require button clicks occurring either on buttons being pressed (up to down) or released (down to up). By default this library will react on buttons being pressed, but if you define this it will only trigger if a button is released.
 NK_ZERO_COMMAND_MEMORY          | Defining this will zero out memory for each drawing command added to a drawing queue (inside nk_command_buffer_push). Zeroing command memory is very useful for fast checking (using memcmp) if command buffers are equal and avoid drawing frames when nothing on screen has changed since previous frame.
 NK_UINT_DRAW_INDEX              | Defining this will set the size of vertex index elements when using NK_VERTEX_BUFFER_OUTPUT to 32bit instead of the default of 16bit
@@ -128,6 +131,9 @@ NK_IS_WORD_BOUNDARY(c)          | Define this to a function macro that takes a s
     - NK_INCLUDE_DEFAULT_FONT
     - NK_INCLUDE_STANDARD_VARARGS
     - NK_INCLUDE_COMMAND_USERDATA
+    - NK_INCLUDE_FRAME_STATS
+    - NK_INCLUDE_INPUT_RECORDING
+    - NK_INCLUDE_COMMAND_STREAM
     - NK_UINT_DRAW_INDEX
 
 ### Constants
@@ -152,8 +158,8 @@ NK_MEMCPY   | You can define this to 'memcpy' or your own memcpy implementation
 NK_INV_SQRT | You can define this to your own inverse sqrt implementation replacement. If not nuklear will use its own slow and not highly accurate version.
 NK_SIN      | You can define this to 'sinf' or your own sine implementation replacement. If not nuklear will use its own approximation implementation.
 NK_COS      | You can define this to 'cosf' or your own cosine implementation replacement. If not nuklear will use its own approximation implementation.
-NK_STRTOD   | You can define this to `strtod` or your own string to double conversion implementation replacement. If not defined nuklear will use its own imprecise and possibly unsafe version (does not handle nan or infinity!).
-NK_DTOA     | You can define this to `dtoa` or your own double to string conversion implementation replacement. If not defined nuklear will use its own imprecise and possibly unsafe version (does not handle nan or infinity!).
+NK_STRTOD   | You can define this to `strtod` or your own string to double conversion implementation replacement. If not defined nuklear will use its own correctly rounded version.
+NK_DTOA     | You can define this to `dtoa` or your own double to string conversion implementation replacement. If not defined nuklear will use its own version which writes the shortest string that reads back as the same value.
 NK_VSNPRINTF| If you define `NK_INCLUDE_STANDARD_VARARGS` as well as `NK_INCLUDE_STANDARD_IO` and want to be safe define this to `vsnprintf` on compilers supporting later versions of C or C++. By default nuklear will check for your stdlib version in C as well as compiler version in C++. if `vsnprintf` is available it will define it to `vsnprintf` directly. If not defined and if you have older versions of C or C++ it will be defined to `vsprintf` which is unsafe.
 
 !!! WARNING
@@ -457,6 +463,7 @@ NK_STATIC_ASSERT(sizeof(nk_bool) >= 2);
 struct nk_buffer;
 struct nk_allocator;
 struct nk_command_buffer;
+struct nk_frame_delta;
 struct nk_draw_command;
 struct nk_convert_config;
 struct nk_style_item;
@@ -566,6 +573,34 @@ enum nk_symbol_type {
  * nk_free(&ctx);
  * ```
  *
+ * A context can only be used by one thread at a time. To build windows on
+ * several threads, each thread gets its own worker context which is
+ * initialized like any other context and used for a disjoint set of windows.
+ * `nk_workers_begin` copies input, style, clipboard and frame time into all
+ * workers and `nk_workers_merge` copies their draw commands back into the main
+ * context in a fixed drawing order. Both have to be called on the thread of
+ * the main context while no worker is being built. In between each worker
+ * may only be used by one thread, while the main context can be used as
+ * usual. Fonts, the font atlas and images are shared between all threads
+ * and must not be changed while workers are built, which also means font
+ * and clipboard callbacks have to be safe to call from several threads.
+ * Style changes inside of a worker only last until the end of the frame.
+ *
+ * ```c
+ * struct nk_context ctx, workers[4];
+ * nk_init_xxx(&ctx, ...);
+ * // [... nk_init_xxx each worker ...]
+ * while (1) {
+ *     // [...input for ctx...]
+ *     nk_workers_begin(&ctx, workers, 4);
+ *     // [...build windows in each worker on its own thread and in ctx...]
+ *     // [...wait for all threads...]
+ *     nk_workers_merge(&ctx, workers, 4);
+ *     // [...draw ctx...]
+ *     nk_clear(&ctx);
+ * }
+ * ```
+ *
  * # Reference
  * Function            | Description
  * --------------------|-------------------------------------------------------
@@ -574,7 +609,10 @@ enum nk_symbol_type {
  * \ref nk_init         | Initializes context with memory allocator callbacks for alloc and free
  * \ref nk_init_custom  | Initializes context from two buffers. One for draw commands the other for window/panel/table allocations
  * \ref nk_clear        | Called at the end of the frame to reset and prepare the context for the next frame
+ * \ref nk_trim         | Returns unused window, panel and table memory back to the allocator
  * \ref nk_free         | Shutdown and free all memory allocated inside the context
+ * \ref nk_workers_begin| Hands input, style and frame time of a context to worker contexts
+ * \ref nk_workers_merge| Appends the draw commands of worker contexts to a context
  * \ref nk_set_user_data| Utility function to pass user data to draw command
  */
 
@@ -649,14 +687,18 @@ NK_API nk_bool nk_init(struct nk_context*, const struct nk_allocator*, const str
  *
  * \details
  * The first buffer is for allocating draw commands while the second buffer is
- * used for allocating windows, panels and state tables.
+ * used for allocating windows, panels and state tables. The draw command buffer
+ * can also be a segmented buffer (`nk_buffer_init_segmented`) which grows without
+ * copying already generated commands. Each segment has to be big enough to hold
+ * the biggest single draw command, which for text is the text length plus the
+ * size of `struct nk_command_text`.
  *
  * ```c
  * nk_bool nk_init_custom(struct nk_context *ctx, struct nk_buffer *cmds, struct nk_buffer *pool, const struct nk_user_font *font);
  * ```
  *
  * \param[in] ctx    Must point to an either stack or heap allocated `nk_context` struct
- * \param[in] cmds   Must point to a previously initialized memory buffer either fixed or dynamic to store draw commands into
+ * \param[in] cmds   Must point to a previously initialized memory buffer either fixed, dynamic or segmented to store draw commands into
  * \param[in] pool   Must point to a previously initialized memory buffer either fixed or dynamic to store windows, panels and tables
  * \param[in] font   Must point to a previously initialized font handle for more info look at font documentation
  *
@@ -679,6 +721,25 @@ NK_API nk_bool nk_init_custom(struct nk_context*, struct nk_buffer *cmds, struct
  */
 NK_API void nk_clear(struct nk_context*);
 
+/**
+ * \brief Returns memory pages of the window, panel and table pool that are
+ * not used anymore back to the allocator.
+ *
+ * \details
+ * Pool memory is never freed while the context is alive and only reused for
+ * new windows, panels and tables. After a frame with a lot more windows, groups
+ * or popups than usual this can be called to release memory pages which only
+ * contain unused elements. Does nothing for contexts initialized with a fixed
+ * size memory block.
+ *
+ * ```c
+ * void nk_trim(struct nk_context *ctx);
+ * ```
+ *
+ * \param[in] ctx  Must point to a previously initialized `nk_context` struct
+ */
+NK_API void nk_trim(struct nk_context*);
+
 /**
  * \brief Frees all memory allocated by nuklear; Not needed if context was initialized with `nk_init_fixed`.
  *
@@ -691,6 +752,51 @@ NK_API void nk_clear(struct nk_context*);
  */
 NK_API void nk_free(struct nk_context*);
 
+/**
+ * \brief Hands input, style and frame time of a context to worker contexts
+ *
+ * \details
+ * Has to be called after `nk_input_end` and before any window of `ctx` or of
+ * one of the workers is built. All contexts are layered with `ctx` at the
+ * bottom and the workers on top in array order. Mouse input goes to the top
+ * most context with a window below the mouse pointer and stays there while a
+ * button is held down. Keyboard and text input go to the context that got
+ * the last mouse press. All other contexts see no mouse buttons and a mouse
+ * position outside of all windows until `nk_workers_merge`.
+ *
+ * ```c
+ * void nk_workers_begin(struct nk_context *ctx, struct nk_context *workers, int count);
+ * ```
+ *
+ * \param[in] ctx     | Must point to a previously initialized `nk_context` struct
+ * \param[in] workers | Must point to an array of `count` previously initialized `nk_context` structs
+ * \param[in] count   | Number of worker contexts
+ */
+NK_API void nk_workers_begin(struct nk_context *ctx, struct nk_context *workers, int count);
+
+/**
+ * \brief Appends the draw commands of worker contexts to a context
+ *
+ * \details
+ * Has to be called after all windows of the workers are finished and
+ * before the commands of `ctx` are iterated or converted. Commands are
+ * copied into the command memory of `ctx` and drawn above all windows and
+ * popups of `ctx`. Input held back by `nk_workers_begin` is given back to
+ * `ctx` and `nk_window_is_any_hovered` and `nk_item_is_any_active` include
+ * the workers afterwards. Each worker is cleared with `nk_clear`.
+ *
+ * ```c
+ * nk_bool nk_workers_merge(struct nk_context *ctx, struct nk_context *workers, int count);
+ * ```
+ *
+ * \param[in] ctx     | Must point to the `nk_context` struct passed to `nk_workers_begin`
+ * \param[in] workers | Must point to the same array passed to `nk_workers_begin`
+ * \param[in] count   | Number of worker contexts
+ *
+ * \returns `false(0)` if the command memory of `ctx` ran out and not all commands were copied
+ */
+NK_API nk_bool nk_workers_merge(struct nk_context *ctx, struct nk_context *workers, int count);
+
 #ifdef NK_INCLUDE_COMMAND_USERDATA
 /**
  * \brief Sets the currently passed userdata passed down into each draw command.
@@ -772,6 +878,16 @@ NK_API void nk_set_user_data(struct nk_context*, nk_handle handle);
  * \ref nk_input_glyph  | Adds a single multi-byte UTF-8 character into an internal text buffer
  * \ref nk_input_unicode| Adds a single unicode rune into an internal text buffer
  * \ref nk_input_end    | Ends the input mirroring process by calculating state changes. Don't call any `nk_input_xxx` function referenced above after this call
+ *
+ * With `NK_INCLUDE_INPUT_RECORDING` defined all of the calls above can be
+ * written into a binary log and fed back later, one frame at a time:
+ *
+ * Function                     | Description
+ * -----------------------------|-------------------------------------------------------
+ * \ref nk_input_record_begin   | Starts appending all input calls into a buffer
+ * \ref nk_input_record_end     | Stops recording
+ * \ref nk_input_replay_begin   | Prepares replaying a previously recorded log
+ * \ref nk_input_replay_frame   | Replays the input of the next frame between `nk_input_begin` and `nk_input_end`
  */
 
 enum nk_keys {
@@ -955,6 +1071,65 @@ NK_API void nk_input_unicode(struct nk_context*, nk_rune);
  */
 NK_API void nk_input_end(struct nk_context*);
 
+#ifdef NK_INCLUDE_INPUT_RECORDING
+struct nk_input_replay {
+    const nk_byte *data;
+    nk_size size;
+    nk_size offset;
+    unsigned int frame;
+    int x, y;
+};
+
+/**
+ * \brief Starts recording all input into `log`
+ *
+ * \details
+ * Every `nk_input_xxx` call and the `delta_time_seconds` of each frame are
+ * appended to `log` in a compact binary format until `nk_input_record_end`
+ * is called. Mouse positions are stored as small deltas, so a frame with a
+ * single mouse motion usually takes four bytes. The buffer contents can be
+ * written to a file as is and passed to `nk_input_replay_begin` later.
+ *
+ * ```c
+ * nk_bool nk_input_record_begin(struct nk_context*, struct nk_buffer *log);
+ * ```
+ *
+ * \param[in] ctx     | Must point to a previously initialized `nk_context` struct
+ * \param[in] log     | Buffer the log is appended to. Must be a fixed or dynamic buffer that stays valid while recording
+ *
+ * \returns `true(1)` if the log header could be written
+ */
+NK_API nk_bool nk_input_record_begin(struct nk_context*, struct nk_buffer *log);
+NK_API void nk_input_record_end(struct nk_context*);
+
+/**
+ * \brief Prepares `replay` to read a log written by `nk_input_record_begin`
+ *
+ * \details
+ * ```c
+ * nk_bool nk_input_replay_begin(struct nk_input_replay*, const void *log, nk_size size);
+ * ```
+ *
+ * \returns `false(0)` if `log` does not start with a valid header
+ */
+NK_API nk_bool nk_input_replay_begin(struct nk_input_replay*, const void *log, nk_size size);
+
+/**
+ * \brief Replays the input of the next recorded frame
+ *
+ * \details
+ * Replaces the backend input handling of one frame, including the calls to
+ * `nk_input_begin` and `nk_input_end`, and restores `ctx->delta_time_seconds`.
+ *
+ * ```c
+ * nk_bool nk_input_replay_frame(struct nk_context*, struct nk_input_replay*);
+ * ```
+ *
+ * \returns `false(0)` once all frames have been replayed or the log is damaged
+ */
+NK_API nk_bool nk_input_replay_frame(struct nk_context*, struct nk_input_replay*);
+#endif
+
 /** =============================================================================
  *
  *                                  DRAWING
@@ -1121,6 +1296,56 @@ NK_API void nk_input_end(struct nk_context*);
  * nk_free(&ctx);
  * ```
  *
+ * Instead of keeping a copy of the command memory around you can also ask
+ * nuklear directly with `nk_frame_status` after the last window of a frame.
+ * It hashes all draw commands that will be drawn and compares the result to
+ * the previous frame. If nothing changed and no timer (like the scrollbar
+ * auto hide timeout) is still running you can skip `nk_convert`, drawing and
+ * swapping buffers and just wait for the next input event. Since some state
+ * changes like activating a window only show up one frame later, keep
+ * updating the UI until a frame reports no changes before going to sleep.
+ *
+ * ```c
+ * struct nk_context ctx;
+ * nk_init_xxx(&ctx, ...);
+ * nk_flags status = NK_FRAME_CHANGED;
+ * while (1) {
+ *     if (!(status & (NK_FRAME_CHANGED|NK_FRAME_ANIMATING)))
+ *         // [...wait for input ]
+ *     // [...input...]
+ *     // [...ui...]
+ *     status = nk_frame_status(&ctx);
+ *     if (status & NK_FRAME_CHANGED) {
+ *         // [...draw and swap buffers ...]
+ *     }
+ *     nk_clear(&ctx);
+ * }
+ * nk_free(&ctx);
+ * ```
+ *
+ * If only parts of the screen have to be redrawn, `nk_frame_delta` goes one
+ * step further and compares the commands of each window, popup and the cursor
+ * overlay separately. Each returned `nk_window_delta` tells how many commands
+ * at the front and back of a window are the same as in the previous frame and
+ * the area covered by changed commands. The union of all changed areas is
+ * kept in `nk_frame_delta::damage`.
+ *
+ * ```c
+ * struct nk_frame_delta delta;
+ * int count;
+ * nk_frame_delta_init_default(&delta);
+ * while (1) {
+ *     // [...input...]
+ *     // [...ui...]
+ *     nk_frame_delta(&delta, &ctx, &count);
+ *     if (delta.changed_count) {
+ *         // [...redraw commands inside delta.damage ...]
+ *     }
+ *     nk_clear(&ctx);
+ * }
+ * nk_frame_delta_free(&delta);
+ * ```
+ *
  * Finally while using draw commands makes sense for higher abstracted platforms like
  * X11 and Win32 or drawing libraries it is often desirable to use graphics
  * hardware directly. Therefore it is possible to just define
@@ -1153,6 +1378,7 @@ NK_API void nk_input_end(struct nk_context*);
  * cfg.circle_segment_count = 22;
  * cfg.curve_segment_count = 22;
  * cfg.arc_segment_count = 22;
+ * cfg.max_segment_error = 0.0f; // or e.g. 0.25f for size dependent segment counts
  * cfg.global_alpha = 1.0f;
  * cfg.tex_null = dev->tex_null;
  * //
@@ -1179,6 +1405,8 @@ NK_API void nk_input_end(struct nk_context*);
  * \ref nk__begin       | Returns the first draw command in the context draw command list to be drawn
  * \ref nk__next        | Increments the draw command iterator to the next command inside the context draw command list
  * \ref nk_foreach      | Iterates over each draw command inside the context draw command list
+ * \ref nk_frame_status | Returns whether the draw command list differs from the previous frame
+ * \ref nk_frame_delta  | Returns which commands of each window differ from the previous frame
  * \ref nk_convert      | Converts from the abstract draw commands list into a hardware accessible vertex format
  * \ref nk_draw_begin   | Returns the first vertex command in the context vertex draw list to be executed
  * \ref nk__draw_next   | Increments the vertex command iterator to the next command inside the context vertex command list
@@ -1205,6 +1433,7 @@ struct nk_convert_config {
     unsigned circle_segment_count;  /**!< number of segments used for circles: default to 22 */
     unsigned arc_segment_count;     /**!< number of segments used for arcs: default to 22 */
     unsigned curve_segment_count;   /**!< number of segments used for curves: default to 22 */
+    float max_segment_error;        /**!< if > 0 derives segment counts per shape from its size so that no point deviates more than this many pixels from the real outline, ignoring the fixed counts above: 0.25 works well */
     struct nk_draw_null_texture tex_null; /**!< handle to texture with a white pixel for shape drawing */
     const struct nk_draw_vertex_layout_element *vertex_layout; /**!< describes the vertex output format and packing */
     nk_size vertex_size;      /**!< sizeof one vertex for vertex packing */
@@ -1253,6 +1482,104 @@ NK_API const struct nk_command* nk__next(struct nk_context*, const struct nk_com
  */
 #define nk_foreach(c, ctx) for((c) = nk__begin(ctx); (c) != 0; (c) = nk__next(ctx,c))
 
+enum nk_frame_status_flags {
+    NK_FRAME_UNCHANGED  = 0,
+    NK_FRAME_CHANGED    = NK_FLAG(0), /**!< draw commands differ from the previous frame */
+    NK_FRAME_ANIMATING  = NK_FLAG(1)  /**!< a timer is still running so following frames will change without input */
+};
+
+/**
+ * \brief Compares all draw commands of the current frame with the previous frame
+ *
+ * \details
+ * Has to be called after the last `nk_end` and before `nk_clear`. Builds
+ * the draw command list like `nk__begin` and hashes the content of each
+ * command. The first frame is always reported as changed. Image and font
+ * handles are only compared by value, so if you change the content of a
+ * texture behind the same handle you have to redraw yourself.
+ *
+ * ```c
+ * nk_flags nk_frame_status(struct nk_context*);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct at the end of a frame
+ *
+ * \returns `NK_FRAME_UNCHANGED` or a combination of `nk_frame_status_flags`
+ */
+NK_API nk_flags nk_frame_status(struct nk_context*);
+
+#ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
+NK_API void nk_frame_delta_init_default(struct nk_frame_delta*);
+#endif
+NK_API void nk_frame_delta_init(struct nk_frame_delta*, const struct nk_allocator*);
+NK_API void nk_frame_delta_reset(struct nk_frame_delta*);
+NK_API void nk_frame_delta_free(struct nk_frame_delta*);
+
+/**
+ * \brief Compares the draw commands of each window with the previous frame
+ *
+ * \details
+ * Has to be called once per frame after the last `nk_end` and before
+ * `nk_clear`. Commands are split into ranges for each window, popup and the
+ * cursor overlay in drawing order, followed by the windows that are no longer
+ * drawn. Each range is compared command by command against the range with the
+ * same id in the previous frame. Commands between `keep_front` and
+ * `count - keep_back` have changed and have to be processed again, all others
+ * can be taken from the previous frame. A window that moved in the drawing
+ * order is reported as changed as a whole. After `nk_frame_delta_reset` or
+ * if memory runs out all windows are reported as added.
+ *
+ * ```c
+ * const struct nk_window_delta *nk_frame_delta(struct nk_frame_delta*, struct nk_context*, int *count);
+ * ```
+ *
+ * \param[in] delta   | Must point to a previously initialized `nk_frame_delta` struct
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct at the end of a frame
+ * \param[out] count  | Number of returned window deltas
+ *
+ * \returns array of window deltas valid until the next call
+ */
+NK_API const struct nk_window_delta *nk_frame_delta(struct nk_frame_delta*, struct nk_context*, int *count);
+
+#ifdef NK_INCLUDE_FRAME_STATS
+/**
+ * \brief Returns counters recorded for the last finished frame
+ *
+ * \details
+ * Counters are recorded per window and per group, popup or other sub panel
+ * between `nk_begin` and `nk_clear`. Each panel only counts work done
+ * directly inside of it and not inside nested panels. Vertex and index counts
+ * are added by `nk_convert`, so convert before calling `nk_clear`.
+ * High-water marks are kept over the lifetime of the context.
+ *
+ * ```c
+ * const struct nk_frame_stats *nk_frame_stats(const struct nk_context*);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct
+ *
+ * \returns stats of the frame finished by the last `nk_clear`
+ */
+NK_API const struct nk_frame_stats *nk_frame_stats(const struct nk_context*);
+
+/**
+ * \brief Draws a window showing the stats of the last finished frame
+ *
+ * \details
+ * ```c
+ * nk_bool nk_frame_stats_window(struct nk_context*, const char *title, struct nk_rect bounds, nk_flags flags);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct
+ * \param[in] title   | Window title and identifier
+ * \param[in] bounds  | Initial position and window size
+ * \param[in] flags   | Window flags defined in the nk_panel_flags section
+ *
+ * \returns `true(1)` if the window is visible or `false(0)` otherwise
+ */
+NK_API nk_bool nk_frame_stats_window(struct nk_context*, const char *title, struct nk_rect bounds, nk_flags flags);
+#endif
+
 #ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
 
 /**
@@ -2402,6 +2729,9 @@ NK_API void nk_rule_horizontal(struct nk_context *ctx, struct nk_color color, nk
  * \ref nk_layout_set_min_row_height            | Set the currently used minimum row height to a specified value
  * \ref nk_layout_reset_min_row_height          | Resets the currently used minimum row height to font height
  * \ref nk_layout_widget_bounds                 | Calculates current width a static layout row can fit inside a window
+ * \ref nk_layout_skip                          | Moves the start of the next row down without laying out anything
+ * \ref nk_layout_skip_rows                     | Moves the start of the next row down by a number of rows of the current height
+ * \ref nk_layout_visible_range                 | Returns the visible vertical range relative to the start of the next row
  * \ref nk_layout_ratio_from_pixel              | Utility functions to calculate window ratio from pixel size
  * \ref nk_layout_row_dynamic                   | Current layout is divided into n same sized growing columns
  * \ref nk_layout_row_static                    | Current layout is divided into n same fixed sized columns
@@ -2479,6 +2809,52 @@ NK_API void nk_layout_reset_min_row_height(struct nk_context*);
  */
 NK_API struct nk_rect nk_layout_widget_bounds(const struct nk_context *ctx);
 
+/**
+ * \brief Moves the start of the next row down by `height` pixels
+ *
+ * \details
+ * Rows which are known to be out of view can be skipped in one call instead
+ * of laying out and culling every widget. Should be called between rows,
+ * widgets still left in the current row would be moved down as well.
+ * ```c
+ * void nk_layout_skip(struct nk_context*, float height);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct after call `nk_begin_xxx`
+ * \param[in] height  | Space to skip including the row spacing of all skipped rows
+ */
+NK_API void nk_layout_skip(struct nk_context*, float height);
+
+/**
+ * \brief Skips `rows` rows with the height of the current row layout
+ *
+ * \details
+ * ```c
+ * void nk_layout_skip_rows(struct nk_context*, int rows);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct after call `nk_layout_row_xxx`
+ * \param[in] rows    | Number of rows to skip
+ */
+NK_API void nk_layout_skip_rows(struct nk_context*, int rows);
+
+/**
+ * \brief Returns the vertical range of the current panel which is visible
+ *
+ * \details
+ * Both values are relative to the start of the next row and include the
+ * current scroll offset, so rows ending above `top` or starting below
+ * `bottom` can be skipped with `nk_layout_skip`.
+ * ```c
+ * void nk_layout_visible_range(const struct nk_context*, float *top, float *bottom);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct after call `nk_begin_xxx`
+ * \param[out] top    | Distance from the next row to the first visible pixel row
+ * \param[out] bottom | Distance from the next row to the end of the visible area
+ */
+NK_API void nk_layout_visible_range(const struct nk_context*, float *top, float *bottom);
+
 /**
  * \brief Utility functions to calculate window ratio from pixel size
  *
@@ -3295,6 +3671,12 @@ struct nk_list_view {
     nk_uint scroll_value;
 };
 NK_API nk_bool nk_list_view_begin(struct nk_context*, struct nk_list_view *out, const char *id, nk_flags, int row_height, int row_count);
+/* list view for rows of different heights. `offsets` holds `row_count + 1`
+ * ascending values with the summed height of all rows before each row, without
+ * row spacing, so `offsets[row_count]` is the height of all rows. Only rows
+ * `begin` to `end` have to be laid out, each with its own height of
+ * `offsets[i+1] - offsets[i]`. Finding them is a binary search */
+NK_API nk_bool nk_list_view_begin_variable(struct nk_context*, struct nk_list_view *out, const char *id, nk_flags, const float *offsets, int row_count);
 NK_API void nk_list_view_end(struct nk_list_view*);
 /* =============================================================================
  *
@@ -3744,9 +4126,32 @@ NK_API void nk_chart_add_slot(struct nk_context *ctx, const enum nk_chart_type,
 NK_API void nk_chart_add_slot_colored(struct nk_context *ctx, const enum nk_chart_type, struct nk_color, struct nk_color active, int count, float min_value, float max_value);
 NK_API nk_flags nk_chart_push(struct nk_context*, float);
 NK_API nk_flags nk_chart_push_slot(struct nk_context*, float, int);
+/* pushes `count` values at once which are `stride` bytes apart (0 for a tightly
+ * packed array). Line slots are drawn as a single polyline reduced to at most
+ * four points per pixel column and only the hovered value gets a marker.
+ * `hovered` optionally receives the slot index under the mouse or -1 */
+NK_API nk_flags nk_chart_push_values(struct nk_context*, const float *values, int count, int stride, int *hovered);
+NK_API nk_flags nk_chart_push_slot_values(struct nk_context*, const float *values, int count, int stride, int slot, int *hovered);
 NK_API void nk_chart_end(struct nk_context*);
 NK_API void nk_plot(struct nk_context*, enum nk_chart_type, const float *values, int count, int offset);
 NK_API void nk_plot_function(struct nk_context*, enum nk_chart_type, void *userdata, float(*value_getter)(void* user, int index), int count, int offset);
+/* streaming charts keep their history in a ring buffer owned by the current
+ * window, so only new samples have to be handed over each frame.
+ * `nk_chart_stream_push` appends one sample to each of `series` line series
+ * (at most NK_CHART_STREAM_MAX_SERIES) and drops the oldest one once a series
+ * holds `capacity` samples (0 for NK_CHART_STREAM_CAPACITY). The ring is
+ * allocated with the context allocator, so streams are not available for
+ * contexts created by `nk_init_fixed`. Changing the number of series or the
+ * capacity clears the history. Like other window state a stream is released
+ * if it is neither pushed nor drawn for a frame.
+ * `nk_chart_stream` draws the stream with the newest sample at the right edge.
+ * If `min` equals `max` the range is taken from the samples in the ring.
+ * Drawing cost depends on the chart width and not on the length of the history.
+ * `colors` holds one color per series or is NULL for the style chart color.
+ * `series`/`index` optionally receive the hovered series and sample (0 is the
+ * oldest sample in the ring) or -1 */
+NK_API nk_bool nk_chart_stream_push(struct nk_context*, const char *name, const float *values, int series, int capacity);
+NK_API nk_flags nk_chart_stream(struct nk_context*, const char *name, const struct nk_color *colors, float min, float max, int *series, int *index);
 /* =============================================================================
  *
  *                                  POPUP
@@ -4051,6 +4456,7 @@ NK_API int nk_strmatch_fuzzy_text(const char *txt, int txt_len, const char *patt
  *
  * ============================================================================= */
 NK_API int nk_utf_decode(const char*, nk_rune*, int);
+NK_API int nk_utf_decode_run(const char*, int byte_len, nk_rune *runes, int max_runes, int *decoded_len);
 NK_API int nk_utf_encode(nk_rune, char*, int);
 NK_API int nk_utf_len(const char*, int byte_len);
 NK_API const char* nk_utf_at(const char *buffer, int length, int index, nk_rune *unicode, int *len);
@@ -4381,6 +4787,15 @@ NK_API void nk_font_atlas_clear(struct nk_font_atlas*);
  * NK_INCLUDE_DEFAULT_ALLOCATOR which uses the standard library memory
  * allocation functions malloc and free and takes over complete control over
  * memory in this library.
+ *
+ * Dynamic buffers have to copy all their content into a bigger memory block
+ * once they run out of memory. If that is a problem, for example for the
+ * context draw command buffer on frames with a sudden spike in draw commands,
+ * a segmented buffer can be used instead. It allocates additional fixed size
+ * segments from the allocator without ever moving memory and keeps all segments
+ * around to be reused after `nk_buffer_clear`. Since memory is not contiguous
+ * anymore only front allocations not bigger than one segment are supported and
+ * `nk_buffer_memory` does not return usable memory.
  */
 
 struct nk_memory_status {
@@ -4394,7 +4809,8 @@ struct nk_memory_status {
 
 enum nk_allocation_type {
     NK_BUFFER_FIXED,
-    NK_BUFFER_DYNAMIC
+    NK_BUFFER_DYNAMIC,
+    NK_BUFFER_SEGMENTED
 };
 
 enum nk_buffer_allocation_type {
@@ -4419,6 +4835,9 @@ struct nk_buffer {
     nk_size needed;               /**!< totally consumed memory given that enough memory is present */
     nk_size calls;                /**!< number of allocation calls */
     nk_size size;                 /**!< current size of the buffer */
+    nk_size segment_size;         /**!< size of each memory segment of a segmented buffer */
+    nk_size segment_count;        /**!< number of memory segments allocated by a segmented buffer */
+    struct nk_memory segments;    /**!< table of memory segments of a segmented buffer */
 };
 
 #ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
@@ -4426,6 +4845,7 @@ NK_API void nk_buffer_init_default(struct nk_buffer*);
 #endif
 NK_API void nk_buffer_init(struct nk_buffer*, const struct nk_allocator*, nk_size size);
 NK_API void nk_buffer_init_fixed(struct nk_buffer*, void *memory, nk_size size);
+NK_API void nk_buffer_init_segmented(struct nk_buffer*, const struct nk_allocator*, nk_size segment_size);
 NK_API void nk_buffer_info(struct nk_memory_status*, const struct nk_buffer*);
 NK_API void nk_buffer_push(struct nk_buffer*, enum nk_buffer_allocation_type type, const void *memory, nk_size size, nk_size align);
 NK_API void nk_buffer_mark(struct nk_buffer*, enum nk_buffer_allocation_type type);
@@ -4858,6 +5278,36 @@ struct nk_command_buffer {
     int use_clipping;
     nk_handle userdata;
     nk_size begin, end, last;
+#ifdef NK_INCLUDE_FRAME_STATS
+    struct nk_panel_stats *stats;
+#endif
+};
+
+enum nk_window_delta_status {
+    NK_WINDOW_DELTA_UNCHANGED,  /**!< all commands equal the previous frame */
+    NK_WINDOW_DELTA_CHANGED,    /**!< some commands differ, see `keep_front` and `keep_back` */
+    NK_WINDOW_DELTA_ADDED,      /**!< the window was not drawn in the previous frame */
+    NK_WINDOW_DELTA_REMOVED     /**!< the window was only drawn in the previous frame */
+};
+struct nk_window_delta {
+    nk_hash id;                 /**!< window name hash, popups and the cursor overlay get their own ids */
+    enum nk_window_delta_status status;
+    int prev_index;             /**!< index of the window in the previous frame or -1 */
+    unsigned int count;         /**!< number of commands in this frame */
+    unsigned int prev_count;    /**!< number of commands in the previous frame */
+    unsigned int keep_front;    /**!< leading commands equal to the previous frame */
+    unsigned int keep_back;     /**!< trailing commands equal to the previous frame */
+    struct nk_rect bounds;      /**!< area covered by changed commands of both frames */
+};
+struct nk_frame_delta {
+    struct nk_buffer commands[2];
+    struct nk_buffer windows[2];
+    struct nk_buffer deltas;
+    int current;
+    int synced;
+    unsigned int command_count; /**!< number of commands in the current frame */
+    unsigned int changed_count; /**!< commands of both frames not covered by `keep_front` or `keep_back`, including removed windows */
+    struct nk_rect damage;      /**!< union of all changed bounds or an empty rect */
 };
 
 /** shape outlines */
@@ -4885,6 +5335,160 @@ NK_API void nk_draw_text(struct nk_command_buffer*, struct nk_rect, const char *
 NK_API void nk_push_scissor(struct nk_command_buffer*, struct nk_rect);
 NK_API void nk_push_custom(struct nk_command_buffer*, struct nk_rect, nk_command_custom_callback, nk_handle usr);
 
+#ifdef NK_INCLUDE_COMMAND_STREAM
+/* ==============================================================
+ *                          COMMAND STREAM
+ * ===============================================================*/
+/**
+ * \page Command Stream
+ * With `NK_INCLUDE_COMMAND_STREAM` defined the draw commands of a finished
+ * frame can be encoded into a compact byte stream, sent to another process
+ * or machine and decoded there into a `nk_command_buffer`, for example the
+ * canvas of a background window, which is then drawn by any backend.
+ *
+ * Coordinates are delta coded against the previous command, colors are only
+ * sent if they differ from the last one and fonts and image handles are sent
+ * once and afterwards referenced by index. Each text is looked up in the
+ * strings sent in the current and previous frame and only sent again if it
+ * is new. Only commands of windows that changed since the previous frame are
+ * sent, everything else is copied by the decoder from its copy of the last
+ * decoded frame (see `nk_frame_delta`). Since encoder and decoder keep this
+ * state in sync every encoded frame has to be decoded in order. If a frame is lost, call
+ * `nk_command_stream_encoder_reset` so the next frame is sent in full.
+ *
+ * Custom commands only hold a local callback and are not encoded. Fonts are
+ * identified by their `nk_user_font::userdata` and height and mapped to a
+ * local font by the decoder `font` callback; image handles are passed through
+ * as is.
+ *
+ * ```c
+ * // sender
+ * nk_command_stream_encode(&encoder, &ctx, &packet);
+ * // [... send nk_buffer_memory(&packet) with packet.allocated bytes ...]
+ * nk_buffer_clear(&packet);
+ * nk_clear(&ctx);
+ *
+ * // receiver
+ * if (nk_begin(&ctx, "remote", bounds, NK_WINDOW_BACKGROUND|NK_WINDOW_NO_INPUT|NK_WINDOW_NO_SCROLLBAR)) {
+ *     if (!nk_command_stream_decode(&decoder, data, size, nk_window_get_canvas(&ctx)))
+ *         // [... ask the sender to reset its encoder ...]
+ * }
+ * nk_end(&ctx);
+ * ```
+ *
+ * # Reference
+ * Function                                  | Description
+ * ------------------------------------------|-------------------------------------------------------
+ * \ref nk_command_stream_encoder_init       | Initializes an encoder with an allocator for its string table
+ * \ref nk_command_stream_encoder_reset      | Forces the next encoded frame to not depend on previous frames
+ * \ref nk_command_stream_encoder_free       | Frees the memory held by an encoder
+ * \ref nk_command_stream_encode             | Appends the draw commands of the current frame to a buffer
+ * \ref nk_command_stream_decoder_init       | Initializes a decoder with an allocator and a default font
+ * \ref nk_command_stream_decoder_free       | Frees the memory held by a decoder
+ * \ref nk_command_stream_decode             | Adds the commands of one encoded frame to a command buffer
+ */
+#ifndef NK_COMMAND_STREAM_MAX_STRINGS
+#define NK_COMMAND_STREAM_MAX_STRINGS 1024
+#endif
+#ifndef NK_COMMAND_STREAM_MAX_FONTS
+#define NK_COMMAND_STREAM_MAX_FONTS 16
+#endif
+#ifndef NK_COMMAND_STREAM_MAX_IMAGES
+#define NK_COMMAND_STREAM_MAX_IMAGES 64
+#endif
+
+struct nk_command_stream_strings {
+    struct nk_buffer text;
+    nk_hash hash[NK_COMMAND_STREAM_MAX_STRINGS];
+    nk_size offset[NK_COMMAND_STREAM_MAX_STRINGS];
+    int length[NK_COMMAND_STREAM_MAX_STRINGS];
+    unsigned short slots[NK_COMMAND_STREAM_MAX_STRINGS*2];
+    int count;
+};
+struct nk_command_stream_state {
+    struct nk_command_stream_strings strings[2];
+    int current;
+    unsigned int frame;
+    int synced;
+    short x, y;
+    struct nk_color color;
+    int font_count;
+    float font_height[NK_COMMAND_STREAM_MAX_FONTS];
+    int image_count;
+    nk_handle images[NK_COMMAND_STREAM_MAX_IMAGES];
+};
+struct nk_command_stream_encoder {
+    struct nk_command_stream_state state;
+    struct nk_frame_delta delta;
+    const struct nk_user_font *fonts[NK_COMMAND_STREAM_MAX_FONTS];
+    unsigned int skipped; /**!< commands of the last frame that could not be encoded */
+};
+struct nk_command_stream_decoder {
+    struct nk_command_stream_state state;
+    struct nk_buffer commands[2]; /* copies of the decoded commands of the current and previous frame */
+    struct nk_buffer records[2];
+    struct nk_buffer windows[2];
+    const struct nk_user_font *fonts[NK_COMMAND_STREAM_MAX_FONTS];
+    const struct nk_user_font *default_font;
+    /** optional: maps a font of the sender to a local font, falls back to `default_font` */
+    const struct nk_user_font*(*font)(nk_handle userdata, nk_handle remote, float height);
+    nk_handle userdata;
+};
+
+#ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
+NK_API void nk_command_stream_encoder_init_default(struct nk_command_stream_encoder*);
+NK_API void nk_command_stream_decoder_init_default(struct nk_command_stream_decoder*, const struct nk_user_font*);
+#endif
+NK_API void nk_command_stream_encoder_init(struct nk_command_stream_encoder*, const struct nk_allocator*);
+NK_API void nk_command_stream_encoder_reset(struct nk_command_stream_encoder*);
+NK_API void nk_command_stream_encoder_free(struct nk_command_stream_encoder*);
+
+/**
+ * \brief Encodes all draw commands of the current frame
+ *
+ * \details
+ * Has to be called after the last `nk_end` and before `nk_clear`. Appends
+ * one self contained packet to `out`, which should be a fixed or dynamic
+ * buffer so the packet ends up in one block of memory.
+ *
+ * ```c
+ * nk_bool nk_command_stream_encode(struct nk_command_stream_encoder*, struct nk_context*, struct nk_buffer *out);
+ * ```
+ *
+ * \param[in] encoder | Must point to a previously initialized encoder
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct at the end of a frame
+ * \param[out] out    | Buffer the packet is appended to
+ *
+ * \returns `false(0)` if `out` ran out of memory. The encoder is reset in that case
+ */
+NK_API nk_bool nk_command_stream_encode(struct nk_command_stream_encoder*, struct nk_context*, struct nk_buffer *out);
+
+NK_API void nk_command_stream_decoder_init(struct nk_command_stream_decoder*, const struct nk_allocator*, const struct nk_user_font*);
+NK_API void nk_command_stream_decoder_free(struct nk_command_stream_decoder*);
+
+/**
+ * \brief Decodes one packet written by `nk_command_stream_encode`
+ *
+ * \details
+ * The commands are appended to `out` exactly as they were encoded, without
+ * clipping them against `out->clip`. If the sender used scissor commands the
+ * clip rectangle of `out` is restored afterwards.
+ *
+ * ```c
+ * nk_bool nk_command_stream_decode(struct nk_command_stream_decoder*, const void *packet, nk_size size, struct nk_command_buffer *out);
+ * ```
+ *
+ * \param[in] decoder | Must point to a previously initialized decoder
+ * \param[in] packet  | Packet produced by `nk_command_stream_encode`
+ * \param[in] size    | Size of the packet in bytes
+ * \param[out] out    | Command buffer the decoded commands are added to
+ *
+ * \returns `false(0)` if the packet is damaged or a previous packet is
+ * missing. Following packets are rejected until the sender resets its encoder
+ */
+NK_API nk_bool nk_command_stream_decode(struct nk_command_stream_decoder*, const void *packet, nk_size size, struct nk_command_buffer *out);
+#endif
+
 /* ===============================================================
  *
  *                          INPUT
@@ -5024,9 +5628,11 @@ struct nk_draw_command {
 #endif
 };
 
+#define NK_DRAW_LIST_CIRCLE_TABLE_SIZE 360 /**< highly composite so most segment counts sample it with a fixed stride */
 struct nk_draw_list {
     struct nk_rect clip_rect;
     struct nk_vec2 circle_vtx[12];
+    struct nk_vec2 circle_table[NK_DRAW_LIST_CIRCLE_TABLE_SIZE];
     struct nk_convert_config config;
 
     struct nk_buffer *buffer;
@@ -5699,6 +6305,10 @@ struct nk_panel {
     struct nk_chart chart;
     struct nk_command_buffer *buffer;
     struct nk_panel *parent;
+#ifdef NK_INCLUDE_FRAME_STATS
+    struct nk_panel_stats *stats;
+    struct nk_panel_stats *stats_parent;
+#endif
 };
 
 /*==============================================================
@@ -5709,6 +6319,8 @@ struct nk_panel {
 #endif
 
 struct nk_table;
+struct nk_chart_stream;
+struct nk_text_cache;
 enum nk_window_flags {
     NK_WINDOW_PRIVATE       = NK_FLAG(11),
     NK_WINDOW_DYNAMIC       = NK_WINDOW_PRIVATE,                  /**< special window type growing up in height while being filled to a certain maximum height */
@@ -5769,6 +6381,7 @@ struct nk_window {
     struct nk_command_buffer buffer;
     struct nk_panel *layout;
     float scrollbar_hiding_timer;
+    unsigned int scrollbar_hiding_seq; /* frame in which a panel of this window still faded its scrollbar */
 
     /* persistent widget state */
     struct nk_property_state property;
@@ -5779,6 +6392,8 @@ struct nk_window {
 
     struct nk_table *tables;
     unsigned int table_count;
+    struct nk_chart_stream *streams;
+    struct nk_text_cache *text_cache;
 
     /* window list hooks */
     struct nk_window *next;
@@ -5884,8 +6499,11 @@ struct nk_configuration_stacks {
 /*==============================================================
  *                          CONTEXT
  * =============================================================*/
-#define NK_VALUE_PAGE_CAPACITY \
-    (((NK_MAX(sizeof(struct nk_window),sizeof(struct nk_panel)) / sizeof(nk_uint))) / 2)
+/* tables have their own pool size class, so their capacity is a fixed count
+ * that keeps a table element below the size of a panel */
+#ifndef NK_VALUE_PAGE_CAPACITY
+#define NK_VALUE_PAGE_CAPACITY 48
+#endif
 
 struct nk_table {
     unsigned int seq;
@@ -5895,16 +6513,88 @@ struct nk_table {
     struct nk_table *next, *prev;
 };
 
+/* number of samples kept per series if `nk_chart_stream_push` is not given
+ * a capacity */
+#ifndef NK_CHART_STREAM_CAPACITY
+#define NK_CHART_STREAM_CAPACITY 1024
+#endif
+#ifndef NK_CHART_STREAM_MAX_SERIES
+#define NK_CHART_STREAM_MAX_SERIES 8
+#endif
+#define NK_CHART_STREAM_BUCKET 16
+
+/* each series owns `capacity` values of a ring allocated with the context
+ * allocator, so only the pointer lives inside the window page element.
+ * Each series keeps the min/max of every NK_CHART_STREAM_BUCKET consecutive
+ * ring entries, updated on push, to answer range queries without a full scan */
+struct nk_chart_stream {
+    nk_hash name;
+    unsigned int seq;
+    int series;
+    int capacity;
+    int head;
+    int count;
+    float *values;
+    float *buckets;
+    struct nk_chart_stream *next, *prev;
+};
+
+#ifndef NK_TEXT_CACHE_SIZE
+#define NK_TEXT_CACHE_SIZE 16 /* initial number of entries, a power of two */
+#endif
+#ifndef NK_TEXT_CACHE_MAX_TEXT
+#define NK_TEXT_CACHE_MAX_TEXT 32
+#endif
+
+/* formatted text of value, label and property widgets of one window.
+ * Entries are found by widget hash with linear probing and remember the raw
+ * value they were formatted from, so an unchanged value skips formatting and
+ * measuring. The table is allocated with the context allocator and rebuilt
+ * from the entries used in the current and previous frame once it is three
+ * quarters full, so it follows the number of widgets drawn. Only contexts with
+ * a growing pool allocate a cache, longer texts are not cached */
+struct nk_text_cache_entry {
+    nk_hash key;
+    unsigned int seq;
+    nk_uint value[3];
+    const struct nk_user_font *font;
+    float height;
+    float width;
+    float label_width;
+    int length;
+    char text[NK_TEXT_CACHE_MAX_TEXT];
+};
+struct nk_text_cache {
+    struct nk_allocator alloc;
+    unsigned int seq;
+    unsigned int counter;
+    int capacity;
+    int count;
+    struct nk_text_cache_entry *entries;
+};
+
 union nk_page_data {
     struct nk_table tbl;
+    struct nk_chart_stream stream;
+    struct nk_text_cache text;
     struct nk_panel pan;
     struct nk_window win;
 };
 
+enum nk_page_element_type {
+    NK_PAGE_ELEMENT_TABLE,
+    NK_PAGE_ELEMENT_PANEL,
+    NK_PAGE_ELEMENT_WINDOW,
+    NK_PAGE_ELEMENT_STREAM,
+    NK_PAGE_ELEMENT_TEXT,
+    NK_PAGE_ELEMENT_TYPE_COUNT
+};
+
+/* page elements are only allocated as big as the `data` member they hold */
 struct nk_page_element {
-    union nk_page_data data;
     struct nk_page_element *next;
     struct nk_page_element *prev;
+    union nk_page_data data;
 };
 
 struct nk_page {
@@ -5917,13 +6607,51 @@ struct nk_pool {
     struct nk_allocator alloc;
     enum nk_allocation_type type;
     unsigned int page_count;
-    struct nk_page *pages;
-    struct nk_page_element *freelist;
+    struct nk_page *pages[NK_PAGE_ELEMENT_TYPE_COUNT];
     unsigned capacity;
+    void *memory;
     nk_size size;
-    nk_size cap;
+    nk_size allocated;
 };
 
+/*==============================================================
+ *                          FRAME STATS
+ * =============================================================*/
+#ifdef NK_INCLUDE_FRAME_STATS
+#ifndef NK_FRAME_STATS_MAX_PANELS
+#define NK_FRAME_STATS_MAX_PANELS 32
+#endif
+#define NK_COMMAND_TYPE_COUNT (NK_COMMAND_CUSTOM+1)
+
+struct nk_panel_stats {
+    char name[NK_WINDOW_MAX_NAME];
+    enum nk_panel_type type;
+    int parent; /**!< index of the parent panel or -1 for windows */
+    unsigned int commands[NK_COMMAND_TYPE_COUNT]; /**!< commands emitted per enum nk_command_type */
+    nk_size command_bytes;
+    unsigned int vertices;  /**!< vertices produced by `nk_convert` */
+    unsigned int indices;   /**!< indices produced by `nk_convert` */
+    unsigned int table_lookups;
+    unsigned int text_measurements;
+    unsigned int text_cache_hits; /**!< value, label and property texts reused without formatting */
+    nk_size begin, end; /**!< range inside the context command memory */
+};
+struct nk_memory_stats {
+    nk_size commands;       /**!< context command buffer */
+    nk_size pool;           /**!< window, panel and table storage */
+    nk_size draw_commands;  /**!< `nk_convert` draw command buffer */
+    nk_size vertices;       /**!< `nk_convert` vertex buffer */
+    nk_size elements;       /**!< `nk_convert` element buffer */
+};
+struct nk_frame_stats {
+    struct nk_panel_stats panels[NK_FRAME_STATS_MAX_PANELS];
+    int panel_count;
+    unsigned int dropped_panels; /**!< panels counted into their parent for lack of records */
+    struct nk_memory_stats memory;
+    struct nk_memory_stats high_water;
+};
+#endif
+
 struct nk_context {
 /* public: can be accessed freely */
     struct nk_input input;
@@ -5951,6 +6679,16 @@ struct nk_context {
     struct nk_text_edit text_edit;
     /** draw buffer used for overlay drawing operation like cursor */
     struct nk_command_buffer overlay;
+    /** draw buffer holding the commands copied from worker contexts */
+    struct nk_command_buffer merged;
+
+    /** worker contexts. Owners are 0 for this context or the worker index + 1 */
+    struct nk_mouse worker_mouse;
+    struct nk_keyboard worker_keyboard;
+    int mouse_owner;
+    int keyboard_owner;
+    int worker_count;
+    nk_flags worker_state;
 
     /** windows */
     int build;
@@ -5960,9 +6698,23 @@ struct nk_context {
     struct nk_window *end;
     struct nk_window *active;
     struct nk_window *current;
-    struct nk_page_element *freelist;
+    struct nk_page_element *freelist[NK_PAGE_ELEMENT_TYPE_COUNT];
     unsigned int count;
     unsigned int seq;
+
+    /** frame change detection */
+    nk_hash frame_hash;
+    nk_flags frame_status;
+    unsigned int frame_seq;
+#ifdef NK_INCLUDE_FRAME_STATS
+    struct nk_frame_stats stats;
+    struct nk_frame_stats last_stats;
+#endif
+#ifdef NK_INCLUDE_INPUT_RECORDING
+    struct nk_buffer *input_log;
+    int input_log_x, input_log_y;
+    float input_log_delta_time;
+#endif
 };
 
 /* ==============================================================
@@ -6063,6 +6815,10 @@ template<typename T> struct nk_alignof{struct Big {T x; char c;}; enum {
 #define NK_BUFFER_DEFAULT_INITIAL_SIZE (4*1024)
 #endif
 
+/* bytes checked at once for plain ASCII and runes decoded per run */
+#define NK_UTF_BLOCK 16
+#define NK_UTF_RUN 64
+
 /* standard library headers */
 #ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
 #include <stdlib.h> /* malloc, free */
@@ -6128,7 +6884,6 @@ NK_STATIC_ASSERT(sizeof(nk_bool) == 4);
 #endif
 
 NK_GLOBAL const struct nk_rect nk_null_rect = {-8192.0f, -8192.0f, 16384, 16384};
-#define NK_FLOAT_PRECISION 0.00000000000001
 
 NK_GLOBAL const struct nk_color nk_red = {255,0,0,255};
 NK_GLOBAL const struct nk_color nk_green = {0,255,0,255};
@@ -6163,11 +6918,8 @@ NK_LIB nk_uint nk_round_up_pow2(nk_uint v);
 NK_LIB struct nk_rect nk_shrink_rect(struct nk_rect r, float amount);
 NK_LIB struct nk_rect nk_pad_rect(struct nk_rect r, struct nk_vec2 pad);
 NK_LIB void nk_unify(struct nk_rect *clip, const struct nk_rect *a, float x0, float y0, float x1, float y1);
-NK_LIB double nk_pow(double x, int n);
-NK_LIB int nk_ifloord(double x);
 NK_LIB int nk_ifloorf(float x);
 NK_LIB int nk_iceilf(float x);
-NK_LIB int nk_log10(double n);
 NK_LIB float nk_roundf(float x);
 
 /* util */
@@ -6186,8 +6938,14 @@ NK_LIB void nk_memset(void *ptr, int c0, nk_size size);
 NK_LIB void nk_zero(void *ptr, nk_size size);
 NK_LIB char *nk_itoa(char *s, long n);
 NK_LIB int nk_string_float_limit(char *string, int prec);
+#define NK_DTOA_DIGITS 17
+enum nk_dtoa_mode {NK_DTOA_SHORTEST, NK_DTOA_FIXED, NK_DTOA_PRECISION};
+NK_LIB int nk_dtoa_digits(char *digits, int max, int *point, double n, enum nk_dtoa_mode mode, int prec);
+NK_LIB int nk_dtoa_fixed(char *s, double n, int prec);
 #ifndef NK_DTOA
 NK_LIB char *nk_dtoa(char *s, double n);
+#else
+#define NK_DTOA_USER_DEFINED
 #endif
 NK_LIB int nk_text_clamp(const struct nk_user_font *font, const char *text, int text_len, float space, int *glyphs, float *text_width, nk_rune *sep_list, int sep_count);
 NK_LIB struct nk_vec2 nk_text_calculate_text_bounds(const struct nk_user_font *font, const char *begin, int byte_len, float row_height, const char **remaining, struct nk_vec2 *out_offset, int *glyphs, int op);
@@ -6206,11 +6964,16 @@ NK_LIB void nk_mfree(nk_handle unused, void *ptr);
 NK_LIB void* nk_buffer_align(void *unaligned, nk_size align, nk_size *alignment, enum nk_buffer_allocation_type type);
 NK_LIB void* nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type, nk_size size, nk_size align);
 NK_LIB void* nk_buffer_realloc(struct nk_buffer *b, nk_size capacity, nk_size *size);
+NK_LIB void* nk_buffer_memory_at(const struct nk_buffer *b, nk_size offset);
+NK_LIB nk_size nk_buffer_segment_left(const struct nk_buffer *b);
+NK_LIB nk_size nk_buffer_segment_next(struct nk_buffer *b);
 
 /* draw */
 NK_LIB void nk_command_buffer_init(struct nk_command_buffer *cb, struct nk_buffer *b, enum nk_command_clipping clip);
 NK_LIB void nk_command_buffer_reset(struct nk_command_buffer *b);
 NK_LIB void* nk_command_buffer_push(struct nk_command_buffer* b, enum nk_command_type t, nk_size size);
+NK_LIB nk_size nk_command_size(const struct nk_command *cmd);
+NK_LIB void nk_draw_text_measured(struct nk_command_buffer *b, struct nk_rect r, const char *string, int length, float text_width, const struct nk_user_font *font, struct nk_color bg, struct nk_color fg);
 NK_LIB void nk_draw_symbol(struct nk_command_buffer *out, enum nk_symbol_type type, struct nk_rect content, struct nk_color background, struct nk_color foreground, float border_width, const struct nk_user_font *font);
 
 /* buffering */
@@ -6221,6 +6984,21 @@ NK_LIB void nk_finish_popup(struct nk_context *ctx, struct nk_window*);
 NK_LIB void nk_finish_buffer(struct nk_context *ctx, struct nk_command_buffer *b);
 NK_LIB void nk_finish(struct nk_context *ctx, struct nk_window *w);
 NK_LIB void nk_build(struct nk_context *ctx);
+NK_LIB nk_hash nk_command_hash(const struct nk_command *cmd, nk_hash hash);
+
+/* frame delta */
+struct nk_delta_command {
+    nk_hash hash;
+    struct nk_rect bounds;
+};
+struct nk_delta_window {
+    nk_hash id;
+    nk_size begin, last; /* command memory offsets of the first and last command */
+    nk_size first; /* index of the first command */
+    unsigned int count;
+    int matched;
+};
+NK_LIB struct nk_rect nk_command_bounds(const struct nk_command *cmd);
 
 /* text editor */
 NK_LIB void nk_textedit_clear_state(struct nk_text_edit *state, enum nk_text_edit_type type, nk_plugin_filter filter);
@@ -6239,16 +7017,48 @@ NK_LIB void nk_free_window(struct nk_context *ctx, struct nk_window *win);
 NK_LIB struct nk_window *nk_find_window(const struct nk_context *ctx, nk_hash hash, const char *name);
 NK_LIB void nk_insert_window(struct nk_context *ctx, struct nk_window *win, enum nk_window_insert_location loc);
 
+/* frame stats */
+#ifdef NK_INCLUDE_FRAME_STATS
+#define NK_STATS_ADD(b, counter, n) do {if ((b)->stats) (b)->stats->counter += (unsigned int)(n);} while (0)
+NK_LIB void nk_stats_panel_begin(struct nk_context *ctx, struct nk_window *win, const char *title, enum nk_panel_type type);
+NK_LIB void nk_stats_panel_end(struct nk_context *ctx, struct nk_window *win);
+NK_LIB struct nk_panel_stats *nk_stats_panel_at(struct nk_context *ctx, nk_size offset);
+NK_LIB void nk_stats_clear(struct nk_context *ctx);
+#else
+#define NK_STATS_ADD(b, counter, n) ((void)0)
+#endif
+
+/* input log */
+#ifdef NK_INCLUDE_INPUT_RECORDING
+enum nk_input_log_event {
+    NK_INPUT_LOG_BEGIN,
+    NK_INPUT_LOG_END,
+    NK_INPUT_LOG_MOTION,
+    NK_INPUT_LOG_KEY,
+    NK_INPUT_LOG_BUTTON,
+    NK_INPUT_LOG_SCROLL,
+    NK_INPUT_LOG_GLYPH,
+    NK_INPUT_LOG_DELTA_TIME
+};
+NK_LIB void nk_input_log(struct nk_context *ctx, enum nk_input_log_event event, int arg, int x, int y, const void *data, int len);
+#define NK_INPUT_LOG(ctx, event, arg, x, y, data, len) do {if ((ctx)->input_log) nk_input_log(ctx, event, arg, x, y, data, len);} while (0)
+#else
+#define NK_INPUT_LOG(ctx, event, arg, x, y, data, len) ((void)0)
+#endif
+
 /* pool */
 NK_LIB void nk_pool_init(struct nk_pool *pool, const struct nk_allocator *alloc, unsigned int capacity);
 NK_LIB void nk_pool_free(struct nk_pool *pool);
 NK_LIB void nk_pool_init_fixed(struct nk_pool *pool, void *memory, nk_size size);
-NK_LIB struct nk_page_element *nk_pool_alloc(struct nk_pool *pool);
+NK_LIB nk_size nk_pool_element_size(enum nk_page_element_type type);
+NK_LIB struct nk_page_element *nk_pool_alloc(struct nk_pool *pool, enum nk_page_element_type type);
+NK_LIB void nk_pool_trim(struct nk_pool *pool, struct nk_page_element **freelist);
 
 /* page-element */
-NK_LIB struct nk_page_element* nk_create_page_element(struct nk_context *ctx);
-NK_LIB void nk_link_page_element_into_freelist(struct nk_context *ctx, struct nk_page_element *elem);
-NK_LIB void nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem);
+NK_LIB struct nk_page_element* nk_create_page_element(struct nk_context *ctx, enum nk_page_element_type type);
+NK_LIB struct nk_page_element* nk_try_create_page_element(struct nk_context *ctx, enum nk_page_element_type type);
+NK_LIB void nk_link_page_element_into_freelist(struct nk_context *ctx, struct nk_page_element *elem, enum nk_page_element_type type);
+NK_LIB void nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem, enum nk_page_element_type type);
 
 /* table */
 NK_LIB struct nk_table* nk_create_table(struct nk_context *ctx);
@@ -6258,6 +7068,31 @@ NK_LIB void nk_push_table(struct nk_window *win, struct nk_table *tbl);
 NK_LIB nk_uint *nk_add_value(struct nk_context *ctx, struct nk_window *win, nk_hash name, nk_uint value);
 NK_LIB nk_uint *nk_find_value(const struct nk_window *win, nk_hash name);
 
+/* chart */
+NK_LIB void nk_free_chart_stream(struct nk_context *ctx, struct nk_window *win, struct nk_chart_stream *stream);
+
+/* text cache */
+enum nk_text_cache_kind {
+    NK_TEXT_CACHE_LABEL = 1,
+    NK_TEXT_CACHE_BOOL,
+    NK_TEXT_CACHE_INT,
+    NK_TEXT_CACHE_UINT,
+    NK_TEXT_CACHE_FLOAT,
+    NK_TEXT_CACHE_COLOR_BYTE,
+    NK_TEXT_CACHE_COLOR_FLOAT,
+    NK_TEXT_CACHE_COLOR_HEX,
+    NK_TEXT_CACHE_PROPERTY_INT,
+    NK_TEXT_CACHE_PROPERTY_FLOAT,
+    NK_TEXT_CACHE_PROPERTY_DOUBLE
+};
+NK_LIB struct nk_text_cache *nk_text_cache_get(struct nk_context *ctx, struct nk_window *win);
+NK_LIB void nk_free_text_cache(struct nk_context *ctx, struct nk_window *win);
+#ifdef NK_INCLUDE_STANDARD_VARARGS
+NK_LIB nk_hash nk_text_cache_key(struct nk_text_cache *cache, const char *str, int len);
+#endif
+NK_LIB struct nk_text_cache_entry *nk_text_cache_find(struct nk_text_cache *cache, nk_hash key, const nk_uint *value, const struct nk_user_font *font);
+NK_LIB struct nk_text_cache_entry *nk_text_cache_store(struct nk_text_cache *cache, nk_hash key, const nk_uint *value, const struct nk_user_font *font, const char *text, int len, float width);
+
 /* panel */
 NK_LIB void *nk_create_panel(struct nk_context *ctx);
 NK_LIB void nk_free_panel(struct nk_context*, struct nk_panel *pan);
@@ -6289,6 +7124,7 @@ struct nk_text {
     struct nk_color text;
 };
 NK_LIB void nk_widget_text(struct nk_command_buffer *o, struct nk_rect b, const char *string, int len, const struct nk_text *t, nk_flags a, const struct nk_user_font *f);
+NK_LIB void nk_widget_text_measured(struct nk_command_buffer *o, struct nk_rect b, const char *string, int len, float width, const struct nk_text *t, nk_flags a, const struct nk_user_font *f);
 NK_LIB void nk_widget_text_wrap(struct nk_command_buffer *o, struct nk_rect b, const char *string, int len, const struct nk_text *t, const struct nk_user_font *f);
 
 /* button */
@@ -6379,8 +7215,8 @@ NK_LIB struct nk_property_variant nk_property_variant_double(double value, doubl
 
 NK_LIB void nk_drag_behavior(nk_flags *state, const struct nk_input *in, struct nk_rect drag, struct nk_property_variant *variant, float inc_per_pixel);
 NK_LIB void nk_property_behavior(nk_flags *ws, const struct nk_input *in, struct nk_rect property,  struct nk_rect label, struct nk_rect edit, struct nk_rect empty, int *state, struct nk_property_variant *variant, float inc_per_pixel);
-NK_LIB void nk_draw_property(struct nk_command_buffer *out, const struct nk_style_property *style, const struct nk_rect *bounds, const struct nk_rect *label, nk_flags state, const char *name, int len, const struct nk_user_font *font);
-NK_LIB void nk_do_property(nk_flags *ws, struct nk_command_buffer *out, struct nk_rect property, const char *name, struct nk_property_variant *variant, float inc_per_pixel, char *buffer, int *len, int *state, int *cursor, int *select_begin, int *select_end, const struct nk_style_property *style, enum nk_property_filter filter, struct nk_input *in, const struct nk_user_font *font, struct nk_text_edit *text_edit, enum nk_button_behavior behavior);
+NK_LIB void nk_draw_property(struct nk_command_buffer *out, const struct nk_style_property *style, const struct nk_rect *bounds, const struct nk_rect *label, nk_flags state, const char *name, int len, float name_width, const struct nk_user_font *font);
+NK_LIB void nk_do_property(nk_flags *ws, struct nk_command_buffer *out, struct nk_rect property, const char *name, struct nk_property_variant *variant, float inc_per_pixel, char *buffer, int *len, int *state, int *cursor, int *select_begin, int *select_end, const struct nk_style_property *style, enum nk_property_filter filter, struct nk_input *in, const struct nk_user_font *font, struct nk_text_edit *text_edit, enum nk_button_behavior behavior, struct nk_text_cache *cache, nk_hash hash);
 NK_LIB void nk_property(struct nk_context *ctx, const char *name, struct nk_property_variant *variant, float inc_per_pixel, const enum nk_property_filter filter);
 
 #ifdef NK_INCLUDE_FONT_BAKING
@@ -6570,27 +7406,6 @@ nk_round_up_pow2(nk_uint v)
     v++;
     return v;
 }
-NK_LIB double
-nk_pow(double x, int n)
-{
-    /*  check the sign of n */
-    double r = 1;
-    int plus = n >= 0;
-    n = (plus) ? n : -n;
-    while (n > 0) {
-        if ((n & 1) == 1)
-            r *= x;
-        n /= 2;
-        x *= x;
-    }
-    return plus ? r : 1.0 / r;
-}
-NK_LIB int
-nk_ifloord(double x)
-{
-    x = (double)((int)x - ((x < 0.0) ? 1 : 0));
-    return (int)x;
-}
 NK_LIB int
 nk_ifloorf(float x)
 {
@@ -6609,22 +7424,6 @@ nk_iceilf(float x)
         return (r > 0.0f) ? t+1: t;
     }
 }
-NK_LIB int
-nk_log10(double n)
-{
-    int neg;
-    int ret;
-    int exp = 0;
-
-    neg = (n < 0) ? 1 : 0;
-    ret = (neg) ? (int)-n : (int)n;
-    while ((ret / 10) > 0) {
-        ret /= 10;
-        exp++;
-    }
-    if (neg) exp = -exp;
-    return exp;
-}
 NK_LIB float
 nk_roundf(float x)
 {
@@ -6947,62 +7746,636 @@ nk_strtoi(const char *str, char **endptr)
         *endptr = (char *)p;
     return neg*value;
 }
-NK_API double
-nk_strtod(const char *str, char **endptr)
+/* Binary <-> decimal conversion. Doubles are split into an integer significand
+ * and binary exponent using power-of-two scaling only and every decimal digit
+ * is taken from an exact ratio of big integers (Steele & White, Burger &
+ * Dybvig), so there is no dependency on a 64-bit integer type or the layout
+ * of `double`. Numbers in the usual UI range only need a handful of limbs. */
+#define NK_BIGNUM_LIMBS 76
+struct nk_bignum {
+    int n;
+    nk_ushort d[NK_BIGNUM_LIMBS];
+};
+NK_GLOBAL const double nk_pow10_table[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+NK_INTERN void
+nk_bignum_trim(struct nk_bignum *b)
+{
+    while (b->n > 0 && !b->d[b->n-1])
+        b->n--;
+}
+NK_INTERN void
+nk_bignum_set(struct nk_bignum *b, nk_uint hi, nk_uint lo)
+{
+    b->d[0] = (nk_ushort)(lo & 0xFFFF);
+    b->d[1] = (nk_ushort)(lo >> 16);
+    b->d[2] = (nk_ushort)(hi & 0xFFFF);
+    b->d[3] = (nk_ushort)(hi >> 16);
+    b->n = 4;
+    nk_bignum_trim(b);
+}
+NK_INTERN int
+nk_bignum_bits(const struct nk_bignum *b)
+{
+    nk_uint top;
+    int bits;
+    if (!b->n) return 0;
+    top = b->d[b->n-1];
+    for (bits = (b->n-1) * 16; top; top >>= 1)
+        bits++;
+    return bits;
+}
+NK_INTERN void
+nk_bignum_mul(struct nk_bignum *b, nk_uint m)
+{
+    /* `m` has to fit into a single limb */
+    nk_uint carry = 0;
+    int i;
+    NK_ASSERT(m <= 0xFFFF);
+    for (i = 0; i < b->n; ++i) {
+        carry += (nk_uint)b->d[i] * m;
+        b->d[i] = (nk_ushort)(carry & 0xFFFF);
+        carry >>= 16;
+    }
+    if (carry) {
+        NK_ASSERT(b->n < NK_BIGNUM_LIMBS);
+        b->d[b->n++] = (nk_ushort)carry;
+    }
+}
+NK_INTERN void
+nk_bignum_mul_pow10(struct nk_bignum *b, int k)
+{
+    NK_ASSERT(k >= 0);
+    for (; k >= 4; k -= 4)
+        nk_bignum_mul(b, 10000);
+    if (k) nk_bignum_mul(b, (nk_uint)nk_pow10_table[k]);
+}
+NK_INTERN void
+nk_bignum_shl(struct nk_bignum *b, int bits)
+{
+    int i, limbs = bits / 16;
+    bits %= 16;
+    if (!b->n) return;
+    if (bits) {
+        nk_uint carry = 0;
+        for (i = 0; i < b->n; ++i) {
+            carry |= (nk_uint)b->d[i] << bits;
+            b->d[i] = (nk_ushort)(carry & 0xFFFF);
+            carry >>= 16;
+        }
+        if (carry) {
+            NK_ASSERT(b->n < NK_BIGNUM_LIMBS);
+            b->d[b->n++] = (nk_ushort)carry;
+        }
+    }
+    if (limbs) {
+        NK_ASSERT(b->n + limbs <= NK_BIGNUM_LIMBS);
+        for (i = b->n-1; i >= 0; --i)
+            b->d[i + limbs] = b->d[i];
+        for (i = 0; i < limbs; ++i)
+            b->d[i] = 0;
+        b->n += limbs;
+    }
+}
+NK_INTERN int
+nk_bignum_cmp(const struct nk_bignum *a, const struct nk_bignum *b)
+{
+    int i;
+    if (a->n != b->n)
+        return (a->n < b->n) ? -1: 1;
+    for (i = a->n-1; i >= 0; --i) {
+        if (a->d[i] != b->d[i])
+            return (a->d[i] < b->d[i]) ? -1: 1;
+    }
+    return 0;
+}
+NK_INTERN void
+nk_bignum_add(struct nk_bignum *r, const struct nk_bignum *a, const struct nk_bignum *b)
+{
+    nk_uint carry = 0;
+    int i, n = NK_MAX(a->n, b->n);
+    for (i = 0; i < n; ++i) {
+        if (i < a->n) carry += a->d[i];
+        if (i < b->n) carry += b->d[i];
+        r->d[i] = (nk_ushort)(carry & 0xFFFF);
+        carry >>= 16;
+    }
+    if (carry) {
+        NK_ASSERT(n < NK_BIGNUM_LIMBS);
+        r->d[n++] = (nk_ushort)carry;
+    }
+    r->n = n;
+}
+NK_INTERN void
+nk_bignum_sub(struct nk_bignum *a, const struct nk_bignum *b)
+{
+    /* `a` has to be larger than or equal to `b` */
+    nk_int borrow = 0;
+    int i;
+    for (i = 0; i < a->n && (i < b->n || borrow); ++i) {
+        nk_int t = (nk_int)a->d[i] - borrow;
+        if (i < b->n) t -= b->d[i];
+        borrow = (t < 0);
+        a->d[i] = (nk_ushort)(t + (borrow << 16));
+    }
+    nk_bignum_trim(a);
+}
+NK_INTERN int
+nk_bignum_digit(struct nk_bignum *r, const struct nk_bignum *s)
+{
+    /* returns floor(r/s) for r < 10*s and leaves the remainder in `r`. With
+     * the top bit of `s` set the quotient estimate is at most two short. */
+    nk_uint top, q, carry = 0;
+    nk_int borrow = 0;
+    int i, n = s->n;
+    NK_ASSERT(n > 0);
+    if (r->n < n) return 0;
+    top = r->d[n-1];
+    if (r->n > n) top |= (nk_uint)r->d[n] << 16;
+    q = top / ((nk_uint)s->d[n-1] + 1);
+    if (q) {
+        for (i = 0; i < r->n; ++i) {
+            nk_int t;
+            if (i < n) carry += (nk_uint)s->d[i] * q;
+            t = (nk_int)r->d[i] - (nk_int)(carry & 0xFFFF) - borrow;
+            carry >>= 16;
+            borrow = (t < 0);
+            r->d[i] = (nk_ushort)(t + (borrow << 16));
+        }
+        nk_bignum_trim(r);
+    }
+    while (nk_bignum_cmp(r, s) >= 0) {
+        nk_bignum_sub(r, s);
+        q++;
+    }
+    return (int)q;
+}
+NK_INTERN int
+nk_bignum_norm(const struct nk_bignum *s)
+{
+    /* number of bits to shift `s` up by until its top limb has the high bit set */
+    nk_uint top = s->d[s->n-1];
+    int bits = 0;
+    for (; !(top & 0x8000); top <<= 1)
+        bits++;
+    return bits;
+}
+NK_INTERN int
+nk_dtoa_estimate(int e)
+{
+    /* ceil(e * log10(2)): for a value in [2^e, 2^(e+1)) this is either its
+     * decimal exponent or one short of it */
+    double x = (double)e * 0.30102999566398114 - 1e-10;
+    int k = (int)x;
+    return ((double)k < x) ? k + 1: k;
+}
+NK_INTERN void
+nk_dtoa_pow2(double *pow2)
+{
+    /* pow2[i] = 2^(2^i) up to 2^512 */
+    int i;
+    pow2[0] = 2.0;
+    for (i = 1; i < 10; ++i)
+        pow2[i] = pow2[i-1] * pow2[i-1];
+}
+NK_INTERN int
+nk_dtoa_split(double v, nk_uint *hi, nk_uint *lo)
+{
+    /* splits finite `v` > 0 into f * 2^e with f < 2^53, returns e. f is at
+     * least 2^52 unless `v` is subnormal in which case e is -1074. */
+    const double lo_bound = 4503599627370496.0; /* 2^52 */
+    const double hi_bound = 9007199254740992.0; /* 2^53 */
+    double pow2[10];
+    int i, e = 0;
+
+    nk_dtoa_pow2(pow2);
+    if (v * pow2[9] * (pow2[9] / 4.0) < 1.0) {
+        const double scale = pow2[9] * pow2[4] * pow2[3] * pow2[0]; /* 2^537 */
+        v = v * scale * scale;
+        e = -1074;
+    } else if (v >= lo_bound) {
+        for (i = 9; i >= 0; --i) {
+            while (v >= lo_bound * pow2[i]) {
+                v /= pow2[i];
+                e += 1 << i;
+            }
+        }
+    } else {
+        for (i = 9; i >= 0; --i) {
+            while (v * pow2[i] < hi_bound) {
+                v *= pow2[i];
+                e -= 1 << i;
+            }
+        }
+    }
+    *hi = (nk_uint)(v / 4294967296.0);
+    *lo = (nk_uint)(v - (double)*hi * 4294967296.0);
+    return e;
+}
+NK_INTERN int
+nk_dtoa_signbit(double n)
+{
+    /* 1.0 and -1.0 only differ in the sign bit, which finds it without
+     * knowing the byte order and also works for zero and nan */
+    NK_STORAGE const double pos = 1.0, neg = -1.0;
+    unsigned char a[sizeof(double)], b[sizeof(double)], c[sizeof(double)];
+    int i;
+    NK_MEMCPY(a, &pos, sizeof(double));
+    NK_MEMCPY(b, &neg, sizeof(double));
+    NK_MEMCPY(c, &n, sizeof(double));
+    for (i = 0; i < (int)sizeof(double); ++i)
+        if (a[i] != b[i]) return (c[i] & (a[i] ^ b[i])) != 0;
+    return n < 0;
+}
+NK_INTERN double
+nk_dtoa_join(nk_uint hi, nk_uint lo, int e)
+{
+    /* f * 2^e: exact for every double and infinity once it does not fit */
+    double pow2[10];
+    double v = (double)hi * 4294967296.0 + (double)lo;
+    int i;
+    nk_dtoa_pow2(pow2);
+    for (i = 9; i >= 0; --i) {
+        for (; e >= (1 << i); e -= 1 << i)
+            v *= pow2[i];
+        for (; -e >= (1 << i); e += 1 << i)
+            v /= pow2[i];
+    }
+    return v;
+}
+NK_INTERN int
+nk_dtoa_round(double *y)
+{
+    /* rounds 0 <= y < 2^52 to the nearest integer, fails on an exact tie */
+    nk_uint hi = (nk_uint)(*y / 4294967296.0);
+    double i = (double)hi * 4294967296.0;
+    double frac;
+    i += (double)(nk_uint)(*y - i);
+    frac = *y - i;
+    if (frac == 0.5) return 0;
+    *y = (frac > 0.5) ? i + 1.0: i;
+    return 1;
+}
+NK_INTERN int
+nk_dtoa_integer(char *digits, double y)
+{
+    /* decimal digits of the integer 0 < y < 2^53 */
+    char tmp[20];
+    double top = (double)(nk_uint)(y / 1e9);
+    double rest = y - top * 1e9;
+    nk_uint hi, lo;
+    int i, n = 0;
+    if (rest < 0) {
+        top -= 1.0;
+        rest += 1e9;
+    } else if (rest >= 1e9) {
+        top += 1.0;
+        rest -= 1e9;
+    }
+    hi = (nk_uint)top;
+    lo = (nk_uint)rest;
+    for (; lo || (hi && n < 9); lo /= 10)
+        tmp[n++] = (char)('0' + lo % 10);
+    for (; hi; hi /= 10)
+        tmp[n++] = (char)('0' + hi % 10);
+    for (i = 0; i < n; ++i)
+        digits[i] = tmp[n-1-i];
+    return n;
+}
+NK_INTERN int
+nk_dtoa_fast(char *digits, int *point, double n, enum nk_dtoa_mode mode, int prec)
+{
+    /* A single correctly rounded multiplication or division by an exact power
+     * of ten stays on the same side of every half-integer as the exact scaled
+     * value unless it lands on one, so rounding it to an integer gives the
+     * correctly rounded digits. Returns -1 wherever that does not apply. */
+    const double limit = 4503599627370496.0; /* 2^52 */
+    int i, k = 0, count, scale = prec;
+    double y;
+
+    if (mode == NK_DTOA_PRECISION) {
+        /* 10^(k-1) <= n < 10^k, estimated here and corrected below */
+        if (prec > 15) return -1;
+        if (n >= 1.0) {
+            for (k = 1; k < 23 && n >= nk_pow10_table[k]; ++k);
+        } else {
+            for (k = 0; k > -22 && n * nk_pow10_table[1-k] < 1.0; --k);
+        }
+        scale = prec - k;
+    }
+    for (i = 0; i < 3; ++i) {
+        if (scale > 22 || scale < -22) return -1;
+        if (scale >= 0)
+            y = n * nk_pow10_table[scale];
+        else y = n / nk_pow10_table[-scale];
+        if (y >= limit || !nk_dtoa_round(&y)) return -1;
+        if (mode != NK_DTOA_PRECISION) break;
+        if (y < nk_pow10_table[prec-1]) scale++;
+        else if (y > nk_pow10_table[prec]) scale--;
+        else break;
+    }
+    if (i == 3) return -1;
+    if (y == 0) return 0;
+    count = nk_dtoa_integer(digits, y);
+    *point = count - scale;
+    /* a carry into a new leading digit only adds a trailing zero */
+    return (mode == NK_DTOA_PRECISION) ? NK_MIN(count, prec): count;
+}
+NK_LIB int
+nk_dtoa_digits(char *digits, int max, int *point, double n,
+    enum nk_dtoa_mode mode, int prec)
 {
-    double m;
-    double neg = 1.0;
-    char *p = (char *)str;
-    double value = 0;
-    double number = 0;
+    struct nk_bignum r, s, mp, mm, t;
+    nk_uint hi, lo;
+    int i, d, e, k, even, count = 0;
 
-    NK_ASSERT(str);
-    if (!str) return 0;
+    NK_ASSERT(digits);
+    NK_ASSERT(point);
+    NK_ASSERT(n >= 0);
+    NK_ASSERT(max >= 17 || mode != NK_DTOA_SHORTEST);
+    *point = 1;
+    if (n <= 0) return 0;
+    if (mode != NK_DTOA_SHORTEST) {
+        count = nk_dtoa_fast(digits, point, n, mode, prec);
+        if (count >= 0 && count <= max) return count;
+    }
+
+    /* n = r/s with the distance to both neighbours at mm/s and mp/s. The gap
+     * below the smallest significand of a binade is half the one above it. */
+    e = nk_dtoa_split(n, &hi, &lo);
+    even = !(lo & 1);
+    nk_bignum_set(&r, hi, lo);
+    k = nk_dtoa_estimate(e + nk_bignum_bits(&r) - 1);
+    nk_bignum_set(&s, 0, 1);
+    nk_bignum_set(&mp, 0, 1);
+    if (e >= 0) nk_bignum_shl(&mp, e);
+    mm = mp;
+    if (hi == 0x100000 && !lo && e > -1074) {
+        nk_bignum_shl(&r, 2);
+        nk_bignum_shl(&s, 2);
+        nk_bignum_shl(&mp, 1);
+    } else {
+        nk_bignum_shl(&r, 1);
+        nk_bignum_shl(&s, 1);
+    }
+    if (e >= 0) nk_bignum_shl(&r, e);
+    else nk_bignum_shl(&s, -e);
 
-    /* skip whitespace */
-    while (*p == ' ') p++;
-    if (*p == '-') {
-        neg = -1.0;
-        p++;
+    /* scale by the estimated decimal exponent and correct it if short */
+    if (k >= 0) nk_bignum_mul_pow10(&s, k);
+    else {
+        nk_bignum_mul_pow10(&r, -k);
+        if (mode == NK_DTOA_SHORTEST) {
+            nk_bignum_mul_pow10(&mp, -k);
+            nk_bignum_mul_pow10(&mm, -k);
+        }
+    }
+    if (mode == NK_DTOA_SHORTEST)
+        nk_bignum_add(&t, &r, &mp);
+    else t = r;
+    d = nk_bignum_cmp(&t, &s);
+    if (d > 0 || (d == 0 && (even || mode != NK_DTOA_SHORTEST))) {
+        nk_bignum_mul(&s, 10);
+        k++;
+    }
+    d = nk_bignum_norm(&s);
+    nk_bignum_shl(&s, d);
+    nk_bignum_shl(&r, d);
+    *point = k;
+
+    if (mode == NK_DTOA_SHORTEST) {
+        /* stop as soon as the digits emitted so far identify `n` */
+        int low, high;
+        nk_bignum_shl(&mp, d);
+        nk_bignum_shl(&mm, d);
+        for (;;) {
+            nk_bignum_mul(&r, 10);
+            nk_bignum_mul(&mp, 10);
+            nk_bignum_mul(&mm, 10);
+            d = nk_bignum_digit(&r, &s);
+            i = nk_bignum_cmp(&r, &mm);
+            low = (i < 0 || (i == 0 && even));
+            nk_bignum_add(&t, &r, &mp);
+            i = nk_bignum_cmp(&t, &s);
+            high = (i > 0 || (i == 0 && even));
+            if (low || high) break;
+            digits[count++] = (char)('0' + d);
+        }
+        if (high && low) {
+            nk_bignum_shl(&r, 1);
+            high = (nk_bignum_cmp(&r, &s) >= 0);
+        }
+        digits[count++] = (char)('0' + d + high);
+        return count;
     }
 
-    while (*p && *p != '.' && *p != 'e') {
-        value = value * 10.0 + (double) (*p - '0');
-        p++;
+    /* fixed number of digits, rounded half to even on the exact remainder.
+     * Digits past `max` are rounded away and read back as zeros. */
+    count = (mode == NK_DTOA_FIXED) ? k + prec: prec;
+    count = NK_MIN(count, max);
+    if (count < 0) return 0;
+    for (i = 0; i < count; ++i) {
+        nk_bignum_mul(&r, 10);
+        digits[i] = (char)('0' + nk_bignum_digit(&r, &s));
+    }
+    nk_bignum_shl(&r, 1);
+    d = nk_bignum_cmp(&r, &s);
+    if (d > 0 || (d == 0 && count && (digits[count-1] & 1))) {
+        for (i = count-1; i >= 0 && digits[i] == '9'; --i)
+            digits[i] = '0';
+        if (i >= 0) digits[i]++;
+        else {
+            /* carried out of the first digit */
+            *point = k + 1;
+            if (!count || (mode == NK_DTOA_FIXED && count < max))
+                digits[count++] = '0';
+            digits[0] = '1';
+        }
     }
+    return count;
+}
+NK_INTERN int
+nk_strtod_cmp(const char *digits, int count, int exp10, struct nk_bignum *r, int e)
+{
+    /* compares 0.d1d2..dn * 10^exp10 with r * 2^e exactly by generating the
+     * decimal expansion of the latter until the two differ */
+    struct nk_bignum s;
+    int i, d, c, k;
+
+    k = nk_dtoa_estimate(e + nk_bignum_bits(r) - 1);
+    nk_bignum_set(&s, 0, 1);
+    if (e >= 0) nk_bignum_shl(r, e);
+    else nk_bignum_shl(&s, -e);
+    if (k >= 0) nk_bignum_mul_pow10(&s, k);
+    else nk_bignum_mul_pow10(r, -k);
+    if (nk_bignum_cmp(r, &s) >= 0) {
+        nk_bignum_mul(&s, 10);
+        k++;
+    }
+    if (k != exp10)
+        return (exp10 > k) ? 1: -1;
+
+    d = nk_bignum_norm(&s);
+    nk_bignum_shl(&s, d);
+    nk_bignum_shl(r, d);
+    for (i = 0; i < count; ++i, ++digits) {
+        if (*digits == '.') digits++;
+        nk_bignum_mul(r, 10);
+        d = nk_bignum_digit(r, &s);
+        c = *digits - '0';
+        if (c != d) return (c > d) ? 1: -1;
+    }
+    return r->n ? -1: 0;
+}
+NK_INTERN double
+nk_strtod_slow(const char *digits, int count, int exp10, double approx)
+{
+    /* walks a close approximation one ulp at a time until the decimal input
+     * lies between the midpoints to both of its neighbours */
+    struct nk_bignum m;
+    nk_uint hi, lo, phi, plo;
+    int e, c;
+
+    if (approx == 0) {
+        hi = lo = 0;
+        e = -1074;
+    } else if (approx - approx != 0) {
+        hi = 0x1FFFFF; lo = 0xFFFFFFFF;
+        e = 971;
+    } else e = nk_dtoa_split(approx, &hi, &lo);
 
-    if (*p == '.') {
-        p++;
-        for(m = 0.1; *p && *p != 'e'; p++ ) {
-            value = value + (double) (*p - '0') * m;
-            m *= 0.1;
+    for (;;) {
+        /* upper midpoint: (2f + 1) * 2^(e-1) */
+        nk_bignum_set(&m, hi << 1 | lo >> 31, lo << 1 | 1);
+        c = nk_strtod_cmp(digits, count, exp10, &m, e - 1);
+        if (c > 0 || (c == 0 && (lo & 1))) {
+            if (!++lo) hi++;
+            if (hi == 0x200000) {
+                hi = 0x100000;
+                e++;
+            }
+            if (e > 971) break;
+            continue;
+        }
+        if (!hi && !lo) break;
+
+        /* lower midpoint: (2f - 1) * 2^(e-1) or (4f - 1) * 2^(e-2) */
+        plo = lo - 1;
+        phi = lo ? hi: hi - 1;
+        if (hi == 0x100000 && !lo && e > -1074) {
+            nk_bignum_set(&m, phi << 2 | plo >> 30, plo << 2 | 3);
+            c = nk_strtod_cmp(digits, count, exp10, &m, e - 2);
+        } else {
+            nk_bignum_set(&m, phi << 1 | plo >> 31, plo << 1 | 1);
+            c = nk_strtod_cmp(digits, count, exp10, &m, e - 1);
+        }
+        if (c < 0 || (c == 0 && (lo & 1))) {
+            if (hi == 0x100000 && !lo && e > -1074) {
+                hi = 0x1FFFFF; lo = 0xFFFFFFFF;
+                e--;
+            } else {
+                hi = phi; lo = plo;
+            }
+            continue;
         }
+        break;
     }
-    if (*p == 'e') {
-        int i, pow, div;
-        p++;
-        if (*p == '-') {
-            div = nk_true;
-            p++;
-        } else if (*p == '+') {
-            div = nk_false;
-            p++;
-        } else div = nk_false;
+    return nk_dtoa_join(hi, lo, e);
+}
+NK_API double
+nk_strtod(const char *str, char **endptr)
+{
+    const char *p = str, *digits = 0;
+    double value = 0, mant = 0, exact = 0;
+    int neg = 0, dot = 0, any = 0;
+    int total = 0, count = 0, exp10 = 0;
 
-        for (pow = 0; *p; p++)
-            pow = pow * 10 + (int) (*p - '0');
+    NK_ASSERT(str);
+    if (!str) return 0;
 
-        for (m = 1.0, i = 0; i < pow; i++)
-            m *= 10.0;
+    /* skip whitespace */
+    while (*p == ' ') p++;
+    if (*p == '-' || *p == '+')
+        neg = (*p++ == '-');
 
-        if (div)
-            value /= m;
-        else value *= m;
+    /* significant digits: 0.d1d2..dn * 10^exp10 with trailing zeros cut */
+    for (;; ++p) {
+        if (*p == '.' && !dot) {
+            dot = 1;
+            continue;
+        }
+        if (*p < '0' || *p > '9') break;
+        any = 1;
+        if (!digits) {
+            if (*p == '0') {
+                exp10 -= dot;
+                continue;
+            }
+            digits = p;
+        }
+        total++;
+        if (!dot) exp10++;
+        if (total <= 19)
+            mant = mant * 10.0 + (double)(*p - '0');
+        if (*p != '0') {
+            count = total;
+            exact = mant;
+        }
+    }
+    if (!any) {
+        /* no digits: infinity, nan or no conversion at all */
+        if (!nk_stricmpn(p, "inf", 3)) {
+            p += nk_stricmpn(p + 3, "inity", 5) ? 3: 8;
+            value = nk_dtoa_join(0x100000, 0, 972);
+        } else if (!nk_stricmpn(p, "nan", 3)) {
+            p += 3;
+            value = nk_dtoa_join(0x100000, 0, 972);
+            value -= value;
+            /* infinity minus infinity may come out negative */
+            if (nk_dtoa_signbit(value))
+                value = -value;
+        } else p = str;
+        if (endptr) *endptr = (char*)p;
+        return neg ? -value: value;
+    }
+    if (*p == 'e' || *p == 'E') {
+        const char *q = p + 1;
+        int exp_neg = 0, exp = 0;
+        if (*q == '-' || *q == '+')
+            exp_neg = (*q++ == '-');
+        if (*q >= '0' && *q <= '9') {
+            for (; *q >= '0' && *q <= '9'; ++q)
+                if (exp < 100000) exp = exp * 10 + (*q - '0');
+            exp10 += exp_neg ? -exp: exp;
+            p = q;
+        }
     }
-    number = value * neg;
     if (endptr)
-        *endptr = p;
-    return number;
+        *endptr = (char*)p;
+
+    if (!count || exp10 < -323) {
+        value = 0;
+    } else if (exp10 > 309) {
+        value = nk_dtoa_join(0x100000, 0, 972);
+    } else if (count <= 15 && exp10 - count <= 22 && exp10 - count >= -22) {
+        /* both operands are exact so the single rounding is correct */
+        if (exp10 >= count)
+            value = exact * nk_pow10_table[exp10 - count];
+        else value = exact / nk_pow10_table[count - exp10];
+    } else {
+        int scale = exp10 - NK_MIN(total, 19);
+        for (value = mant; scale > 22; scale -= 22)
+            value *= 1e22;
+        for (; scale < -22; scale += 22)
+            value /= 1e22;
+        if (scale >= 0)
+            value *= nk_pow10_table[scale];
+        else value /= nk_pow10_table[-scale];
+        value = nk_strtod_slow(digits, count, exp10, value);
+    }
+    return neg ? -value: value;
 }
 NK_API float
 nk_strtof(const char *str, char **endptr)
@@ -7282,87 +8655,121 @@ nk_itoa(char *s, long n)
     nk_strrev_ascii(s);
     return s;
 }
+NK_INTERN int
+nk_dtoa_special(char *s, double n)
+{
+    /* nan and infinity have no digits to generate */
+    const char *str;
+    int len = 0;
+    if (n != n) str = "nan";
+    else if (n - n == 0) return 0;
+    else str = (n < 0) ? "-inf": "inf";
+    while (*str) s[len++] = *str++;
+    s[len] = '\0';
+    return len;
+}
+NK_INTERN int
+nk_dtoa_plain(char *s, const char *digits, int count, int point, int frac)
+{
+    /* writes 0.d1d2..dn * 10^point with exactly `frac` fractional digits */
+    int i, len = 0;
+    if (point <= 0)
+        s[len++] = '0';
+    for (i = 0; i < point; ++i)
+        s[len++] = (i < count) ? digits[i]: '0';
+    if (frac > 0)
+        s[len++] = '.';
+    for (i = point; i < point + frac; ++i)
+        s[len++] = (i >= 0 && i < count) ? digits[i]: '0';
+    s[len] = '\0';
+    return len;
+}
+NK_INTERN int
+nk_dtoa_exp(char *s, const char *digits, int count, int point, int frac,
+    int dot, char e)
+{
+    /* writes d.dd..e+XX with exactly `frac` fractional digits. The decimal
+     * point is also written without fractional digits if `dot` is set */
+    int i, len = 0;
+    int exp = (count) ? point - 1: 0;
+    s[len++] = (count) ? digits[0]: '0';
+    if (frac > 0 || dot)
+        s[len++] = '.';
+    for (i = 1; i <= frac; ++i)
+        s[len++] = (i < count) ? digits[i]: '0';
+    s[len++] = e;
+    s[len++] = (exp < 0) ? '-': '+';
+    if (exp < 0) exp = -exp;
+    if (exp >= 100)
+        s[len++] = (char)('0' + exp / 100);
+    s[len++] = (char)('0' + exp / 10 % 10);
+    s[len++] = (char)('0' + exp % 10);
+    s[len] = '\0';
+    return len;
+}
 #ifndef NK_DTOA
 #define NK_DTOA nk_dtoa
 NK_LIB char*
 nk_dtoa(char *s, double n)
 {
-    int useExp = 0;
-    int digit = 0, m = 0, m1 = 0;
+    /* shortest string that reads back as `n` */
+    char digits[NK_DTOA_DIGITS];
+    int count, point;
     char *c = s;
-    int neg = 0;
 
     NK_ASSERT(s);
     if (!s) return 0;
-
-    if (n == 0.0) {
-        s[0] = '0'; s[1] = '\0';
+    if (nk_dtoa_special(s, n))
         return s;
+    if (n < 0) {
+        *(c++) = '-';
+        n = -n;
     }
+    count = nk_dtoa_digits(digits, NK_DTOA_DIGITS, &point, n, NK_DTOA_SHORTEST, 0);
+    if (point > 14 || point < -7)
+        nk_dtoa_exp(c, digits, count, point, count-1, nk_false, 'e');
+    else nk_dtoa_plain(c, digits, count, point, NK_MAX(count - point, 0));
+    return s;
+}
+#endif
+NK_LIB int
+nk_dtoa_fixed(char *s, double n, int prec)
+{
+    /* `n` correctly rounded to at most `prec` fractional digits without
+     * trailing zeros. Magnitudes of 1e15 and up are left to NK_DTOA. */
+#ifdef NK_DTOA_USER_DEFINED
+    /* a user supplied conversion is only cut down to `prec` digits */
+    NK_ASSERT(s);
+    if (!s) return 0;
+    NK_DTOA(s, n);
+    return nk_string_float_limit(s, prec);
+#else
+    char digits[NK_MAX_NUMBER_BUFFER];
+    int len = 0, count, point;
 
-    neg = (n < 0);
-    if (neg) n = -n;
-
-    /* calculate magnitude */
-    m = nk_log10(n);
-    useExp = (m >= 14 || (neg && m >= 9) || m <= -9);
-    if (neg) *(c++) = '-';
-
-    /* set up for scientific notation */
-    if (useExp) {
-        if (m < 0)
-           m -= 1;
-        n = n / (double)nk_pow(10.0, m);
-        m1 = m;
-        m = 0;
-    }
-    if (m < 1.0) {
-        m = 0;
+    NK_ASSERT(s);
+    NK_ASSERT(prec >= 0 && prec <= NK_MAX_NUMBER_BUFFER - 20);
+    if (!s) return 0;
+    if ((len = nk_dtoa_special(s, n)) != 0)
+        return len;
+    if (n >= 1e15 || n <= -1e15) {
+        NK_DTOA(s, n);
+        return nk_strlen(s);
     }
-
-    /* convert the number */
-    while (n > NK_FLOAT_PRECISION || m >= 0) {
-        double weight = nk_pow(10.0, m);
-        if (weight > 0) {
-            double t = (double)n / weight;
-            digit = nk_ifloord(t);
-            n -= ((double)digit * weight);
-            *(c++) = (char)('0' + (char)digit);
-        }
-        if (m == 0 && n > 0)
-            *(c++) = '.';
-        m--;
+    if (n < 0) {
+        s[len++] = '-';
+        n = -n;
     }
-
-    if (useExp) {
-        /* convert the exponent */
-        int i, j;
-        *(c++) = 'e';
-        if (m1 > 0) {
-            *(c++) = '+';
-        } else {
-            *(c++) = '-';
-            m1 = -m1;
-        }
-        m = 0;
-        while (m1 > 0) {
-            *(c++) = (char)('0' + (char)(m1 % 10));
-            m1 /= 10;
-            m++;
-        }
-        c -= m;
-        for (i = 0, j = m-1; i<j; i++, j--) {
-            /* swap without temporary */
-            c[i] ^= c[j];
-            c[j] ^= c[i];
-            c[i] ^= c[j];
-        }
-        c += m;
+    count = nk_dtoa_digits(digits, (int)sizeof(digits), &point, n, NK_DTOA_FIXED, prec);
+    while (count > 0 && digits[count-1] == '0')
+        count--;
+    if (!count) {
+        s[0] = '0'; s[1] = '\0';
+        return 1;
     }
-    *(c) = '\0';
-    return s;
-}
+    return len + nk_dtoa_plain(s + len, digits, count, point, NK_MAX(count - point, 0));
 #endif
+}
 #ifdef NK_INCLUDE_STANDARD_VARARGS
 #ifndef NK_INCLUDE_STANDARD_IO
 NK_INTERN int
@@ -7610,31 +9017,69 @@ nk_vsnprintf(char *buf, int buf_size, const char *fmt, va_list args)
                 while ((padding-- > 0) && (len < buf_size))
                     buf[len++] = ' ';
             }
-        } else if (*iter == 'f') {
-            /* floating point */
-            const char *num_iter;
-            int cur_precision = (precision < 0) ? 6: precision;
-            int prefix, cur_width = NK_MAX(width, 0);
+        } else if (*iter == 'f' || *iter == 'e' || *iter == 'E' ||
+                   *iter == 'g' || *iter == 'G') {
+            /* floating point: digits are correctly rounded, numbers that do
+             * not fit the number buffer in `f` notation fall back to `e` */
+            char digits[NK_MAX_NUMBER_BUFFER];
+            const char *num_iter = number_buffer;
+            int cur_precision = (precision < 0) ? 6: NK_MIN(precision, NK_MAX_NUMBER_BUFFER/2);
+            int cur_width = NK_MAX(width, 0);
             double value = va_arg(args, double);
-            int num_len = 0, frac_len = 0, dot = 0;
-            int padding = 0;
+            int num_len = 0, count, point, padding;
+            char spec = *iter;
 
             NK_ASSERT(arg_type == NK_ARG_TYPE_DEFAULT);
-            NK_DTOA(number_buffer, value);
-            num_len = nk_strlen(number_buffer);
-
-            /* calculate padding */
-            num_iter = number_buffer;
-            while (*num_iter && *num_iter != '.')
-                num_iter++;
-
-            prefix = (*num_iter == '.')?(int)(num_iter - number_buffer)+1:0;
-            padding = NK_MAX(cur_width - (prefix + NK_MIN(cur_precision, num_len - prefix)) , 0);
-            if ((flag & NK_ARG_FLAG_PLUS) || (flag & NK_ARG_FLAG_SPACE))
-                padding = NK_MAX(padding-1, 0);
+            if (nk_dtoa_signbit(value)) {
+                /* includes negative zero */
+                number_buffer[num_len++] = '-';
+                value = -value;
+            } else if (flag & NK_ARG_FLAG_PLUS) {
+                number_buffer[num_len++] = '+';
+            } else if (flag & NK_ARG_FLAG_SPACE) {
+                number_buffer[num_len++] = ' ';
+            }
+            if (nk_dtoa_special(number_buffer + num_len, value)) {
+                num_len = nk_strlen(number_buffer);
+                flag &= ~(nk_flags)NK_ARG_FLAG_ZERO;
+            } else if (spec == 'f' && value < 1e25) {
+                count = nk_dtoa_digits(digits, NK_MAX_NUMBER_BUFFER, &point, value, NK_DTOA_FIXED, cur_precision);
+                num_len += nk_dtoa_plain(number_buffer + num_len, digits, count, point, cur_precision);
+                if (!cur_precision && (flag & NK_ARG_FLAG_NUM)) {
+                    number_buffer[num_len++] = '.';
+                    number_buffer[num_len] = '\0';
+                }
+            } else if (spec == 'g' || spec == 'G') {
+                int sig = NK_MAX(cur_precision, 1), exp;
+                count = nk_dtoa_digits(digits, NK_MAX_NUMBER_BUFFER, &point, value, NK_DTOA_PRECISION, sig);
+                exp = point - 1;
+                if (!(flag & NK_ARG_FLAG_NUM)) {
+                    while (count > 0 && digits[count-1] == '0')
+                        count--;
+                }
+                if (exp < -4 || exp >= sig) {
+                    num_len += nk_dtoa_exp(number_buffer + num_len, digits, count, point,
+                        (flag & NK_ARG_FLAG_NUM) ? sig - 1: NK_MAX(count - 1, 0),
+                        (flag & NK_ARG_FLAG_NUM) != 0, (spec == 'G') ? 'E': 'e');
+                } else {
+                    num_len += nk_dtoa_plain(number_buffer + num_len, digits, count, point,
+                        (flag & NK_ARG_FLAG_NUM) ? sig - 1 - exp: NK_MAX(count - point, 0));
+                    if (sig - 1 == exp && (flag & NK_ARG_FLAG_NUM)) {
+                        number_buffer[num_len++] = '.';
+                        number_buffer[num_len] = '\0';
+                    }
+                }
+            } else {
+                count = nk_dtoa_digits(digits, NK_MAX_NUMBER_BUFFER, &point, value, NK_DTOA_PRECISION, cur_precision + 1);
+                num_len += nk_dtoa_exp(number_buffer + num_len, digits, count, point,
+                    cur_precision, (flag & NK_ARG_FLAG_NUM) != 0, (spec == 'E') ? 'E': 'e');
+            }
+            padding = NK_MAX(cur_width - num_len, 0);
 
             /* fill left padding up to a total of `width` characters */
             if (!(flag & NK_ARG_FLAG_LEFT)) {
+                if ((flag & NK_ARG_FLAG_ZERO) && (*num_iter < '0') && (len < buf_size))
+                    buf[len++] = *num_iter++;
                 while (padding-- > 0 && (len < buf_size)) {
                     if (flag & NK_ARG_FLAG_ZERO)
                         buf[len++] = '0';
@@ -7643,30 +9088,8 @@ nk_vsnprintf(char *buf, int buf_size, const char *fmt, va_list args)
             }
 
             /* copy string value representation into buffer */
-            num_iter = number_buffer;
-            if ((flag & NK_ARG_FLAG_PLUS) && (value >= 0) && (len < buf_size))
-                buf[len++] = '+';
-            else if ((flag & NK_ARG_FLAG_SPACE) && (value >= 0) && (len < buf_size))
-                buf[len++] = ' ';
-            while (*num_iter) {
-                if (dot) frac_len++;
-                if (len < buf_size)
-                    buf[len++] = *num_iter;
-                if (*num_iter == '.') dot = 1;
-                if (frac_len >= cur_precision) break;
-                num_iter++;
-            }
-
-            /* fill number up to precision */
-            while (frac_len < cur_precision) {
-                if (!dot && len < buf_size) {
-                    buf[len++] = '.';
-                    dot = 1;
-                }
-                if (len < buf_size)
-                    buf[len++] = '0';
-                frac_len++;
-            }
+            while (*num_iter && (len < buf_size))
+                buf[len++] = *num_iter++;
 
             /* fill right padding up to width characters */
             if (flag & NK_ARG_FLAG_LEFT) {
@@ -7674,7 +9097,7 @@ nk_vsnprintf(char *buf, int buf_size, const char *fmt, va_list args)
                     buf[len++] = ' ';
             }
         } else {
-            /* Specifier not supported: g,G,e,E,p,z */
+            /* Specifier not supported: p,z */
             NK_ASSERT(0 && "specifier is not supported!");
             return result;
         }
@@ -8380,6 +9803,10 @@ nk_utf_decode(const char *c, nk_rune *u, int clen)
 
     if (!c || !u) return 0;
     if (!clen) return 0;
+    if (!((nk_byte)c[0] & 0x80)) {
+        *u = (nk_byte)c[0];
+        return 1;
+    }
     *u = NK_UTF_INVALID;
 
     udecoded = nk_utf_decode_byte(c[0], &len);
@@ -8397,13 +9824,51 @@ nk_utf_decode(const char *c, nk_rune *u, int clen)
     nk_utf_validate(u, len);
     return len;
 }
-NK_INTERN char
-nk_utf_encode_byte(nk_rune u, int i)
+NK_INTERN int
+nk_utf_ascii_block(const char *c)
 {
-    return (char)((nk_utfbyte[i]) | ((nk_byte)u & ~nk_utfmask[i]));
+    /* written as a plain reduction so compilers can vectorize it */
+    nk_byte bits = 0;
+    int i;
+    for (i = 0; i < NK_UTF_BLOCK; ++i)
+        bits |= (nk_byte)c[i];
+    return !(bits & 0x80);
 }
 NK_API int
-nk_utf_encode(nk_rune u, char *c, int clen)
+nk_utf_decode_run(const char *text, int byte_len, nk_rune *runes,
+    int max_runes, int *decoded_len)
+{
+    int count = 0, len = 0, glyph_len, i;
+
+    NK_ASSERT(text);
+    NK_ASSERT(runes);
+    NK_ASSERT(decoded_len);
+
+    if (!text || !runes || !decoded_len) return 0;
+    while (count < max_runes && len < byte_len) {
+        if (max_runes - count >= NK_UTF_BLOCK && byte_len - len >= NK_UTF_BLOCK &&
+            nk_utf_ascii_block(text + len)) {
+            for (i = 0; i < NK_UTF_BLOCK; ++i)
+                runes[count + i] = (nk_byte)text[len + i];
+            count += NK_UTF_BLOCK;
+            len += NK_UTF_BLOCK;
+            continue;
+        }
+        glyph_len = nk_utf_decode(text + len, &runes[count], byte_len - len);
+        if (!glyph_len) break;
+        len += glyph_len;
+        if (runes[count++] == NK_UTF_INVALID) break;
+    }
+    *decoded_len = len;
+    return count;
+}
+NK_INTERN char
+nk_utf_encode_byte(nk_rune u, int i)
+{
+    return (char)((nk_utfbyte[i]) | ((nk_byte)u & ~nk_utfmask[i]));
+}
+NK_API int
+nk_utf_encode(nk_rune u, char *c, int clen)
 {
     int len, i;
     len = nk_utf_validate(&u, 0);
@@ -8420,23 +9885,19 @@ nk_utf_encode(nk_rune u, char *c, int clen)
 NK_API int
 nk_utf_len(const char *str, int len)
 {
-    const char *text;
+    nk_rune runes[NK_UTF_RUN];
     int glyphs = 0;
-    int text_len;
-    int glyph_len;
     int src_len = 0;
-    nk_rune unicode;
+    int run_len;
 
     NK_ASSERT(str);
     if (!str || !len) return 0;
 
-    text = str;
-    text_len = len;
-    glyph_len = nk_utf_decode(text, &unicode, text_len);
-    while (glyph_len && src_len < len) {
-        glyphs++;
-        src_len = src_len + glyph_len;
-        glyph_len = nk_utf_decode(text + src_len, &unicode, text_len - src_len);
+    while (src_len < len) {
+        glyphs += nk_utf_decode_run(str + src_len, len - src_len, runes,
+            (int)NK_LEN(runes), &run_len);
+        if (!run_len) break;
+        src_len += run_len;
     }
     return glyphs;
 }
@@ -8543,6 +10004,20 @@ nk_buffer_init_fixed(struct nk_buffer *b, void *m, nk_size size)
     b->memory.size = size;
     b->size = size;
 }
+NK_API void
+nk_buffer_init_segmented(struct nk_buffer *b, const struct nk_allocator *a,
+    nk_size segment_size)
+{
+    NK_ASSERT(b);
+    NK_ASSERT(a);
+    NK_ASSERT(segment_size);
+    if (!b || !a || !segment_size) return;
+
+    nk_zero(b, sizeof(*b));
+    b->type = NK_BUFFER_SEGMENTED;
+    b->segment_size = segment_size;
+    b->pool = *a;
+}
 NK_LIB void*
 nk_buffer_align(void *unaligned,
     nk_size align, nk_size *alignment,
@@ -8611,6 +10086,101 @@ nk_buffer_realloc(struct nk_buffer *b, nk_size capacity, nk_size *size)
     }
     return temp;
 }
+NK_INTERN nk_bool
+nk_buffer_add_segment(struct nk_buffer *b)
+{
+    void **segments;
+    void *segment;
+    nk_size capacity;
+
+    NK_ASSERT(b->pool.alloc && b->pool.free);
+    if (!b->pool.alloc || !b->pool.free)
+        return nk_false;
+
+    /* grow segment table which only holds pointers so copying is cheap */
+    capacity = b->segments.size / sizeof(void*);
+    if (b->segment_count >= capacity) {
+        void *table;
+        capacity = NK_MAX(8, capacity * 2);
+        table = b->pool.alloc(b->pool.userdata, b->segments.ptr, capacity * sizeof(void*));
+        NK_ASSERT(table);
+        if (!table) return nk_false;
+        if (b->segments.ptr) {
+            NK_MEMCPY(table, b->segments.ptr, b->segment_count * sizeof(void*));
+            b->pool.free(b->pool.userdata, b->segments.ptr);
+        }
+        b->segments.ptr = table;
+        b->segments.size = capacity * sizeof(void*);
+    }
+    segment = b->pool.alloc(b->pool.userdata, 0, b->segment_size);
+    NK_ASSERT(segment);
+    if (!segment) return nk_false;
+
+    segments = (void**)b->segments.ptr;
+    segments[b->segment_count++] = segment;
+    b->memory.size += b->segment_size;
+    b->size = b->memory.size;
+    return nk_true;
+}
+NK_INTERN void*
+nk_buffer_alloc_segmented(struct nk_buffer *b, enum nk_buffer_allocation_type type,
+    nk_size size, nk_size align)
+{
+    nk_size alignment = 0;
+    void *memory = 0;
+
+    /* segments are only filled front to back and allocations never cross
+     * segment borders so every offset stays valid until the buffer is cleared */
+    NK_ASSERT(type == NK_BUFFER_FRONT);
+    NK_ASSERT(size <= b->segment_size);
+    if (type != NK_BUFFER_FRONT || size > b->segment_size)
+        return 0;
+    b->needed += size;
+
+    for (;;) {
+        nk_size index = b->allocated / b->segment_size;
+        nk_size offset = b->allocated % b->segment_size;
+        void *unaligned;
+
+        if (index >= b->segment_count && !nk_buffer_add_segment(b))
+            return 0;
+        unaligned = nk_ptr_add(void, ((void**)b->segments.ptr)[index], offset);
+        memory = nk_buffer_align(unaligned, align, &alignment, type);
+        if (offset + alignment + size <= b->segment_size)
+            break;
+        if (!offset) return 0;
+        /* continue at the beginning of the next segment */
+        b->allocated = (index + 1) * b->segment_size;
+    }
+    b->allocated += size + alignment;
+    b->needed += alignment;
+    b->calls++;
+    return memory;
+}
+NK_LIB nk_size
+nk_buffer_segment_left(const struct nk_buffer *b)
+{
+    NK_ASSERT(b->type == NK_BUFFER_SEGMENTED);
+    return b->segment_size - (b->allocated % b->segment_size);
+}
+NK_LIB nk_size
+nk_buffer_segment_next(struct nk_buffer *b)
+{
+    NK_ASSERT(b->type == NK_BUFFER_SEGMENTED);
+    b->allocated = (b->allocated / b->segment_size + 1) * b->segment_size;
+    return b->allocated;
+}
+NK_LIB void*
+nk_buffer_memory_at(const struct nk_buffer *b, nk_size offset)
+{
+    NK_ASSERT(b);
+    if (b->type == NK_BUFFER_SEGMENTED) {
+        void **segments = (void**)b->segments.ptr;
+        NK_ASSERT(offset / b->segment_size < b->segment_count);
+        return nk_ptr_add(void, segments[offset / b->segment_size], offset % b->segment_size);
+    }
+    return nk_ptr_add(void, b->memory.ptr, offset);
+}
 NK_LIB void*
 nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type,
     nk_size size, nk_size align)
@@ -8623,6 +10193,8 @@ nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type,
     NK_ASSERT(b);
     NK_ASSERT(size);
     if (!b || !size) return 0;
+    if (b->type == NK_BUFFER_SEGMENTED)
+        return nk_buffer_alloc_segmented(b, type, size, align);
     b->needed += size;
 
     /* calculate total size with needed alignment + size */
@@ -8716,7 +10288,20 @@ NK_API void
 nk_buffer_free(struct nk_buffer *b)
 {
     NK_ASSERT(b);
-    if (!b || !b->memory.ptr) return;
+    if (!b) return;
+    if (b->type == NK_BUFFER_SEGMENTED) {
+        nk_size i;
+        void **segments = (void**)b->segments.ptr;
+        if (!b->pool.free || !segments) return;
+        for (i = 0; i < b->segment_count; ++i)
+            b->pool.free(b->pool.userdata, segments[i]);
+        b->pool.free(b->pool.userdata, segments);
+        b->segments.ptr = 0;
+        b->segments.size = 0;
+        b->segment_count = 0;
+        return;
+    }
+    if (!b->memory.ptr) return;
     if (b->type == NK_BUFFER_FIXED) return;
     if (!b->pool.free) return;
     NK_ASSERT(b->pool.free);
@@ -9225,6 +10810,9 @@ nk_command_buffer_init(struct nk_command_buffer *cb,
     cb->begin = b->allocated;
     cb->end = b->allocated;
     cb->last = b->allocated;
+#ifdef NK_INCLUDE_FRAME_STATS
+    cb->stats = 0;
+#endif
 }
 NK_LIB void
 nk_command_buffer_reset(struct nk_command_buffer *b)
@@ -9252,11 +10840,27 @@ nk_command_buffer_push(struct nk_command_buffer* b,
     NK_ASSERT(b);
     NK_ASSERT(b->base);
     if (!b) return 0;
+    if (b->base->type == NK_BUFFER_SEGMENTED) {
+        /* commands cannot cross segment borders. Therefore each segment always
+         * keeps enough space for a NOP command linking to the next segment */
+        const nk_size link_size = sizeof(struct nk_command) + align;
+        if (size + align + link_size > b->base->segment_size)
+            return 0;
+        if (nk_buffer_segment_left(b->base) < size + align + link_size) {
+            cmd = (struct nk_command*)nk_buffer_alloc(b->base, NK_BUFFER_FRONT, sizeof(*cmd), align);
+            if (!cmd) return 0;
+            cmd->type = NK_COMMAND_NOP;
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+            cmd->userdata = b->userdata;
+#endif
+            cmd->next = nk_buffer_segment_next(b->base);
+        }
+    }
     cmd = (struct nk_command*)nk_buffer_alloc(b->base,NK_BUFFER_FRONT,size,align);
     if (!cmd) return 0;
 
     /* make sure the offset to the next command is aligned */
-    b->last = (nk_size)((nk_byte*)cmd - (nk_byte*)b->base->memory.ptr);
+    b->last = b->base->allocated - size;
     unaligned = (nk_byte*)cmd + size;
     memory = NK_ALIGN_PTR(unaligned, align);
     alignment = (nk_size)((nk_byte*)memory - (nk_byte*)unaligned);
@@ -9270,8 +10874,48 @@ nk_command_buffer_push(struct nk_command_buffer* b,
     cmd->userdata = b->userdata;
 #endif
     b->end = cmd->next;
+#ifdef NK_INCLUDE_FRAME_STATS
+    if (b->stats) {
+        b->stats->commands[t]++;
+        b->stats->command_bytes += size;
+    }
+#endif
     return cmd;
 }
+NK_LIB nk_size
+nk_command_size(const struct nk_command *cmd)
+{
+    /* same sizes as passed to `nk_command_buffer_push` by the draw functions */
+    switch (cmd->type) {
+    case NK_COMMAND_SCISSOR: return sizeof(struct nk_command_scissor);
+    case NK_COMMAND_LINE: return sizeof(struct nk_command_line);
+    case NK_COMMAND_CURVE: return sizeof(struct nk_command_curve);
+    case NK_COMMAND_RECT: return sizeof(struct nk_command_rect);
+    case NK_COMMAND_RECT_FILLED: return sizeof(struct nk_command_rect_filled);
+    case NK_COMMAND_RECT_MULTI_COLOR: return sizeof(struct nk_command_rect_multi_color);
+    case NK_COMMAND_CIRCLE: return sizeof(struct nk_command_circle);
+    case NK_COMMAND_CIRCLE_FILLED: return sizeof(struct nk_command_circle_filled);
+    case NK_COMMAND_ARC: return sizeof(struct nk_command_arc);
+    case NK_COMMAND_ARC_FILLED: return sizeof(struct nk_command_arc_filled);
+    case NK_COMMAND_TRIANGLE: return sizeof(struct nk_command_triangle);
+    case NK_COMMAND_TRIANGLE_FILLED: return sizeof(struct nk_command_triangle_filled);
+    case NK_COMMAND_POLYGON:
+        return sizeof(struct nk_command_polygon) + sizeof(short) * 2 *
+            (nk_size)((const struct nk_command_polygon*)cmd)->point_count;
+    case NK_COMMAND_POLYGON_FILLED:
+        return sizeof(struct nk_command_polygon_filled) + sizeof(short) * 2 *
+            (nk_size)((const struct nk_command_polygon_filled*)cmd)->point_count;
+    case NK_COMMAND_POLYLINE:
+        return sizeof(struct nk_command_polyline) + sizeof(short) * 2 *
+            (nk_size)((const struct nk_command_polyline*)cmd)->point_count;
+    case NK_COMMAND_TEXT:
+        return sizeof(struct nk_command_text) +
+            (nk_size)(((const struct nk_command_text*)cmd)->length + 1);
+    case NK_COMMAND_IMAGE: return sizeof(struct nk_command_image);
+    case NK_COMMAND_CUSTOM: return sizeof(struct nk_command_custom);
+    default: return sizeof(struct nk_command);
+    }
+}
 NK_API void
 nk_push_scissor(struct nk_command_buffer *b, struct nk_rect r)
 {
@@ -9726,7 +11370,13 @@ nk_draw_text(struct nk_command_buffer *b, struct nk_rect r,
     const char *string, int length, const struct nk_user_font *font,
     struct nk_color bg, struct nk_color fg)
 {
-    float text_width = 0;
+    nk_draw_text_measured(b, r, string, length, -1.0f, font, bg, fg);
+}
+NK_LIB void
+nk_draw_text_measured(struct nk_command_buffer *b, struct nk_rect r,
+    const char *string, int length, float text_width,
+    const struct nk_user_font *font, struct nk_color bg, struct nk_color fg)
+{
     struct nk_command_text *cmd;
 
     NK_ASSERT(b);
@@ -9738,12 +11388,16 @@ nk_draw_text(struct nk_command_buffer *b, struct nk_rect r,
             return;
     }
 
-    /* make sure text fits inside bounds */
-    text_width = font->width(font->userdata, font->height, string, length);
+    /* make sure text fits inside bounds, a negative width is measured here */
+    if (text_width < 0) {
+        text_width = font->width(font->userdata, font->height, string, length);
+        NK_STATS_ADD(b, text_measurements, 1);
+    }
     if (text_width > r.w){
         int glyphs = 0;
         float txt_width = (float)text_width;
         length = nk_text_clamp(font, string, length, r.w, &glyphs, &txt_width, 0,0);
+        NK_STATS_ADD(b, text_measurements, glyphs);
     }
 
     if (!length) return;
@@ -9779,11 +11433,13 @@ nk_draw_list_init(struct nk_draw_list *list)
     NK_ASSERT(list);
     if (!list) return;
     nk_zero(list, sizeof(*list));
-    for (i = 0; i < NK_LEN(list->circle_vtx); ++i) {
-        const float a = ((float)i / (float)NK_LEN(list->circle_vtx)) * 2 * NK_PI;
-        list->circle_vtx[i].x = (float)NK_COS(a);
-        list->circle_vtx[i].y = (float)NK_SIN(a);
+    for (i = 0; i < NK_LEN(list->circle_table); ++i) {
+        const float a = ((float)i / (float)NK_LEN(list->circle_table)) * 2 * NK_PI;
+        list->circle_table[i].x = (float)NK_COS(a);
+        list->circle_table[i].y = (float)NK_SIN(a);
     }
+    for (i = 0; i < NK_LEN(list->circle_vtx); ++i)
+        list->circle_vtx[i] = list->circle_table[i * (NK_LEN(list->circle_table)/NK_LEN(list->circle_vtx))];
 }
 NK_API void
 nk_draw_list_setup(struct nk_draw_list *canvas, const struct nk_convert_config *config,
@@ -10584,6 +12240,100 @@ nk_draw_list_path_arc_to_fast(struct nk_draw_list *list, struct nk_vec2 center,
         }
     }
 }
+NK_INTERN float
+nk_draw_list_circle_error_segments(const struct nk_draw_list *list, float radius)
+{
+    /* A chord spanning the angle `a` deviates at most r*(1-cos(a/2)) <= r*a*a/8
+     * from its circle, so PI*sqrt(r/(2*e)) segments per full circle keep the
+     * outline within the configured error `e`. */
+    float n;
+    NK_ASSERT(list->config.max_segment_error > 0.0f);
+    if (radius <= 0.0f) return 1.0f;
+    n = radius / (2.0f * list->config.max_segment_error);
+    return NK_PI * n * NK_INV_SQRT(n);
+}
+NK_INTERN unsigned int
+nk_draw_list_circle_table_stride(const struct nk_draw_list *list, float radius,
+    unsigned int span)
+{
+    /* returns the distance in circle table entries between two points so that
+     * `span` entries are split into evenly spaced segments which still stay
+     * within the configured error. At least three segments are used so tiny
+     * circles and corners do not collapse into a point or a line */
+    unsigned int count;
+    float n = nk_draw_list_circle_error_segments(list, radius);
+    n = n * (float)span / (float)NK_DRAW_LIST_CIRCLE_TABLE_SIZE;
+    n = NK_MIN(n, (float)span);
+    count = (n < 3.0f) ? 3: (unsigned int)n + (((float)(unsigned int)n < n) ? 1: 0);
+    count = NK_MIN(count, span);
+    for (; count < span; ++count)
+        if (span % count == 0) return span / count;
+    return 1;
+}
+NK_INTERN void
+nk_draw_list_path_arc_to_table(struct nk_draw_list *list, struct nk_vec2 center,
+    float radius, unsigned int first, unsigned int count, unsigned int stride)
+{
+    unsigned int i;
+    struct nk_vec2 *points;
+    const struct nk_vec2 *table = list->circle_table;
+    NK_ASSERT(count);
+    if (!count) return;
+
+    first %= NK_DRAW_LIST_CIRCLE_TABLE_SIZE;
+    nk_draw_list_path_line_to(list, nk_vec2(center.x + table[first].x * radius,
+        center.y + table[first].y * radius));
+    if (count == 1) return;
+
+    points = nk_draw_list_alloc_path(list, (int)count - 1);
+    if (!points) return;
+    for (i = 1; i < count; ++i) {
+        const struct nk_vec2 c = table[(first + i * stride) % NK_DRAW_LIST_CIRCLE_TABLE_SIZE];
+        points[i-1].x = center.x + c.x * radius;
+        points[i-1].y = center.y + c.y * radius;
+    }
+}
+NK_INTERN unsigned int
+nk_draw_list_circle_segments(const struct nk_draw_list *list, float radius,
+    unsigned int segments)
+{
+    if (list->config.max_segment_error <= 0.0f)
+        return segments;
+    return NK_DRAW_LIST_CIRCLE_TABLE_SIZE /
+        nk_draw_list_circle_table_stride(list, radius, NK_DRAW_LIST_CIRCLE_TABLE_SIZE);
+}
+NK_INTERN unsigned int
+nk_draw_list_arc_segments(const struct nk_draw_list *list, float radius,
+    float a_min, float a_max, unsigned int segments)
+{
+    float n;
+    if (list->config.max_segment_error <= 0.0f)
+        return segments;
+    n = nk_draw_list_circle_error_segments(list, radius);
+    n = n * NK_ABS(a_max - a_min) / (2.0f * NK_PI);
+    n = NK_MIN(n, (float)(NK_DRAW_LIST_CIRCLE_TABLE_SIZE - 1));
+    return (unsigned int)n + 1;
+}
+NK_INTERN unsigned int
+nk_draw_list_curve_segments(const struct nk_draw_list *list, struct nk_vec2 p0,
+    struct nk_vec2 p1, struct nk_vec2 p2, struct nk_vec2 p3, unsigned int segments)
+{
+    /* Wang's formula: a cubic bezier split into n uniform steps stays within `e`
+     * of the curve for n >= sqrt(3/4 * M / e) with M being the largest second
+     * difference of its control points. */
+    float dx0, dy0, dx1, dy1, m, n;
+    if (list->config.max_segment_error <= 0.0f)
+        return segments;
+    dx0 = p0.x - 2.0f * p1.x + p2.x; dy0 = p0.y - 2.0f * p1.y + p2.y;
+    dx1 = p1.x - 2.0f * p2.x + p3.x; dy1 = p1.y - 2.0f * p2.y + p3.y;
+    m = NK_MAX(dx0*dx0 + dy0*dy0, dx1*dx1 + dy1*dy1);
+    if (m <= 0.0f) return 1;
+    m = m * NK_INV_SQRT(m);
+    n = 0.75f * m / list->config.max_segment_error;
+    n = n * NK_INV_SQRT(n);
+    n = NK_MIN(n, (float)(NK_DRAW_LIST_CIRCLE_TABLE_SIZE - 1));
+    return (unsigned int)n + 1;
+}
 NK_API void
 nk_draw_list_path_arc_to(struct nk_draw_list *list, struct nk_vec2 center,
     float radius, float a_min, float a_max, unsigned int segments)
@@ -10645,6 +12395,14 @@ nk_draw_list_path_rect_to(struct nk_draw_list *list, struct nk_vec2 a,
         nk_draw_list_path_line_to(list, nk_vec2(b.x,a.y));
         nk_draw_list_path_line_to(list, b);
         nk_draw_list_path_line_to(list, nk_vec2(a.x,b.y));
+    } else if (list->config.max_segment_error > 0.0f) {
+        const unsigned int quarter = NK_DRAW_LIST_CIRCLE_TABLE_SIZE/4;
+        const unsigned int stride = nk_draw_list_circle_table_stride(list, r, quarter);
+        const unsigned int count = quarter / stride + 1;
+        nk_draw_list_path_arc_to_table(list, nk_vec2(a.x + r, a.y + r), r, 2*quarter, count, stride);
+        nk_draw_list_path_arc_to_table(list, nk_vec2(b.x - r, a.y + r), r, 3*quarter, count, stride);
+        nk_draw_list_path_arc_to_table(list, nk_vec2(b.x - r, b.y - r), r, 0, count, stride);
+        nk_draw_list_path_arc_to_table(list, nk_vec2(a.x + r, b.y - r), r, quarter, count, stride);
     } else {
         nk_draw_list_path_arc_to_fast(list, nk_vec2(a.x + r, a.y + r), r, 6, 9);
         nk_draw_list_path_arc_to_fast(list, nk_vec2(b.x - r, a.y + r), r, 9, 12);
@@ -10808,8 +12566,13 @@ nk_draw_list_fill_circle(struct nk_draw_list *list, struct nk_vec2 center,
     float a_max;
     NK_ASSERT(list);
     if (!list || !col.a) return;
-    a_max = NK_PI * 2.0f * ((float)segs - 1.0f) / (float)segs;
-    nk_draw_list_path_arc_to(list, center, radius, 0.0f, a_max, segs);
+    if (segs && NK_DRAW_LIST_CIRCLE_TABLE_SIZE % segs == 0) {
+        nk_draw_list_path_arc_to_table(list, center, radius, 0, segs,
+            NK_DRAW_LIST_CIRCLE_TABLE_SIZE / segs);
+    } else {
+        a_max = NK_PI * 2.0f * ((float)segs - 1.0f) / (float)segs;
+        nk_draw_list_path_arc_to(list, center, radius, 0.0f, a_max, segs);
+    }
     nk_draw_list_path_fill(list, col);
 }
 NK_API void
@@ -10819,8 +12582,13 @@ nk_draw_list_stroke_circle(struct nk_draw_list *list, struct nk_vec2 center,
     float a_max;
     NK_ASSERT(list);
     if (!list || !col.a) return;
-    a_max = NK_PI * 2.0f * ((float)segs - 1.0f) / (float)segs;
-    nk_draw_list_path_arc_to(list, center, radius, 0.0f, a_max, segs);
+    if (segs && NK_DRAW_LIST_CIRCLE_TABLE_SIZE % segs == 0) {
+        nk_draw_list_path_arc_to_table(list, center, radius, 0, segs,
+            NK_DRAW_LIST_CIRCLE_TABLE_SIZE / segs);
+    } else {
+        a_max = NK_PI * 2.0f * ((float)segs - 1.0f) / (float)segs;
+        nk_draw_list_path_arc_to(list, center, radius, 0.0f, a_max, segs);
+    }
     nk_draw_list_path_stroke(list, col, NK_STROKE_CLOSED, thickness);
 }
 NK_API void
@@ -10899,10 +12667,9 @@ nk_draw_list_add_text(struct nk_draw_list *list, const struct nk_user_font *font
 {
     float x = 0;
     int text_len = 0;
-    nk_rune unicode = 0;
-    nk_rune next = 0;
-    int glyph_len = 0;
-    int next_glyph_len = 0;
+    nk_rune runes[NK_UTF_RUN];
+    int run_len = 0;
+    int count, i;
     struct nk_user_font_glyph g;
 
     NK_ASSERT(list);
@@ -10912,34 +12679,39 @@ nk_draw_list_add_text(struct nk_draw_list *list, const struct nk_user_font *font
 
     nk_draw_list_push_image(list, font->texture);
     x = rect.x;
-    glyph_len = nk_utf_decode(text, &unicode, len);
-    if (!glyph_len) return;
+    count = nk_utf_decode_run(text, len, runes, (int)NK_LEN(runes), &run_len);
+    if (!count) return;
 
     /* draw every glyph image */
     fg.a = (nk_byte)((float)fg.a * list->config.global_alpha);
-    while (text_len < len && glyph_len) {
-        float gx, gy, gh, gw;
-        float char_width = 0;
-        if (unicode == NK_UTF_INVALID) break;
-
-        /* query currently drawn glyph information */
-        next_glyph_len = nk_utf_decode(text + text_len + glyph_len, &next, (int)len - text_len);
-        font->query(font->userdata, font_height, &g, unicode,
-                    (next == NK_UTF_INVALID) ? '\0' : next);
-
-        /* calculate and draw glyph drawing rectangle and image */
-        gx = x + g.offset.x;
-        gy = rect.y + g.offset.y;
-        gw = g.width; gh = g.height;
-        char_width = g.xadvance;
-        nk_draw_list_push_rect_uv(list, nk_vec2(gx,gy), nk_vec2(gx + gw, gy+ gh),
-            g.uv[0], g.uv[1], fg);
-
-        /* offset next glyph */
-        text_len += glyph_len;
-        x += char_width;
-        glyph_len = next_glyph_len;
-        unicode = next;
+    while (count) {
+        for (i = 0; i < count; ++i) {
+            float gx, gy, gh, gw;
+            nk_rune next = 0;
+            if (runes[i] == NK_UTF_INVALID) return;
+
+            /* the last rune of a run looks ahead into the next one */
+            if (i + 1 < count) next = runes[i+1];
+            else nk_utf_decode(text + text_len + run_len, &next, len - text_len - run_len);
+
+            /* query currently drawn glyph information */
+            font->query(font->userdata, font_height, &g, runes[i],
+                        (next == NK_UTF_INVALID) ? '\0' : next);
+
+            /* calculate and draw glyph drawing rectangle and image */
+            gx = x + g.offset.x;
+            gy = rect.y + g.offset.y;
+            gw = g.width; gh = g.height;
+            nk_draw_list_push_rect_uv(list, nk_vec2(gx,gy), nk_vec2(gx + gw, gy+ gh),
+                g.uv[0], g.uv[1], fg);
+
+            /* offset next glyph */
+            x += g.xadvance;
+        }
+        text_len += run_len;
+        if (!run_len || text_len >= len) break;
+        count = nk_utf_decode_run(text + text_len, len - text_len, runes,
+            (int)NK_LEN(runes), &run_len);
     }
 }
 NK_API nk_flags
@@ -10949,6 +12721,9 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
 {
     nk_flags res = NK_CONVERT_SUCCESS;
     const struct nk_command *cmd;
+#ifdef NK_INCLUDE_FRAME_STATS
+    nk_size offset = 0;
+#endif
     NK_ASSERT(ctx);
     NK_ASSERT(cmds);
     NK_ASSERT(vertices);
@@ -10961,8 +12736,21 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
 
     nk_draw_list_setup(&ctx->draw_list, config, cmds, vertices, elements,
         config->line_AA, config->shape_AA);
+#ifdef NK_INCLUDE_FRAME_STATS
+    /* commands start inside the first visible window buffer like in nk__begin */
+    {const struct nk_window *iter = ctx->begin;
+    while (iter && ((iter->buffer.begin == iter->buffer.end) ||
+        (iter->flags & NK_WINDOW_HIDDEN) || iter->seq != ctx->seq))
+        iter = iter->next;
+    if (iter) offset = iter->buffer.begin;}
+#endif
     nk_foreach(cmd, ctx)
     {
+#ifdef NK_INCLUDE_FRAME_STATS
+        struct nk_panel_stats *stats = nk_stats_panel_at(ctx, offset);
+        unsigned int vertex_count = ctx->draw_list.vertex_count;
+        unsigned int element_count = ctx->draw_list.element_count;
+#endif
 #ifdef NK_INCLUDE_COMMAND_USERDATA
         ctx->draw_list.userdata = cmd->userdata;
 #endif
@@ -10982,7 +12770,10 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
             nk_draw_list_stroke_curve(&ctx->draw_list, nk_vec2(q->begin.x, q->begin.y),
                 nk_vec2(q->ctrl[0].x, q->ctrl[0].y), nk_vec2(q->ctrl[1].x,
                 q->ctrl[1].y), nk_vec2(q->end.x, q->end.y), q->color,
-                config->curve_segment_count, q->line_thickness);
+                nk_draw_list_curve_segments(&ctx->draw_list, nk_vec2(q->begin.x, q->begin.y),
+                    nk_vec2(q->ctrl[0].x, q->ctrl[0].y), nk_vec2(q->ctrl[1].x, q->ctrl[1].y),
+                    nk_vec2(q->end.x, q->end.y), config->curve_segment_count),
+                q->line_thickness);
         } break;
         case NK_COMMAND_RECT: {
             const struct nk_command_rect *r = (const struct nk_command_rect*)cmd;
@@ -11003,26 +12794,30 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
             const struct nk_command_circle *c = (const struct nk_command_circle*)cmd;
             nk_draw_list_stroke_circle(&ctx->draw_list, nk_vec2((float)c->x + (float)c->w/2,
                 (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
-                config->circle_segment_count, c->line_thickness);
+                nk_draw_list_circle_segments(&ctx->draw_list, (float)c->w/2,
+                    config->circle_segment_count), c->line_thickness);
         } break;
         case NK_COMMAND_CIRCLE_FILLED: {
             const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled *)cmd;
             nk_draw_list_fill_circle(&ctx->draw_list, nk_vec2((float)c->x + (float)c->w/2,
                 (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
-                config->circle_segment_count);
+                nk_draw_list_circle_segments(&ctx->draw_list, (float)c->w/2,
+                    config->circle_segment_count));
         } break;
         case NK_COMMAND_ARC: {
             const struct nk_command_arc *c = (const struct nk_command_arc*)cmd;
             nk_draw_list_path_line_to(&ctx->draw_list, nk_vec2(c->cx, c->cy));
             nk_draw_list_path_arc_to(&ctx->draw_list, nk_vec2(c->cx, c->cy), c->r,
-                c->a[0], c->a[1], config->arc_segment_count);
+                c->a[0], c->a[1], nk_draw_list_arc_segments(&ctx->draw_list, c->r,
+                    c->a[0], c->a[1], config->arc_segment_count));
             nk_draw_list_path_stroke(&ctx->draw_list, c->color, NK_STROKE_CLOSED, c->line_thickness);
         } break;
         case NK_COMMAND_ARC_FILLED: {
             const struct nk_command_arc_filled *c = (const struct nk_command_arc_filled*)cmd;
             nk_draw_list_path_line_to(&ctx->draw_list, nk_vec2(c->cx, c->cy));
             nk_draw_list_path_arc_to(&ctx->draw_list, nk_vec2(c->cx, c->cy), c->r,
-                c->a[0], c->a[1], config->arc_segment_count);
+                c->a[0], c->a[1], nk_draw_list_arc_segments(&ctx->draw_list, c->r,
+                    c->a[0], c->a[1], config->arc_segment_count));
             nk_draw_list_path_fill(&ctx->draw_list, c->color);
         } break;
         case NK_COMMAND_TRIANGLE: {
@@ -11078,7 +12873,19 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
         } break;
         default: break;
         }
+#ifdef NK_INCLUDE_FRAME_STATS
+        if (stats) {
+            stats->vertices += ctx->draw_list.vertex_count - vertex_count;
+            stats->indices += ctx->draw_list.element_count - element_count;
+        }
+        offset = cmd->next;
+#endif
     }
+#ifdef NK_INCLUDE_FRAME_STATS
+    ctx->stats.memory.draw_commands = cmds->needed;
+    ctx->stats.memory.vertices = vertices->needed;
+    ctx->stats.memory.elements = elements->needed;
+#endif
     res |= (cmds->needed > cmds->allocated + (cmds->memory.size - cmds->size)) ? NK_CONVERT_COMMAND_BUFFER_FULL: 0;
     res |= (vertices->needed > vertices->allocated) ? NK_CONVERT_VERTEX_BUFFER_FULL: 0;
     res |= (elements->needed > elements->allocated) ? NK_CONVERT_ELEMENT_BUFFER_FULL: 0;
@@ -17254,10 +19061,10 @@ nk_font_bake_convert(void *out_memory, int img_width, int img_height,
 NK_INTERN float
 nk_font_text_width(nk_handle handle, float height, const char *text, int len)
 {
-    nk_rune unicode;
+    nk_rune runes[NK_UTF_RUN];
     int text_len  = 0;
     float text_width = 0;
-    int glyph_len = 0;
+    int run_len = 0;
     float scale = 0;
 
     struct nk_font *font = (struct nk_font*)handle.ptr;
@@ -17267,19 +19074,17 @@ nk_font_text_width(nk_handle handle, float height, const char *text, int len)
         return 0;
 
     scale = height/font->info.height;
-    glyph_len = text_len = nk_utf_decode(text, &unicode, (int)len);
-    if (!glyph_len) return 0;
-    while (text_len <= (int)len && glyph_len) {
-        const struct nk_font_glyph *g;
-        if (unicode == NK_UTF_INVALID) break;
-
-        /* query currently drawn glyph information */
-        g = nk_font_find_glyph(font, unicode);
-        text_width += g->xadvance * scale;
-
-        /* offset next glyph */
-        glyph_len = nk_utf_decode(text + text_len, &unicode, (int)len - text_len);
-        text_len += glyph_len;
+    while (text_len < len) {
+        int i, count;
+        count = nk_utf_decode_run(text + text_len, len - text_len, runes,
+            (int)NK_LEN(runes), &run_len);
+        for (i = 0; i < count; ++i) {
+            if (runes[i] == NK_UTF_INVALID)
+                return text_width;
+            text_width += nk_font_find_glyph(font, runes[i])->xadvance * scale;
+        }
+        if (!run_len) break;
+        text_len += run_len;
     }
     return text_width;
 }
@@ -18194,6 +19999,7 @@ nk_input_begin(struct nk_context *ctx)
     struct nk_input *in;
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_BEGIN, 0, 0, 0, 0, 0);
     in = &ctx->input;
     for (i = 0; i < NK_BUTTON_MAX; ++i)
         in->mouse.buttons[i].clicked = 0;
@@ -18213,6 +20019,7 @@ nk_input_end(struct nk_context *ctx)
     struct nk_input *in;
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_END, 0, 0, 0, 0, 0);
     in = &ctx->input;
     if (in->mouse.grab)
         in->mouse.grab = 0;
@@ -18228,6 +20035,7 @@ nk_input_motion(struct nk_context *ctx, int x, int y)
     struct nk_input *in;
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_MOTION, 0, x, y, 0, 0);
     in = &ctx->input;
     in->mouse.pos.x = (float)x;
     in->mouse.pos.y = (float)y;
@@ -18240,6 +20048,7 @@ nk_input_key(struct nk_context *ctx, enum nk_keys key, nk_bool down)
     struct nk_input *in;
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_KEY, down, (int)key, 0, 0, 0);
     in = &ctx->input;
 #ifdef NK_KEYSTATE_BASED_INPUT
     if (in->keyboard.keys[key].down != down)
@@ -18256,6 +20065,7 @@ nk_input_button(struct nk_context *ctx, enum nk_buttons id, int x, int y, nk_boo
     struct nk_input *in;
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_BUTTON, ((int)id << 1) | (down ? 1: 0), x, y, 0, 0);
     in = &ctx->input;
     if (in->mouse.buttons[id].down == down) return;
 
@@ -18281,6 +20091,7 @@ nk_input_scroll(struct nk_context *ctx, struct nk_vec2 val)
 {
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_SCROLL, 0, 0, 0, &val, 0);
     ctx->input.mouse.scroll_delta.x += val.x;
     ctx->input.mouse.scroll_delta.y += val.y;
 }
@@ -18296,6 +20107,7 @@ nk_input_glyph(struct nk_context *ctx, const nk_glyph glyph)
     in = &ctx->input;
 
     len = nk_utf_decode(glyph, &unicode, NK_UTF_SIZE);
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_GLYPH, len, 0, 0, glyph, len);
     if (len && ((in->keyboard.text_len + len) < NK_INPUT_MAX)) {
         nk_utf_encode(unicode, &in->keyboard.text[in->keyboard.text_len],
             NK_INPUT_MAX - in->keyboard.text_len);
@@ -19420,8 +21232,16 @@ nk_free(struct nk_context *ctx)
     NK_ASSERT(ctx);
     if (!ctx) return;
     nk_buffer_free(&ctx->memory);
-    if (ctx->use_pool)
+    if (ctx->use_pool) {
+        /* chart stream rings are allocated outside of the pool pages */
+        struct nk_window *iter = ctx->begin, *next;
+        while (iter) {
+            next = iter->next;
+            nk_free_window(ctx, iter);
+            iter = next;
+        }
         nk_pool_free(&ctx->pool);
+    }
 
     nk_zero(&ctx->input, sizeof(ctx->input));
     nk_zero(&ctx->style, sizeof(ctx->style));
@@ -19433,7 +21253,7 @@ nk_free(struct nk_context *ctx)
     ctx->end = 0;
     ctx->active = 0;
     ctx->current = 0;
-    ctx->freelist = 0;
+    nk_zero(ctx->freelist, sizeof(ctx->freelist));
     ctx->count = 0;
 }
 NK_API void
@@ -19444,6 +21264,9 @@ nk_clear(struct nk_context *ctx)
     NK_ASSERT(ctx);
 
     if (!ctx) return;
+#ifdef NK_INCLUDE_FRAME_STATS
+    nk_stats_clear(ctx);
+#endif
     if (ctx->use_pool)
         nk_buffer_clear(&ctx->memory);
     else nk_buffer_reset(&ctx->memory, NK_BUFFER_FRONT);
@@ -19453,6 +21276,8 @@ nk_clear(struct nk_context *ctx)
     ctx->last_widget_state = 0;
     ctx->style.cursor_active = ctx->style.cursors[NK_CURSOR_ARROW];
     NK_MEMSET(&ctx->overlay, 0, sizeof(ctx->overlay));
+    NK_MEMSET(&ctx->merged, 0, sizeof(ctx->merged));
+    ctx->worker_state = 0;
 
     /* garbage collector */
     iter = ctx->begin;
@@ -19486,12 +21311,23 @@ nk_clear(struct nk_context *ctx)
             n = it->next;
             if (it->seq != ctx->seq) {
                 nk_remove_table(iter, it);
-                nk_zero(it, sizeof(union nk_page_data));
+                nk_zero(it, sizeof(*it));
                 nk_free_table(ctx, it);
                 if (it == iter->tables)
                     iter->tables = n;
             } it = n;
         }}
+        /* remove chart streams that were neither pushed nor drawn */
+        {struct nk_chart_stream *n, *it = iter->streams;
+        while (it) {
+            n = it->next;
+            if (it->seq != ctx->seq)
+                nk_free_chart_stream(ctx, iter, it);
+            it = n;
+        }}
+        /* remove the text cache if no value widget was drawn */
+        if (iter->text_cache && iter->text_cache->seq != ctx->seq)
+            nk_free_text_cache(ctx, iter);
         /* window itself is not used anymore so free */
         if (iter->seq != ctx->seq || iter->flags & NK_WINDOW_CLOSED) {
             next = iter->next;
@@ -19502,6 +21338,13 @@ nk_clear(struct nk_context *ctx)
     }
     ctx->seq++;
 }
+NK_API void
+nk_trim(struct nk_context *ctx)
+{
+    NK_ASSERT(ctx);
+    if (!ctx || !ctx->use_pool) return;
+    nk_pool_trim(&ctx->pool, ctx->freelist);
+}
 NK_LIB void
 nk_start_buffer(struct nk_context *ctx, struct nk_command_buffer *buffer)
 {
@@ -19561,7 +21404,6 @@ nk_finish(struct nk_context *ctx, struct nk_window *win)
 {
     struct nk_popup_buffer *buf;
     struct nk_command *parent_last;
-    void *memory;
 
     NK_ASSERT(ctx);
     NK_ASSERT(win);
@@ -19570,8 +21412,7 @@ nk_finish(struct nk_context *ctx, struct nk_window *win)
     if (!win->popup.buf.active) return;
 
     buf = &win->popup.buf;
-    memory = ctx->memory.memory.ptr;
-    parent_last = nk_ptr_add(struct nk_command, memory, buf->parent);
+    parent_last = (struct nk_command*)nk_buffer_memory_at(&ctx->memory, buf->parent);
     parent_last->next = buf->end;
 }
 NK_LIB void
@@ -19579,7 +21420,6 @@ nk_build(struct nk_context *ctx)
 {
     struct nk_window *it = 0;
     struct nk_command *cmd = 0;
-    nk_byte *buffer = 0;
 
     /* draw cursor overlay */
     if (!ctx->style.cursor_active)
@@ -19600,14 +21440,13 @@ nk_build(struct nk_context *ctx)
     }
     /* build one big draw command list out of all window buffers */
     it = ctx->begin;
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
     while (it != 0) {
         struct nk_window *next = it->next;
         if (it->buffer.last == it->buffer.begin || (it->flags & NK_WINDOW_HIDDEN)||
             it->seq != ctx->seq)
             goto cont;
 
-        cmd = nk_ptr_add(struct nk_command, buffer, it->buffer.last);
+        cmd = (struct nk_command*)nk_buffer_memory_at(&ctx->memory, it->buffer.last);
         while (next && ((next->buffer.last == next->buffer.begin) ||
             (next->flags & NK_WINDOW_HIDDEN) || next->seq != ctx->seq))
             next = next->next; /* skip empty command buffers */
@@ -19625,10 +21464,15 @@ nk_build(struct nk_context *ctx)
 
         buf = &it->popup.buf;
         cmd->next = buf->begin;
-        cmd = nk_ptr_add(struct nk_command, buffer, buf->last);
+        cmd = (struct nk_command*)nk_buffer_memory_at(&ctx->memory, buf->last);
         buf->active = nk_false;
         skip: it = next;
     }
+    /* append commands of worker contexts */
+    if (ctx->merged.end != ctx->merged.begin) {
+        if (cmd) cmd->next = ctx->merged.begin;
+        cmd = (struct nk_command*)nk_buffer_memory_at(&ctx->memory, ctx->merged.last);
+    }
     if (cmd) {
         /* append overlay commands */
         if (ctx->overlay.end != ctx->overlay.begin)
@@ -19640,12 +21484,10 @@ NK_API const struct nk_command*
 nk__begin(struct nk_context *ctx)
 {
     struct nk_window *iter;
-    nk_byte *buffer;
     NK_ASSERT(ctx);
     if (!ctx) return 0;
-    if (!ctx->count) return 0;
+    if (!ctx->count && ctx->merged.end == ctx->merged.begin) return 0;
 
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
     if (!ctx->build) {
         nk_build(ctx);
         ctx->build = nk_true;
@@ -19654,21 +21496,123 @@ nk__begin(struct nk_context *ctx)
     while (iter && ((iter->buffer.begin == iter->buffer.end) ||
         (iter->flags & NK_WINDOW_HIDDEN) || iter->seq != ctx->seq))
         iter = iter->next;
-    if (!iter) return 0;
-    return nk_ptr_add_const(struct nk_command, buffer, iter->buffer.begin);
+    if (!iter) {
+        if (ctx->merged.end == ctx->merged.begin) return 0;
+        return (const struct nk_command*)nk_buffer_memory_at(&ctx->memory, ctx->merged.begin);
+    }
+    return (const struct nk_command*)nk_buffer_memory_at(&ctx->memory, iter->buffer.begin);
 }
 
 NK_API const struct nk_command*
 nk__next(struct nk_context *ctx, const struct nk_command *cmd)
 {
-    nk_byte *buffer;
-    const struct nk_command *next;
     NK_ASSERT(ctx);
-    if (!ctx || !cmd || !ctx->count) return 0;
+    if (!ctx || !cmd) return 0;
     if (cmd->next >= ctx->memory.allocated) return 0;
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
-    next = nk_ptr_add_const(struct nk_command, buffer, cmd->next);
-    return next;
+    return (const struct nk_command*)nk_buffer_memory_at(&ctx->memory, cmd->next);
+}
+NK_LIB nk_hash
+nk_command_hash(const struct nk_command *cmd, nk_hash hash)
+{
+    /* only hash members since padding inside command memory is not initialized */
+    #define NK_HASH_MEMBERS(T, first, last)\
+        nk_murmur_hash(&((const struct T*)cmd)->first, (int)(NK_OFFSETOF(struct T, last) +\
+            sizeof(((const struct T*)cmd)->last) - NK_OFFSETOF(struct T, first)), hash)
+
+    hash = nk_murmur_hash(&cmd->type, (int)sizeof(cmd->type), hash);
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+    hash = nk_murmur_hash(&cmd->userdata, (int)sizeof(cmd->userdata), hash);
+#endif
+    switch (cmd->type) {
+    case NK_COMMAND_NOP: break;
+    case NK_COMMAND_SCISSOR:
+        hash = NK_HASH_MEMBERS(nk_command_scissor, x, h); break;
+    case NK_COMMAND_LINE:
+        hash = NK_HASH_MEMBERS(nk_command_line, line_thickness, color); break;
+    case NK_COMMAND_CURVE:
+        hash = NK_HASH_MEMBERS(nk_command_curve, line_thickness, color); break;
+    case NK_COMMAND_RECT:
+        hash = NK_HASH_MEMBERS(nk_command_rect, rounding, color); break;
+    case NK_COMMAND_RECT_FILLED:
+        hash = NK_HASH_MEMBERS(nk_command_rect_filled, rounding, color); break;
+    case NK_COMMAND_RECT_MULTI_COLOR:
+        hash = NK_HASH_MEMBERS(nk_command_rect_multi_color, x, right); break;
+    case NK_COMMAND_CIRCLE:
+        hash = NK_HASH_MEMBERS(nk_command_circle, x, color); break;
+    case NK_COMMAND_CIRCLE_FILLED:
+        hash = NK_HASH_MEMBERS(nk_command_circle_filled, x, color); break;
+    case NK_COMMAND_ARC:
+        hash = NK_HASH_MEMBERS(nk_command_arc, cx, color); break;
+    case NK_COMMAND_ARC_FILLED:
+        hash = NK_HASH_MEMBERS(nk_command_arc_filled, cx, r);
+        hash = NK_HASH_MEMBERS(nk_command_arc_filled, a, color); break;
+    case NK_COMMAND_TRIANGLE:
+        hash = NK_HASH_MEMBERS(nk_command_triangle, line_thickness, color); break;
+    case NK_COMMAND_TRIANGLE_FILLED:
+        hash = NK_HASH_MEMBERS(nk_command_triangle_filled, a, color); break;
+    case NK_COMMAND_POLYGON:
+    case NK_COMMAND_POLYLINE: {
+        const struct nk_command_polygon *p = (const struct nk_command_polygon*)cmd;
+        hash = NK_HASH_MEMBERS(nk_command_polygon, color, point_count);
+        hash = nk_murmur_hash(p->points, (int)(p->point_count * sizeof(p->points[0])), hash);
+    } break;
+    case NK_COMMAND_POLYGON_FILLED: {
+        const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled*)cmd;
+        hash = NK_HASH_MEMBERS(nk_command_polygon_filled, color, point_count);
+        hash = nk_murmur_hash(p->points, (int)(p->point_count * sizeof(p->points[0])), hash);
+    } break;
+    case NK_COMMAND_TEXT: {
+        const struct nk_command_text *t = (const struct nk_command_text*)cmd;
+        hash = NK_HASH_MEMBERS(nk_command_text, font, length);
+        hash = nk_murmur_hash(t->string, t->length, hash);
+    } break;
+    case NK_COMMAND_IMAGE: {
+        const struct nk_command_image *i = (const struct nk_command_image*)cmd;
+        hash = NK_HASH_MEMBERS(nk_command_image, x, h);
+        hash = nk_murmur_hash(&i->img.handle, (int)sizeof(i->img.handle), hash);
+        hash = nk_murmur_hash(&i->img.w, (int)(NK_OFFSETOF(struct nk_image, region) +
+            sizeof(i->img.region) - NK_OFFSETOF(struct nk_image, w)), hash);
+        hash = nk_murmur_hash(&i->col, (int)sizeof(i->col), hash);
+    } break;
+    case NK_COMMAND_CUSTOM: {
+        const struct nk_command_custom *c = (const struct nk_command_custom*)cmd;
+        hash = NK_HASH_MEMBERS(nk_command_custom, x, callback_data);
+        hash = nk_murmur_hash(&c->callback, (int)sizeof(c->callback), hash);
+    } break;
+    }
+    #undef NK_HASH_MEMBERS
+    return hash;
+}
+NK_API nk_flags
+nk_frame_status(struct nk_context *ctx)
+{
+    const struct nk_command *cmd;
+    struct nk_window *iter;
+    nk_hash hash = 0;
+    nk_flags status = NK_FRAME_UNCHANGED;
+
+    NK_ASSERT(ctx);
+    if (!ctx) return NK_FRAME_CHANGED;
+    /* repeated calls inside the same frame return the same result */
+    if (ctx->frame_seq == ctx->seq)
+        return ctx->frame_status;
+
+    nk_foreach(cmd, ctx)
+        hash = nk_command_hash(cmd, hash);
+    if (hash != ctx->frame_hash || !ctx->frame_seq)
+        status |= NK_FRAME_CHANGED;
+
+    /* windows with any panel waiting to auto hide its scrollbar */
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        if (iter->seq != ctx->seq || (iter->flags & (NK_WINDOW_HIDDEN|NK_WINDOW_CLOSED)))
+            continue;
+        if (iter->scrollbar_hiding_seq == ctx->seq)
+            status |= NK_FRAME_ANIMATING;
+    }
+    ctx->frame_hash = hash;
+    ctx->frame_status = status;
+    ctx->frame_seq = ctx->seq;
+    return status;
 }
 
 
@@ -19681,6 +21625,22 @@ nk__next(struct nk_context *ctx, const struct nk_command *cmd)
  *                              POOL
  *
  * ===============================================================*/
+NK_LIB nk_size
+nk_pool_element_size(enum nk_page_element_type type)
+{
+    NK_STORAGE const nk_size align = NK_ALIGNOF(struct nk_page_element);
+    nk_size size = NK_OFFSETOF(struct nk_page_element, data);
+    switch (type) {
+    default:
+    case NK_PAGE_ELEMENT_WINDOW: size += sizeof(struct nk_window); break;
+    case NK_PAGE_ELEMENT_PANEL: size += sizeof(struct nk_panel); break;
+    case NK_PAGE_ELEMENT_TABLE: size += sizeof(struct nk_table); break;
+    case NK_PAGE_ELEMENT_STREAM: size += sizeof(struct nk_chart_stream); break;
+    case NK_PAGE_ELEMENT_TEXT: size += sizeof(struct nk_text_cache); break;
+    }
+    /* keep the following element in a page aligned */
+    return (size + (align - 1)) & ~(align - 1);
+}
 NK_LIB void
 nk_pool_init(struct nk_pool *pool, const struct nk_allocator *alloc,
     unsigned int capacity)
@@ -19690,53 +21650,96 @@ nk_pool_init(struct nk_pool *pool, const struct nk_allocator *alloc,
     pool->alloc = *alloc;
     pool->capacity = capacity;
     pool->type = NK_BUFFER_DYNAMIC;
-    pool->pages = 0;
 }
 NK_LIB void
 nk_pool_free(struct nk_pool *pool)
 {
-    struct nk_page *iter;
+    int type;
     if (!pool) return;
-    iter = pool->pages;
     if (pool->type == NK_BUFFER_FIXED) return;
-    while (iter) {
-        struct nk_page *next = iter->next;
-        pool->alloc.free(pool->alloc.userdata, iter);
-        iter = next;
+    for (type = 0; type < NK_PAGE_ELEMENT_TYPE_COUNT; ++type) {
+        struct nk_page *iter = pool->pages[type];
+        while (iter) {
+            struct nk_page *next = iter->next;
+            pool->alloc.free(pool->alloc.userdata, iter);
+            iter = next;
+        }
+        pool->pages[type] = 0;
     }
+    pool->page_count = 0;
 }
 NK_LIB void
 nk_pool_init_fixed(struct nk_pool *pool, void *memory, nk_size size)
 {
     nk_zero(pool, sizeof(*pool));
-    NK_ASSERT(size >= sizeof(struct nk_page));
-    if (size < sizeof(struct nk_page)) return;
-    /* first nk_page_element is embedded in nk_page, additional elements follow in adjacent space */
-    pool->capacity = (unsigned)(1 + (size - sizeof(struct nk_page)) / sizeof(struct nk_page_element));
-    pool->pages = (struct nk_page*)memory;
+    NK_ASSERT(memory);
+    if (!memory) return;
+    /* all element types are carved front to back out of the memory block */
+    pool->memory = memory;
     pool->type = NK_BUFFER_FIXED;
     pool->size = size;
 }
 NK_LIB struct nk_page_element*
-nk_pool_alloc(struct nk_pool *pool)
+nk_pool_alloc(struct nk_pool *pool, enum nk_page_element_type type)
 {
-    if (!pool->pages || pool->pages->size >= pool->capacity) {
+    const nk_size elem_size = nk_pool_element_size(type);
+    struct nk_page *page;
+    if (pool->type == NK_BUFFER_FIXED) {
+        NK_STORAGE const nk_size align = NK_ALIGNOF(struct nk_page_element);
+        void *unaligned = nk_ptr_add(void, pool->memory, pool->allocated);
+        void *memory = NK_ALIGN_PTR(unaligned, align);
+        nk_size offset = (nk_size)((nk_byte*)memory - (nk_byte*)pool->memory);
+        if (offset + elem_size > pool->size) return 0;
+        pool->allocated = offset + elem_size;
+        return (struct nk_page_element*)memory;
+    }
+    page = pool->pages[type];
+    if (!page || page->size >= pool->capacity) {
         /* allocate new page */
-        struct nk_page *page;
-        if (pool->type == NK_BUFFER_FIXED) {
-            NK_ASSERT(pool->pages);
-            if (!pool->pages) return 0;
-            NK_ASSERT(pool->pages->size < pool->capacity);
-            return 0;
-        } else {
-            nk_size size = sizeof(struct nk_page);
-            size += (pool->capacity - 1) * sizeof(struct nk_page_element);
-            page = (struct nk_page*)pool->alloc.alloc(pool->alloc.userdata,0, size);
-            page->next = pool->pages;
-            pool->pages = page;
-            page->size = 0;
+        nk_size size = NK_OFFSETOF(struct nk_page, win);
+        size += pool->capacity * elem_size;
+        page = (struct nk_page*)pool->alloc.alloc(pool->alloc.userdata,0, size);
+        if (!page) return 0;
+        page->next = pool->pages[type];
+        page->size = 0;
+        pool->pages[type] = page;
+        pool->page_count++;
+    }
+    return nk_ptr_add(struct nk_page_element, page->win, elem_size * page->size++);
+}
+NK_LIB void
+nk_pool_trim(struct nk_pool *pool, struct nk_page_element **freelist)
+{
+    int type;
+    if (pool->type != NK_BUFFER_DYNAMIC) return;
+    for (type = 0; type < NK_PAGE_ELEMENT_TYPE_COUNT; ++type) {
+        const nk_size elem_size = nk_pool_element_size((enum nk_page_element_type)type);
+        struct nk_page **page = &pool->pages[type];
+        while (*page) {
+            struct nk_page *iter = *page;
+            nk_ptr begin = (nk_ptr)iter->win;
+            nk_ptr end = begin + elem_size * iter->size;
+            unsigned int unused = 0;
+            struct nk_page_element **elem;
+
+            /* only pages without any element in use can be released */
+            for (elem = &freelist[type]; *elem; elem = &(*elem)->next)
+                if ((nk_ptr)*elem >= begin && (nk_ptr)*elem < end) unused++;
+            if (unused != iter->size) {
+                page = &iter->next;
+                continue;
+            }
+            elem = &freelist[type];
+            while (*elem) {
+                if ((nk_ptr)*elem >= begin && (nk_ptr)*elem < end)
+                    *elem = (*elem)->next;
+                else elem = &(*elem)->next;
+            }
+            *page = iter->next;
+            pool->alloc.free(pool->alloc.userdata, iter);
+            pool->page_count--;
         }
-    } return &pool->pages->win[pool->pages->size++];
+    }
 }
 
 
@@ -19749,57 +21752,64 @@ nk_pool_alloc(struct nk_pool *pool)
  *
  * ===============================================================*/
 NK_LIB struct nk_page_element*
-nk_create_page_element(struct nk_context *ctx)
+nk_create_page_element(struct nk_context *ctx, enum nk_page_element_type type)
 {
+    struct nk_page_element *elem = nk_try_create_page_element(ctx, type);
+    NK_ASSERT(elem);
+    return elem;
+}
+NK_LIB struct nk_page_element*
+nk_try_create_page_element(struct nk_context *ctx, enum nk_page_element_type type)
+{
+    /* same as `nk_create_page_element` but out of memory is not an error,
+     * for optional state the caller can do without */
     struct nk_page_element *elem;
-    if (ctx->freelist) {
+    const nk_size size = nk_pool_element_size(type);
+    if (ctx->freelist[type]) {
         /* unlink page element from free list */
-        elem = ctx->freelist;
-        ctx->freelist = elem->next;
+        elem = ctx->freelist[type];
+        ctx->freelist[type] = elem->next;
     } else if (ctx->use_pool) {
         /* allocate page element from memory pool */
-        elem = nk_pool_alloc(&ctx->pool);
-        NK_ASSERT(elem);
+        elem = nk_pool_alloc(&ctx->pool, type);
         if (!elem) return 0;
     } else {
         /* allocate new page element from back of fixed size memory buffer */
-        NK_STORAGE const nk_size size = sizeof(struct nk_page_element);
         NK_STORAGE const nk_size align = NK_ALIGNOF(struct nk_page_element);
         elem = (struct nk_page_element*)nk_buffer_alloc(&ctx->memory, NK_BUFFER_BACK, size, align);
-        NK_ASSERT(elem);
         if (!elem) return 0;
     }
-    nk_zero_struct(*elem);
+    nk_zero(elem, size);
     elem->next = 0;
     elem->prev = 0;
     return elem;
 }
 NK_LIB void
 nk_link_page_element_into_freelist(struct nk_context *ctx,
-    struct nk_page_element *elem)
+    struct nk_page_element *elem, enum nk_page_element_type type)
 {
     /* link table into freelist */
-    if (!ctx->freelist) {
-        ctx->freelist = elem;
+    if (!ctx->freelist[type]) {
+        ctx->freelist[type] = elem;
     } else {
-        elem->next = ctx->freelist;
-        ctx->freelist = elem;
+        elem->next = ctx->freelist[type];
+        ctx->freelist[type] = elem;
     }
 }
 NK_LIB void
-nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem)
+nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem,
+    enum nk_page_element_type type)
 {
     /* we have a pool so just add to free list */
     if (ctx->use_pool) {
-        nk_link_page_element_into_freelist(ctx, elem);
+        nk_link_page_element_into_freelist(ctx, elem, type);
         return;
     }
     /* if possible remove last element from back of fixed memory buffer */
-    {void *elem_end = (void*)(elem + 1);
-    void *buffer_end = (nk_byte*)ctx->memory.memory.ptr + ctx->memory.size;
-    if (elem_end == buffer_end)
-        ctx->memory.size -= sizeof(struct nk_page_element);
-    else nk_link_page_element_into_freelist(ctx, elem);}
+    {void *buffer_back = (nk_byte*)ctx->memory.memory.ptr + ctx->memory.size;
+    if ((void*)elem == buffer_back)
+        ctx->memory.size += nk_pool_element_size(type);
+    else nk_link_page_element_into_freelist(ctx, elem, type);}
 }
 
 
@@ -19815,9 +21825,8 @@ NK_LIB struct nk_table*
 nk_create_table(struct nk_context *ctx)
 {
     struct nk_page_element *elem;
-    elem = nk_create_page_element(ctx);
+    elem = nk_create_page_element(ctx, NK_PAGE_ELEMENT_TABLE);
     if (!elem) return 0;
-    nk_zero_struct(*elem);
     return &elem->data.tbl;
 }
 NK_LIB void
@@ -19825,7 +21834,7 @@ nk_free_table(struct nk_context *ctx, struct nk_table *tbl)
 {
     union nk_page_data *pd = NK_CONTAINER_OF(tbl, union nk_page_data, tbl);
     struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
-    nk_free_page_element(ctx, pe);
+    nk_free_page_element(ctx, pe, NK_PAGE_ELEMENT_TABLE);
 }
 NK_LIB void
 nk_push_table(struct nk_window *win, struct nk_table *tbl)
@@ -19879,6 +21888,7 @@ NK_LIB nk_uint*
 nk_find_value(const struct nk_window *win, nk_hash name)
 {
     struct nk_table *iter = win->tables;
+    NK_STATS_ADD(&win->buffer, table_lookups, 1);
     while (iter) {
         unsigned int i = 0;
         unsigned int size = iter->size;
@@ -19905,9 +21915,8 @@ NK_LIB void*
 nk_create_panel(struct nk_context *ctx)
 {
     struct nk_page_element *elem;
-    elem = nk_create_page_element(ctx);
+    elem = nk_create_page_element(ctx, NK_PAGE_ELEMENT_PANEL);
     if (!elem) return 0;
-    nk_zero_struct(*elem);
     return &elem->data.pan;
 }
 NK_LIB void
@@ -19915,7 +21924,7 @@ nk_free_panel(struct nk_context *ctx, struct nk_panel *pan)
 {
     union nk_page_data *pd = NK_CONTAINER_OF(pan, union nk_page_data, pan);
     struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
-    nk_free_page_element(ctx, pe);
+    nk_free_page_element(ctx, pe, NK_PAGE_ELEMENT_PANEL);
 }
 NK_LIB nk_bool
 nk_panel_has_header(nk_flags flags, const char *title)
@@ -20010,6 +22019,9 @@ nk_panel_begin(struct nk_context *ctx, const char *title, enum nk_panel_type pan
     in = (win->flags & NK_WINDOW_NO_INPUT) ? 0: &ctx->input;
 #ifdef NK_INCLUDE_COMMAND_USERDATA
     win->buffer.userdata = ctx->userdata;
+#endif
+#ifdef NK_INCLUDE_FRAME_STATS
+    nk_stats_panel_begin(ctx, win, title, panel_type);
 #endif
     /* pull style configuration into local stack */
     scrollbar_size = style->window.scrollbar_size;
@@ -20177,6 +22189,7 @@ nk_panel_begin(struct nk_context *ctx, const char *title, enum nk_panel_type pan
         int text_len = nk_strlen(title);
         struct nk_rect label = {0,0,0,0};
         float t = font->width(font->userdata, font->height, title, text_len);
+        NK_STATS_ADD(out, text_measurements, 1);
         text.padding = nk_vec2(0,0);
 
         label.x = header.x + style->window.header.padding.x;
@@ -20387,6 +22400,17 @@ nk_panel_end(struct nk_context *ctx)
         if ((!has_input && is_window_hovered) || (!is_window_hovered && !any_item_active))
             window->scrollbar_hiding_timer += ctx->delta_time_seconds;
         else window->scrollbar_hiding_timer = 0;
+
+        /* popups report a running timer to their root window. Groups are ended
+         * through a temporary window which restarts the timer every frame, so
+         * their scrollbar never fades and does not keep the frame animating */
+        if (window->seq == ctx->seq &&
+            window->scrollbar_hiding_timer < NK_SCROLLBAR_HIDING_TIMEOUT) {
+            struct nk_window *root = window;
+            while (root->parent)
+                root = root->parent;
+            root->scrollbar_hiding_seq = ctx->seq;
+        }
     } else window->scrollbar_hiding_timer = 0;
 
     /* window border */
@@ -20527,7 +22551,7 @@ NK_LIB void*
 nk_create_window(struct nk_context *ctx)
 {
     struct nk_page_element *elem;
-    elem = nk_create_page_element(ctx);
+    elem = nk_create_page_element(ctx, NK_PAGE_ELEMENT_WINDOW);
     if (!elem) return 0;
     elem->data.win.seq = ctx->seq;
     return &elem->data.win;
@@ -20554,10 +22578,15 @@ nk_free_window(struct nk_context *ctx, struct nk_window *win)
         it = n;
     }
 
+    while (win->streams)
+        nk_free_chart_stream(ctx, win, win->streams);
+    if (win->text_cache)
+        nk_free_text_cache(ctx, win);
+
     /* link windows into freelist */
     {union nk_page_data *pd = NK_CONTAINER_OF(win, union nk_page_data, win);
     struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
-    nk_free_page_element(ctx, pe);}
+    nk_free_page_element(ctx, pe, NK_PAGE_ELEMENT_WINDOW);}
 }
 NK_LIB struct nk_window*
 nk_find_window(const struct nk_context *ctx, nk_hash hash, const char *name)
@@ -20825,6 +22854,9 @@ nk_end(struct nk_context *ctx)
         return;
     }
     nk_panel_end(ctx);
+#ifdef NK_INCLUDE_FRAME_STATS
+    nk_stats_panel_end(ctx, ctx->current);
+#endif
     nk_free_panel(ctx, ctx->current->layout);
     ctx->current = 0;
 }
@@ -20965,6 +22997,8 @@ nk_window_is_any_hovered(const struct nk_context *ctx)
     struct nk_window *iter;
     NK_ASSERT(ctx);
     if (!ctx) return 0;
+    if (ctx->worker_state & NK_WIDGET_STATE_HOVER)
+        return 1;
     iter = ctx->begin;
     while (iter) {
         /* check if window is being hovered */
@@ -20990,7 +23024,7 @@ NK_API nk_bool
 nk_item_is_any_active(const struct nk_context *ctx)
 {
     int any_hovered = nk_window_is_any_hovered(ctx);
-    int any_active = (ctx->last_widget_state & NK_WIDGET_STATE_MODIFIED);
+    int any_active = ((ctx->last_widget_state | ctx->worker_state) & NK_WIDGET_STATE_MODIFIED);
     return any_hovered || any_active;
 }
 NK_API nk_bool
@@ -22487,6 +24521,46 @@ nk_layout_widget_bounds(const struct nk_context *ctx)
     ret.h = layout->row.height;
     return ret;
 }
+NK_API void
+nk_layout_skip(struct nk_context *ctx, float height)
+{
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(ctx->current->layout);
+    if (!ctx || !ctx->current || !ctx->current->layout)
+        return;
+    ctx->current->layout->at_y += NK_MAX(height, 0);
+}
+NK_API void
+nk_layout_skip_rows(struct nk_context *ctx, int rows)
+{
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(ctx->current->layout);
+    if (!ctx || !ctx->current || !ctx->current->layout)
+        return;
+    nk_layout_skip(ctx, ctx->current->layout->row.height * (float)rows);
+}
+NK_API void
+nk_layout_visible_range(const struct nk_context *ctx, float *top, float *bottom)
+{
+    const struct nk_panel *layout;
+    float next;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(ctx->current->layout);
+    NK_ASSERT(top);
+    NK_ASSERT(bottom);
+    if (!ctx || !ctx->current || !ctx->current->layout || !top || !bottom)
+        return;
+
+    /* `at_y` is unscrolled while the clip rectangle is in screen space */
+    layout = ctx->current->layout;
+    next = layout->at_y + layout->row.height;
+    *top = layout->clip.y + (float)*layout->offset_y - next;
+    *bottom = *top + layout->clip.h;
+}
 NK_API struct nk_vec2
 nk_layout_space_to_screen(const struct nk_context *ctx, struct nk_vec2 ret)
 {
@@ -22763,6 +24837,21 @@ nk_spacer(struct nk_context *ctx )
  *
  * ===============================================================*/
 NK_INTERN int
+nk_tree_indent(struct nk_context *ctx, struct nk_rect header,
+    enum nk_collapse_states state)
+{
+    /* increase x-axis cursor widget position pointer */
+    const struct nk_style *style = &ctx->style;
+    struct nk_panel *layout = ctx->current->layout;
+    if (state == NK_MAXIMIZED) {
+        layout->at_x = header.x + (float)*layout->offset_x + style->tab.indent;
+        layout->bounds.w = NK_MAX(layout->bounds.w, style->tab.indent);
+        layout->bounds.w -= (style->tab.indent + style->window.padding.x);
+        layout->row.tree_depth++;
+        return nk_true;
+    } else return nk_false;
+}
+NK_INTERN int
 nk_tree_state_base(struct nk_context *ctx, enum nk_tree_type type,
     struct nk_image *img, const char *title, enum nk_collapse_states *state)
 {
@@ -22803,6 +24892,11 @@ nk_tree_state_base(struct nk_context *ctx, enum nk_tree_type type,
     nk_layout_reset_min_row_height(ctx);
 
     widget_state = nk_widget(&header, ctx);
+    if (widget_state == NK_WIDGET_INVALID) {
+        /* header is clipped away so only the node state is kept. Open nodes
+         * still return true since their height is only known after layout */
+        return nk_tree_indent(ctx, header, *state);
+    }
     if (type == NK_TREE_TAB) {
         const struct nk_style_item *background = &style->tab.background;
 
@@ -22866,14 +24960,7 @@ nk_tree_state_base(struct nk_context *ctx, enum nk_tree_type type,
     nk_widget_text(out, label, title, nk_strlen(title), &text,
         NK_TEXT_LEFT, style->font);}
 
-    /* increase x-axis cursor widget position pointer */
-    if (*state == NK_MAXIMIZED) {
-        layout->at_x = header.x + (float)*layout->offset_x + style->tab.indent;
-        layout->bounds.w = NK_MAX(layout->bounds.w, style->tab.indent);
-        layout->bounds.w -= (style->tab.indent + style->window.padding.x);
-        layout->row.tree_depth++;
-        return nk_true;
-    } else return nk_false;
+    return nk_tree_indent(ctx, header, *state);
 }
 NK_INTERN int
 nk_tree_base(struct nk_context *ctx, enum nk_tree_type type,
@@ -22993,6 +25080,11 @@ nk_tree_element_image_push_hashed_base(struct nk_context *ctx, enum nk_tree_type
     nk_layout_reset_min_row_height(ctx);
 
     widget_state = nk_widget(&header, ctx);
+    if (widget_state == NK_WIDGET_INVALID) {
+        /* header is clipped away so only the node state is kept. Open nodes
+         * still return true since their height is only known after layout */
+        return nk_tree_indent(ctx, header, *state);
+    }
     if (type == NK_TREE_TAB) {
         const struct nk_style_item *background = &style->tab.background;
 
@@ -23040,6 +25132,7 @@ nk_tree_element_image_push_hashed_base(struct nk_context *ctx, enum nk_tree_type
     /* calculate size of the text and tooltip */
     text_len = nk_strlen(title);
     text_width = style->font->width(style->font->userdata, style->font->height, title, text_len);
+    NK_STATS_ADD(out, text_measurements, 1);
     text_width += (4 * padding.x);
 
     header.w = NK_MAX(header.w, sym.w + item_spacing.x);
@@ -23054,14 +25147,7 @@ nk_tree_element_image_push_hashed_base(struct nk_context *ctx, enum nk_tree_type
     } else nk_do_selectable(&dummy, &win->buffer, label, title, title_len, NK_TEXT_LEFT,
             selected, &style->selectable, in, style->font);
     }
-    /* increase x-axis cursor widget position pointer */
-    if (*state == NK_MAXIMIZED) {
-        layout->at_x = header.x + (float)*layout->offset_x + style->tab.indent;
-        layout->bounds.w = NK_MAX(layout->bounds.w, style->tab.indent);
-        layout->bounds.w -= (style->tab.indent + style->window.padding.x);
-        layout->row.tree_depth++;
-        return nk_true;
-    } else return nk_false;
+    return nk_tree_indent(ctx, header, *state);
 }
 NK_INTERN int
 nk_tree_element_base(struct nk_context *ctx, enum nk_tree_type type,
@@ -23394,6 +25480,11 @@ nk_list_view_begin(struct nk_context *ctx, struct nk_list_view *view,
 
     *y_offset = 0;
     result = nk_group_scrolled_offset_begin(ctx, x_offset, y_offset, title, flags);
+    if (!result) {
+        /* group was clipped and nk_list_view_end will not restore the offset */
+        *y_offset = view->scroll_value;
+        return 0;
+    }
     win = ctx->current;
     layout = win->layout;
 
@@ -23405,6 +25496,52 @@ nk_list_view_begin(struct nk_context *ctx, struct nk_list_view *view,
     view->ctx = ctx;
     return result;
 }
+NK_INTERN int
+nk_list_view_find_row(const float *offsets, int row_count, float spacing, float y)
+{
+    /* first row which ends below `y` */
+    int lo = 0, hi = row_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (offsets[mid+1] + spacing * (float)(mid+1) <= y)
+            lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+NK_API nk_bool
+nk_list_view_begin_variable(struct nk_context *ctx, struct nk_list_view *view,
+    const char *title, nk_flags flags, const float *offsets, int row_count)
+{
+    struct nk_panel *layout;
+    float spacing, top, bottom;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(view);
+    NK_ASSERT(title);
+    NK_ASSERT(offsets);
+    if (!ctx || !view || !title || !offsets) return 0;
+
+    nk_zero(view, sizeof(*view));
+    if (!nk_group_begin(ctx, title, flags))
+        return 0;
+
+    /* rows are laid out at their real position inside the scrolled group, so
+     * unlike uniform list views the scrollbar offset is left untouched */
+    layout = ctx->current->layout;
+    spacing = ctx->style.window.spacing.y;
+    row_count = NK_MAX(row_count, 0);
+    nk_layout_visible_range(ctx, &top, &bottom);
+    view->begin = nk_list_view_find_row(offsets, row_count, spacing, top);
+    view->end = nk_list_view_find_row(offsets, row_count, spacing, bottom);
+    view->end = NK_MIN(view->end + 1, row_count);
+    view->count = view->end - view->begin;
+    view->total_height = nk_iceilf(layout->at_y + layout->row.height - layout->bounds.y +
+        offsets[row_count] + spacing * (float)row_count);
+    view->ctx = ctx;
+    nk_layout_skip(ctx, offsets[view->begin] + spacing * (float)view->begin);
+    return 1;
+}
 NK_API void
 nk_list_view_end(struct nk_list_view *view)
 {
@@ -23414,14 +25551,19 @@ nk_list_view_end(struct nk_list_view *view)
 
     NK_ASSERT(view);
     NK_ASSERT(view->ctx);
-    NK_ASSERT(view->scroll_pointer);
     if (!view || !view->ctx) return;
 
     ctx = view->ctx;
     win = ctx->current;
     layout = win->layout;
-    layout->at_y = layout->bounds.y + (float)view->total_height;
-    *view->scroll_pointer = *view->scroll_pointer + view->scroll_value;
+    if (view->scroll_pointer) {
+        layout->at_y = layout->bounds.y + (float)view->total_height;
+        *view->scroll_pointer = *view->scroll_pointer + view->scroll_value;
+    } else {
+        /* skip all rows below the visible ones, the last laid out row
+         * is added by the panel itself */
+        layout->at_y = layout->bounds.y + (float)view->total_height - layout->row.height;
+    }
     nk_group_end(view->ctx);
 }
 
@@ -23796,6 +25938,13 @@ NK_LIB void
 nk_widget_text(struct nk_command_buffer *o, struct nk_rect b,
     const char *string, int len, const struct nk_text *t,
     nk_flags a, const struct nk_user_font *f)
+{
+    nk_widget_text_measured(o, b, string, len, -1.0f, t, a, f);
+}
+NK_LIB void
+nk_widget_text_measured(struct nk_command_buffer *o, struct nk_rect b,
+    const char *string, int len, float width, const struct nk_text *t,
+    nk_flags a, const struct nk_user_font *f)
 {
     struct nk_rect label;
     float text_width;
@@ -23809,8 +25958,12 @@ nk_widget_text(struct nk_command_buffer *o, struct nk_rect b,
     label.y = b.y + t->padding.y;
     label.h = NK_MIN(f->height, b.h - 2 * t->padding.y);
 
-    text_width = f->width(f->userdata, f->height, (const char*)string, len);
-    text_width += (2.0f * t->padding.x);
+    /* the width is measured once and handed on to `nk_draw_text` */
+    if (width < 0) {
+        width = f->width(f->userdata, f->height, (const char*)string, len);
+        NK_STATS_ADD(o, text_measurements, 1);
+    }
+    text_width = width + (2.0f * t->padding.x);
 
     /* align in x-axis */
     if (a & NK_TEXT_ALIGN_LEFT) {
@@ -23835,7 +25988,7 @@ nk_widget_text(struct nk_command_buffer *o, struct nk_rect b,
         label.y = b.y + b.h - f->height;
         label.h = f->height;
     }
-    nk_draw_text(o, label, (const char*)string, len, f, t->background, t->text);
+    nk_draw_text_measured(o, label, (const char*)string, len, width, f, t->background, t->text);
 }
 NK_LIB void
 nk_widget_text_wrap(struct nk_command_buffer *o, struct nk_rect b,
@@ -23868,17 +26021,145 @@ nk_widget_text_wrap(struct nk_command_buffer *o, struct nk_rect b,
     line.h = 2 * t->padding.y + f->height;
 
     fitting = nk_text_clamp(f, string, len, line.w, &glyphs, &width, seperator,NK_LEN(seperator));
+    NK_STATS_ADD(o, text_measurements, glyphs);
     while (done < len) {
         if (!fitting || line.y + line.h >= (b.y + b.h)) break;
         nk_widget_text(o, line, &string[done], fitting, &text, NK_TEXT_LEFT, f);
         done += fitting;
         line.y += f->height + 2 * t->padding.y;
         fitting = nk_text_clamp(f, &string[done], len - done, line.w, &glyphs, &width, seperator,NK_LEN(seperator));
+        NK_STATS_ADD(o, text_measurements, glyphs);
     }
 }
-NK_API void
-nk_text_colored(struct nk_context *ctx, const char *str, int len,
-    nk_flags alignment, struct nk_color color)
+NK_LIB struct nk_text_cache*
+nk_text_cache_get(struct nk_context *ctx, struct nk_window *win)
+{
+    struct nk_text_cache *cache = win->text_cache;
+    if (!cache) {
+        /* the cache is optional: fixed memory contexts go without and a
+         * failed allocation falls back to formatting every frame */
+        struct nk_page_element *elem;
+        if (!ctx->use_pool || ctx->pool.type != NK_BUFFER_DYNAMIC)
+            return 0;
+        elem = nk_try_create_page_element(ctx, NK_PAGE_ELEMENT_TEXT);
+        if (!elem) return 0;
+        cache = &elem->data.text;
+        nk_zero(cache, sizeof(*cache));
+        cache->alloc = ctx->pool.alloc;
+        win->text_cache = cache;
+    }
+    if (cache->seq != win->seq) {
+        /* first use this frame so restart counting value widgets */
+        cache->seq = win->seq;
+        cache->counter = 0;
+    }
+    return cache;
+}
+NK_LIB void
+nk_free_text_cache(struct nk_context *ctx, struct nk_window *win)
+{
+    union nk_page_data *pd = NK_CONTAINER_OF(win->text_cache, union nk_page_data, text);
+    struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
+    if (win->text_cache->entries)
+        win->text_cache->alloc.free(win->text_cache->alloc.userdata, win->text_cache->entries);
+    win->text_cache = 0;
+    nk_free_page_element(ctx, pe, NK_PAGE_ELEMENT_TEXT);
+}
+#ifdef NK_INCLUDE_STANDARD_VARARGS
+NK_LIB nk_hash
+nk_text_cache_key(struct nk_text_cache *cache, const char *str, int len)
+{
+    /* like number properties, widgets without an id are told apart by order */
+    return nk_murmur_hash(str, len, cache->counter++);
+}
+#endif
+NK_INTERN struct nk_text_cache_entry*
+nk_text_cache_slot(struct nk_text_cache *cache, nk_hash key)
+{
+    /* empty entries have no font and the table is never full */
+    const int mask = cache->capacity - 1;
+    int i = (int)(key & (nk_hash)mask);
+    while (cache->entries[i].font && cache->entries[i].key != key)
+        i = (i + 1) & mask;
+    return &cache->entries[i];
+}
+NK_INTERN nk_bool
+nk_text_cache_rebuild(struct nk_text_cache *cache)
+{
+    /* keep entries used in this or the previous frame and leave room for
+     * as many new ones */
+    struct nk_text_cache_entry *entries;
+    int capacity = NK_TEXT_CACHE_SIZE;
+    int live = 0, i;
+    for (i = 0; i < cache->capacity; ++i) {
+        const struct nk_text_cache_entry *entry = &cache->entries[i];
+        if (entry->font && cache->seq - entry->seq <= 1) live++;
+    }
+    while (capacity < 2 * (live + 1))
+        capacity *= 2;
+    entries = (struct nk_text_cache_entry*)cache->alloc.alloc(cache->alloc.userdata,
+        0, sizeof(*entries) * (nk_size)capacity);
+    if (!entries) return nk_false;
+    NK_MEMSET(entries, 0, sizeof(*entries) * (nk_size)capacity);
+    {struct nk_text_cache old = *cache;
+    cache->entries = entries;
+    cache->capacity = capacity;
+    cache->count = live;
+    for (i = 0; i < old.capacity; ++i) {
+        const struct nk_text_cache_entry *entry = &old.entries[i];
+        if (entry->font && cache->seq - entry->seq <= 1)
+            *nk_text_cache_slot(cache, entry->key) = *entry;
+    }
+    if (old.entries)
+        cache->alloc.free(cache->alloc.userdata, old.entries);}
+    return nk_true;
+}
+NK_LIB struct nk_text_cache_entry*
+nk_text_cache_find(struct nk_text_cache *cache, nk_hash key,
+    const nk_uint *value, const struct nk_user_font *font)
+{
+    struct nk_text_cache_entry *entry;
+    if (!cache->capacity) return 0;
+    entry = nk_text_cache_slot(cache, key);
+    if (!entry->font) return 0;
+    entry->seq = cache->seq;
+    if (entry->font != font || entry->height != font->height ||
+        entry->value[0] != value[0] || entry->value[1] != value[1] ||
+        entry->value[2] != value[2])
+        return 0;
+    return entry;
+}
+NK_LIB struct nk_text_cache_entry*
+nk_text_cache_store(struct nk_text_cache *cache, nk_hash key,
+    const nk_uint *value, const struct nk_user_font *font,
+    const char *text, int len, float width)
+{
+    struct nk_text_cache_entry *entry;
+    if (len >= NK_TEXT_CACHE_MAX_TEXT) return 0;
+    if (4 * (cache->count + 1) > 3 * cache->capacity) {
+        /* if the table cannot be rebuilt keep one entry empty for probing */
+        if (!nk_text_cache_rebuild(cache) && cache->count + 1 >= cache->capacity)
+            return 0;
+    }
+    entry = nk_text_cache_slot(cache, key);
+    if (!entry->font) cache->count++;
+    entry->key = key;
+    entry->seq = cache->seq;
+    entry->value[0] = value[0];
+    entry->value[1] = value[1];
+    entry->value[2] = value[2];
+    entry->font = font;
+    entry->height = font->height;
+    entry->width = width;
+    entry->label_width = 0;
+    entry->length = len;
+    NK_MEMCPY(entry->text, text, (nk_size)len);
+    entry->text[len] = '\0';
+    return entry;
+}
+NK_INTERN void
+nk_text_colored_measured(struct nk_context *ctx, const char *str, int len,
+    float width, nk_flags alignment, struct nk_color color)
 {
     struct nk_window *win;
     const struct nk_style *style;
@@ -23901,7 +26182,13 @@ nk_text_colored(struct nk_context *ctx, const char *str, int len,
     text.padding.y = item_padding.y;
     text.background = style->window.background;
     text.text = nk_rgb_factor(color, style->text.color_factor);
-    nk_widget_text(&win->buffer, bounds, str, len, &text, alignment, style->font);
+    nk_widget_text_measured(&win->buffer, bounds, str, len, width, &text, alignment, style->font);
+}
+NK_API void
+nk_text_colored(struct nk_context *ctx, const char *str, int len,
+    nk_flags alignment, struct nk_color color)
+{
+    nk_text_colored_measured(ctx, str, len, -1.0f, alignment, color);
 }
 NK_API void
 nk_text_wrap_colored(struct nk_context *ctx, const char *str,
@@ -23931,6 +26218,87 @@ nk_text_wrap_colored(struct nk_context *ctx, const char *str,
     nk_widget_text_wrap(&win->buffer, bounds, str, len, &text, style->font);
 }
 #ifdef NK_INCLUDE_STANDARD_VARARGS
+NK_INTERN void
+nk_label_cached(struct nk_context *ctx, const char *fmt, const char *str,
+    nk_flags align, struct nk_color color)
+{
+    /* labels are formatted anyway but only measured if the text changed */
+    const struct nk_user_font *font;
+    struct nk_text_cache *cache;
+    struct nk_text_cache_entry *entry;
+    nk_uint value[3];
+    nk_hash key;
+    float width;
+    int len, i = 0;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(ctx->current->layout);
+    if (!ctx || !ctx->current || !ctx->current->layout) return;
+
+    len = nk_strlen(str);
+    cache = nk_text_cache_get(ctx, ctx->current);
+    if (!cache) {
+        nk_text_colored(ctx, str, len, align, color);
+        return;
+    }
+    font = ctx->style.font;
+    value[0] = NK_TEXT_CACHE_LABEL;
+    value[1] = value[2] = 0;
+    key = nk_text_cache_key(cache, fmt, nk_strlen(fmt));
+    entry = nk_text_cache_find(cache, key, value, font);
+    if (entry && entry->length == len)
+        while (i < len && entry->text[i] == str[i]) ++i;
+    if (entry && entry->length == len && i == len) {
+        width = entry->width;
+        NK_STATS_ADD(&ctx->current->buffer, text_cache_hits, 1);
+    } else {
+        width = font->width(font->userdata, font->height, str, len);
+        NK_STATS_ADD(&ctx->current->buffer, text_measurements, 1);
+        nk_text_cache_store(cache, key, value, font, str, len, width);
+    }
+    nk_text_colored_measured(ctx, str, len, width, align, color);
+}
+NK_INTERN void
+nk_value_cached(struct nk_context *ctx, const char *prefix,
+    const nk_uint *value, const char *fmt, ...)
+{
+    /* values skip formatting as well as long as the value is unchanged */
+    const struct nk_user_font *font;
+    struct nk_text_cache *cache;
+    struct nk_text_cache_entry *entry = 0;
+    nk_hash key = 0;
+    char buf[256];
+    float width;
+    va_list args;
+    int len;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(ctx->current->layout);
+    if (!ctx || !ctx->current || !ctx->current->layout) return;
+
+    font = ctx->style.font;
+    cache = nk_text_cache_get(ctx, ctx->current);
+    if (cache) {
+        key = nk_text_cache_key(cache, prefix, nk_strlen(prefix));
+        entry = nk_text_cache_find(cache, key, value, font);
+    }
+    if (entry) {
+        NK_STATS_ADD(&ctx->current->buffer, text_cache_hits, 1);
+        nk_text_colored_measured(ctx, entry->text, entry->length, entry->width,
+            NK_TEXT_LEFT, ctx->style.text.color);
+        return;
+    }
+    va_start(args, fmt);
+    nk_strfmt(buf, NK_LEN(buf), fmt, args);
+    va_end(args);
+    len = nk_strlen(buf);
+    width = font->width(font->userdata, font->height, buf, len);
+    NK_STATS_ADD(&ctx->current->buffer, text_measurements, 1);
+    if (cache) nk_text_cache_store(cache, key, value, font, buf, len, width);
+    nk_text_colored_measured(ctx, buf, len, width, NK_TEXT_LEFT, ctx->style.text.color);
+}
 NK_API void
 nk_labelf_colored(struct nk_context *ctx, nk_flags flags,
     struct nk_color color, const char *fmt, ...)
@@ -23971,7 +26339,7 @@ nk_labelfv_colored(struct nk_context *ctx, nk_flags flags,
 {
     char buf[256];
     nk_strfmt(buf, NK_LEN(buf), fmt, args);
-    nk_label_colored(ctx, buf, flags, color);
+    nk_label_cached(ctx, fmt, buf, flags, color);
 }
 
 NK_API void
@@ -23988,7 +26356,9 @@ nk_labelfv(struct nk_context *ctx, nk_flags flags, const char *fmt, va_list args
 {
     char buf[256];
     nk_strfmt(buf, NK_LEN(buf), fmt, args);
-    nk_label(ctx, buf, flags);
+    NK_ASSERT(ctx);
+    if (!ctx) return;
+    nk_label_cached(ctx, fmt, buf, flags, ctx->style.text.color);
 }
 
 NK_API void
@@ -24002,42 +26372,58 @@ nk_labelfv_wrap(struct nk_context *ctx, const char *fmt, va_list args)
 NK_API void
 nk_value_bool(struct nk_context *ctx, const char *prefix, int value)
 {
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: %s", prefix, ((value) ? "true": "false"));
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_BOOL; key[1] = (value != 0); key[2] = 0;
+    nk_value_cached(ctx, prefix, key, "%s: %s", prefix, ((value) ? "true": "false"));
 }
 NK_API void
 nk_value_int(struct nk_context *ctx, const char *prefix, int value)
 {
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: %d", prefix, value);
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_INT; key[1] = (nk_uint)value; key[2] = 0;
+    nk_value_cached(ctx, prefix, key, "%s: %d", prefix, value);
 }
 NK_API void
 nk_value_uint(struct nk_context *ctx, const char *prefix, unsigned int value)
 {
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: %u", prefix, value);
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_UINT; key[1] = value; key[2] = 0;
+    nk_value_cached(ctx, prefix, key, "%s: %u", prefix, value);
 }
 NK_API void
 nk_value_float(struct nk_context *ctx, const char *prefix, float value)
 {
     double double_value = (double)value;
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: %.3f", prefix, double_value);
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_FLOAT; key[2] = 0;
+    NK_MEMCPY(&key[1], &value, sizeof(value));
+    nk_value_cached(ctx, prefix, key, "%s: %.3f", prefix, double_value);
 }
 NK_API void
 nk_value_color_byte(struct nk_context *ctx, const char *p, struct nk_color c)
 {
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: (%d, %d, %d, %d)", p, c.r, c.g, c.b, c.a);
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_COLOR_BYTE; key[1] = nk_color_u32(c); key[2] = 0;
+    nk_value_cached(ctx, p, key, "%s: (%d, %d, %d, %d)", p, c.r, c.g, c.b, c.a);
 }
 NK_API void
 nk_value_color_float(struct nk_context *ctx, const char *p, struct nk_color color)
 {
-    double c[4]; nk_color_dv(c, color);
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: (%.2f, %.2f, %.2f, %.2f)",
+    double c[4];
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_COLOR_FLOAT; key[1] = nk_color_u32(color); key[2] = 0;
+    nk_color_dv(c, color);
+    nk_value_cached(ctx, p, key, "%s: (%.2f, %.2f, %.2f, %.2f)",
         p, c[0], c[1], c[2], c[3]);
 }
 NK_API void
 nk_value_color_hex(struct nk_context *ctx, const char *prefix, struct nk_color color)
 {
     char hex[16];
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_COLOR_HEX; key[1] = nk_color_u32(color); key[2] = 0;
     nk_color_hex_rgba(hex, color);
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: %s", prefix, hex);
+    nk_value_cached(ctx, prefix, key, "%s: %s", prefix, hex);
 }
 #endif
 NK_API void
@@ -27948,6 +30334,7 @@ nk_edit_draw_text(struct nk_command_buffer *out,
             continue;
         }
         glyph_width = font->width(font->userdata, font->height, text+text_len, glyph_len);
+        NK_STATS_ADD(out, text_measurements, 1);
         line_width += (float)glyph_width;
         text_len += glyph_len;
         glyph_len = nk_utf_decode(text + text_len, &unicode, byte_len-text_len);
@@ -28216,6 +30603,7 @@ nk_do_edit(nk_flags *state, struct nk_command_buffer *out,
                                 &out_offset, &glyph_offset, NK_STOP_ON_NEW_LINE);
                     cursor_pos.x = row_size.x;
                     cursor_ptr = text + text_len;
+                    NK_STATS_ADD(out, text_measurements, glyph_offset);
                 }
 
                 /* set start selection 2D position and line */
@@ -28234,6 +30622,7 @@ nk_do_edit(nk_flags *state, struct nk_command_buffer *out,
                                 &out_offset, &glyph_offset, NK_STOP_ON_NEW_LINE);
                     selection_offset_start.x = row_size.x;
                     select_begin_ptr = text + text_len;
+                    NK_STATS_ADD(out, text_measurements, glyph_offset);
                 }
 
                 /* set end selection 2D position and line */
@@ -28252,6 +30641,7 @@ nk_do_edit(nk_flags *state, struct nk_command_buffer *out,
                                 &out_offset, &glyph_offset, NK_STOP_ON_NEW_LINE);
                     selection_offset_end.x = row_size.x;
                     select_end_ptr = text + text_len;
+                    NK_STATS_ADD(out, text_measurements, glyph_offset);
                 }
                 if (unicode == '\n') {
                     text_size.x = NK_MAX(text_size.x, line_width);
@@ -28274,6 +30664,7 @@ nk_do_edit(nk_flags *state, struct nk_command_buffer *out,
                     text+text_len, glyph_len);
                 continue;
             }
+            NK_STATS_ADD(out, text_measurements, glyphs + 1);
             text_size.y = (float)total_lines * row_height;
 
             /* handle case when cursor is at end of text buffer */
@@ -28450,6 +30841,7 @@ nk_do_edit(nk_flags *state, struct nk_command_buffer *out,
                 label.x = area.x + cursor_pos.x - edit->scrollbar.x;
                 label.y = area.y + cursor_pos.y - edit->scrollbar.y;
                 label.w = font->width(font->userdata, font->height, cursor_ptr, glyph_len);
+                NK_STATS_ADD(out, text_measurements, 1);
                 label.h = row_height;
 
                 txt.padding = nk_vec2(0,0);
@@ -28723,7 +31115,7 @@ nk_property_behavior(nk_flags *ws, const struct nk_input *in,
 NK_LIB void
 nk_draw_property(struct nk_command_buffer *out, const struct nk_style_property *style,
     const struct nk_rect *bounds, const struct nk_rect *label, nk_flags state,
-    const char *name, int len, const struct nk_user_font *font)
+    const char *name, int len, float name_width, const struct nk_user_font *font)
 {
     struct nk_text text;
     const struct nk_style_item *background;
@@ -28762,7 +31154,7 @@ nk_draw_property(struct nk_command_buffer *out, const struct nk_style_property *
     /* draw label */
     text.padding = nk_vec2(0,0);
     if (name && name[0] != '#') {
-        nk_widget_text(out, *label, name, len, &text, NK_TEXT_CENTERED, font);
+        nk_widget_text_measured(out, *label, name, len, name_width, &text, NK_TEXT_CENTERED, font);
     }
 }
 NK_LIB void
@@ -28774,7 +31166,7 @@ nk_do_property(nk_flags *ws,
     const struct nk_style_property *style,
     enum nk_property_filter filter, struct nk_input *in,
     const struct nk_user_font *font, struct nk_text_edit *text_edit,
-    enum nk_button_behavior behavior)
+    enum nk_button_behavior behavior, struct nk_text_cache *cache, nk_hash hash)
 {
     const nk_plugin_filter filters[] = {
         nk_filter_decimal,
@@ -28783,7 +31175,9 @@ nk_do_property(nk_flags *ws,
     nk_bool active, old;
     int num_len = 0, name_len = 0;
     char string[NK_MAX_NUMBER_BUFFER];
-    float size;
+    float size, name_width;
+    struct nk_text_cache_entry *cached = 0;
+    nk_uint value[3];
 
     char *dst = 0;
     int *length;
@@ -28804,9 +31198,32 @@ nk_do_property(nk_flags *ws,
     if (name && name[0] != '#') {
         name_len = nk_strlen(name);
     }
-    size = font->width(font->userdata, font->height, name, name_len);
+    if (cache && *state != NK_PROPERTY_EDIT) {
+        /* the hash includes the name so its width is cached alongside */
+        value[1] = value[2] = 0;
+        switch (variant->kind) {
+        default:
+        case NK_PROPERTY_INT:
+            value[0] = NK_TEXT_CACHE_PROPERTY_INT;
+            value[1] = (nk_uint)variant->value.i; break;
+        case NK_PROPERTY_FLOAT:
+            value[0] = NK_TEXT_CACHE_PROPERTY_FLOAT;
+            NK_MEMCPY(&value[1], &variant->value.f, sizeof(float)); break;
+        case NK_PROPERTY_DOUBLE:
+            value[0] = NK_TEXT_CACHE_PROPERTY_DOUBLE;
+            NK_MEMCPY(&value[1], &variant->value.d, sizeof(double)); break;
+        }
+        cached = nk_text_cache_find(cache, hash, value, font);
+    }
+    if (cached) {
+        name_width = cached->label_width;
+        NK_STATS_ADD(out, text_cache_hits, 1);
+    } else {
+        name_width = font->width(font->userdata, font->height, name, name_len);
+        NK_STATS_ADD(out, text_measurements, 1);
+    }
     label.x = left.x + left.w + style->padding.x;
-    label.w = (float)size + 2 * style->padding.x;
+    label.w = name_width + 2 * style->padding.x;
     label.y = property.y + style->border + style->padding.y;
     label.h = property.h - (2 * style->border + 2 * style->padding.y);
 
@@ -28819,9 +31236,16 @@ nk_do_property(nk_flags *ws,
     /* edit */
     if (*state == NK_PROPERTY_EDIT) {
         size = font->width(font->userdata, font->height, buffer, *len);
+        NK_STATS_ADD(out, text_measurements, 1);
         size += style->edit.cursor_size;
         length = len;
         dst = buffer;
+    } else if (cached) {
+        num_len = cached->length;
+        NK_MEMCPY(string, cached->text, (nk_size)num_len);
+        size = cached->width;
+        dst = string;
+        length = &num_len;
     } else {
         switch (variant->kind) {
         default: break;
@@ -28830,15 +31254,18 @@ nk_do_property(nk_flags *ws,
             num_len = nk_strlen(string);
             break;
         case NK_PROPERTY_FLOAT:
-            NK_DTOA(string, (double)variant->value.f);
-            num_len = nk_string_float_limit(string, NK_MAX_FLOAT_PRECISION);
+            num_len = nk_dtoa_fixed(string, (double)variant->value.f, NK_MAX_FLOAT_PRECISION);
             break;
         case NK_PROPERTY_DOUBLE:
-            NK_DTOA(string, variant->value.d);
-            num_len = nk_string_float_limit(string, NK_MAX_FLOAT_PRECISION);
+            num_len = nk_dtoa_fixed(string, variant->value.d, NK_MAX_FLOAT_PRECISION);
             break;
         }
         size = font->width(font->userdata, font->height, string, num_len);
+        NK_STATS_ADD(out, text_measurements, 1);
+        if (cache) {
+            cached = nk_text_cache_store(cache, hash, value, font, string, num_len, size);
+            if (cached) cached->label_width = name_width;
+        }
         dst = string;
         length = &num_len;
     }
@@ -28861,7 +31288,7 @@ nk_do_property(nk_flags *ws,
 
     /* draw property */
     if (style->draw_begin) style->draw_begin(out, style->userdata);
-    nk_draw_property(out, style, &property, &label, *ws, name, name_len, font);
+    nk_draw_property(out, style, &property, &label, *ws, name, name_len, name_width, font);
     if (style->draw_end) style->draw_end(out, style->userdata);
 
     /* execute right button  */
@@ -29048,7 +31475,7 @@ nk_property(struct nk_context *ctx, const char *name, struct nk_property_variant
     nk_do_property(&ctx->last_widget_state, &win->buffer, bounds, name,
         variant, inc_per_pixel, buffer, len, state, cursor, select_begin,
         select_end, &style->property, filter, in, style->font, &ctx->text_edit,
-        ctx->button_behavior);
+        ctx->button_behavior, nk_text_cache_get(ctx, win), hash);
 
     if (in && *state != NK_PROPERTY_DEFAULT && !win->property.active) {
         /* current property is now hot */
@@ -29431,6 +31858,191 @@ nk_chart_push(struct nk_context *ctx, float value)
 {
     return nk_chart_push_slot(ctx, value, 0);
 }
+struct nk_chart_series {
+    const float *values;
+    int stride;
+    float(*getter)(void*, int);
+    void *userdata;
+    int offset;
+};
+NK_INTERN float
+nk_chart_series_value(const struct nk_chart_series *series, int index)
+{
+    if (series->getter)
+        return series->getter(series->userdata, series->offset + index);
+    return *(const float*)(const void*)((const char*)series->values + index * series->stride);
+}
+NK_INTERN float
+nk_chart_series_y(const struct nk_chart *g, const struct nk_chart_slot *slot, float value)
+{
+    float ratio = (slot->range != 0) ? (value - slot->min) / slot->range: 0;
+    return (g->y + g->h) - ratio * g->h;
+}
+NK_INTERN nk_flags
+nk_chart_push_line_series(struct nk_context *ctx, struct nk_window *win,
+    struct nk_chart *g, const struct nk_chart_series *series, int count, int slot,
+    int *hovered)
+{
+    struct nk_chart_slot *s = &g->slots[slot];
+    struct nk_command_buffer *out = &win->buffer;
+    const struct nk_input *in = ctx->current->widgets_disabled ? 0 : &ctx->input;
+    struct nk_command_polyline *cmd = 0;
+    nk_flags ret = 0;
+    float step;
+    int first = s->index;
+    int columns;
+    int index = -1;
+    int i;
+
+    NK_ASSERT(slot >= 0 && slot < NK_CHART_MAX_SLOT);
+    if (hovered) *hovered = -1;
+    if (count <= 0 || s->count <= 0) return 0;
+    step = g->w / (float)s->count;
+
+    /* at most four points per pixel column (first, min, max, last) are needed to
+     * draw the same outline, so dense series are reduced before drawing */
+    columns = NK_MAX(nk_iceilf(step * (float)count), 1);
+    columns = NK_MIN(columns, 16000);
+    {const struct nk_rect *c = &out->clip;
+    if (!out->use_clipping || NK_INTERSECT(g->x, g->y, g->w, g->h, c->x, c->y, c->w, c->h)) {
+        nk_size size = sizeof(*cmd) + sizeof(short) * 2 * (nk_size)(NK_MIN(count, 4 * columns) + 1);
+        cmd = (struct nk_command_polyline*)nk_command_buffer_push(out, NK_COMMAND_POLYLINE, size);
+    }}
+    if (cmd) {
+        int n = 0;
+        cmd->color = s->color;
+        cmd->line_thickness = 1;
+        if (first) {
+            /* connect with the points pushed before */
+            cmd->points[n].x = (short)s->last.x;
+            cmd->points[n++].y = (short)s->last.y;
+        }
+        if (count <= 4 * columns) {
+            for (i = 0; i < count; ++i) {
+                cmd->points[n].x = (short)(g->x + step * (float)(first + i));
+                cmd->points[n++].y = (short)nk_chart_series_y(g, s, nk_chart_series_value(series, i));
+            }
+        } else {
+            float column_width = (step * (float)count) / (float)columns;
+            int column = 0;
+            int lo = 0, hi = 0, begin = 0;
+            float lo_value, hi_value;
+            lo_value = hi_value = nk_chart_series_value(series, 0);
+            for (i = 1; i <= count; ++i) {
+                float value = 0;
+                int c = columns;
+                if (i < count) {
+                    value = nk_chart_series_value(series, i);
+                    c = NK_MIN((int)((step * (float)i) / column_width), columns - 1);
+                }
+                if (c == column) {
+                    if (value < lo_value) {lo = i; lo_value = value;}
+                    if (value > hi_value) {hi = i; hi_value = value;}
+                    continue;
+                }
+                {/* emit first, min, max and last sample of the column in order */
+                int pick[4], k, p = 0;
+                pick[p++] = begin;
+                if (lo < hi) {pick[p++] = lo; pick[p++] = hi;}
+                else {pick[p++] = hi; pick[p++] = lo;}
+                pick[p++] = i - 1;
+                for (k = 0; k < p; ++k) {
+                    if (k && pick[k] == pick[k-1]) continue;
+                    cmd->points[n].x = (short)(g->x + step * (float)(first + pick[k]));
+                    cmd->points[n++].y = (short)nk_chart_series_y(g, s, nk_chart_series_value(series, pick[k]));
+                }}
+                column = c;
+                begin = lo = hi = i;
+                lo_value = hi_value = value;
+            }
+        }
+        cmd->point_count = (unsigned short)n;
+    }
+
+    /* hit test only samples inside the marker box around the mouse */
+    if (!(win->layout->flags & NK_WINDOW_ROM) && in &&
+        NK_INBOX(in->mouse.pos.x, in->mouse.pos.y, g->x - 3, g->y - 3, g->w + 6, g->h + 6)) {
+        float dx = in->mouse.pos.x - g->x;
+        int lo = NK_MAX(nk_iceilf((dx - 3) / step) - first, 0);
+        int hi = NK_MIN((int)((dx + 3) / step) - first, count - 1);
+        float best = 3;
+        for (i = lo; i <= hi; ++i) {
+            float y = nk_chart_series_y(g, s, nk_chart_series_value(series, i));
+            float dy = NK_ABS(in->mouse.pos.y - y);
+            if (dy <= best) {best = dy; index = i;}
+        }
+        if (index >= 0) {
+            ret = NK_CHART_HOVERING;
+            ret |= (!in->mouse.buttons[NK_BUTTON_LEFT].down &&
+                in->mouse.buttons[NK_BUTTON_LEFT].clicked) ? NK_CHART_CLICKED: 0;
+            if (hovered) *hovered = first + index;
+        }
+    }
+
+    /* markers are drawn for every sample unless the series was decimated,
+     * in which case only the hovered sample is marked */
+    if (s->show_markers) {
+        int begin = (count <= 4 * columns) ? 0: index;
+        int end = (count <= 4 * columns) ? count: index + 1;
+        for (i = NK_MAX(begin, 0); i < end; ++i) {
+            float x = g->x + step * (float)(first + i);
+            float y = nk_chart_series_y(g, s, nk_chart_series_value(series, i));
+            nk_fill_rect(out, nk_rect(x - 2, y - 2, 4, 4), 0,
+                (i == index) ? s->highlight: s->color);
+        }
+    }
+
+    /* save last data point position */
+    s->last.x = g->x + step * (float)(first + count - 1);
+    s->last.y = nk_chart_series_y(g, s, nk_chart_series_value(series, count - 1));
+    s->index += count;
+    return ret;
+}
+NK_INTERN nk_flags
+nk_chart_push_series(struct nk_context *ctx, const struct nk_chart_series *series,
+    int count, int slot, int *hovered)
+{
+    struct nk_window *win;
+    struct nk_chart *chart;
+    nk_flags flags = 0;
+    int i;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(slot >= 0 && slot < NK_CHART_MAX_SLOT);
+    if (hovered) *hovered = -1;
+    if (!ctx || !ctx->current || slot < 0 || slot >= NK_CHART_MAX_SLOT) return 0;
+    win = ctx->current;
+    chart = &win->layout->chart;
+    if (slot >= chart->slot) return 0;
+
+    if (chart->slots[slot].type == NK_CHART_LINES)
+        return nk_chart_push_line_series(ctx, win, chart, series, count, slot, hovered);
+    for (i = 0; i < count; ++i) {
+        nk_flags ret = nk_chart_push_slot(ctx, nk_chart_series_value(series, i), slot);
+        if (ret && hovered) *hovered = chart->slots[slot].index - 1;
+        flags |= ret;
+    }
+    return flags;
+}
+NK_API nk_flags
+nk_chart_push_slot_values(struct nk_context *ctx, const float *values, int count,
+    int stride, int slot, int *hovered)
+{
+    struct nk_chart_series series;
+    NK_ASSERT(values);
+    if (!values) return 0;
+    nk_zero_struct(series);
+    series.values = values;
+    series.stride = (stride) ? stride: (int)sizeof(float);
+    return nk_chart_push_series(ctx, &series, count, slot, hovered);
+}
+NK_API nk_flags
+nk_chart_push_values(struct nk_context *ctx, const float *values, int count,
+    int stride, int *hovered)
+{
+    return nk_chart_push_slot_values(ctx, values, count, stride, 0, hovered);
+}
 NK_API void
 nk_chart_end(struct nk_context *ctx)
 {
@@ -29467,8 +32079,7 @@ nk_plot(struct nk_context *ctx, enum nk_chart_type type, const float *values,
     }
 
     if (nk_chart_begin(ctx, type, count, min_value, max_value)) {
-        for (i = 0; i < count; ++i)
-            nk_chart_push(ctx, values[i + offset]);
+        nk_chart_push_values(ctx, values + offset, count, 0, 0);
         nk_chart_end(ctx);
     }
 }
@@ -29492,12 +32103,283 @@ nk_plot_function(struct nk_context *ctx, enum nk_chart_type type, void *userdata
     }
 
     if (nk_chart_begin(ctx, type, count, min_value, max_value)) {
-        for (i = 0; i < count; ++i)
-            nk_chart_push(ctx, value_getter(userdata, i + offset));
+        struct nk_chart_series series;
+        nk_zero_struct(series);
+        series.getter = value_getter;
+        series.userdata = userdata;
+        series.offset = offset;
+        nk_chart_push_series(ctx, &series, count, 0, 0);
         nk_chart_end(ctx);
     }
 }
 
+NK_LIB void
+nk_free_chart_stream(struct nk_context *ctx, struct nk_window *win,
+    struct nk_chart_stream *stream)
+{
+    union nk_page_data *pd = NK_CONTAINER_OF(stream, union nk_page_data, stream);
+    struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
+    if (stream->values)
+        ctx->pool.alloc.free(ctx->pool.alloc.userdata, stream->values);
+    if (win->streams == stream)
+        win->streams = stream->next;
+    if (stream->next)
+        stream->next->prev = stream->prev;
+    if (stream->prev)
+        stream->prev->next = stream->next;
+    nk_free_page_element(ctx, pe, NK_PAGE_ELEMENT_STREAM);
+}
+NK_INTERN struct nk_chart_stream*
+nk_chart_stream_find(struct nk_context *ctx, struct nk_window *win,
+    const char *name, int series, int capacity)
+{
+    nk_hash hash = nk_murmur_hash(name, (int)nk_strlen(name), NK_PAGE_ELEMENT_STREAM);
+    struct nk_chart_stream *stream = win->streams;
+    while (stream && stream->name != hash)
+        stream = stream->next;
+    if (!stream) {
+        struct nk_page_element *elem;
+        if (!series || !ctx->use_pool || ctx->pool.type != NK_BUFFER_DYNAMIC)
+            return 0;
+        elem = nk_create_page_element(ctx, NK_PAGE_ELEMENT_STREAM);
+        if (!elem) return 0;
+        stream = &elem->data.stream;
+        stream->name = hash;
+        stream->next = win->streams;
+        if (win->streams)
+            win->streams->prev = stream;
+        win->streams = stream;
+    }
+    if (series) {
+        /* every series gets `capacity` samples rounded up to whole buckets */
+        capacity = (capacity > 0) ? capacity: NK_CHART_STREAM_CAPACITY;
+        capacity += (NK_CHART_STREAM_BUCKET - capacity % NK_CHART_STREAM_BUCKET) % NK_CHART_STREAM_BUCKET;
+        if (stream->series != series || stream->capacity != capacity) {
+            nk_size size = (nk_size)series * (nk_size)capacity * sizeof(float);
+            size += size / NK_CHART_STREAM_BUCKET * 2;
+            if (stream->values)
+                ctx->pool.alloc.free(ctx->pool.alloc.userdata, stream->values);
+            stream->values = (float*)ctx->pool.alloc.alloc(ctx->pool.alloc.userdata, 0, size);
+            stream->buckets = 0;
+            stream->series = stream->capacity = 0;
+            stream->head = stream->count = 0;
+            if (!stream->values) return 0;
+            stream->buckets = stream->values + series * capacity;
+            stream->series = series;
+            stream->capacity = capacity;
+        }
+    }
+    stream->seq = win->seq;
+    return stream;
+}
+NK_API nk_bool
+nk_chart_stream_push(struct nk_context *ctx, const char *name,
+    const float *values, int series, int capacity)
+{
+    struct nk_chart_stream *stream;
+    int at, i;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(name);
+    NK_ASSERT(values);
+    NK_ASSERT(series > 0 && series <= NK_CHART_STREAM_MAX_SERIES);
+    if (!ctx || !ctx->current || !name || !values) return nk_false;
+    if (series <= 0 || series > NK_CHART_STREAM_MAX_SERIES) return nk_false;
+    stream = nk_chart_stream_find(ctx, ctx->current, name, series, capacity);
+    if (!stream) return nk_false;
+
+    at = stream->head + stream->count;
+    if (at >= stream->capacity)
+        at -= stream->capacity;
+    if (stream->count < stream->capacity)
+        stream->count++;
+    else if (++stream->head == stream->capacity)
+        stream->head = 0;
+
+    for (i = 0; i < series; ++i) {
+        int slot = i * stream->capacity + at;
+        float *bucket = stream->buckets + slot / NK_CHART_STREAM_BUCKET * 2;
+        stream->values[slot] = values[i];
+        if (at % NK_CHART_STREAM_BUCKET == 0) {
+            /* entering a bucket overwrites its oldest samples */
+            bucket[0] = bucket[1] = values[i];
+        } else {
+            bucket[0] = NK_MIN(bucket[0], values[i]);
+            bucket[1] = NK_MAX(bucket[1], values[i]);
+        }
+    }
+    return nk_true;
+}
+NK_INTERN float
+nk_chart_stream_value(const struct nk_chart_stream *stream, int series, int index)
+{
+    int at = stream->head + index;
+    if (at >= stream->capacity)
+        at -= stream->capacity;
+    return stream->values[series * stream->capacity + at];
+}
+NK_INTERN void
+nk_chart_stream_range(const struct nk_chart_stream *stream, int series,
+    int begin, int end, float *lo, float *hi)
+{
+    /* whole buckets inside [begin, end) are read from the bucket summary. The
+     * bucket which is currently overwritten can never lie completely inside
+     * the range since it holds both the oldest and the newest samples */
+    const float *values = stream->values + series * stream->capacity;
+    const int first_bucket = series * stream->capacity / NK_CHART_STREAM_BUCKET;
+    int at = stream->head + begin;
+    if (at >= stream->capacity)
+        at -= stream->capacity;
+    *lo = *hi = values[at];
+    while (begin < end) {
+        if (at % NK_CHART_STREAM_BUCKET == 0 && begin + NK_CHART_STREAM_BUCKET <= end) {
+            const float *bucket = stream->buckets + (first_bucket + at / NK_CHART_STREAM_BUCKET) * 2;
+            *lo = NK_MIN(*lo, bucket[0]);
+            *hi = NK_MAX(*hi, bucket[1]);
+            begin += NK_CHART_STREAM_BUCKET;
+            at += NK_CHART_STREAM_BUCKET;
+        } else {
+            *lo = NK_MIN(*lo, values[at]);
+            *hi = NK_MAX(*hi, values[at]);
+            begin++;
+            at++;
+        }
+        if (at == stream->capacity)
+            at = 0;
+    }
+}
+NK_INTERN void
+nk_chart_stream_draw(struct nk_command_buffer *out, const struct nk_chart *g,
+    const struct nk_chart_slot *slot, const struct nk_chart_stream *stream, int series)
+{
+    const int count = stream->count;
+    const float step = g->w / (float)stream->capacity;
+    const float right = g->x + g->w;
+    struct nk_command_polyline *cmd;
+    int columns, n = 0, i;
+    nk_size size;
+
+    columns = NK_MAX(nk_iceilf(step * (float)count), 1);
+    columns = NK_MIN(columns, 16000);
+    size = sizeof(*cmd) + sizeof(short) * 2 * (nk_size)NK_MIN(count, 4 * columns);
+    cmd = (struct nk_command_polyline*)nk_command_buffer_push(out, NK_COMMAND_POLYLINE, size);
+    if (!cmd) return;
+    cmd->color = slot->color;
+    cmd->line_thickness = 1;
+
+    if (count <= 4 * columns) {
+        for (i = 0; i < count; ++i) {
+            cmd->points[n].x = (short)(right - step * (float)(count - 1 - i));
+            cmd->points[n++].y = (short)nk_chart_series_y(g, slot, nk_chart_stream_value(stream, series, i));
+        }
+    } else {
+        /* reduce each pixel column to its first, min, max and last sample */
+        for (i = 0; i < columns; ++i) {
+            const int begin = (int)(((nk_size)i * (nk_size)count) / (nk_size)columns);
+            const int end = (int)(((nk_size)(i + 1) * (nk_size)count) / (nk_size)columns);
+            float first = nk_chart_stream_value(stream, series, begin);
+            float last = nk_chart_stream_value(stream, series, end - 1);
+            float x = right - step * (float)(count - 1 - begin);
+            float lo, hi, y[4];
+            int k;
+
+            nk_chart_stream_range(stream, series, begin, end, &lo, &hi);
+            y[0] = first;
+            if (first - lo < hi - first) {y[1] = lo; y[2] = hi;}
+            else {y[1] = hi; y[2] = lo;}
+            y[3] = last;
+            for (k = 0; k < 4; ++k) {
+                if (k && y[k] == y[k-1]) continue;
+                if (k == 3) x = right - step * (float)(count - end);
+                cmd->points[n].x = (short)x;
+                cmd->points[n++].y = (short)nk_chart_series_y(g, slot, y[k]);
+            }
+        }
+    }
+    cmd->point_count = (unsigned short)n;
+}
+NK_API nk_flags
+nk_chart_stream(struct nk_context *ctx, const char *name,
+    const struct nk_color *colors, float min, float max,
+    int *series, int *index)
+{
+    struct nk_window *win;
+    struct nk_chart_stream *stream;
+    struct nk_chart *g;
+    const struct nk_input *in;
+    struct nk_chart_slot slot;
+    nk_flags ret = 0;
+    int i;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(name);
+    if (series) *series = -1;
+    if (index) *index = -1;
+    if (!ctx || !ctx->current || !ctx->current->layout || !name) return 0;
+
+    win = ctx->current;
+    stream = nk_chart_stream_find(ctx, win, name, 0, 0);
+    if (stream && stream->count && min == max) {
+        for (i = 0; i < stream->series; ++i) {
+            float lo, hi;
+            nk_chart_stream_range(stream, i, 0, stream->count, &lo, &hi);
+            min = (i) ? NK_MIN(min, lo): lo;
+            max = (i) ? NK_MAX(max, hi): hi;
+        }
+    }
+    if (!nk_chart_begin(ctx, NK_CHART_LINES, (stream && stream->capacity) ? stream->capacity: 1, min, max))
+        return 0;
+    g = &win->layout->chart;
+    slot = g->slots[0];
+    if (!stream || !stream->count) {
+        nk_chart_end(ctx);
+        return 0;
+    }
+
+    {const struct nk_rect *c = &win->buffer.clip;
+    if (!win->buffer.use_clipping || NK_INTERSECT(g->x, g->y, g->w, g->h, c->x, c->y, c->w, c->h)) {
+        for (i = 0; i < stream->series; ++i) {
+            if (colors) slot.color = nk_rgb_factor(colors[i], ctx->style.chart.color_factor);
+            nk_chart_stream_draw(&win->buffer, g, &slot, stream, i);
+        }
+    }}
+
+    /* hit test only samples inside the marker box around the mouse */
+    in = win->widgets_disabled ? 0 : &ctx->input;
+    if (!(win->layout->flags & NK_WINDOW_ROM) && in &&
+        NK_INBOX(in->mouse.pos.x, in->mouse.pos.y, g->x - 3, g->y - 3, g->w + 6, g->h + 6)) {
+        const float step = g->w / (float)stream->capacity;
+        const float dx = g->x + g->w - in->mouse.pos.x;
+        const int last = stream->count - 1;
+        int lo = NK_MAX(last - (int)((dx + 3) / step), 0);
+        int hi = NK_MIN(last - nk_iceilf((dx - 3) / step), last);
+        int hit = -1, hit_series = -1, j;
+        float best = 3;
+        for (i = 0; i < stream->series; ++i) {
+            for (j = lo; j <= hi; ++j) {
+                float y = nk_chart_series_y(g, &slot, nk_chart_stream_value(stream, i, j));
+                float dy = NK_ABS(in->mouse.pos.y - y);
+                if (dy <= best) {best = dy; hit = j; hit_series = i;}
+            }
+        }
+        if (hit >= 0) {
+            struct nk_vec2 p;
+            p.x = g->x + g->w - step * (float)(last - hit);
+            p.y = nk_chart_series_y(g, &slot, nk_chart_stream_value(stream, hit_series, hit));
+            ret = NK_CHART_HOVERING;
+            ret |= (!in->mouse.buttons[NK_BUTTON_LEFT].down &&
+                in->mouse.buttons[NK_BUTTON_LEFT].clicked) ? NK_CHART_CLICKED: 0;
+            if (slot.show_markers)
+                nk_fill_rect(&win->buffer, nk_rect(p.x - 2, p.y - 2, 4, 4), 0, slot.highlight);
+            if (series) *series = hit_series;
+            if (index) *index = hit;
+        }
+    }
+    nk_chart_end(ctx);
+    return ret;
+}
 
 
 
@@ -30404,6 +33286,25 @@ NK_API void nk_combo_close(struct nk_context *ctx)
 {
     nk_contextual_close(ctx);
 }
+NK_INTERN void
+nk_combo_rows_begin(struct nk_context *ctx, int count, int *begin, int *end)
+{
+    /* only rows overlapping the visible part of the popup are laid out and
+     * drawn. All rows above are skipped by moving the layout cursor */
+    struct nk_panel *layout = ctx->current->layout;
+    float row_height = NK_MAX(layout->row.height, 1.0f);
+    float offset = (float)*layout->offset_y;
+    *begin = NK_CLAMP(0, (int)(offset / row_height), count);
+    *end = NK_CLAMP(*begin, nk_iceilf((offset + layout->clip.h) / row_height) + 1, count);
+    layout->at_y += row_height * (float)*begin;
+}
+NK_INTERN void
+nk_combo_rows_end(struct nk_context *ctx, int count, int end)
+{
+    /* skip rows below so the scrollbar still covers all items */
+    struct nk_panel *layout = ctx->current->layout;
+    layout->at_y += layout->row.height * (float)(count - end);
+}
 NK_API int
 nk_combo(struct nk_context *ctx, const char *const *items, int count,
     int selected, int item_height, struct nk_vec2 size)
@@ -30425,15 +33326,28 @@ nk_combo(struct nk_context *ctx, const char *const *items, int count,
     max_height += (int)item_spacing.y * 2 + (int)window_padding.y * 2;
     size.y = NK_MIN(size.y, (float)max_height);
     if (nk_combo_begin_label(ctx, items[selected], size)) {
+        int begin, end;
         nk_layout_row_dynamic(ctx, (float)item_height, 1);
-        for (i = 0; i < count; ++i) {
+        nk_combo_rows_begin(ctx, count, &begin, &end);
+        for (i = begin; i < end; ++i) {
             if (nk_combo_item_label(ctx, items[i], NK_TEXT_LEFT))
                 selected = i;
         }
+        nk_combo_rows_end(ctx, count, end);
         nk_combo_end(ctx);
     }
     return selected;
 }
+NK_INTERN const char*
+nk_combo_separator_seek(const char *item, int separator, int from, int to)
+{
+    /* walk item by item from a known item start */
+    for (; from < to; ++from) {
+        while (*item && *item != separator) item++;
+        if (*item == (char)separator) item++;
+    }
+    return item;
+}
 NK_API int
 nk_combo_separator(struct nk_context *ctx, const char *items_separated_by_separator,
     int separator, int selected, int count, int item_height, struct nk_vec2 size)
@@ -30444,6 +33358,7 @@ nk_combo_separator(struct nk_context *ctx, const char *items_separated_by_separa
     struct nk_vec2 window_padding;
     const char *current_item;
     const char *iter;
+    int current;
     int length = 0;
 
     NK_ASSERT(ctx);
@@ -30458,27 +33373,34 @@ nk_combo_separator(struct nk_context *ctx, const char *items_separated_by_separa
     max_height += (int)item_spacing.y * 2 + (int)window_padding.y * 2;
     size.y = NK_MIN(size.y, (float)max_height);
 
-    /* find selected item */
-    current_item = items_separated_by_separator;
-    for (i = 0; i < count; ++i) {
-        iter = current_item;
-        while (*iter && *iter != separator) iter++;
-        length = (int)(iter - current_item);
-        if (i == selected) break;
-        current_item = iter + 1;
-    }
+    /* find selected item. Item offsets are not kept across frames since the
+     * caller may rewrite the string in place and validating a stored offset
+     * costs as much as the scan itself. */
+    current = NK_CLAMP(0, selected, count-1);
+    current_item = nk_combo_separator_seek(items_separated_by_separator,
+        separator, 0, current);
+    iter = current_item;
+    while (*iter && *iter != separator) iter++;
+    length = (int)(iter - current_item);
 
     if (nk_combo_begin_text(ctx, current_item, length, size)) {
-        current_item = items_separated_by_separator;
+        int begin, end;
         nk_layout_row_dynamic(ctx, (float)item_height, 1);
-        for (i = 0; i < count; ++i) {
+        nk_combo_rows_begin(ctx, count, &begin, &end);
+        /* continue from the selected item if the first visible row follows it */
+        if (begin >= current)
+            current_item = nk_combo_separator_seek(current_item, separator, current, begin);
+        else current_item = nk_combo_separator_seek(items_separated_by_separator,
+            separator, 0, begin);
+        for (i = begin; i < end; ++i) {
             iter = current_item;
             while (*iter && *iter != separator) iter++;
             length = (int)(iter - current_item);
             if (nk_combo_item_text(ctx, current_item, length, NK_TEXT_LEFT))
                 selected = i;
-            current_item = current_item + length + 1;
+            current_item = (*iter == (char)separator) ? iter + 1: iter;
         }
+        nk_combo_rows_end(ctx, count, end);
         nk_combo_end(ctx);
     }
     return selected;
@@ -30513,12 +33435,15 @@ nk_combo_callback(struct nk_context *ctx, void(*item_getter)(void*, int, const c
 
     item_getter(userdata, selected, &item);
     if (nk_combo_begin_label(ctx, item, size)) {
+        int begin, end;
         nk_layout_row_dynamic(ctx, (float)item_height, 1);
-        for (i = 0; i < count; ++i) {
+        nk_combo_rows_begin(ctx, count, &begin, &end);
+        for (i = begin; i < end; ++i) {
             item_getter(userdata, i, &item);
             if (nk_combo_item_label(ctx, item, NK_TEXT_LEFT))
                 selected = i;
         }
+        nk_combo_rows_end(ctx, count, end);
         nk_combo_end(ctx);
     } return selected;
 }
@@ -30631,6 +33556,7 @@ nk_tooltip(struct nk_context *ctx, const char *text)
     text_len = nk_strlen(text);
     text_width = style->font->width(style->font->userdata,
                     style->font->height, text, text_len);
+    NK_STATS_ADD(&ctx->current->buffer, text_measurements, 1);
     text_width += (4 * padding.x);
     text_height = (style->font->height + 2 * padding.y);
 
@@ -30661,6 +33587,2057 @@ nk_tooltipfv(struct nk_context *ctx, const char *fmt, va_list args)
 
 
 
+
+
+
+/* ===============================================================
+ *
+ *                          FRAME STATS
+ *
+ * ===============================================================*/
+#ifdef NK_INCLUDE_FRAME_STATS
+NK_LIB void
+nk_stats_panel_begin(struct nk_context *ctx, struct nk_window *win,
+    const char *title, enum nk_panel_type type)
+{
+    struct nk_frame_stats *stats = &ctx->stats;
+    struct nk_panel *layout = win->layout;
+    struct nk_panel_stats *panel;
+    const char *name;
+    int len;
+
+    /* window buffers still point to last frame so only sub panels have a parent */
+    layout->stats_parent = nk_panel_is_sub(type) ? win->buffer.stats : 0;
+    if (stats->panel_count >= NK_FRAME_STATS_MAX_PANELS) {
+        /* out of records so everything is counted into the parent */
+        stats->dropped_panels++;
+        layout->stats = 0;
+        win->buffer.stats = layout->stats_parent;
+        return;
+    }
+    panel = &stats->panels[stats->panel_count++];
+    panel->type = type;
+    panel->parent = (layout->stats_parent) ? (int)(layout->stats_parent - stats->panels): -1;
+    panel->begin = ctx->memory.allocated;
+    panel->end = panel->begin;
+
+    name = (title) ? title: (type == NK_PANEL_WINDOW) ? win->name_string: "";
+    len = NK_MIN((int)nk_strlen(name), NK_WINDOW_MAX_NAME-1);
+    NK_MEMCPY(panel->name, name, (nk_size)len);
+    panel->name[len] = '\0';
+
+    layout->stats = panel;
+    win->buffer.stats = panel;
+}
+NK_LIB void
+nk_stats_panel_end(struct nk_context *ctx, struct nk_window *win)
+{
+    struct nk_panel *layout = win->layout;
+    if (layout->stats)
+        layout->stats->end = ctx->memory.allocated;
+    win->buffer.stats = layout->stats_parent;
+}
+NK_LIB struct nk_panel_stats*
+nk_stats_panel_at(struct nk_context *ctx, nk_size offset)
+{
+    /* nested panels are recorded after their parents so search backwards */
+    int i = ctx->stats.panel_count;
+    while (i-- > 0) {
+        struct nk_panel_stats *panel = &ctx->stats.panels[i];
+        if (panel->begin <= offset && offset < panel->end)
+            return panel;
+    }
+    return 0;
+}
+NK_INTERN nk_size
+nk_stats_pool_memory(const struct nk_context *ctx)
+{
+    const struct nk_pool *pool = &ctx->pool;
+    nk_size size = 0;
+    int type;
+
+    if (!ctx->use_pool)
+        return ctx->memory.memory.size - ctx->memory.size;
+    if (pool->type == NK_BUFFER_FIXED)
+        return pool->allocated;
+    for (type = 0; type < NK_PAGE_ELEMENT_TYPE_COUNT; ++type) {
+        const struct nk_page *iter = pool->pages[type];
+        nk_size elem_size = nk_pool_element_size((enum nk_page_element_type)type);
+        for (; iter; iter = iter->next)
+            size += NK_OFFSETOF(struct nk_page, win) + pool->capacity * elem_size;
+    }
+    return size;
+}
+NK_LIB void
+nk_stats_clear(struct nk_context *ctx)
+{
+    struct nk_frame_stats *stats = &ctx->stats;
+    struct nk_memory_stats *max = &stats->high_water;
+
+    stats->memory.commands = ctx->memory.allocated;
+    stats->memory.pool = nk_stats_pool_memory(ctx);
+    max->commands = NK_MAX(max->commands, stats->memory.commands);
+    max->pool = NK_MAX(max->pool, stats->memory.pool);
+    max->draw_commands = NK_MAX(max->draw_commands, stats->memory.draw_commands);
+    max->vertices = NK_MAX(max->vertices, stats->memory.vertices);
+    max->elements = NK_MAX(max->elements, stats->memory.elements);
+
+    /* publish finished frame and start a new one only keeping high-water marks */
+    ctx->last_stats = *stats;
+    nk_zero_struct(*stats);
+    stats->high_water = ctx->last_stats.high_water;
+}
+NK_API const struct nk_frame_stats*
+nk_frame_stats(const struct nk_context *ctx)
+{
+    NK_ASSERT(ctx);
+    if (!ctx) return 0;
+    return &ctx->last_stats;
+}
+NK_INTERN void
+nk_stats_label(struct nk_context *ctx, nk_size value)
+{
+    char buffer[32];
+    nk_itoa(buffer, (long)value);
+    nk_label(ctx, buffer, NK_TEXT_RIGHT);
+}
+NK_API nk_bool
+nk_frame_stats_window(struct nk_context *ctx, const char *title,
+    struct nk_rect bounds, nk_flags flags)
+{
+    NK_STORAGE const float memory_ratio[] = {0.4f, 0.3f, 0.3f};
+    NK_STORAGE const float panel_ratio[] = {0.24f, 0.1f, 0.12f, 0.1f, 0.1f, 0.1f, 0.12f, 0.12f};
+    const struct nk_frame_stats *stats;
+    nk_bool visible;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(title);
+    if (!ctx || !title) return 0;
+
+    /* show the last finished frame since the current one is still recorded */
+    stats = &ctx->last_stats;
+    visible = nk_begin(ctx, title, bounds, flags);
+    if (visible) {
+        int i;
+        nk_layout_row(ctx, NK_DYNAMIC, 0, 3, memory_ratio);
+        nk_label(ctx, "memory", NK_TEXT_LEFT);
+        nk_label(ctx, "frame", NK_TEXT_RIGHT);
+        nk_label(ctx, "peak", NK_TEXT_RIGHT);
+        nk_label(ctx, "commands", NK_TEXT_LEFT);
+        nk_stats_label(ctx, stats->memory.commands);
+        nk_stats_label(ctx, stats->high_water.commands);
+        nk_label(ctx, "pool", NK_TEXT_LEFT);
+        nk_stats_label(ctx, stats->memory.pool);
+        nk_stats_label(ctx, stats->high_water.pool);
+        nk_label(ctx, "draw commands", NK_TEXT_LEFT);
+        nk_stats_label(ctx, stats->memory.draw_commands);
+        nk_stats_label(ctx, stats->high_water.draw_commands);
+        nk_label(ctx, "vertices", NK_TEXT_LEFT);
+        nk_stats_label(ctx, stats->memory.vertices);
+        nk_stats_label(ctx, stats->high_water.vertices);
+        nk_label(ctx, "elements", NK_TEXT_LEFT);
+        nk_stats_label(ctx, stats->memory.elements);
+        nk_stats_label(ctx, stats->high_water.elements);
+
+        nk_layout_row(ctx, NK_DYNAMIC, 0, 8, panel_ratio);
+        nk_label(ctx, "panel", NK_TEXT_LEFT);
+        nk_label(ctx, "cmds", NK_TEXT_RIGHT);
+        nk_label(ctx, "bytes", NK_TEXT_RIGHT);
+        nk_label(ctx, "vtx", NK_TEXT_RIGHT);
+        nk_label(ctx, "idx", NK_TEXT_RIGHT);
+        nk_label(ctx, "tbl", NK_TEXT_RIGHT);
+        nk_label(ctx, "text", NK_TEXT_RIGHT);
+        nk_label(ctx, "cached", NK_TEXT_RIGHT);
+        for (i = 0; i < stats->panel_count; ++i) {
+            const struct nk_panel_stats *panel = &stats->panels[i];
+            char name[NK_WINDOW_MAX_NAME + 16];
+            nk_size commands = 0;
+            int depth = 0, parent, len = 0, n;
+
+            for (parent = panel->parent; parent >= 0 && depth < 8; ++depth)
+                parent = stats->panels[parent].parent;
+            while (len < depth * 2) name[len++] = ' ';
+            n = nk_strlen(panel->name);
+            NK_MEMCPY(&name[len], panel->name, (nk_size)n);
+            name[len + n] = '\0';
+            for (n = 0; n < NK_COMMAND_TYPE_COUNT; ++n)
+                commands += panel->commands[n];
+
+            nk_label(ctx, name, NK_TEXT_LEFT);
+            nk_stats_label(ctx, commands);
+            nk_stats_label(ctx, panel->command_bytes);
+            nk_stats_label(ctx, panel->vertices);
+            nk_stats_label(ctx, panel->indices);
+            nk_stats_label(ctx, panel->table_lookups);
+            nk_stats_label(ctx, panel->text_measurements);
+            nk_stats_label(ctx, panel->text_cache_hits);
+        }
+        if (stats->dropped_panels) {
+            nk_layout_row_dynamic(ctx, 0, 2);
+            nk_label(ctx, "untracked panels", NK_TEXT_LEFT);
+            nk_stats_label(ctx, stats->dropped_panels);
+        }
+    }
+    nk_end(ctx);
+    return visible;
+}
+#endif
+
+
+
+
+
+/* ===============================================================
+ *
+ *                          FRAME DELTA
+ *
+ * ===============================================================*/
+NK_INTERN struct nk_rect
+nk_delta_points_bounds(const struct nk_vec2i *points, int count, float pad)
+{
+    short x0, y0, x1, y1;
+    int i;
+    if (!count) return nk_rect(0,0,0,0);
+    x0 = x1 = points[0].x;
+    y0 = y1 = points[0].y;
+    for (i = 1; i < count; ++i) {
+        x0 = NK_MIN(x0, points[i].x); x1 = NK_MAX(x1, points[i].x);
+        y0 = NK_MIN(y0, points[i].y); y1 = NK_MAX(y1, points[i].y);
+    }
+    return nk_rect((float)x0 - pad, (float)y0 - pad,
+        (float)(x1 - x0) + 2 * pad, (float)(y1 - y0) + 2 * pad);
+}
+NK_INTERN struct nk_rect
+nk_delta_rect_bounds(short x, short y, unsigned short w, unsigned short h, float pad)
+{
+    return nk_rect((float)x - pad, (float)y - pad, (float)w + 2 * pad, (float)h + 2 * pad);
+}
+NK_LIB struct nk_rect
+nk_command_bounds(const struct nk_command *cmd)
+{
+    /* strokes are padded by their thickness plus one pixel of anti-aliasing */
+    switch (cmd->type) {
+    case NK_COMMAND_SCISSOR: {
+        const struct nk_command_scissor *s = (const struct nk_command_scissor*)cmd;
+        return nk_delta_rect_bounds(s->x, s->y, s->w, s->h, 0);
+    }
+    case NK_COMMAND_LINE: {
+        const struct nk_command_line *l = (const struct nk_command_line*)cmd;
+        struct nk_vec2i p[2];
+        p[0] = l->begin; p[1] = l->end;
+        return nk_delta_points_bounds(p, 2, l->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_CURVE: {
+        const struct nk_command_curve *q = (const struct nk_command_curve*)cmd;
+        struct nk_vec2i p[4];
+        p[0] = q->begin; p[1] = q->ctrl[0]; p[2] = q->ctrl[1]; p[3] = q->end;
+        return nk_delta_points_bounds(p, 4, q->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_RECT: {
+        const struct nk_command_rect *r = (const struct nk_command_rect*)cmd;
+        return nk_delta_rect_bounds(r->x, r->y, r->w, r->h, r->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_RECT_FILLED: {
+        const struct nk_command_rect_filled *r = (const struct nk_command_rect_filled*)cmd;
+        return nk_delta_rect_bounds(r->x, r->y, r->w, r->h, 1.0f);
+    }
+    case NK_COMMAND_RECT_MULTI_COLOR: {
+        const struct nk_command_rect_multi_color *r = (const struct nk_command_rect_multi_color*)cmd;
+        return nk_delta_rect_bounds(r->x, r->y, r->w, r->h, 1.0f);
+    }
+    case NK_COMMAND_CIRCLE: {
+        const struct nk_command_circle *c = (const struct nk_command_circle*)cmd;
+        return nk_delta_rect_bounds(c->x, c->y, c->w, c->h, c->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_CIRCLE_FILLED: {
+        const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled*)cmd;
+        return nk_delta_rect_bounds(c->x, c->y, c->w, c->h, 1.0f);
+    }
+    case NK_COMMAND_ARC: {
+        const struct nk_command_arc *a = (const struct nk_command_arc*)cmd;
+        return nk_delta_rect_bounds((short)(a->cx - a->r), (short)(a->cy - a->r),
+            (unsigned short)(a->r * 2), (unsigned short)(a->r * 2), a->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_ARC_FILLED: {
+        const struct nk_command_arc_filled *a = (const struct nk_command_arc_filled*)cmd;
+        return nk_delta_rect_bounds((short)(a->cx - a->r), (short)(a->cy - a->r),
+            (unsigned short)(a->r * 2), (unsigned short)(a->r * 2), 1.0f);
+    }
+    case NK_COMMAND_TRIANGLE: {
+        const struct nk_command_triangle *t = (const struct nk_command_triangle*)cmd;
+        struct nk_vec2i p[3];
+        p[0] = t->a; p[1] = t->b; p[2] = t->c;
+        return nk_delta_points_bounds(p, 3, t->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_TRIANGLE_FILLED: {
+        const struct nk_command_triangle_filled *t = (const struct nk_command_triangle_filled*)cmd;
+        struct nk_vec2i p[3];
+        p[0] = t->a; p[1] = t->b; p[2] = t->c;
+        return nk_delta_points_bounds(p, 3, 1.0f);
+    }
+    case NK_COMMAND_POLYGON:
+    case NK_COMMAND_POLYLINE: {
+        const struct nk_command_polygon *p = (const struct nk_command_polygon*)cmd;
+        return nk_delta_points_bounds(p->points, p->point_count, p->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_POLYGON_FILLED: {
+        const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled*)cmd;
+        return nk_delta_points_bounds(p->points, p->point_count, 1.0f);
+    }
+    case NK_COMMAND_TEXT: {
+        const struct nk_command_text *t = (const struct nk_command_text*)cmd;
+        return nk_delta_rect_bounds(t->x, t->y, t->w, t->h, 1.0f);
+    }
+    case NK_COMMAND_IMAGE: {
+        const struct nk_command_image *i = (const struct nk_command_image*)cmd;
+        return nk_delta_rect_bounds(i->x, i->y, i->w, i->h, 1.0f);
+    }
+    case NK_COMMAND_CUSTOM: {
+        const struct nk_command_custom *c = (const struct nk_command_custom*)cmd;
+        return nk_delta_rect_bounds(c->x, c->y, c->w, c->h, 1.0f);
+    }
+    default: break;
+    }
+    return nk_rect(0,0,0,0);
+}
+NK_INTERN void
+nk_delta_merge(struct nk_rect *a, struct nk_rect b)
+{
+    float x1, y1;
+    if (b.w <= 0 || b.h <= 0) return;
+    if (a->w <= 0 || a->h <= 0) {
+        *a = b;
+        return;
+    }
+    x1 = NK_MAX(a->x + a->w, b.x + b.w);
+    y1 = NK_MAX(a->y + a->h, b.y + b.h);
+    a->x = NK_MIN(a->x, b.x);
+    a->y = NK_MIN(a->y, b.y);
+    a->w = x1 - a->x;
+    a->h = y1 - a->y;
+}
+NK_API void
+nk_frame_delta_init(struct nk_frame_delta *delta, const struct nk_allocator *alloc)
+{
+    NK_ASSERT(delta);
+    NK_ASSERT(alloc);
+    if (!delta || !alloc) return;
+    nk_zero(delta, sizeof(*delta));
+    nk_buffer_init(&delta->commands[0], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    nk_buffer_init(&delta->commands[1], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    nk_buffer_init(&delta->windows[0], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    nk_buffer_init(&delta->windows[1], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    nk_buffer_init(&delta->deltas, alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+}
+#ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
+NK_API void
+nk_frame_delta_init_default(struct nk_frame_delta *delta)
+{
+    struct nk_allocator alloc;
+    alloc.userdata.ptr = 0;
+    alloc.alloc = nk_malloc;
+    alloc.free = nk_mfree;
+    nk_frame_delta_init(delta, &alloc);
+}
+#endif
+NK_API void
+nk_frame_delta_reset(struct nk_frame_delta *delta)
+{
+    NK_ASSERT(delta);
+    if (!delta) return;
+    delta->synced = nk_false;
+}
+NK_API void
+nk_frame_delta_free(struct nk_frame_delta *delta)
+{
+    NK_ASSERT(delta);
+    if (!delta) return;
+    nk_buffer_free(&delta->commands[0]);
+    nk_buffer_free(&delta->commands[1]);
+    nk_buffer_free(&delta->windows[0]);
+    nk_buffer_free(&delta->windows[1]);
+    nk_buffer_free(&delta->deltas);
+}
+NK_INTERN int
+nk_delta_add_window(struct nk_buffer *windows, nk_hash id, nk_size begin, nk_size last)
+{
+    struct nk_delta_window *win = (struct nk_delta_window*)nk_buffer_alloc(windows,
+        NK_BUFFER_FRONT, sizeof(*win), NK_ALIGNOF(struct nk_delta_window));
+    if (!win) return nk_false;
+    win->id = id;
+    win->begin = begin;
+    win->last = last;
+    win->first = 0;
+    win->count = 0;
+    win->matched = nk_false;
+    return nk_true;
+}
+NK_INTERN int
+nk_delta_collect(struct nk_frame_delta *delta, struct nk_context *ctx,
+    struct nk_buffer *windows, struct nk_buffer *commands)
+{
+    const struct nk_command *cmd;
+    struct nk_delta_window *win;
+    struct nk_window *iter;
+    nk_size offset, count, index = 0;
+    int ok = nk_true;
+
+    /* ranges in the order `nk_build` links them together. Popups are only
+     * linked if they were drawn, so they are matched by their first command */
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        if (iter->buffer.last == iter->buffer.begin || (iter->flags & NK_WINDOW_HIDDEN) ||
+            iter->seq != ctx->seq) continue;
+        ok = ok && nk_delta_add_window(windows, iter->name, iter->buffer.begin, iter->buffer.last);
+    }
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        if (!iter->popup.win || iter->popup.win->seq != ctx->seq) continue;
+        ok = ok && nk_delta_add_window(windows, nk_murmur_hash(&iter->popup.win->name,
+            (int)sizeof(nk_hash), iter->name), iter->popup.buf.begin, iter->popup.buf.last);
+    }
+    if (ctx->merged.end != ctx->merged.begin)
+        ok = ok && nk_delta_add_window(windows, 1, ctx->merged.begin, ctx->merged.last);
+    if (ctx->overlay.end != ctx->overlay.begin)
+        ok = ok && nk_delta_add_window(windows, 0, ctx->overlay.begin, ctx->overlay.last);
+    if (!ok) return nk_false;
+
+    count = windows->allocated / sizeof(*win);
+    win = (struct nk_delta_window*)nk_buffer_memory(windows);
+    cmd = nk__begin(ctx);
+    if (!cmd || !count) return nk_true;
+
+    offset = win[0].begin;
+    while (cmd) {
+        if (cmd->type != NK_COMMAND_NOP) {
+            struct nk_delta_command *c = (struct nk_delta_command*)nk_buffer_alloc(commands,
+                NK_BUFFER_FRONT, sizeof(*c), NK_ALIGNOF(struct nk_delta_command));
+            if (!c) return nk_false;
+            c->hash = nk_command_hash(cmd, 0);
+            c->bounds = nk_command_bounds(cmd);
+            win[index].count++;
+            delta->command_count++;
+        }
+        if (offset == win[index].last && index + 1 < count) {
+            /* the next range is the one starting where this one links to */
+            nk_size next = index + 1;
+            while (next < count && win[next].begin != cmd->next) next++;
+            if (next < count) {
+                win[next].first = win[index].first + win[index].count;
+                index = next;
+            }
+        }
+        offset = cmd->next;
+        cmd = nk__next(ctx, cmd);
+    }
+    return nk_true;
+}
+NK_API const struct nk_window_delta*
+nk_frame_delta(struct nk_frame_delta *delta, struct nk_context *ctx, int *count)
+{
+    struct nk_buffer *cur_windows, *prev_windows;
+    struct nk_delta_window *cur, *prev;
+    struct nk_delta_command *cur_cmds, *prev_cmds;
+    struct nk_window_delta *out;
+    nk_size cur_count, prev_count, i;
+    int last_match = -1;
+
+    NK_ASSERT(delta);
+    NK_ASSERT(ctx);
+    NK_ASSERT(count);
+    if (!delta || !ctx || !count) return 0;
+    *count = 0;
+
+    delta->current = !delta->current;
+    cur_windows = &delta->windows[delta->current];
+    prev_windows = &delta->windows[!delta->current];
+    nk_buffer_clear(cur_windows);
+    nk_buffer_clear(&delta->commands[delta->current]);
+    nk_buffer_clear(&delta->deltas);
+    delta->command_count = 0;
+    delta->changed_count = 0;
+    delta->damage = nk_rect(0,0,0,0);
+    if (!nk_delta_collect(delta, ctx, cur_windows, &delta->commands[delta->current])) {
+        /* without a complete frame there is nothing to compare against */
+        nk_buffer_clear(cur_windows);
+        delta->synced = nk_false;
+        return 0;
+    }
+
+    cur_count = cur_windows->allocated / sizeof(*cur);
+    cur = (struct nk_delta_window*)nk_buffer_memory(cur_windows);
+    cur_cmds = (struct nk_delta_command*)nk_buffer_memory(&delta->commands[delta->current]);
+    prev_count = delta->synced ? prev_windows->allocated / sizeof(*prev): 0;
+    prev = (struct nk_delta_window*)nk_buffer_memory(prev_windows);
+    prev_cmds = (struct nk_delta_command*)nk_buffer_memory(&delta->commands[!delta->current]);
+
+    out = (struct nk_window_delta*)nk_buffer_alloc(&delta->deltas, NK_BUFFER_FRONT,
+        sizeof(*out) * (cur_count + prev_count + 1), NK_ALIGNOF(struct nk_window_delta));
+    if (!out) {
+        delta->synced = nk_false;
+        return 0;
+    }
+    for (i = 0; i < cur_count; ++i) {
+        struct nk_window_delta *d = &out[*count];
+        const struct nk_delta_command *a = cur_cmds + cur[i].first;
+        const struct nk_delta_command *b;
+        nk_size p = (i < prev_count && prev[i].id == cur[i].id) ? i: 0;
+        unsigned int j, end;
+
+        /* most windows keep their place in the drawing order */
+        if (p < prev_count && prev[p].id != cur[i].id) {
+            for (p = 0; p < prev_count; ++p)
+                if (prev[p].id == cur[i].id && !prev[p].matched) break;
+        }
+        d->id = cur[i].id;
+        d->count = cur[i].count;
+        d->bounds = nk_rect(0,0,0,0);
+        d->keep_front = d->keep_back = 0;
+        if (p >= prev_count) {
+            d->status = NK_WINDOW_DELTA_ADDED;
+            d->prev_index = -1;
+            d->prev_count = 0;
+        } else {
+            b = prev_cmds + prev[p].first;
+            prev[p].matched = nk_true;
+            d->prev_index = (int)p;
+            d->prev_count = prev[p].count;
+            if ((int)p > last_match) {
+                /* windows moved to the front change everything they overlap */
+                last_match = (int)p;
+                while (d->keep_front < d->count && d->keep_front < d->prev_count &&
+                    a[d->keep_front].hash == b[d->keep_front].hash)
+                    d->keep_front++;
+                while (d->keep_front + d->keep_back < d->count &&
+                    d->keep_front + d->keep_back < d->prev_count &&
+                    a[d->count - d->keep_back - 1].hash == b[d->prev_count - d->keep_back - 1].hash)
+                    d->keep_back++;
+            }
+            d->status = (d->keep_front == d->count && d->count == d->prev_count) ?
+                NK_WINDOW_DELTA_UNCHANGED: NK_WINDOW_DELTA_CHANGED;
+            for (j = d->keep_front, end = d->prev_count - d->keep_back; j < end; ++j)
+                nk_delta_merge(&d->bounds, b[j].bounds);
+        }
+        for (j = d->keep_front, end = d->count - d->keep_back; j < end; ++j)
+            nk_delta_merge(&d->bounds, a[j].bounds);
+        delta->changed_count += d->count - d->keep_front - d->keep_back;
+        if (d->prev_count)
+            delta->changed_count += d->prev_count - d->keep_front - d->keep_back;
+        nk_delta_merge(&delta->damage, d->bounds);
+        (*count)++;
+    }
+    for (i = 0; i < prev_count; ++i) {
+        struct nk_window_delta *d = &out[*count];
+        const struct nk_delta_command *b = prev_cmds + prev[i].first;
+        unsigned int j;
+        if (prev[i].matched) continue;
+        d->id = prev[i].id;
+        d->status = NK_WINDOW_DELTA_REMOVED;
+        d->prev_index = (int)i;
+        d->count = d->keep_front = d->keep_back = 0;
+        d->prev_count = prev[i].count;
+        d->bounds = nk_rect(0,0,0,0);
+        for (j = 0; j < d->prev_count; ++j)
+            nk_delta_merge(&d->bounds, b[j].bounds);
+        delta->changed_count += d->prev_count;
+        nk_delta_merge(&delta->damage, d->bounds);
+        (*count)++;
+    }
+    delta->synced = nk_true;
+    return out;
+}
+
+
+
+
+/* ===============================================================
+ *
+ *                          INPUT LOG
+ *
+ * ===============================================================*/
+#ifdef NK_INCLUDE_INPUT_RECORDING
+/* A log starts with a four byte magic and a version byte followed by one
+ * record per input call. Each record begins with a tag byte holding the
+ * event in the lower and a small argument (key/button state, glyph length)
+ * in the upper four bits. Mouse positions are stored as zig-zag varint
+ * deltas to the previously recorded position, floats as little endian
+ * 32-bit words. */
+NK_GLOBAL const nk_byte nk_input_log_magic[5] = {'N','K','I','L',1};
+
+NK_INTERN int
+nk_input_log_put_int(nk_byte *out, int value)
+{
+    nk_uint u = (value < 0) ? (((nk_uint)(-(value + 1))) << 1) | 1u: ((nk_uint)value) << 1;
+    int n = 0;
+    while (u >= 0x80) {
+        out[n++] = (nk_byte)(u | 0x80);
+        u >>= 7;
+    }
+    out[n++] = (nk_byte)u;
+    return n;
+}
+NK_INTERN int
+nk_input_log_put_float(nk_byte *out, float value)
+{
+    nk_uint u;
+    NK_MEMCPY(&u, &value, sizeof(u));
+    out[0] = (nk_byte)(u & 0xFF);
+    out[1] = (nk_byte)((u >> 8) & 0xFF);
+    out[2] = (nk_byte)((u >> 16) & 0xFF);
+    out[3] = (nk_byte)((u >> 24) & 0xFF);
+    return 4;
+}
+NK_LIB void
+nk_input_log(struct nk_context *ctx, enum nk_input_log_event event,
+    int arg, int x, int y, const void *data, int len)
+{
+    nk_byte record[32];
+    int n = 0;
+
+    NK_ASSERT(ctx->input_log);
+    if (event == NK_INPUT_LOG_GLYPH && (len <= 0 || len > NK_UTF_SIZE))
+        return;
+    if (event == NK_INPUT_LOG_END && ctx->delta_time_seconds != ctx->input_log_delta_time) {
+        /* frame time is part of the input for time based widget state */
+        record[n++] = (nk_byte)NK_INPUT_LOG_DELTA_TIME;
+        n += nk_input_log_put_float(&record[n], ctx->delta_time_seconds);
+        ctx->input_log_delta_time = ctx->delta_time_seconds;
+    }
+    record[n++] = (nk_byte)(((arg & 0x0F) << 4) | (int)event);
+    switch (event) {
+    case NK_INPUT_LOG_MOTION:
+    case NK_INPUT_LOG_BUTTON:
+        n += nk_input_log_put_int(&record[n], x - ctx->input_log_x);
+        n += nk_input_log_put_int(&record[n], y - ctx->input_log_y);
+        ctx->input_log_x = x;
+        ctx->input_log_y = y;
+        break;
+    case NK_INPUT_LOG_KEY:
+        record[n++] = (nk_byte)x;
+        break;
+    case NK_INPUT_LOG_SCROLL: {
+        const struct nk_vec2 *val = (const struct nk_vec2*)data;
+        n += nk_input_log_put_float(&record[n], val->x);
+        n += nk_input_log_put_float(&record[n], val->y);
+    } break;
+    case NK_INPUT_LOG_GLYPH:
+        NK_MEMCPY(&record[n], data, (nk_size)len);
+        n += len;
+        break;
+    default: break;
+    }
+    nk_buffer_push(ctx->input_log, NK_BUFFER_FRONT, record, (nk_size)n, 1);
+}
+NK_API nk_bool
+nk_input_record_begin(struct nk_context *ctx, struct nk_buffer *log)
+{
+    void *header;
+    NK_ASSERT(ctx);
+    NK_ASSERT(log);
+    /* the log is handed to `nk_input_replay_begin` as one block of memory */
+    NK_ASSERT(log->type != NK_BUFFER_SEGMENTED);
+    if (!ctx || !log || log->type == NK_BUFFER_SEGMENTED) return nk_false;
+    ctx->input_log = 0;
+    header = nk_buffer_alloc(log, NK_BUFFER_FRONT, sizeof(nk_input_log_magic), 1);
+    if (!header) return nk_false;
+    NK_MEMCPY(header, nk_input_log_magic, sizeof(nk_input_log_magic));
+    ctx->input_log = log;
+    ctx->input_log_x = ctx->input_log_y = 0;
+    ctx->input_log_delta_time = 0;
+    return nk_true;
+}
+NK_API void
+nk_input_record_end(struct nk_context *ctx)
+{
+    NK_ASSERT(ctx);
+    if (!ctx) return;
+    ctx->input_log = 0;
+}
+NK_API nk_bool
+nk_input_replay_begin(struct nk_input_replay *replay, const void *log, nk_size size)
+{
+    nk_size i;
+    NK_ASSERT(replay);
+    NK_ASSERT(log);
+    if (!replay || !log) return nk_false;
+    nk_zero(replay, sizeof(*replay));
+    if (size < sizeof(nk_input_log_magic)) return nk_false;
+    for (i = 0; i < sizeof(nk_input_log_magic); ++i)
+        if (((const nk_byte*)log)[i] != nk_input_log_magic[i])
+            return nk_false;
+    replay->data = (const nk_byte*)log;
+    replay->size = size;
+    replay->offset = sizeof(nk_input_log_magic);
+    return nk_true;
+}
+NK_INTERN nk_bool
+nk_input_replay_int(struct nk_input_replay *replay, int *value)
+{
+    nk_uint u = 0;
+    int shift = 0;
+    while (replay->offset < replay->size && shift < 35) {
+        nk_byte b = replay->data[replay->offset++];
+        u |= (nk_uint)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            *value = (u & 1) ? -(int)(u >> 1) - 1: (int)(u >> 1);
+            return nk_true;
+        }
+        shift += 7;
+    }
+    return nk_false;
+}
+NK_INTERN nk_bool
+nk_input_replay_float(struct nk_input_replay *replay, float *value)
+{
+    const nk_byte *p = replay->data + replay->offset;
+    nk_uint u;
+    if (replay->size - replay->offset < 4) return nk_false;
+    u = (nk_uint)p[0] | ((nk_uint)p[1] << 8) | ((nk_uint)p[2] << 16) | ((nk_uint)p[3] << 24);
+    NK_MEMCPY(value, &u, sizeof(*value));
+    replay->offset += 4;
+    return nk_true;
+}
+NK_API nk_bool
+nk_input_replay_frame(struct nk_context *ctx, struct nk_input_replay *replay)
+{
+    NK_ASSERT(ctx);
+    NK_ASSERT(replay);
+    if (!ctx || !replay || !replay->data) return nk_false;
+    if (replay->offset >= replay->size ||
+        replay->data[replay->offset] != NK_INPUT_LOG_BEGIN)
+        return nk_false;
+
+    replay->offset++;
+    nk_input_begin(ctx);
+    while (replay->offset < replay->size) {
+        const nk_byte tag = replay->data[replay->offset++];
+        const int arg = tag >> 4;
+        switch (tag & 0x0F) {
+        case NK_INPUT_LOG_END:
+            nk_input_end(ctx);
+            replay->frame++;
+            return nk_true;
+        case NK_INPUT_LOG_MOTION:
+        case NK_INPUT_LOG_BUTTON: {
+            int dx, dy;
+            if (!nk_input_replay_int(replay, &dx) || !nk_input_replay_int(replay, &dy))
+                break;
+            replay->x += dx;
+            replay->y += dy;
+            if ((tag & 0x0F) == NK_INPUT_LOG_MOTION)
+                nk_input_motion(ctx, replay->x, replay->y);
+            else if ((arg >> 1) < NK_BUTTON_MAX)
+                nk_input_button(ctx, (enum nk_buttons)(arg >> 1), replay->x, replay->y, arg & 1);
+            continue;
+        }
+        case NK_INPUT_LOG_KEY:
+            if (replay->offset >= replay->size) break;
+            if (replay->data[replay->offset] < NK_KEY_MAX)
+                nk_input_key(ctx, (enum nk_keys)replay->data[replay->offset], arg & 1);
+            replay->offset++;
+            continue;
+        case NK_INPUT_LOG_SCROLL: {
+            struct nk_vec2 val;
+            if (!nk_input_replay_float(replay, &val.x) || !nk_input_replay_float(replay, &val.y))
+                break;
+            nk_input_scroll(ctx, val);
+            continue;
+        }
+        case NK_INPUT_LOG_GLYPH: {
+            nk_glyph glyph = {0};
+            if (arg < 1 || arg > NK_UTF_SIZE || replay->size - replay->offset < (nk_size)arg)
+                break;
+            NK_MEMCPY(glyph, replay->data + replay->offset, (nk_size)arg);
+            replay->offset += (nk_size)arg;
+            nk_input_glyph(ctx, glyph);
+            continue;
+        }
+        case NK_INPUT_LOG_DELTA_TIME:
+            if (!nk_input_replay_float(replay, &ctx->delta_time_seconds))
+                break;
+            continue;
+        default: break;
+        }
+        break;
+    }
+    /* damaged or truncated log */
+    nk_input_end(ctx);
+    replay->offset = replay->size;
+    return nk_false;
+}
+#endif
+
+
+
+
+/* ===============================================================
+ *
+ *                          COMMAND STREAM
+ *
+ * ===============================================================*/
+#ifdef NK_INCLUDE_COMMAND_STREAM
+/* A packet starts with a four byte magic, a version byte, a flags byte and
+ * the frame number, followed by one record per window range reported by
+ * `nk_frame_delta` and an end record. A window record names the window of
+ * the previous frame and how many commands at its front and back are kept,
+ * followed by one record for each changed command. Each record begins with
+ * a tag byte holding the command type in the lower five bits. Coordinates
+ * are zig-zag varint deltas to the previous point, sizes unsigned varints
+ * and floats little endian 32-bit words. */
+NK_GLOBAL const nk_byte nk_command_stream_magic[5] = {'N','K','C','S',1};
+
+enum nk_command_stream_record {
+    NK_COMMAND_STREAM_FONT = 24,
+    NK_COMMAND_STREAM_IMAGE = 25,
+    NK_COMMAND_STREAM_WINDOW = 26,
+    NK_COMMAND_STREAM_END = 31
+};
+enum nk_command_stream_tag_flags {
+    NK_COMMAND_STREAM_TYPE_MASK = 0x1F,
+    NK_COMMAND_STREAM_SAME_COLOR = NK_FLAG(5),  /* color equals the previous color */
+    NK_COMMAND_STREAM_FONT_HEIGHT = NK_FLAG(6)  /* text height equals the font height */
+};
+enum nk_command_stream_packet_flags {
+    NK_COMMAND_STREAM_KEY_FRAME = NK_FLAG(0)
+};
+
+/* ---------------------------------------------------------------
+ *                          SHARED STATE
+ * ---------------------------------------------------------------*/
+NK_INTERN void
+nk_command_stream_strings_clear(struct nk_command_stream_strings *s)
+{
+    nk_buffer_clear(&s->text);
+    nk_zero_struct(s->slots);
+    s->count = 0;
+}
+NK_INTERN int
+nk_command_stream_equal(const char *a, const char *b, int len)
+{
+    while (len--)
+        if (*a++ != *b++) return nk_false;
+    return nk_true;
+}
+NK_INTERN int
+nk_command_stream_strings_find(const struct nk_command_stream_strings *s,
+    const char *str, int len, nk_hash hash)
+{
+    const int mask = (int)NK_LEN(s->slots) - 1;
+    int slot = (int)(hash & (nk_hash)mask);
+    while (s->slots[slot]) {
+        const int index = s->slots[slot] - 1;
+        if (s->hash[index] == hash && s->length[index] == len &&
+            nk_command_stream_equal((const char*)nk_buffer_memory_at(&s->text, s->offset[index]), str, len))
+            return index;
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+NK_INTERN void
+nk_command_stream_strings_add(struct nk_command_stream_strings *s,
+    const char *str, int len, nk_hash hash)
+{
+    const int mask = (int)NK_LEN(s->slots) - 1;
+    int slot = (int)(hash & (nk_hash)mask);
+    void *mem;
+
+    if (s->count >= NK_COMMAND_STREAM_MAX_STRINGS) return;
+    mem = nk_buffer_alloc(&s->text, NK_BUFFER_FRONT, (nk_size)len, 1);
+    if (!mem) return;
+    NK_MEMCPY(mem, str, (nk_size)len);
+    s->hash[s->count] = hash;
+    s->offset[s->count] = s->text.allocated - (nk_size)len;
+    s->length[s->count] = len;
+    while (s->slots[slot])
+        slot = (slot + 1) & mask;
+    s->slots[slot] = (unsigned short)++s->count;
+}
+NK_INTERN void
+nk_command_stream_state_init(struct nk_command_stream_state *state,
+    const struct nk_allocator *alloc)
+{
+    nk_zero(state, sizeof(*state));
+    nk_buffer_init(&state->strings[0].text, alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    nk_buffer_init(&state->strings[1].text, alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+}
+NK_INTERN void
+nk_command_stream_state_free(struct nk_command_stream_state *state)
+{
+    nk_buffer_free(&state->strings[0].text);
+    nk_buffer_free(&state->strings[1].text);
+}
+NK_INTERN void
+nk_command_stream_state_reset(struct nk_command_stream_state *state)
+{
+    nk_command_stream_strings_clear(&state->strings[0]);
+    nk_command_stream_strings_clear(&state->strings[1]);
+    state->font_count = 0;
+    state->image_count = 0;
+}
+NK_INTERN void
+nk_command_stream_state_begin(struct nk_command_stream_state *state)
+{
+    /* strings of the previous frame stay referencable for one more frame */
+    state->current = !state->current;
+    nk_command_stream_strings_clear(&state->strings[state->current]);
+    state->x = state->y = 0;
+    state->color = nk_rgba(0,0,0,0);
+}
+NK_INTERN int
+nk_command_stream_same_color(struct nk_color a, struct nk_color b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+/* ---------------------------------------------------------------
+ *                          ENCODER
+ * ---------------------------------------------------------------*/
+struct nk_command_stream_writer {
+    struct nk_buffer *out;
+    nk_byte record[96];
+    int len;
+    int failed;
+};
+NK_INTERN void
+nk_command_stream_flush(struct nk_command_stream_writer *w)
+{
+    void *mem;
+    if (!w->len || w->failed) {
+        w->len = 0;
+        return;
+    }
+    mem = nk_buffer_alloc(w->out, NK_BUFFER_FRONT, (nk_size)w->len, 1);
+    if (mem) NK_MEMCPY(mem, w->record, (nk_size)w->len);
+    else w->failed = nk_true;
+    w->len = 0;
+}
+NK_INTERN void
+nk_command_stream_put_byte(struct nk_command_stream_writer *w, nk_byte b)
+{
+    if (w->len >= (int)sizeof(w->record))
+        nk_command_stream_flush(w);
+    w->record[w->len++] = b;
+}
+NK_INTERN void
+nk_command_stream_put_uint(struct nk_command_stream_writer *w, nk_ptr u)
+{
+    while (u >= 0x80) {
+        nk_command_stream_put_byte(w, (nk_byte)(u | 0x80));
+        u >>= 7;
+    }
+    nk_command_stream_put_byte(w, (nk_byte)u);
+}
+NK_INTERN void
+nk_command_stream_put_int(struct nk_command_stream_writer *w, int value)
+{
+    nk_command_stream_put_uint(w, (value < 0) ?
+        (((nk_ptr)(-(value + 1))) << 1) | 1u: ((nk_ptr)value) << 1);
+}
+NK_INTERN void
+nk_command_stream_put_float(struct nk_command_stream_writer *w, float value)
+{
+    nk_uint u;
+    NK_MEMCPY(&u, &value, sizeof(u));
+    nk_command_stream_put_byte(w, (nk_byte)(u & 0xFF));
+    nk_command_stream_put_byte(w, (nk_byte)((u >> 8) & 0xFF));
+    nk_command_stream_put_byte(w, (nk_byte)((u >> 16) & 0xFF));
+    nk_command_stream_put_byte(w, (nk_byte)((u >> 24) & 0xFF));
+}
+NK_INTERN void
+nk_command_stream_put_color(struct nk_command_stream_writer *w, struct nk_color c)
+{
+    nk_command_stream_put_byte(w, c.r);
+    nk_command_stream_put_byte(w, c.g);
+    nk_command_stream_put_byte(w, c.b);
+    nk_command_stream_put_byte(w, c.a);
+}
+NK_INTERN void
+nk_command_stream_put_point(struct nk_command_stream_writer *w,
+    short *x, short *y, short nx, short ny)
+{
+    nk_command_stream_put_int(w, (int)nx - (int)*x);
+    nk_command_stream_put_int(w, (int)ny - (int)*y);
+    *x = nx; *y = ny;
+}
+NK_INTERN void
+nk_command_stream_put_rect(struct nk_command_stream_writer *w,
+    struct nk_command_stream_state *state, short x, short y,
+    unsigned short width, unsigned short height)
+{
+    nk_command_stream_put_point(w, &state->x, &state->y, x, y);
+    nk_command_stream_put_uint(w, width);
+    nk_command_stream_put_uint(w, height);
+}
+NK_INTERN void
+nk_command_stream_put_points(struct nk_command_stream_writer *w,
+    struct nk_command_stream_state *state, const struct nk_vec2i *points, int count)
+{
+    short x, y;
+    int i;
+    if (!count) return;
+    nk_command_stream_put_point(w, &state->x, &state->y, points[0].x, points[0].y);
+    x = state->x; y = state->y;
+    for (i = 1; i < count; ++i)
+        nk_command_stream_put_point(w, &x, &y, points[i].x, points[i].y);
+}
+NK_INTERN void
+nk_command_stream_put_tag(struct nk_command_stream_writer *w,
+    struct nk_command_stream_state *state, enum nk_command_type type,
+    struct nk_color color)
+{
+    /* the color itself follows the tag byte if it changed */
+    if (nk_command_stream_same_color(color, state->color)) {
+        nk_command_stream_put_byte(w, (nk_byte)(type | NK_COMMAND_STREAM_SAME_COLOR));
+    } else {
+        nk_command_stream_put_byte(w, (nk_byte)type);
+        nk_command_stream_put_color(w, color);
+        state->color = color;
+    }
+}
+NK_INTERN int
+nk_command_stream_font(struct nk_command_stream_encoder *enc,
+    struct nk_command_stream_writer *w, const struct nk_user_font *font)
+{
+    struct nk_command_stream_state *state = &enc->state;
+    int i;
+    for (i = 0; i < state->font_count; ++i)
+        if (enc->fonts[i] == font) return i;
+    if (state->font_count >= NK_COMMAND_STREAM_MAX_FONTS)
+        return -1;
+    enc->fonts[state->font_count] = font;
+    state->font_height[state->font_count] = font->height;
+    nk_command_stream_put_byte(w, NK_COMMAND_STREAM_FONT);
+    nk_command_stream_put_float(w, font->height);
+    nk_command_stream_put_uint(w, (nk_ptr)font->userdata.ptr);
+    return state->font_count++;
+}
+NK_INTERN int
+nk_command_stream_image(struct nk_command_stream_state *state,
+    struct nk_command_stream_writer *w, nk_handle handle)
+{
+    int i;
+    for (i = 0; i < state->image_count; ++i)
+        if (state->images[i].ptr == handle.ptr) return i;
+    if (state->image_count >= NK_COMMAND_STREAM_MAX_IMAGES)
+        return -1;
+    state->images[state->image_count] = handle;
+    nk_command_stream_put_byte(w, NK_COMMAND_STREAM_IMAGE);
+    nk_command_stream_put_uint(w, (nk_ptr)handle.ptr);
+    return state->image_count++;
+}
+NK_INTERN void
+nk_command_stream_put_string(struct nk_command_stream_writer *w,
+    struct nk_command_stream_state *state, const char *str, int len)
+{
+    struct nk_command_stream_strings *cur = &state->strings[state->current];
+    struct nk_command_stream_strings *prev = &state->strings[!state->current];
+    const nk_hash hash = nk_murmur_hash(str, len, 0);
+    int i;
+
+    /* 0 is a new string, otherwise an index into the current or previous frame */
+    if ((i = nk_command_stream_strings_find(cur, str, len, hash)) >= 0) {
+        nk_command_stream_put_uint(w, ((nk_ptr)i << 1) + 1);
+        return;
+    }
+    if ((i = nk_command_stream_strings_find(prev, str, len, hash)) >= 0) {
+        nk_command_stream_put_uint(w, ((nk_ptr)i << 1) + 2);
+    } else {
+        nk_command_stream_put_uint(w, 0);
+        nk_command_stream_put_uint(w, (nk_ptr)len);
+        for (i = 0; i < len; ++i)
+            nk_command_stream_put_byte(w, (nk_byte)str[i]);
+    }
+    nk_command_stream_strings_add(cur, str, len, hash);
+}
+NK_INTERN int
+nk_command_stream_encode_command(struct nk_command_stream_encoder *enc,
+    struct nk_command_stream_writer *w, const struct nk_command *cmd)
+{
+    struct nk_command_stream_state *state = &enc->state;
+    switch (cmd->type) {
+    case NK_COMMAND_NOP: break;
+    case NK_COMMAND_SCISSOR: {
+        const struct nk_command_scissor *s = (const struct nk_command_scissor*)cmd;
+        nk_command_stream_put_byte(w, (nk_byte)cmd->type);
+        nk_command_stream_put_rect(w, state, s->x, s->y, s->w, s->h);
+    } break;
+    case NK_COMMAND_LINE: {
+        const struct nk_command_line *l = (const struct nk_command_line*)cmd;
+        short x, y;
+        nk_command_stream_put_tag(w, state, cmd->type, l->color);
+        nk_command_stream_put_uint(w, l->line_thickness);
+        nk_command_stream_put_point(w, &state->x, &state->y, l->begin.x, l->begin.y);
+        x = state->x; y = state->y;
+        nk_command_stream_put_point(w, &x, &y, l->end.x, l->end.y);
+    } break;
+    case NK_COMMAND_CURVE: {
+        const struct nk_command_curve *q = (const struct nk_command_curve*)cmd;
+        short x, y;
+        nk_command_stream_put_tag(w, state, cmd->type, q->color);
+        nk_command_stream_put_uint(w, q->line_thickness);
+        nk_command_stream_put_point(w, &state->x, &state->y, q->begin.x, q->begin.y);
+        x = state->x; y = state->y;
+        nk_command_stream_put_point(w, &x, &y, q->ctrl[0].x, q->ctrl[0].y);
+        nk_command_stream_put_point(w, &x, &y, q->ctrl[1].x, q->ctrl[1].y);
+        nk_command_stream_put_point(w, &x, &y, q->end.x, q->end.y);
+    } break;
+    case NK_COMMAND_RECT: {
+        const struct nk_command_rect *r = (const struct nk_command_rect*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, r->color);
+        nk_command_stream_put_uint(w, r->rounding);
+        nk_command_stream_put_uint(w, r->line_thickness);
+        nk_command_stream_put_rect(w, state, r->x, r->y, r->w, r->h);
+    } break;
+    case NK_COMMAND_RECT_FILLED: {
+        const struct nk_command_rect_filled *r = (const struct nk_command_rect_filled*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, r->color);
+        nk_command_stream_put_uint(w, r->rounding);
+        nk_command_stream_put_rect(w, state, r->x, r->y, r->w, r->h);
+    } break;
+    case NK_COMMAND_RECT_MULTI_COLOR: {
+        const struct nk_command_rect_multi_color *r = (const struct nk_command_rect_multi_color*)cmd;
+        nk_command_stream_put_byte(w, (nk_byte)cmd->type);
+        nk_command_stream_put_rect(w, state, r->x, r->y, r->w, r->h);
+        nk_command_stream_put_color(w, r->left);
+        nk_command_stream_put_color(w, r->top);
+        nk_command_stream_put_color(w, r->bottom);
+        nk_command_stream_put_color(w, r->right);
+    } break;
+    case NK_COMMAND_CIRCLE: {
+        const struct nk_command_circle *c = (const struct nk_command_circle*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, c->color);
+        nk_command_stream_put_uint(w, c->line_thickness);
+        nk_command_stream_put_rect(w, state, c->x, c->y, c->w, c->h);
+    } break;
+    case NK_COMMAND_CIRCLE_FILLED: {
+        const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, c->color);
+        nk_command_stream_put_rect(w, state, c->x, c->y, c->w, c->h);
+    } break;
+    case NK_COMMAND_ARC: {
+        const struct nk_command_arc *a = (const struct nk_command_arc*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, a->color);
+        nk_command_stream_put_uint(w, a->line_thickness);
+        nk_command_stream_put_point(w, &state->x, &state->y, a->cx, a->cy);
+        nk_command_stream_put_uint(w, a->r);
+        nk_command_stream_put_float(w, a->a[0]);
+        nk_command_stream_put_float(w, a->a[1]);
+    } break;
+    case NK_COMMAND_ARC_FILLED: {
+        const struct nk_command_arc_filled *a = (const struct nk_command_arc_filled*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, a->color);
+        nk_command_stream_put_point(w, &state->x, &state->y, a->cx, a->cy);
+        nk_command_stream_put_uint(w, a->r);
+        nk_command_stream_put_float(w, a->a[0]);
+        nk_command_stream_put_float(w, a->a[1]);
+    } break;
+    case NK_COMMAND_TRIANGLE: {
+        const struct nk_command_triangle *t = (const struct nk_command_triangle*)cmd;
+        struct nk_vec2i p[3];
+        p[0] = t->a; p[1] = t->b; p[2] = t->c;
+        nk_command_stream_put_tag(w, state, cmd->type, t->color);
+        nk_command_stream_put_uint(w, t->line_thickness);
+        nk_command_stream_put_points(w, state, p, 3);
+    } break;
+    case NK_COMMAND_TRIANGLE_FILLED: {
+        const struct nk_command_triangle_filled *t = (const struct nk_command_triangle_filled*)cmd;
+        struct nk_vec2i p[3];
+        p[0] = t->a; p[1] = t->b; p[2] = t->c;
+        nk_command_stream_put_tag(w, state, cmd->type, t->color);
+        nk_command_stream_put_points(w, state, p, 3);
+    } break;
+    case NK_COMMAND_POLYGON:
+    case NK_COMMAND_POLYLINE: {
+        /* both share the same layout */
+        const struct nk_command_polygon *p = (const struct nk_command_polygon*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, p->color);
+        nk_command_stream_put_uint(w, p->line_thickness);
+        nk_command_stream_put_uint(w, p->point_count);
+        nk_command_stream_put_points(w, state, p->points, p->point_count);
+    } break;
+    case NK_COMMAND_POLYGON_FILLED: {
+        const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, p->color);
+        nk_command_stream_put_uint(w, p->point_count);
+        nk_command_stream_put_points(w, state, p->points, p->point_count);
+    } break;
+    case NK_COMMAND_TEXT: {
+        const struct nk_command_text *t = (const struct nk_command_text*)cmd;
+        const int font = nk_command_stream_font(enc, w, t->font);
+        nk_byte flags = 0;
+        if (font < 0) return nk_false;
+        if (t->height == state->font_height[font])
+            flags |= NK_COMMAND_STREAM_FONT_HEIGHT;
+        if (nk_command_stream_same_color(t->foreground, state->color))
+            flags |= NK_COMMAND_STREAM_SAME_COLOR;
+        nk_command_stream_put_byte(w, (nk_byte)(cmd->type | flags));
+        if (!(flags & NK_COMMAND_STREAM_SAME_COLOR)) {
+            nk_command_stream_put_color(w, t->foreground);
+            state->color = t->foreground;
+        }
+        nk_command_stream_put_uint(w, (nk_ptr)font);
+        nk_command_stream_put_color(w, t->background);
+        nk_command_stream_put_rect(w, state, t->x, t->y, t->w, t->h);
+        if (!(flags & NK_COMMAND_STREAM_FONT_HEIGHT))
+            nk_command_stream_put_float(w, t->height);
+        nk_command_stream_put_string(w, state, t->string, t->length);
+    } break;
+    case NK_COMMAND_IMAGE: {
+        const struct nk_command_image *i = (const struct nk_command_image*)cmd;
+        const int image = nk_command_stream_image(state, w, i->img.handle);
+        if (image < 0) return nk_false;
+        nk_command_stream_put_tag(w, state, cmd->type, i->col);
+        nk_command_stream_put_uint(w, (nk_ptr)image);
+        nk_command_stream_put_uint(w, i->img.w);
+        nk_command_stream_put_uint(w, i->img.h);
+        nk_command_stream_put_uint(w, i->img.region[0]);
+        nk_command_stream_put_uint(w, i->img.region[1]);
+        nk_command_stream_put_uint(w, i->img.region[2]);
+        nk_command_stream_put_uint(w, i->img.region[3]);
+        nk_command_stream_put_rect(w, state, i->x, i->y, i->w, i->h);
+    } break;
+    case NK_COMMAND_CUSTOM:
+    default: return nk_false;
+    }
+    return nk_true;
+}
+NK_API void
+nk_command_stream_encoder_init(struct nk_command_stream_encoder *enc,
+    const struct nk_allocator *alloc)
+{
+    NK_ASSERT(enc);
+    NK_ASSERT(alloc);
+    if (!enc || !alloc) return;
+    nk_zero(enc, sizeof(*enc));
+    nk_command_stream_state_init(&enc->state, alloc);
+    nk_frame_delta_init(&enc->delta, alloc);
+}
+#ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
+NK_API void
+nk_command_stream_encoder_init_default(struct nk_command_stream_encoder *enc)
+{
+    struct nk_allocator alloc;
+    alloc.userdata.ptr = 0;
+    alloc.alloc = nk_malloc;
+    alloc.free = nk_mfree;
+    nk_command_stream_encoder_init(enc, &alloc);
+}
+#endif
+NK_API void
+nk_command_stream_encoder_reset(struct nk_command_stream_encoder *enc)
+{
+    NK_ASSERT(enc);
+    if (!enc) return;
+    enc->state.synced = nk_false;
+}
+NK_API void
+nk_command_stream_encoder_free(struct nk_command_stream_encoder *enc)
+{
+    NK_ASSERT(enc);
+    if (!enc) return;
+    nk_command_stream_state_free(&enc->state);
+    nk_frame_delta_free(&enc->delta);
+}
+NK_INTERN void
+nk_command_stream_put_window(struct nk_command_stream_writer *w,
+    struct nk_command_stream_state *state, const struct nk_window_delta *win)
+{
+    nk_command_stream_put_byte(w, NK_COMMAND_STREAM_WINDOW);
+    nk_command_stream_put_uint(w, (nk_ptr)(win->prev_index + 1));
+    if (win->prev_index >= 0) {
+        nk_command_stream_put_uint(w, win->keep_front);
+        nk_command_stream_put_uint(w, win->keep_back);
+    }
+    /* windows do not depend on the commands of other windows */
+    state->x = state->y = 0;
+    state->color = nk_rgba(0,0,0,0);
+}
+NK_API nk_bool
+nk_command_stream_encode(struct nk_command_stream_encoder *enc,
+    struct nk_context *ctx, struct nk_buffer *out)
+{
+    struct nk_command_stream_writer w;
+    const struct nk_window_delta *windows;
+    const struct nk_command *cmd;
+    int window_count, window = -1;
+    unsigned int index = 0;
+    nk_size start;
+    unsigned int i;
+
+    NK_ASSERT(enc);
+    NK_ASSERT(ctx);
+    NK_ASSERT(out);
+    if (!enc || !ctx || !out) return nk_false;
+
+    w.out = out;
+    w.len = 0;
+    w.failed = nk_false;
+    start = out->allocated;
+    enc->skipped = 0;
+    if (!enc->state.synced) {
+        nk_command_stream_state_reset(&enc->state);
+        nk_frame_delta_reset(&enc->delta);
+    }
+    windows = nk_frame_delta(&enc->delta, ctx, &window_count);
+    if (!windows) {
+        enc->state.synced = nk_false;
+        return nk_false;
+    }
+    nk_command_stream_state_begin(&enc->state);
+
+    for (i = 0; i < sizeof(nk_command_stream_magic); ++i)
+        nk_command_stream_put_byte(&w, nk_command_stream_magic[i]);
+    nk_command_stream_put_byte(&w, (nk_byte)(enc->state.synced ? 0: NK_COMMAND_STREAM_KEY_FRAME));
+    nk_command_stream_put_uint(&w, enc->state.frame);
+    nk_foreach(cmd, ctx) {
+        const struct nk_window_delta *win;
+        if (cmd->type == NK_COMMAND_NOP) continue;
+        while (window < 0 || index >= windows[window].count) {
+            NK_ASSERT(window + 1 < window_count);
+            if (window + 1 >= window_count) break;
+            nk_command_stream_put_window(&w, &enc->state, &windows[++window]);
+            index = 0;
+        }
+        if (window < 0 || index >= windows[window].count) break;
+        /* only commands that differ from the previous frame are sent */
+        win = &windows[window];
+        if (index >= win->keep_front && index < win->count - win->keep_back &&
+            !nk_command_stream_encode_command(enc, &w, cmd)) {
+            nk_command_stream_put_byte(&w, NK_COMMAND_NOP);
+            enc->skipped++;
+        }
+        index++;
+    }
+    while (++window < window_count && windows[window].status != NK_WINDOW_DELTA_REMOVED)
+        nk_command_stream_put_window(&w, &enc->state, &windows[window]);
+    nk_command_stream_put_byte(&w, NK_COMMAND_STREAM_END);
+    nk_command_stream_flush(&w);
+
+    if (w.failed) {
+        /* the decoder would not be able to follow, so start over next frame */
+        out->allocated = start;
+        enc->state.synced = nk_false;
+        return nk_false;
+    }
+    enc->state.synced = nk_true;
+    enc->state.frame++;
+    return nk_true;
+}
+
+/* ---------------------------------------------------------------
+ *                          DECODER
+ * ---------------------------------------------------------------*/
+struct nk_command_stream_reader {
+    const nk_byte *data;
+    nk_size size;
+    nk_size offset;
+    int failed;
+};
+NK_INTERN nk_byte
+nk_command_stream_get_byte(struct nk_command_stream_reader *r)
+{
+    if (r->offset >= r->size) {
+        r->failed = nk_true;
+        return 0;
+    }
+    return r->data[r->offset++];
+}
+NK_INTERN nk_ptr
+nk_command_stream_get_uint(struct nk_command_stream_reader *r)
+{
+    nk_ptr u = 0;
+    unsigned shift = 0;
+    nk_byte b;
+    do {
+        b = nk_command_stream_get_byte(r);
+        if (shift < sizeof(nk_ptr) * 8)
+            u |= (nk_ptr)(b & 0x7F) << shift;
+        shift += 7;
+    } while ((b & 0x80) && !r->failed);
+    return u;
+}
+NK_INTERN int
+nk_command_stream_get_int(struct nk_command_stream_reader *r)
+{
+    const nk_ptr u = nk_command_stream_get_uint(r);
+    return (u & 1) ? -(int)(u >> 1) - 1: (int)(u >> 1);
+}
+NK_INTERN unsigned short
+nk_command_stream_get_ushort(struct nk_command_stream_reader *r)
+{
+    return (unsigned short)nk_command_stream_get_uint(r);
+}
+NK_INTERN float
+nk_command_stream_get_float(struct nk_command_stream_reader *r)
+{
+    nk_uint u;
+    float value;
+    u = (nk_uint)nk_command_stream_get_byte(r);
+    u |= (nk_uint)nk_command_stream_get_byte(r) << 8;
+    u |= (nk_uint)nk_command_stream_get_byte(r) << 16;
+    u |= (nk_uint)nk_command_stream_get_byte(r) << 24;
+    NK_MEMCPY(&value, &u, sizeof(value));
+    return value;
+}
+NK_INTERN struct nk_color
+nk_command_stream_get_color(struct nk_command_stream_reader *r)
+{
+    struct nk_color c;
+    c.r = nk_command_stream_get_byte(r);
+    c.g = nk_command_stream_get_byte(r);
+    c.b = nk_command_stream_get_byte(r);
+    c.a = nk_command_stream_get_byte(r);
+    return c;
+}
+NK_INTERN void
+nk_command_stream_get_point(struct nk_command_stream_reader *r,
+    short *x, short *y)
+{
+    *x = (short)((int)*x + nk_command_stream_get_int(r));
+    *y = (short)((int)*y + nk_command_stream_get_int(r));
+}
+NK_INTERN struct nk_color
+nk_command_stream_get_tag_color(struct nk_command_stream_reader *r,
+    struct nk_command_stream_state *state, nk_byte tag)
+{
+    if (!(tag & NK_COMMAND_STREAM_SAME_COLOR))
+        state->color = nk_command_stream_get_color(r);
+    return state->color;
+}
+NK_INTERN void
+nk_command_stream_get_points(struct nk_command_stream_reader *r,
+    struct nk_command_stream_state *state, struct nk_vec2i *points, int count)
+{
+    short x, y;
+    int i;
+    if (!count) return;
+    nk_command_stream_get_point(r, &state->x, &state->y);
+    points[0].x = x = state->x;
+    points[0].y = y = state->y;
+    for (i = 1; i < count; ++i) {
+        nk_command_stream_get_point(r, &x, &y);
+        points[i].x = x;
+        points[i].y = y;
+    }
+}
+struct nk_command_stream_pushed {
+    void *cmd;
+    nk_size size;
+};
+NK_INTERN void*
+nk_command_stream_push(struct nk_command_buffer *out,
+    struct nk_command_stream_pushed *pushed, enum nk_command_type type, nk_size size)
+{
+    pushed->cmd = nk_command_buffer_push(out, type, size);
+    pushed->size = size;
+    return pushed->cmd;
+}
+#define NK_COMMAND_STREAM_PUSH(T, type, size)\
+    (struct T*)nk_command_stream_push(out, pushed, type, size);\
+    if (!cmd) return nk_false
+NK_INTERN int
+nk_command_stream_decode_command(struct nk_command_stream_decoder *dec,
+    struct nk_command_stream_reader *r, nk_byte tag, struct nk_command_buffer *out,
+    struct nk_command_stream_pushed *pushed)
+{
+    struct nk_command_stream_state *state = &dec->state;
+    const enum nk_command_type type = (enum nk_command_type)(tag & NK_COMMAND_STREAM_TYPE_MASK);
+    switch ((int)type) {
+    case NK_COMMAND_STREAM_FONT: {
+        const struct nk_user_font *font = 0;
+        nk_handle remote;
+        float height = nk_command_stream_get_float(r);
+        remote.ptr = (void*)nk_command_stream_get_uint(r);
+        if (state->font_count >= NK_COMMAND_STREAM_MAX_FONTS) return nk_false;
+        if (dec->font) font = dec->font(dec->userdata, remote, height);
+        dec->fonts[state->font_count] = font ? font: dec->default_font;
+        state->font_height[state->font_count++] = height;
+    } break;
+    case NK_COMMAND_STREAM_IMAGE: {
+        nk_handle handle;
+        handle.ptr = (void*)nk_command_stream_get_uint(r);
+        if (state->image_count >= NK_COMMAND_STREAM_MAX_IMAGES) return nk_false;
+        state->images[state->image_count++] = handle;
+    } break;
+    case NK_COMMAND_SCISSOR: {
+        struct nk_command_scissor *cmd = NK_COMMAND_STREAM_PUSH(nk_command_scissor, type, sizeof(*cmd));
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    case NK_COMMAND_LINE: {
+        struct nk_command_line *cmd = NK_COMMAND_STREAM_PUSH(nk_command_line, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->begin.x = cmd->end.x = state->x;
+        cmd->begin.y = cmd->end.y = state->y;
+        nk_command_stream_get_point(r, &cmd->end.x, &cmd->end.y);
+    } break;
+    case NK_COMMAND_CURVE: {
+        short x, y;
+        struct nk_command_curve *cmd = NK_COMMAND_STREAM_PUSH(nk_command_curve, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->begin.x = x = state->x;
+        cmd->begin.y = y = state->y;
+        nk_command_stream_get_point(r, &x, &y);
+        cmd->ctrl[0].x = x; cmd->ctrl[0].y = y;
+        nk_command_stream_get_point(r, &x, &y);
+        cmd->ctrl[1].x = x; cmd->ctrl[1].y = y;
+        nk_command_stream_get_point(r, &x, &y);
+        cmd->end.x = x; cmd->end.y = y;
+    } break;
+    case NK_COMMAND_RECT: {
+        struct nk_command_rect *cmd = NK_COMMAND_STREAM_PUSH(nk_command_rect, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->rounding = nk_command_stream_get_ushort(r);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    case NK_COMMAND_RECT_FILLED: {
+        struct nk_command_rect_filled *cmd = NK_COMMAND_STREAM_PUSH(nk_command_rect_filled, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->rounding = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    case NK_COMMAND_RECT_MULTI_COLOR: {
+        struct nk_command_rect_multi_color *cmd = NK_COMMAND_STREAM_PUSH(nk_command_rect_multi_color, type, sizeof(*cmd));
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+        cmd->left = nk_command_stream_get_color(r);
+        cmd->top = nk_command_stream_get_color(r);
+        cmd->bottom = nk_command_stream_get_color(r);
+        cmd->right = nk_command_stream_get_color(r);
+    } break;
+    case NK_COMMAND_CIRCLE: {
+        struct nk_command_circle *cmd = NK_COMMAND_STREAM_PUSH(nk_command_circle, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    case NK_COMMAND_CIRCLE_FILLED: {
+        struct nk_command_circle_filled *cmd = NK_COMMAND_STREAM_PUSH(nk_command_circle_filled, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    case NK_COMMAND_ARC: {
+        struct nk_command_arc *cmd = NK_COMMAND_STREAM_PUSH(nk_command_arc, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->cx = state->x; cmd->cy = state->y;
+        cmd->r = nk_command_stream_get_ushort(r);
+        cmd->a[0] = nk_command_stream_get_float(r);
+        cmd->a[1] = nk_command_stream_get_float(r);
+    } break;
+    case NK_COMMAND_ARC_FILLED: {
+        struct nk_command_arc_filled *cmd = NK_COMMAND_STREAM_PUSH(nk_command_arc_filled, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->cx = state->x; cmd->cy = state->y;
+        cmd->r = nk_command_stream_get_ushort(r);
+        cmd->a[0] = nk_command_stream_get_float(r);
+        cmd->a[1] = nk_command_stream_get_float(r);
+    } break;
+    case NK_COMMAND_TRIANGLE: {
+        struct nk_vec2i p[3];
+        struct nk_command_triangle *cmd = NK_COMMAND_STREAM_PUSH(nk_command_triangle, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_points(r, state, p, 3);
+        cmd->a = p[0]; cmd->b = p[1]; cmd->c = p[2];
+    } break;
+    case NK_COMMAND_TRIANGLE_FILLED: {
+        struct nk_vec2i p[3];
+        struct nk_command_triangle_filled *cmd = NK_COMMAND_STREAM_PUSH(nk_command_triangle_filled, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        nk_command_stream_get_points(r, state, p, 3);
+        cmd->a = p[0]; cmd->b = p[1]; cmd->c = p[2];
+    } break;
+    case NK_COMMAND_POLYGON:
+    case NK_COMMAND_POLYLINE: {
+        struct nk_command_polygon *cmd;
+        const struct nk_color color = nk_command_stream_get_tag_color(r, state, tag);
+        const unsigned short thickness = nk_command_stream_get_ushort(r);
+        const unsigned short count = nk_command_stream_get_ushort(r);
+        /* every point takes at least two bytes, so this also bounds the allocation */
+        if (r->failed || (nk_size)count * 2 > r->size - r->offset) return nk_false;
+        cmd = NK_COMMAND_STREAM_PUSH(nk_command_polygon, type,
+            sizeof(*cmd) + sizeof(short) * 2 * (nk_size)count);
+        cmd->color = color;
+        cmd->line_thickness = thickness;
+        cmd->point_count = count;
+        nk_command_stream_get_points(r, state, cmd->points, count);
+    } break;
+    case NK_COMMAND_POLYGON_FILLED: {
+        struct nk_command_polygon_filled *cmd;
+        const struct nk_color color = nk_command_stream_get_tag_color(r, state, tag);
+        const unsigned short count = nk_command_stream_get_ushort(r);
+        if (r->failed || (nk_size)count * 2 > r->size - r->offset) return nk_false;
+        cmd = NK_COMMAND_STREAM_PUSH(nk_command_polygon_filled, type,
+            sizeof(*cmd) + sizeof(short) * 2 * (nk_size)count);
+        cmd->color = color;
+        cmd->point_count = count;
+        nk_command_stream_get_points(r, state, cmd->points, count);
+    } break;
+    case NK_COMMAND_TEXT: {
+        struct nk_command_stream_strings *cur = &state->strings[state->current];
+        struct nk_command_stream_strings *prev = &state->strings[!state->current];
+        struct nk_command_text *cmd;
+        struct nk_command_text text;
+        const char *str;
+        nk_ptr code;
+        nk_ptr font;
+        int len;
+
+        text.foreground = nk_command_stream_get_tag_color(r, state, tag);
+        font = nk_command_stream_get_uint(r);
+        if (font >= (nk_ptr)state->font_count) return nk_false;
+        text.font = dec->fonts[font];
+        text.background = nk_command_stream_get_color(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        text.x = state->x; text.y = state->y;
+        text.w = nk_command_stream_get_ushort(r);
+        text.h = nk_command_stream_get_ushort(r);
+        text.height = (tag & NK_COMMAND_STREAM_FONT_HEIGHT) ?
+            state->font_height[font]: nk_command_stream_get_float(r);
+
+        code = nk_command_stream_get_uint(r);
+        if (r->failed) return nk_false;
+        if (!code) {
+            const nk_ptr length = nk_command_stream_get_uint(r);
+            if (r->failed || length > r->size - r->offset || !length) return nk_false;
+            len = (int)length;
+            str = (const char*)r->data + r->offset;
+            r->offset += (nk_size)len;
+        } else {
+            const struct nk_command_stream_strings *s = (code & 1) ? cur: prev;
+            const nk_ptr index = (code - 1) >> 1;
+            if (index >= (nk_ptr)s->count) return nk_false;
+            len = s->length[index];
+            str = (const char*)nk_buffer_memory_at(&s->text, s->offset[index]);
+        }
+        if (!(code & 1)) {
+            /* remember new strings and strings of the previous frame
+             * exactly like the encoder did */
+            nk_command_stream_strings_add(cur, str, len,
+                nk_murmur_hash(str, len, 0));
+        }
+        if (!text.font) break;
+        cmd = NK_COMMAND_STREAM_PUSH(nk_command_text, type, sizeof(*cmd) + (nk_size)(len + 1));
+        cmd->font = text.font;
+        cmd->background = text.background;
+        cmd->foreground = text.foreground;
+        cmd->x = text.x; cmd->y = text.y;
+        cmd->w = text.w; cmd->h = text.h;
+        cmd->height = text.height;
+        cmd->length = len;
+        NK_MEMCPY(cmd->string, str, (nk_size)len);
+        cmd->string[len] = '\0';
+    } break;
+    case NK_COMMAND_IMAGE: {
+        nk_ptr image;
+        struct nk_command_image *cmd = NK_COMMAND_STREAM_PUSH(nk_command_image, type, sizeof(*cmd));
+        cmd->col = nk_command_stream_get_tag_color(r, state, tag);
+        image = nk_command_stream_get_uint(r);
+        if (image >= (nk_ptr)state->image_count) return nk_false;
+        cmd->img.handle = state->images[image];
+        cmd->img.w = nk_command_stream_get_ushort(r);
+        cmd->img.h = nk_command_stream_get_ushort(r);
+        cmd->img.region[0] = nk_command_stream_get_ushort(r);
+        cmd->img.region[1] = nk_command_stream_get_ushort(r);
+        cmd->img.region[2] = nk_command_stream_get_ushort(r);
+        cmd->img.region[3] = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    default: return nk_false;
+    }
+    return !r->failed;
+}
+#undef NK_COMMAND_STREAM_PUSH
+NK_API void
+nk_command_stream_decoder_init(struct nk_command_stream_decoder *dec,
+    const struct nk_allocator *alloc, const struct nk_user_font *font)
+{
+    int i;
+    NK_ASSERT(dec);
+    NK_ASSERT(alloc);
+    if (!dec || !alloc) return;
+    nk_zero(dec, sizeof(*dec));
+    nk_command_stream_state_init(&dec->state, alloc);
+    for (i = 0; i < 2; ++i) {
+        nk_buffer_init(&dec->commands[i], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+        nk_buffer_init(&dec->records[i], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+        nk_buffer_init(&dec->windows[i], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    }
+    dec->default_font = font;
+}
+#ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
+NK_API void
+nk_command_stream_decoder_init_default(struct nk_command_stream_decoder *dec,
+    const struct nk_user_font *font)
+{
+    struct nk_allocator alloc;
+    alloc.userdata.ptr = 0;
+    alloc.alloc = nk_malloc;
+    alloc.free = nk_mfree;
+    nk_command_stream_decoder_init(dec, &alloc, font);
+}
+#endif
+NK_API void
+nk_command_stream_decoder_free(struct nk_command_stream_decoder *dec)
+{
+    int i;
+    NK_ASSERT(dec);
+    if (!dec) return;
+    nk_command_stream_state_free(&dec->state);
+    for (i = 0; i < 2; ++i) {
+        nk_buffer_free(&dec->commands[i]);
+        nk_buffer_free(&dec->records[i]);
+        nk_buffer_free(&dec->windows[i]);
+    }
+}
+/* each decoded command is copied so unchanged commands can be taken from
+ * the previous frame. Skipped commands keep a record with size zero */
+struct nk_command_stream_copy {
+    nk_size offset;
+    nk_size size;
+};
+struct nk_command_stream_window {
+    nk_size first;
+    nk_size count;
+};
+NK_INTERN int
+nk_command_stream_retain(struct nk_command_stream_decoder *dec,
+    const void *cmd, nk_size size)
+{
+    const int cur = dec->state.current;
+    struct nk_command_stream_copy *copy;
+    struct nk_command_stream_window *win;
+
+    copy = (struct nk_command_stream_copy*)nk_buffer_alloc(&dec->records[cur],
+        NK_BUFFER_FRONT, sizeof(*copy), NK_ALIGNOF(struct nk_command_stream_copy));
+    if (!copy) return nk_false;
+    copy->offset = 0;
+    copy->size = size;
+    if (size) {
+        void *mem = nk_buffer_alloc(&dec->commands[cur], NK_BUFFER_FRONT, size,
+            NK_ALIGNOF(struct nk_command));
+        if (!mem) return nk_false;
+        NK_MEMCPY(mem, cmd, size);
+        copy->offset = dec->commands[cur].allocated - size;
+    }
+    win = (struct nk_command_stream_window*)nk_buffer_memory(&dec->windows[cur]);
+    win[dec->windows[cur].allocated / sizeof(*win) - 1].count++;
+    return nk_true;
+}
+NK_INTERN int
+nk_command_stream_keep(struct nk_command_stream_decoder *dec,
+    struct nk_command_buffer *out, const struct nk_command_stream_window *prev,
+    nk_size begin, nk_size end, nk_bool *scissor)
+{
+    const int old = !dec->state.current;
+    for (; begin < end; ++begin) {
+        const struct nk_command_stream_copy *copy = (const struct nk_command_stream_copy*)
+            nk_buffer_memory_const(&dec->records[old]) + prev->first + begin;
+        const struct nk_command *src = 0;
+        if (copy->size) {
+            struct nk_command *cmd;
+            src = (const struct nk_command*)nk_ptr_add_const(void,
+                nk_buffer_memory_const(&dec->commands[old]), copy->offset);
+            cmd = (struct nk_command*)nk_command_buffer_push(out, src->type, copy->size);
+            if (!cmd) return nk_false;
+            NK_MEMCPY(cmd + 1, src + 1, copy->size - sizeof(*cmd));
+            *scissor = *scissor || src->type == NK_COMMAND_SCISSOR;
+        }
+        if (!nk_command_stream_retain(dec, src, copy->size))
+            return nk_false;
+    }
+    return nk_true;
+}
+NK_API nk_bool
+nk_command_stream_decode(struct nk_command_stream_decoder *dec,
+    const void *packet, nk_size size, struct nk_command_buffer *out)
+{
+    const struct nk_command_stream_window *prev = 0;
+    struct nk_command_stream_reader r;
+    struct nk_rect clip;
+    nk_size allocated, end, last;
+    nk_size prev_count, keep_back = 0;
+    nk_bool scissor = nk_false;
+    nk_byte flags;
+    nk_ptr frame;
+    unsigned int i;
+    int cur;
+
+    NK_ASSERT(dec);
+    NK_ASSERT(packet);
+    NK_ASSERT(out);
+    if (!dec || !packet || !out || !out->base) return nk_false;
+
+    r.data = (const nk_byte*)packet;
+    r.size = size;
+    r.offset = 0;
+    r.failed = nk_false;
+    for (i = 0; i < sizeof(nk_command_stream_magic); ++i)
+        if (nk_command_stream_get_byte(&r) != nk_command_stream_magic[i])
+            return nk_false;
+    flags = nk_command_stream_get_byte(&r);
+    frame = nk_command_stream_get_uint(&r);
+    if (r.failed) return nk_false;
+    if (flags & NK_COMMAND_STREAM_KEY_FRAME) {
+        nk_command_stream_state_reset(&dec->state);
+        dec->state.synced = nk_true;
+    } else if (!dec->state.synced || frame != (nk_ptr)dec->state.frame) {
+        dec->state.synced = nk_false;
+        return nk_false;
+    }
+    dec->state.frame = (unsigned int)frame;
+    nk_command_stream_state_begin(&dec->state);
+    cur = dec->state.current;
+    nk_buffer_clear(&dec->commands[cur]);
+    nk_buffer_clear(&dec->records[cur]);
+    nk_buffer_clear(&dec->windows[cur]);
+    if (flags & NK_COMMAND_STREAM_KEY_FRAME)
+        nk_buffer_clear(&dec->windows[!cur]);
+    prev_count = dec->windows[!cur].allocated / sizeof(*prev);
+
+    clip = out->clip;
+    allocated = out->base->allocated;
+    end = out->end;
+    last = out->last;
+    for (;;) {
+        const nk_byte tag = nk_command_stream_get_byte(&r);
+        struct nk_command_stream_pushed pushed;
+        if (r.failed) break;
+        if (tag == NK_COMMAND_STREAM_END || tag == NK_COMMAND_STREAM_WINDOW) {
+            struct nk_command_stream_window *win;
+            nk_size index, keep_front = 0;
+            /* finish the previous window with its unchanged trailing commands */
+            if (prev && !nk_command_stream_keep(dec, out, prev,
+                prev->count - keep_back, prev->count, &scissor)) break;
+            if (tag == NK_COMMAND_STREAM_END) {
+                if (scissor) nk_push_scissor(out, clip);
+                dec->state.frame++;
+                return nk_true;
+            }
+            win = (struct nk_command_stream_window*)nk_buffer_alloc(&dec->windows[cur],
+                NK_BUFFER_FRONT, sizeof(*win), NK_ALIGNOF(struct nk_command_stream_window));
+            if (!win) break;
+            win->first = dec->records[cur].allocated / sizeof(struct nk_command_stream_copy);
+            win->count = 0;
+            index = (nk_size)nk_command_stream_get_uint(&r);
+            prev = 0;
+            keep_back = 0;
+            if (index) {
+                if (index > prev_count) break;
+                prev = (const struct nk_command_stream_window*)
+                    nk_buffer_memory_const(&dec->windows[!cur]) + (index - 1);
+                keep_front = (nk_size)nk_command_stream_get_uint(&r);
+                keep_back = (nk_size)nk_command_stream_get_uint(&r);
+                if (r.failed || keep_front + keep_back > prev->count) break;
+                if (!nk_command_stream_keep(dec, out, prev, 0, keep_front, &scissor)) break;
+            }
+            dec->state.x = dec->state.y = 0;
+            dec->state.color = nk_rgba(0,0,0,0);
+            continue;
+        }
+        if (!dec->windows[cur].allocated) break;
+        pushed.cmd = 0;
+        pushed.size = 0;
+        if (tag != NK_COMMAND_NOP && !nk_command_stream_decode_command(dec, &r, tag, out, &pushed))
+            break;
+        if ((tag & NK_COMMAND_STREAM_TYPE_MASK) < NK_COMMAND_STREAM_FONT &&
+            !nk_command_stream_retain(dec, pushed.cmd, pushed.cmd ? pushed.size: 0))
+            break;
+        scissor = scissor || (tag & NK_COMMAND_STREAM_TYPE_MASK) == NK_COMMAND_SCISSOR;
+    }
+    /* drop everything decoded from the damaged packet */
+    out->base->allocated = allocated;
+    out->end = end;
+    out->last = last;
+    out->clip = clip;
+    dec->state.synced = nk_false;
+    return nk_false;
+}
+#endif
+
+
+
+
+/* ==============================================================
+ *
+ *                          WORKERS
+ *
+ * ===============================================================*/
+NK_INTERN nk_bool
+nk_workers_hovered(const struct nk_context *ctx, struct nk_vec2 pos)
+{
+    /* same as `nk_window_is_any_hovered` but for bounds of the previous
+     * frame and a mouse position the context itself might never see */
+    const struct nk_window *iter;
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        struct nk_rect bounds = iter->bounds;
+        if (iter->flags & NK_WINDOW_HIDDEN) continue;
+        if (iter->popup.active && iter->popup.win &&
+            NK_INBOX(pos.x, pos.y, iter->popup.win->bounds.x, iter->popup.win->bounds.y,
+                iter->popup.win->bounds.w, iter->popup.win->bounds.h))
+            return nk_true;
+        if (iter->flags & NK_WINDOW_MINIMIZED)
+            bounds.h = ctx->style.font->height + 2 * ctx->style.window.header.padding.y;
+        if (NK_INBOX(pos.x, pos.y, bounds.x, bounds.y, bounds.w, bounds.h))
+            return nk_true;
+    }
+    return nk_false;
+}
+NK_INTERN void
+nk_workers_mask_mouse(struct nk_mouse *mouse)
+{
+    /* keep the pointer far away from any window */
+    const struct nk_vec2 outside = nk_vec2(-65536.0f, -65536.0f);
+    int i;
+    for (i = 0; i < NK_BUTTON_MAX; ++i) {
+        mouse->buttons[i].down = nk_false;
+        mouse->buttons[i].clicked = 0;
+        mouse->buttons[i].clicked_pos = outside;
+    }
+    mouse->pos = mouse->prev = outside;
+#ifdef NK_BUTTON_TRIGGER_ON_RELEASE
+    mouse->down_pos = outside;
+#endif
+    mouse->delta = nk_vec2(0,0);
+    mouse->scroll_delta = nk_vec2(0,0);
+}
+NK_INTERN void
+nk_workers_mask_keyboard(struct nk_keyboard *keyboard)
+{
+    nk_zero(keyboard->keys, sizeof(keyboard->keys));
+    keyboard->text_len = 0;
+}
+NK_API void
+nk_workers_begin(struct nk_context *ctx, struct nk_context *workers, int count)
+{
+    nk_bool held = nk_false, pressed = nk_false;
+    int i, owner;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(workers || !count);
+    NK_ASSERT(count >= 0);
+    if (!ctx || (!workers && count) || count < 0) return;
+
+    /* the mouse stays with the context that saw the button going down */
+    for (i = 0; i < NK_BUTTON_MAX; ++i) {
+        const struct nk_mouse_button *button = &ctx->input.mouse.buttons[i];
+        held = held || (button->down ^ (button->clicked & 1));
+        pressed = pressed || (button->down && button->clicked);
+    }
+    owner = ctx->mouse_owner;
+    if (!held || owner > count) {
+        /* contexts are layered in order with `ctx` at the bottom */
+        for (owner = count; owner > 0; --owner)
+            if (nk_workers_hovered(&workers[owner-1], ctx->input.mouse.pos)) break;
+    }
+    if (pressed) ctx->keyboard_owner = owner;
+    if (ctx->keyboard_owner > count) ctx->keyboard_owner = 0;
+    ctx->mouse_owner = owner;
+
+    for (i = 0; i < count; ++i) {
+        struct nk_context *worker = &workers[i];
+        worker->input = ctx->input;
+        if (owner != i + 1)
+            nk_workers_mask_mouse(&worker->input.mouse);
+        if (ctx->keyboard_owner != i + 1)
+            nk_workers_mask_keyboard(&worker->input.keyboard);
+        worker->style = ctx->style;
+        worker->style.cursor_visible = nk_false;
+        worker->clip = ctx->clip;
+        worker->button_behavior = ctx->button_behavior;
+        worker->delta_time_seconds = ctx->delta_time_seconds;
+    }
+    /* input for workers is held back from `ctx` until `nk_workers_merge` */
+    if (ctx->mouse_owner) {
+        ctx->worker_mouse = ctx->input.mouse;
+        nk_workers_mask_mouse(&ctx->input.mouse);
+    }
+    if (ctx->keyboard_owner) {
+        ctx->worker_keyboard = ctx->input.keyboard;
+        nk_workers_mask_keyboard(&ctx->input.keyboard);
+    }
+    ctx->worker_count = count;
+}
+NK_API nk_bool
+nk_workers_merge(struct nk_context *ctx, struct nk_context *workers, int count)
+{
+    nk_bool ok = nk_true;
+    int i;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(workers || !count);
+    NK_ASSERT(count == ctx->worker_count);
+    if (!ctx || (!workers && count) || count != ctx->worker_count) return nk_false;
+
+    if (ctx->mouse_owner) {
+        const struct nk_context *owner = &workers[ctx->mouse_owner-1];
+        ctx->input.mouse = ctx->worker_mouse;
+        ctx->input.mouse.grab = owner->input.mouse.grab;
+        ctx->input.mouse.grabbed = owner->input.mouse.grabbed;
+        ctx->input.mouse.ungrab = owner->input.mouse.ungrab;
+        ctx->style.cursor_active = owner->style.cursor_active;
+        if (nk_window_is_any_hovered(owner))
+            ctx->worker_state |= NK_WIDGET_STATE_HOVER;
+    }
+    if (ctx->keyboard_owner)
+        ctx->input.keyboard = ctx->worker_keyboard;
+    ctx->worker_count = 0;
+
+    if (!ctx->merged.base) {
+        nk_command_buffer_init(&ctx->merged, &ctx->memory, NK_CLIPPING_OFF);
+        nk_start_buffer(ctx, &ctx->merged);
+    }
+    for (i = 0; i < count; ++i) {
+        struct nk_context *worker = &workers[i];
+        const struct nk_command *cmd;
+        /* commands are copied since each worker has its own command memory */
+        nk_foreach(cmd, worker) {
+            nk_size size;
+            struct nk_command *copy;
+            if (cmd->type == NK_COMMAND_NOP || !ok) continue;
+            size = nk_command_size(cmd);
+            copy = (struct nk_command*)nk_command_buffer_push(&ctx->merged, cmd->type, size);
+            if (!copy) {
+                ok = nk_false;
+                continue;
+            }
+            NK_MEMCPY(copy + 1, cmd + 1, size - sizeof(*copy));
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+            copy->userdata = cmd->userdata;
+#endif
+        }
+        ctx->worker_state |= worker->last_widget_state & NK_WIDGET_STATE_MODIFIED;
+        nk_clear(worker);
+    }
+    nk_finish_buffer(ctx, &ctx->merged);
+    return ok;
+}
+
 #endif /* NK_IMPLEMENTATION */
 
 /*
@@ -30716,6 +35693,61 @@ nk_tooltipfv(struct nk_context *ctx, const char *fmt, va_list args)
 ///   - [y]: Minor version with non-breaking API and library changes
 ///   - [z]: Patch version with no direct changes to the API
 ///
+/// - 2026/10/19 (4.28.3) - Look up cached value, label and property texts with linear probing in a table
+///                         that grows with the number of widgets drawn per window
+/// - 2026/10/19 (4.28.2) - Write the decimal point for `%#.0e` and `%#g` in exponent form
+/// - 2026/10/19 (4.28.1) - Count commands of removed windows and commands that disappeared from a window in
+///                         `nk_frame_delta::changed_count`
+/// - 2026/10/19 (4.28.0) - Allocate the ring of each chart stream with the context allocator and let
+///                         `nk_chart_stream_push` take the number of samples kept per series
+/// - 2026/10/19 (4.27.8) - Draw per-point markers again for line charts that are not decimated, so `nk_plot`
+///                         and `nk_plot_function` keep their markers when `show_markers` is set
+/// - 2026/10/19 (4.27.7) - Stop caching item offsets of separated combo strings across frames so a rewritten
+///                         string can no longer return a wrong item or read past its end
+/// - 2026/10/19 (4.27.6) - Shrink the per-window text cache, skip it for fixed memory contexts and fall
+///                         back to uncached text when it cannot be allocated
+/// - 2026/10/19 (4.27.5) - Keep the sign of negative zero in `%f`/`%e`/`%g`, parse "nan" as a positive
+///                         nan and format property values through a user defined NK_DTOA
+/// - 2026/10/19 (4.27.4) - Lower the default NK_CHART_STREAM_CAPACITY to 128 samples so a chart stream
+///                         stays close to the size of other window state
+/// - 2026/10/19 (4.27.3) - Report scrollbar auto hide timers of popups in `nk_frame_status`
+/// - 2026/10/19 (4.27.2) - Size window value tables by a fixed capacity so a table element is smaller
+///                         than a panel instead of a window
+/// - 2026/10/19 (4.27.1) - Use at least three segments for tiny circles and rounded corners
+/// - 2026/10/19 (4.27.0) - Cache formatted text and widths of value, label and property widgets per
+///                         window so unchanged values skip formatting and measuring; report hits in
+///                         the frame stats
+/// - 2026/10/19 (4.26.0) - Make nk_dtoa and nk_strtod exact and correctly rounded, round
+///                         property values instead of truncating and add %e/%g to nk_vsnprintf
+/// - 2026/10/19 (4.25.0) - Add nk_utf_decode_run decoding runs of UTF-8 with an ASCII fast path
+///                         and use it to measure and draw text
+/// - 2026/10/19 (4.24.0) - Add nk_workers_begin and nk_workers_merge to build windows in worker
+///                         contexts on several threads and merge their draw commands
+/// - 2026/10/19 (4.23.0) - Add nk_frame_delta reporting unchanged commands per window and
+///                         only send changed commands in NK_INCLUDE_COMMAND_STREAM
+/// - 2026/10/19 (4.22.0) - Add NK_INCLUDE_COMMAND_STREAM with nk_command_stream_encode and
+///                         nk_command_stream_decode to send draw commands to a remote renderer
+/// - 2026/10/19 (4.21.0) - Add NK_INCLUDE_INPUT_RECORDING with nk_input_record_begin and
+///                         nk_input_replay_frame to record and replay input
+/// - 2026/10/19 (4.20.1) - Skip drawing of clipped tree headers and keep the scroll offset of
+///                         clipped list views
+/// - 2026/10/19 (4.20.0) - Add nk_layout_skip, nk_layout_skip_rows, nk_layout_visible_range and
+///                         nk_list_view_begin_variable for culling rows of variable height
+/// - 2026/10/19 (4.19.0) - Add nk_chart_stream_push and nk_chart_stream for ring buffered
+///                         streaming charts stored with the window
+/// - 2026/10/19 (4.18.0) - Add nk_chart_push_values and nk_chart_push_slot_values drawing
+///                         decimated line series as one polyline; use them in nk_plot
+/// - 2026/10/19 (4.17.1) - Only lay out and draw visible rows in nk_combo, nk_combo_separator
+///                         and nk_combo_callback and cache item offsets for separated strings
+/// - 2026/10/19 (4.17.0) - Add NK_INCLUDE_FRAME_STATS with per panel counters, memory
+///                         high-water marks, nk_frame_stats and nk_frame_stats_window
+/// - 2026/10/19 (4.16.0) - Add nk_frame_status to detect unchanged frames and running timers
+/// - 2026/10/19 (4.15.0) - Split window, panel and table pool into per type size classes
+///                         and add nk_trim to release unused pool pages
+/// - 2026/10/19 (4.14.0) - Add segmented buffers and allow them as context command memory
+///                         to grow without copying draw commands
+/// - 2026/10/19 (4.13.0) - Add `max_segment_error` to `nk_convert_config` for size dependent
+///                         circle, arc and curve tessellation
 /// - 2025/04/06 (4.12.7) - Fix text input navigation and mouse scrolling
 /// - 2025/03/29 (4.12.6) - Fix unitialized data in nk_input_char
 /// - 2025/03/05 (4.12.5) - Fix scrolling knob also scrolling parent window, remove dead code
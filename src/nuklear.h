@@ -234,6 +234,7 @@ NK_STATIC_ASSERT(sizeof(nk_bool) >= 2);
 struct nk_buffer;
 struct nk_allocator;
 struct nk_command_buffer;
+struct nk_frame_delta;
 struct nk_draw_command;
 struct nk_convert_config;
 struct nk_style_item;
@@ -343,6 +344,34 @@ enum nk_symbol_type {
  * nk_free(&ctx);
  * ```
  *
+ * A context can only be used by one thread at a time. To build windows on
+ * several threads, each thread gets its own worker context which is
+ * initialized like any other context and used for a disjoint set of windows.
+ * `nk_workers_begin` copies input, style, clipboard and frame time into all
+ * workers and `nk_workers_merge` copies their draw commands back into the main
+ * context in a fixed drawing order. Both have to be called on the thread of
+ * the main context while no worker is being built. In between each worker
+ * may only be used by one thread, while the main context can be used as
+ * usual. Fonts, the font atlas and images are shared between all threads
+ * and must not be changed while workers are built, which also means font
+ * and clipboard callbacks have to be safe to call from several threads.
+ * Style changes inside of a worker only last until the end of the frame.
+ *
+ * ```c
+ * struct nk_context ctx, workers[4];
+ * nk_init_xxx(&ctx, ...);
+ * // [... nk_init_xxx each worker ...]
+ * while (1) {
+ *     // [...input for ctx...]
+ *     nk_workers_begin(&ctx, workers, 4);
+ *     // [...build windows in each worker on its own thread and in ctx...]
+ *     // [...wait for all threads...]
+ *     nk_workers_merge(&ctx, workers, 4);
+ *     // [...draw ctx...]
+ *     nk_clear(&ctx);
+ * }
+ * ```
+ *
  * # Reference
  * Function            | Description
  * --------------------|-------------------------------------------------------
@@ -351,7 +380,10 @@ enum nk_symbol_type {
  * \ref nk_init         | Initializes context with memory allocator callbacks for alloc and free
  * \ref nk_init_custom  | Initializes context from two buffers. One for draw commands the other for window/panel/table allocations
  * \ref nk_clear        | Called at the end of the frame to reset and prepare the context for the next frame
+ * \ref nk_trim         | Returns unused window, panel and table memory back to the allocator
  * \ref nk_free         | Shutdown and free all memory allocated inside the context
+ * \ref nk_workers_begin| Hands input, style and frame time of a context to worker contexts
+ * \ref nk_workers_merge| Appends the draw commands of worker contexts to a context
  * \ref nk_set_user_data| Utility function to pass user data to draw command
  */
 
@@ -426,14 +458,18 @@ NK_API nk_bool nk_init(struct nk_context*, const struct nk_allocator*, const str
  *
  * \details
  * The first buffer is for allocating draw commands while the second buffer is
- * used for allocating windows, panels and state tables.
+ * used for allocating windows, panels and state tables. The draw command buffer
+ * can also be a segmented buffer (`nk_buffer_init_segmented`) which grows without
+ * copying already generated commands. Each segment has to be big enough to hold
+ * the biggest single draw command, which for text is the text length plus the
+ * size of `struct nk_command_text`.
  *
  * ```c
  * nk_bool nk_init_custom(struct nk_context *ctx, struct nk_buffer *cmds, struct nk_buffer *pool, const struct nk_user_font *font);
  * ```
  *
  * \param[in] ctx    Must point to an either stack or heap allocated `nk_context` struct
- * \param[in] cmds   Must point to a previously initialized memory buffer either fixed or dynamic to store draw commands into
+ * \param[in] cmds   Must point to a previously initialized memory buffer either fixed, dynamic or segmented to store draw commands into
  * \param[in] pool   Must point to a previously initialized memory buffer either fixed or dynamic to store windows, panels and tables
  * \param[in] font   Must point to a previously initialized font handle for more info look at font documentation
  *
@@ -456,6 +492,25 @@ NK_API nk_bool nk_init_custom(struct nk_context*, struct nk_buffer *cmds, struct
  */
 NK_API void nk_clear(struct nk_context*);
 
+/**
+ * \brief Returns memory pages of the window, panel and table pool that are
+ * not used anymore back to the allocator.
+ *
+ * \details
+ * Pool memory is never freed while the context is alive and only reused for
+ * new windows, panels and tables. After a frame with a lot more windows, groups
+ * or popups than usual this can be called to release memory pages which only
+ * contain unused elements. Does nothing for contexts initialized with a fixed
+ * size memory block.
+ *
+ * ```c
+ * void nk_trim(struct nk_context *ctx);
+ * ```
+ *
+ * \param[in] ctx  Must point to a previously initialized `nk_context` struct
+ */
+NK_API void nk_trim(struct nk_context*);
+
 /**
  * \brief Frees all memory allocated by nuklear; Not needed if context was initialized with `nk_init_fixed`.
  *
@@ -468,6 +523,51 @@ NK_API void nk_clear(struct nk_context*);
  */
 NK_API void nk_free(struct nk_context*);
 
+/**
+ * \brief Hands input, style and frame time of a context to worker contexts
+ *
+ * \details
+ * Has to be called after `nk_input_end` and before any window of `ctx` or of
+ * one of the workers is built. All contexts are layered with `ctx` at the
+ * bottom and the workers on top in array order. Mouse input goes to the top
+ * most context with a window below the mouse pointer and stays there while a
+ * button is held down. Keyboard and text input go to the context that got
+ * the last mouse press. All other contexts see no mouse buttons and a mouse
+ * position outside of all windows until `nk_workers_merge`.
+ *
+ * ```c
+ * void nk_workers_begin(struct nk_context *ctx, struct nk_context *workers, int count);
+ * ```
+ *
+ * \param[in] ctx     | Must point to a previously initialized `nk_context` struct
+ * \param[in] workers | Must point to an array of `count` previously initialized `nk_context` structs
+ * \param[in] count   | Number of worker contexts
+ */
+NK_API void nk_workers_begin(struct nk_context *ctx, struct nk_context *workers, int count);
+
+/**
+ * \brief Appends the draw commands of worker contexts to a context
+ *
+ * \details
+ * Has to be called after all windows of the workers are finished and
+ * before the commands of `ctx` are iterated or converted. Commands are
+ * copied into the command memory of `ctx` and drawn above all windows and
+ * popups of `ctx`. Input held back by `nk_workers_begin` is given back to
+ * `ctx` and `nk_window_is_any_hovered` and `nk_item_is_any_active` include
+ * the workers afterwards. Each worker is cleared with `nk_clear`.
+ *
+ * ```c
+ * nk_bool nk_workers_merge(struct nk_context *ctx, struct nk_context *workers, int count);
+ * ```
+ *
+ * \param[in] ctx     | Must point to the `nk_context` struct passed to `nk_workers_begin`
+ * \param[in] workers | Must point to the same array passed to `nk_workers_begin`
+ * \param[in] count   | Number of worker contexts
+ *
+ * \returns `false(0)` if the command memory of `ctx` ran out and not all commands were copied
+ */
+NK_API nk_bool nk_workers_merge(struct nk_context *ctx, struct nk_context *workers, int count);
+
 #ifdef NK_INCLUDE_COMMAND_USERDATA
 /**
  * \brief Sets the currently passed userdata passed down into each draw command.
@@ -549,6 +649,16 @@ NK_API void nk_set_user_data(struct nk_context*, nk_handle handle);
  * \ref nk_input_glyph  | Adds a single multi-byte UTF-8 character into an internal text buffer
  * \ref nk_input_unicode| Adds a single unicode rune into an internal text buffer
  * \ref nk_input_end    | Ends the input mirroring process by calculating state changes. Don't call any `nk_input_xxx` function referenced above after this call
+ *
+ * With `NK_INCLUDE_INPUT_RECORDING` defined all of the calls above can be
+ * written into a binary log and fed back later, one frame at a time:
+ *
+ * Function                     | Description
+ * -----------------------------|-------------------------------------------------------
+ * \ref nk_input_record_begin   | Starts appending all input calls into a buffer
+ * \ref nk_input_record_end     | Stops recording
+ * \ref nk_input_replay_begin   | Prepares replaying a previously recorded log
+ * \ref nk_input_replay_frame   | Replays the input of the next frame between `nk_input_begin` and `nk_input_end`
  */
 
 enum nk_keys {
@@ -732,6 +842,65 @@ NK_API void nk_input_unicode(struct nk_context*, nk_rune);
  */
 NK_API void nk_input_end(struct nk_context*);
 
+#ifdef NK_INCLUDE_INPUT_RECORDING
+struct nk_input_replay {
+    const nk_byte *data;
+    nk_size size;
+    nk_size offset;
+    unsigned int frame;
+    int x, y;
+};
+
+/**
+ * \brief Starts recording all input into `log`
+ *
+ * \details
+ * Every `nk_input_xxx` call and the `delta_time_seconds` of each frame are
+ * appended to `log` in a compact binary format until `nk_input_record_end`
+ * is called. Mouse positions are stored as small deltas, so a frame with a
+ * single mouse motion usually takes four bytes. The buffer contents can be
+ * written to a file as is and passed to `nk_input_replay_begin` later.
+ *
+ * ```c
+ * nk_bool nk_input_record_begin(struct nk_context*, struct nk_buffer *log);
+ * ```
+ *
+ * \param[in] ctx     | Must point to a previously initialized `nk_context` struct
+ * \param[in] log     | Buffer the log is appended to. Must be a fixed or dynamic buffer that stays valid while recording
+ *
+ * \returns `true(1)` if the log header could be written
+ */
+NK_API nk_bool nk_input_record_begin(struct nk_context*, struct nk_buffer *log);
+NK_API void nk_input_record_end(struct nk_context*);
+
+/**
+ * \brief Prepares `replay` to read a log written by `nk_input_record_begin`
+ *
+ * \details
+ * ```c
+ * nk_bool nk_input_replay_begin(struct nk_input_replay*, const void *log, nk_size size);
+ * ```
+ *
+ * \returns `false(0)` if `log` does not start with a valid header
+ */
+NK_API nk_bool nk_input_replay_begin(struct nk_input_replay*, const void *log, nk_size size);
+
+/**
+ * \brief Replays the input of the next recorded frame
+ *
+ * \details
+ * Replaces the backend input handling of one frame, including the calls to
+ * `nk_input_begin` and `nk_input_end`, and restores `ctx->delta_time_seconds`.
+ *
+ * ```c
+ * nk_bool nk_input_replay_frame(struct nk_context*, struct nk_input_replay*);
+ * ```
+ *
+ * \returns `false(0)` once all frames have been replayed or the log is damaged
+ */
+NK_API nk_bool nk_input_replay_frame(struct nk_context*, struct nk_input_replay*);
+#endif
+
 /** =============================================================================
  *
  *                                  DRAWING
@@ -898,6 +1067,56 @@ NK_API void nk_input_end(struct nk_context*);
  * nk_free(&ctx);
  * ```
  *
+ * Instead of keeping a copy of the command memory around you can also ask
+ * nuklear directly with `nk_frame_status` after the last window of a frame.
+ * It hashes all draw commands that will be drawn and compares the result to
+ * the previous frame. If nothing changed and no timer (like the scrollbar
+ * auto hide timeout) is still running you can skip `nk_convert`, drawing and
+ * swapping buffers and just wait for the next input event. Since some state
+ * changes like activating a window only show up one frame later, keep
+ * updating the UI until a frame reports no changes before going to sleep.
+ *
+ * ```c
+ * struct nk_context ctx;
+ * nk_init_xxx(&ctx, ...);
+ * nk_flags status = NK_FRAME_CHANGED;
+ * while (1) {
+ *     if (!(status & (NK_FRAME_CHANGED|NK_FRAME_ANIMATING)))
+ *         // [...wait for input ]
+ *     // [...input...]
+ *     // [...ui...]
+ *     status = nk_frame_status(&ctx);
+ *     if (status & NK_FRAME_CHANGED) {
+ *         // [...draw and swap buffers ...]
+ *     }
+ *     nk_clear(&ctx);
+ * }
+ * nk_free(&ctx);
+ * ```
+ *
+ * If only parts of the screen have to be redrawn, `nk_frame_delta` goes one
+ * step further and compares the commands of each window, popup and the cursor
+ * overlay separately. Each returned `nk_window_delta` tells how many commands
+ * at the front and back of a window are the same as in the previous frame and
+ * the area covered by changed commands. The union of all changed areas is
+ * kept in `nk_frame_delta::damage`.
+ *
+ * ```c
+ * struct nk_frame_delta delta;
+ * int count;
+ * nk_frame_delta_init_default(&delta);
+ * while (1) {
+ *     // [...input...]
+ *     // [...ui...]
+ *     nk_frame_delta(&delta, &ctx, &count);
+ *     if (delta.changed_count) {
+ *         // [...redraw commands inside delta.damage ...]
+ *     }
+ *     nk_clear(&ctx);
+ * }
+ * nk_frame_delta_free(&delta);
+ * ```
+ *
  * Finally while using draw commands makes sense for higher abstracted platforms like
  * X11 and Win32 or drawing libraries it is often desirable to use graphics
  * hardware directly. Therefore it is possible to just define
@@ -930,6 +1149,7 @@ NK_API void nk_input_end(struct nk_context*);
  * cfg.circle_segment_count = 22;
  * cfg.curve_segment_count = 22;
  * cfg.arc_segment_count = 22;
+ * cfg.max_segment_error = 0.0f; // or e.g. 0.25f for size dependent segment counts
  * cfg.global_alpha = 1.0f;
  * cfg.tex_null = dev->tex_null;
  * //
@@ -956,6 +1176,8 @@ NK_API void nk_input_end(struct nk_context*);
  * \ref nk__begin       | Returns the first draw command in the context draw command list to be drawn
  * \ref nk__next        | Increments the draw command iterator to the next command inside the context draw command list
  * \ref nk_foreach      | Iterates over each draw command inside the context draw command list
+ * \ref nk_frame_status | Returns whether the draw command list differs from the previous frame
+ * \ref nk_frame_delta  | Returns which commands of each window differ from the previous frame
  * \ref nk_convert      | Converts from the abstract draw commands list into a hardware accessible vertex format
  * \ref nk_draw_begin   | Returns the first vertex command in the context vertex draw list to be executed
  * \ref nk__draw_next   | Increments the vertex command iterator to the next command inside the context vertex command list
@@ -982,6 +1204,7 @@ struct nk_convert_config {
     unsigned circle_segment_count;  /**!< number of segments used for circles: default to 22 */
     unsigned arc_segment_count;     /**!< number of segments used for arcs: default to 22 */
     unsigned curve_segment_count;   /**!< number of segments used for curves: default to 22 */
+    float max_segment_error;        /**!< if > 0 derives segment counts per shape from its size so that no point deviates more than this many pixels from the real outline, ignoring the fixed counts above: 0.25 works well */
     struct nk_draw_null_texture tex_null; /**!< handle to texture with a white pixel for shape drawing */
     const struct nk_draw_vertex_layout_element *vertex_layout; /**!< describes the vertex output format and packing */
     nk_size vertex_size;      /**!< sizeof one vertex for vertex packing */
@@ -1030,6 +1253,104 @@ NK_API const struct nk_command* nk__next(struct nk_context*, const struct nk_com
  */
 #define nk_foreach(c, ctx) for((c) = nk__begin(ctx); (c) != 0; (c) = nk__next(ctx,c))
 
+enum nk_frame_status_flags {
+    NK_FRAME_UNCHANGED  = 0,
+    NK_FRAME_CHANGED    = NK_FLAG(0), /**!< draw commands differ from the previous frame */
+    NK_FRAME_ANIMATING  = NK_FLAG(1)  /**!< a timer is still running so following frames will change without input */
+};
+
+/**
+ * \brief Compares all draw commands of the current frame with the previous frame
+ *
+ * \details
+ * Has to be called after the last `nk_end` and before `nk_clear`. Builds
+ * the draw command list like `nk__begin` and hashes the content of each
+ * command. The first frame is always reported as changed. Image and font
+ * handles are only compared by value, so if you change the content of a
+ * texture behind the same handle you have to redraw yourself.
+ *
+ * ```c
+ * nk_flags nk_frame_status(struct nk_context*);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct at the end of a frame
+ *
+ * \returns `NK_FRAME_UNCHANGED` or a combination of `nk_frame_status_flags`
+ */
+NK_API nk_flags nk_frame_status(struct nk_context*);
+
+#ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
+NK_API void nk_frame_delta_init_default(struct nk_frame_delta*);
+#endif
+NK_API void nk_frame_delta_init(struct nk_frame_delta*, const struct nk_allocator*);
+NK_API void nk_frame_delta_reset(struct nk_frame_delta*);
+NK_API void nk_frame_delta_free(struct nk_frame_delta*);
+
+/**
+ * \brief Compares the draw commands of each window with the previous frame
+ *
+ * \details
+ * Has to be called once per frame after the last `nk_end` and before
+ * `nk_clear`. Commands are split into ranges for each window, popup and the
+ * cursor overlay in drawing order, followed by the windows that are no longer
+ * drawn. Each range is compared command by command against the range with the
+ * same id in the previous frame. Commands between `keep_front` and
+ * `count - keep_back` have changed and have to be processed again, all others
+ * can be taken from the previous frame. A window that moved in the drawing
+ * order is reported as changed as a whole. After `nk_frame_delta_reset` or
+ * if memory runs out all windows are reported as added.
+ *
+ * ```c
+ * const struct nk_window_delta *nk_frame_delta(struct nk_frame_delta*, struct nk_context*, int *count);
+ * ```
+ *
+ * \param[in] delta   | Must point to a previously initialized `nk_frame_delta` struct
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct at the end of a frame
+ * \param[out] count  | Number of returned window deltas
+ *
+ * \returns array of window deltas valid until the next call
+ */
+NK_API const struct nk_window_delta *nk_frame_delta(struct nk_frame_delta*, struct nk_context*, int *count);
+
+#ifdef NK_INCLUDE_FRAME_STATS
+/**
+ * \brief Returns counters recorded for the last finished frame
+ *
+ * \details
+ * Counters are recorded per window and per group, popup or other sub panel
+ * between `nk_begin` and `nk_clear`. Each panel only counts work done
+ * directly inside of it and not inside nested panels. Vertex and index counts
+ * are added by `nk_convert`, so convert before calling `nk_clear`.
+ * High-water marks are kept over the lifetime of the context.
+ *
+ * ```c
+ * const struct nk_frame_stats *nk_frame_stats(const struct nk_context*);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct
+ *
+ * \returns stats of the frame finished by the last `nk_clear`
+ */
+NK_API const struct nk_frame_stats *nk_frame_stats(const struct nk_context*);
+
+/**
+ * \brief Draws a window showing the stats of the last finished frame
+ *
+ * \details
+ * ```c
+ * nk_bool nk_frame_stats_window(struct nk_context*, const char *title, struct nk_rect bounds, nk_flags flags);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct
+ * \param[in] title   | Window title and identifier
+ * \param[in] bounds  | Initial position and window size
+ * \param[in] flags   | Window flags defined in the nk_panel_flags section
+ *
+ * \returns `true(1)` if the window is visible or `false(0)` otherwise
+ */
+NK_API nk_bool nk_frame_stats_window(struct nk_context*, const char *title, struct nk_rect bounds, nk_flags flags);
+#endif
+
 #ifdef NK_INCLUDE_VERTEX_BUFFER_OUTPUT
 
 /**
@@ -2179,6 +2500,9 @@ NK_API void nk_rule_horizontal(struct nk_context *ctx, struct nk_color color, nk
  * \ref nk_layout_set_min_row_height            | Set the currently used minimum row height to a specified value
  * \ref nk_layout_reset_min_row_height          | Resets the currently used minimum row height to font height
  * \ref nk_layout_widget_bounds                 | Calculates current width a static layout row can fit inside a window
+ * \ref nk_layout_skip                          | Moves the start of the next row down without laying out anything
+ * \ref nk_layout_skip_rows                     | Moves the start of the next row down by a number of rows of the current height
+ * \ref nk_layout_visible_range                 | Returns the visible vertical range relative to the start of the next row
  * \ref nk_layout_ratio_from_pixel              | Utility functions to calculate window ratio from pixel size
  * \ref nk_layout_row_dynamic                   | Current layout is divided into n same sized growing columns
  * \ref nk_layout_row_static                    | Current layout is divided into n same fixed sized columns
@@ -2256,6 +2580,52 @@ NK_API void nk_layout_reset_min_row_height(struct nk_context*);
  */
 NK_API struct nk_rect nk_layout_widget_bounds(const struct nk_context *ctx);
 
+/**
+ * \brief Moves the start of the next row down by `height` pixels
+ *
+ * \details
+ * Rows which are known to be out of view can be skipped in one call instead
+ * of laying out and culling every widget. Should be called between rows,
+ * widgets still left in the current row would be moved down as well.
+ * ```c
+ * void nk_layout_skip(struct nk_context*, float height);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct after call `nk_begin_xxx`
+ * \param[in] height  | Space to skip including the row spacing of all skipped rows
+ */
+NK_API void nk_layout_skip(struct nk_context*, float height);
+
+/**
+ * \brief Skips `rows` rows with the height of the current row layout
+ *
+ * \details
+ * ```c
+ * void nk_layout_skip_rows(struct nk_context*, int rows);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct after call `nk_layout_row_xxx`
+ * \param[in] rows    | Number of rows to skip
+ */
+NK_API void nk_layout_skip_rows(struct nk_context*, int rows);
+
+/**
+ * \brief Returns the vertical range of the current panel which is visible
+ *
+ * \details
+ * Both values are relative to the start of the next row and include the
+ * current scroll offset, so rows ending above `top` or starting below
+ * `bottom` can be skipped with `nk_layout_skip`.
+ * ```c
+ * void nk_layout_visible_range(const struct nk_context*, float *top, float *bottom);
+ * ```
+ *
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct after call `nk_begin_xxx`
+ * \param[out] top    | Distance from the next row to the first visible pixel row
+ * \param[out] bottom | Distance from the next row to the end of the visible area
+ */
+NK_API void nk_layout_visible_range(const struct nk_context*, float *top, float *bottom);
+
 /**
  * \brief Utility functions to calculate window ratio from pixel size
  *
@@ -3072,6 +3442,12 @@ struct nk_list_view {
     nk_uint scroll_value;
 };
 NK_API nk_bool nk_list_view_begin(struct nk_context*, struct nk_list_view *out, const char *id, nk_flags, int row_height, int row_count);
+/* list view for rows of different heights. `offsets` holds `row_count + 1`
+ * ascending values with the summed height of all rows before each row, without
+ * row spacing, so `offsets[row_count]` is the height of all rows. Only rows
+ * `begin` to `end` have to be laid out, each with its own height of
+ * `offsets[i+1] - offsets[i]`. Finding them is a binary search */
+NK_API nk_bool nk_list_view_begin_variable(struct nk_context*, struct nk_list_view *out, const char *id, nk_flags, const float *offsets, int row_count);
 NK_API void nk_list_view_end(struct nk_list_view*);
 /* =============================================================================
  *
@@ -3521,9 +3897,32 @@ NK_API void nk_chart_add_slot(struct nk_context *ctx, const enum nk_chart_type,
 NK_API void nk_chart_add_slot_colored(struct nk_context *ctx, const enum nk_chart_type, struct nk_color, struct nk_color active, int count, float min_value, float max_value);
 NK_API nk_flags nk_chart_push(struct nk_context*, float);
 NK_API nk_flags nk_chart_push_slot(struct nk_context*, float, int);
+/* pushes `count` values at once which are `stride` bytes apart (0 for a tightly
+ * packed array). Line slots are drawn as a single polyline reduced to at most
+ * four points per pixel column and only the hovered value gets a marker.
+ * `hovered` optionally receives the slot index under the mouse or -1 */
+NK_API nk_flags nk_chart_push_values(struct nk_context*, const float *values, int count, int stride, int *hovered);
+NK_API nk_flags nk_chart_push_slot_values(struct nk_context*, const float *values, int count, int stride, int slot, int *hovered);
 NK_API void nk_chart_end(struct nk_context*);
 NK_API void nk_plot(struct nk_context*, enum nk_chart_type, const float *values, int count, int offset);
 NK_API void nk_plot_function(struct nk_context*, enum nk_chart_type, void *userdata, float(*value_getter)(void* user, int index), int count, int offset);
+/* streaming charts keep their history in a ring buffer owned by the current
+ * window, so only new samples have to be handed over each frame.
+ * `nk_chart_stream_push` appends one sample to each of `series` line series
+ * (at most NK_CHART_STREAM_MAX_SERIES) and drops the oldest one once a series
+ * holds `capacity` samples (0 for NK_CHART_STREAM_CAPACITY). The ring is
+ * allocated with the context allocator, so streams are not available for
+ * contexts created by `nk_init_fixed`. Changing the number of series or the
+ * capacity clears the history. Like other window state a stream is released
+ * if it is neither pushed nor drawn for a frame.
+ * `nk_chart_stream` draws the stream with the newest sample at the right edge.
+ * If `min` equals `max` the range is taken from the samples in the ring.
+ * Drawing cost depends on the chart width and not on the length of the history.
+ * `colors` holds one color per series or is NULL for the style chart color.
+ * `series`/`index` optionally receive the hovered series and sample (0 is the
+ * oldest sample in the ring) or -1 */
+NK_API nk_bool nk_chart_stream_push(struct nk_context*, const char *name, const float *values, int series, int capacity);
+NK_API nk_flags nk_chart_stream(struct nk_context*, const char *name, const struct nk_color *colors, float min, float max, int *series, int *index);
 /* =============================================================================
  *
  *                                  POPUP
@@ -3828,6 +4227,7 @@ NK_API int nk_strmatch_fuzzy_text(const char *txt, int txt_len, const char *patt
  *
  * ============================================================================= */
 NK_API int nk_utf_decode(const char*, nk_rune*, int);
+NK_API int nk_utf_decode_run(const char*, int byte_len, nk_rune *runes, int max_runes, int *decoded_len);
 NK_API int nk_utf_encode(nk_rune, char*, int);
 NK_API int nk_utf_len(const char*, int byte_len);
 NK_API const char* nk_utf_at(const char *buffer, int length, int index, nk_rune *unicode, int *len);
@@ -4158,6 +4558,15 @@ NK_API void nk_font_atlas_clear(struct nk_font_atlas*);
  * NK_INCLUDE_DEFAULT_ALLOCATOR which uses the standard library memory
  * allocation functions malloc and free and takes over complete control over
  * memory in this library.
+ *
+ * Dynamic buffers have to copy all their content into a bigger memory block
+ * once they run out of memory. If that is a problem, for example for the
+ * context draw command buffer on frames with a sudden spike in draw commands,
+ * a segmented buffer can be used instead. It allocates additional fixed size
+ * segments from the allocator without ever moving memory and keeps all segments
+ * around to be reused after `nk_buffer_clear`. Since memory is not contiguous
+ * anymore only front allocations not bigger than one segment are supported and
+ * `nk_buffer_memory` does not return usable memory.
  */
 
 struct nk_memory_status {
@@ -4171,7 +4580,8 @@ struct nk_memory_status {
 
 enum nk_allocation_type {
     NK_BUFFER_FIXED,
-    NK_BUFFER_DYNAMIC
+    NK_BUFFER_DYNAMIC,
+    NK_BUFFER_SEGMENTED
 };
 
 enum nk_buffer_allocation_type {
@@ -4196,6 +4606,9 @@ struct nk_buffer {
     nk_size needed;               /**!< totally consumed memory given that enough memory is present */
     nk_size calls;                /**!< number of allocation calls */
     nk_size size;                 /**!< current size of the buffer */
+    nk_size segment_size;         /**!< size of each memory segment of a segmented buffer */
+    nk_size segment_count;        /**!< number of memory segments allocated by a segmented buffer */
+    struct nk_memory segments;    /**!< table of memory segments of a segmented buffer */
 };
 
 #ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
@@ -4203,6 +4616,7 @@ NK_API void nk_buffer_init_default(struct nk_buffer*);
 #endif
 NK_API void nk_buffer_init(struct nk_buffer*, const struct nk_allocator*, nk_size size);
 NK_API void nk_buffer_init_fixed(struct nk_buffer*, void *memory, nk_size size);
+NK_API void nk_buffer_init_segmented(struct nk_buffer*, const struct nk_allocator*, nk_size segment_size);
 NK_API void nk_buffer_info(struct nk_memory_status*, const struct nk_buffer*);
 NK_API void nk_buffer_push(struct nk_buffer*, enum nk_buffer_allocation_type type, const void *memory, nk_size size, nk_size align);
 NK_API void nk_buffer_mark(struct nk_buffer*, enum nk_buffer_allocation_type type);
@@ -4635,6 +5049,36 @@ struct nk_command_buffer {
     int use_clipping;
     nk_handle userdata;
     nk_size begin, end, last;
+#ifdef NK_INCLUDE_FRAME_STATS
+    struct nk_panel_stats *stats;
+#endif
+};
+
+enum nk_window_delta_status {
+    NK_WINDOW_DELTA_UNCHANGED,  /**!< all commands equal the previous frame */
+    NK_WINDOW_DELTA_CHANGED,    /**!< some commands differ, see `keep_front` and `keep_back` */
+    NK_WINDOW_DELTA_ADDED,      /**!< the window was not drawn in the previous frame */
+    NK_WINDOW_DELTA_REMOVED     /**!< the window was only drawn in the previous frame */
+};
+struct nk_window_delta {
+    nk_hash id;                 /**!< window name hash, popups and the cursor overlay get their own ids */
+    enum nk_window_delta_status status;
+    int prev_index;             /**!< index of the window in the previous frame or -1 */
+    unsigned int count;         /**!< number of commands in this frame */
+    unsigned int prev_count;    /**!< number of commands in the previous frame */
+    unsigned int keep_front;    /**!< leading commands equal to the previous frame */
+    unsigned int keep_back;     /**!< trailing commands equal to the previous frame */
+    struct nk_rect bounds;      /**!< area covered by changed commands of both frames */
+};
+struct nk_frame_delta {
+    struct nk_buffer commands[2];
+    struct nk_buffer windows[2];
+    struct nk_buffer deltas;
+    int current;
+    int synced;
+    unsigned int command_count; /**!< number of commands in the current frame */
+    unsigned int changed_count; /**!< commands of both frames not covered by `keep_front` or `keep_back`, including removed windows */
+    struct nk_rect damage;      /**!< union of all changed bounds or an empty rect */
 };
 
 /** shape outlines */
@@ -4662,6 +5106,160 @@ NK_API void nk_draw_text(struct nk_command_buffer*, struct nk_rect, const char *
 NK_API void nk_push_scissor(struct nk_command_buffer*, struct nk_rect);
 NK_API void nk_push_custom(struct nk_command_buffer*, struct nk_rect, nk_command_custom_callback, nk_handle usr);
 
+#ifdef NK_INCLUDE_COMMAND_STREAM
+/* ==============================================================
+ *                          COMMAND STREAM
+ * ===============================================================*/
+/**
+ * \page Command Stream
+ * With `NK_INCLUDE_COMMAND_STREAM` defined the draw commands of a finished
+ * frame can be encoded into a compact byte stream, sent to another process
+ * or machine and decoded there into a `nk_command_buffer`, for example the
+ * canvas of a background window, which is then drawn by any backend.
+ *
+ * Coordinates are delta coded against the previous command, colors are only
+ * sent if they differ from the last one and fonts and image handles are sent
+ * once and afterwards referenced by index. Each text is looked up in the
+ * strings sent in the current and previous frame and only sent again if it
+ * is new. Only commands of windows that changed since the previous frame are
+ * sent, everything else is copied by the decoder from its copy of the last
+ * decoded frame (see `nk_frame_delta`). Since encoder and decoder keep this
+ * state in sync every encoded frame has to be decoded in order. If a frame is lost, call
+ * `nk_command_stream_encoder_reset` so the next frame is sent in full.
+ *
+ * Custom commands only hold a local callback and are not encoded. Fonts are
+ * identified by their `nk_user_font::userdata` and height and mapped to a
+ * local font by the decoder `font` callback; image handles are passed through
+ * as is.
+ *
+ * ```c
+ * // sender
+ * nk_command_stream_encode(&encoder, &ctx, &packet);
+ * // [... send nk_buffer_memory(&packet) with packet.allocated bytes ...]
+ * nk_buffer_clear(&packet);
+ * nk_clear(&ctx);
+ *
+ * // receiver
+ * if (nk_begin(&ctx, "remote", bounds, NK_WINDOW_BACKGROUND|NK_WINDOW_NO_INPUT|NK_WINDOW_NO_SCROLLBAR)) {
+ *     if (!nk_command_stream_decode(&decoder, data, size, nk_window_get_canvas(&ctx)))
+ *         // [... ask the sender to reset its encoder ...]
+ * }
+ * nk_end(&ctx);
+ * ```
+ *
+ * # Reference
+ * Function                                  | Description
+ * ------------------------------------------|-------------------------------------------------------
+ * \ref nk_command_stream_encoder_init       | Initializes an encoder with an allocator for its string table
+ * \ref nk_command_stream_encoder_reset      | Forces the next encoded frame to not depend on previous frames
+ * \ref nk_command_stream_encoder_free       | Frees the memory held by an encoder
+ * \ref nk_command_stream_encode             | Appends the draw commands of the current frame to a buffer
+ * \ref nk_command_stream_decoder_init       | Initializes a decoder with an allocator and a default font
+ * \ref nk_command_stream_decoder_free       | Frees the memory held by a decoder
+ * \ref nk_command_stream_decode             | Adds the commands of one encoded frame to a command buffer
+ */
+#ifndef NK_COMMAND_STREAM_MAX_STRINGS
+#define NK_COMMAND_STREAM_MAX_STRINGS 1024
+#endif
+#ifndef NK_COMMAND_STREAM_MAX_FONTS
+#define NK_COMMAND_STREAM_MAX_FONTS 16
+#endif
+#ifndef NK_COMMAND_STREAM_MAX_IMAGES
+#define NK_COMMAND_STREAM_MAX_IMAGES 64
+#endif
+
+struct nk_command_stream_strings {
+    struct nk_buffer text;
+    nk_hash hash[NK_COMMAND_STREAM_MAX_STRINGS];
+    nk_size offset[NK_COMMAND_STREAM_MAX_STRINGS];
+    int length[NK_COMMAND_STREAM_MAX_STRINGS];
+    unsigned short slots[NK_COMMAND_STREAM_MAX_STRINGS*2];
+    int count;
+};
+struct nk_command_stream_state {
+    struct nk_command_stream_strings strings[2];
+    int current;
+    unsigned int frame;
+    int synced;
+    short x, y;
+    struct nk_color color;
+    int font_count;
+    float font_height[NK_COMMAND_STREAM_MAX_FONTS];
+    int image_count;
+    nk_handle images[NK_COMMAND_STREAM_MAX_IMAGES];
+};
+struct nk_command_stream_encoder {
+    struct nk_command_stream_state state;
+    struct nk_frame_delta delta;
+    const struct nk_user_font *fonts[NK_COMMAND_STREAM_MAX_FONTS];
+    unsigned int skipped; /**!< commands of the last frame that could not be encoded */
+};
+struct nk_command_stream_decoder {
+    struct nk_command_stream_state state;
+    struct nk_buffer commands[2]; /* copies of the decoded commands of the current and previous frame */
+    struct nk_buffer records[2];
+    struct nk_buffer windows[2];
+    const struct nk_user_font *fonts[NK_COMMAND_STREAM_MAX_FONTS];
+    const struct nk_user_font *default_font;
+    /** optional: maps a font of the sender to a local font, falls back to `default_font` */
+    const struct nk_user_font*(*font)(nk_handle userdata, nk_handle remote, float height);
+    nk_handle userdata;
+};
+
+#ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
+NK_API void nk_command_stream_encoder_init_default(struct nk_command_stream_encoder*);
+NK_API void nk_command_stream_decoder_init_default(struct nk_command_stream_decoder*, const struct nk_user_font*);
+#endif
+NK_API void nk_command_stream_encoder_init(struct nk_command_stream_encoder*, const struct nk_allocator*);
+NK_API void nk_command_stream_encoder_reset(struct nk_command_stream_encoder*);
+NK_API void nk_command_stream_encoder_free(struct nk_command_stream_encoder*);
+
+/**
+ * \brief Encodes all draw commands of the current frame
+ *
+ * \details
+ * Has to be called after the last `nk_end` and before `nk_clear`. Appends
+ * one self contained packet to `out`, which should be a fixed or dynamic
+ * buffer so the packet ends up in one block of memory.
+ *
+ * ```c
+ * nk_bool nk_command_stream_encode(struct nk_command_stream_encoder*, struct nk_context*, struct nk_buffer *out);
+ * ```
+ *
+ * \param[in] encoder | Must point to a previously initialized encoder
+ * \param[in] ctx     | Must point to an previously initialized `nk_context` struct at the end of a frame
+ * \param[out] out    | Buffer the packet is appended to
+ *
+ * \returns `false(0)` if `out` ran out of memory. The encoder is reset in that case
+ */
+NK_API nk_bool nk_command_stream_encode(struct nk_command_stream_encoder*, struct nk_context*, struct nk_buffer *out);
+
+NK_API void nk_command_stream_decoder_init(struct nk_command_stream_decoder*, const struct nk_allocator*, const struct nk_user_font*);
+NK_API void nk_command_stream_decoder_free(struct nk_command_stream_decoder*);
+
+/**
+ * \brief Decodes one packet written by `nk_command_stream_encode`
+ *
+ * \details
+ * The commands are appended to `out` exactly as they were encoded, without
+ * clipping them against `out->clip`. If the sender used scissor commands the
+ * clip rectangle of `out` is restored afterwards.
+ *
+ * ```c
+ * nk_bool nk_command_stream_decode(struct nk_command_stream_decoder*, const void *packet, nk_size size, struct nk_command_buffer *out);
+ * ```
+ *
+ * \param[in] decoder | Must point to a previously initialized decoder
+ * \param[in] packet  | Packet produced by `nk_command_stream_encode`
+ * \param[in] size    | Size of the packet in bytes
+ * \param[out] out    | Command buffer the decoded commands are added to
+ *
+ * \returns `false(0)` if the packet is damaged or a previous packet is
+ * missing. Following packets are rejected until the sender resets its encoder
+ */
+NK_API nk_bool nk_command_stream_decode(struct nk_command_stream_decoder*, const void *packet, nk_size size, struct nk_command_buffer *out);
+#endif
+
 /* ===============================================================
  *
  *                          INPUT
@@ -4801,9 +5399,11 @@ struct nk_draw_command {
 #endif
 };
 
+#define NK_DRAW_LIST_CIRCLE_TABLE_SIZE 360 /**< highly composite so most segment counts sample it with a fixed stride */
 struct nk_draw_list {
     struct nk_rect clip_rect;
     struct nk_vec2 circle_vtx[12];
+    struct nk_vec2 circle_table[NK_DRAW_LIST_CIRCLE_TABLE_SIZE];
     struct nk_convert_config config;
 
     struct nk_buffer *buffer;
@@ -5476,6 +6076,10 @@ struct nk_panel {
     struct nk_chart chart;
     struct nk_command_buffer *buffer;
     struct nk_panel *parent;
+#ifdef NK_INCLUDE_FRAME_STATS
+    struct nk_panel_stats *stats;
+    struct nk_panel_stats *stats_parent;
+#endif
 };
 
 /*==============================================================
@@ -5486,6 +6090,8 @@ struct nk_panel {
 #endif
 
 struct nk_table;
+struct nk_chart_stream;
+struct nk_text_cache;
 enum nk_window_flags {
     NK_WINDOW_PRIVATE       = NK_FLAG(11),
     NK_WINDOW_DYNAMIC       = NK_WINDOW_PRIVATE,                  /**< special window type growing up in height while being filled to a certain maximum height */
@@ -5546,6 +6152,7 @@ struct nk_window {
     struct nk_command_buffer buffer;
     struct nk_panel *layout;
     float scrollbar_hiding_timer;
+    unsigned int scrollbar_hiding_seq; /* frame in which a panel of this window still faded its scrollbar */
 
     /* persistent widget state */
     struct nk_property_state property;
@@ -5556,6 +6163,8 @@ struct nk_window {
 
     struct nk_table *tables;
     unsigned int table_count;
+    struct nk_chart_stream *streams;
+    struct nk_text_cache *text_cache;
 
     /* window list hooks */
     struct nk_window *next;
@@ -5661,8 +6270,11 @@ struct nk_configuration_stacks {
 /*==============================================================
  *                          CONTEXT
  * =============================================================*/
-#define NK_VALUE_PAGE_CAPACITY \
-    (((NK_MAX(sizeof(struct nk_window),sizeof(struct nk_panel)) / sizeof(nk_uint))) / 2)
+/* tables have their own pool size class, so their capacity is a fixed count
+ * that keeps a table element below the size of a panel */
+#ifndef NK_VALUE_PAGE_CAPACITY
+#define NK_VALUE_PAGE_CAPACITY 48
+#endif
 
 struct nk_table {
     unsigned int seq;
@@ -5672,16 +6284,88 @@ struct nk_table {
     struct nk_table *next, *prev;
 };
 
+/* number of samples kept per series if `nk_chart_stream_push` is not given
+ * a capacity */
+#ifndef NK_CHART_STREAM_CAPACITY
+#define NK_CHART_STREAM_CAPACITY 1024
+#endif
+#ifndef NK_CHART_STREAM_MAX_SERIES
+#define NK_CHART_STREAM_MAX_SERIES 8
+#endif
+#define NK_CHART_STREAM_BUCKET 16
+
+/* each series owns `capacity` values of a ring allocated with the context
+ * allocator, so only the pointer lives inside the window page element.
+ * Each series keeps the min/max of every NK_CHART_STREAM_BUCKET consecutive
+ * ring entries, updated on push, to answer range queries without a full scan */
+struct nk_chart_stream {
+    nk_hash name;
+    unsigned int seq;
+    int series;
+    int capacity;
+    int head;
+    int count;
+    float *values;
+    float *buckets;
+    struct nk_chart_stream *next, *prev;
+};
+
+#ifndef NK_TEXT_CACHE_SIZE
+#define NK_TEXT_CACHE_SIZE 16 /* initial number of entries, a power of two */
+#endif
+#ifndef NK_TEXT_CACHE_MAX_TEXT
+#define NK_TEXT_CACHE_MAX_TEXT 32
+#endif
+
+/* formatted text of value, label and property widgets of one window.
+ * Entries are found by widget hash with linear probing and remember the raw
+ * value they were formatted from, so an unchanged value skips formatting and
+ * measuring. The table is allocated with the context allocator and rebuilt
+ * from the entries used in the current and previous frame once it is three
+ * quarters full, so it follows the number of widgets drawn. Only contexts with
+ * a growing pool allocate a cache, longer texts are not cached */
+struct nk_text_cache_entry {
+    nk_hash key;
+    unsigned int seq;
+    nk_uint value[3];
+    const struct nk_user_font *font;
+    float height;
+    float width;
+    float label_width;
+    int length;
+    char text[NK_TEXT_CACHE_MAX_TEXT];
+};
+struct nk_text_cache {
+    struct nk_allocator alloc;
+    unsigned int seq;
+    unsigned int counter;
+    int capacity;
+    int count;
+    struct nk_text_cache_entry *entries;
+};
+
 union nk_page_data {
     struct nk_table tbl;
+    struct nk_chart_stream stream;
+    struct nk_text_cache text;
     struct nk_panel pan;
     struct nk_window win;
 };
 
+enum nk_page_element_type {
+    NK_PAGE_ELEMENT_TABLE,
+    NK_PAGE_ELEMENT_PANEL,
+    NK_PAGE_ELEMENT_WINDOW,
+    NK_PAGE_ELEMENT_STREAM,
+    NK_PAGE_ELEMENT_TEXT,
+    NK_PAGE_ELEMENT_TYPE_COUNT
+};
+
+/* page elements are only allocated as big as the `data` member they hold */
 struct nk_page_element {
-    union nk_page_data data;
     struct nk_page_element *next;
     struct nk_page_element *prev;
+    union nk_page_data data;
 };
 
 struct nk_page {
@@ -5694,12 +6378,50 @@ struct nk_pool {
     struct nk_allocator alloc;
     enum nk_allocation_type type;
     unsigned int page_count;
-    struct nk_page *pages;
-    struct nk_page_element *freelist;
+    struct nk_page *pages[NK_PAGE_ELEMENT_TYPE_COUNT];
     unsigned capacity;
+    void *memory;
     nk_size size;
-    nk_size cap;
+    nk_size allocated;
+};
+
+/*==============================================================
+ *                          FRAME STATS
+ * =============================================================*/
+#ifdef NK_INCLUDE_FRAME_STATS
+#ifndef NK_FRAME_STATS_MAX_PANELS
+#define NK_FRAME_STATS_MAX_PANELS 32
+#endif
+#define NK_COMMAND_TYPE_COUNT (NK_COMMAND_CUSTOM+1)
+
+struct nk_panel_stats {
+    char name[NK_WINDOW_MAX_NAME];
+    enum nk_panel_type type;
+    int parent; /**!< index of the parent panel or -1 for windows */
+    unsigned int commands[NK_COMMAND_TYPE_COUNT]; /**!< commands emitted per enum nk_command_type */
+    nk_size command_bytes;
+    unsigned int vertices;  /**!< vertices produced by `nk_convert` */
+    unsigned int indices;   /**!< indices produced by `nk_convert` */
+    unsigned int table_lookups;
+    unsigned int text_measurements;
+    unsigned int text_cache_hits; /**!< value, label and property texts reused without formatting */
+    nk_size begin, end; /**!< range inside the context command memory */
+};
+struct nk_memory_stats {
+    nk_size commands;       /**!< context command buffer */
+    nk_size pool;           /**!< window, panel and table storage */
+    nk_size draw_commands;  /**!< `nk_convert` draw command buffer */
+    nk_size vertices;       /**!< `nk_convert` vertex buffer */
+    nk_size elements;       /**!< `nk_convert` element buffer */
 };
+struct nk_frame_stats {
+    struct nk_panel_stats panels[NK_FRAME_STATS_MAX_PANELS];
+    int panel_count;
+    unsigned int dropped_panels; /**!< panels counted into their parent for lack of records */
+    struct nk_memory_stats memory;
+    struct nk_memory_stats high_water;
+};
+#endif
 
 struct nk_context {
 /* public: can be accessed freely */
@@ -5728,6 +6450,16 @@ struct nk_context {
     struct nk_text_edit text_edit;
     /** draw buffer used for overlay drawing operation like cursor */
     struct nk_command_buffer overlay;
+    /** draw buffer holding the commands copied from worker contexts */
+    struct nk_command_buffer merged;
+
+    /** worker contexts. Owners are 0 for this context or the worker index + 1 */
+    struct nk_mouse worker_mouse;
+    struct nk_keyboard worker_keyboard;
+    int mouse_owner;
+    int keyboard_owner;
+    int worker_count;
+    nk_flags worker_state;
 
     /** windows */
     int build;
@@ -5737,9 +6469,23 @@ struct nk_context {
     struct nk_window *end;
     struct nk_window *active;
     struct nk_window *current;
-    struct nk_page_element *freelist;
+    struct nk_page_element *freelist[NK_PAGE_ELEMENT_TYPE_COUNT];
     unsigned int count;
     unsigned int seq;
+
+    /** frame change detection */
+    nk_hash frame_hash;
+    nk_flags frame_status;
+    unsigned int frame_seq;
+#ifdef NK_INCLUDE_FRAME_STATS
+    struct nk_frame_stats stats;
+    struct nk_frame_stats last_stats;
+#endif
+#ifdef NK_INCLUDE_INPUT_RECORDING
+    struct nk_buffer *input_log;
+    int input_log_x, input_log_y;
+    float input_log_delta_time;
+#endif
 };
 
 /* ==============================================================
@@ -62,6 +62,20 @@ nk_buffer_init_fixed(struct nk_buffer *b, void *m, nk_size size)
     b->memory.size = size;
     b->size = size;
 }
+NK_API void
+nk_buffer_init_segmented(struct nk_buffer *b, const struct nk_allocator *a,
+    nk_size segment_size)
+{
+    NK_ASSERT(b);
+    NK_ASSERT(a);
+    NK_ASSERT(segment_size);
+    if (!b || !a || !segment_size) return;
+
+    nk_zero(b, sizeof(*b));
+    b->type = NK_BUFFER_SEGMENTED;
+    b->segment_size = segment_size;
+    b->pool = *a;
+}
 NK_LIB void*
 nk_buffer_align(void *unaligned,
     nk_size align, nk_size *alignment,
@@ -130,6 +144,101 @@ nk_buffer_realloc(struct nk_buffer *b, nk_size capacity, nk_size *size)
     }
     return temp;
 }
+NK_INTERN nk_bool
+nk_buffer_add_segment(struct nk_buffer *b)
+{
+    void **segments;
+    void *segment;
+    nk_size capacity;
+
+    NK_ASSERT(b->pool.alloc && b->pool.free);
+    if (!b->pool.alloc || !b->pool.free)
+        return nk_false;
+
+    /* grow segment table which only holds pointers so copying is cheap */
+    capacity = b->segments.size / sizeof(void*);
+    if (b->segment_count >= capacity) {
+        void *table;
+        capacity = NK_MAX(8, capacity * 2);
+        table = b->pool.alloc(b->pool.userdata, b->segments.ptr, capacity * sizeof(void*));
+        NK_ASSERT(table);
+        if (!table) return nk_false;
+        if (b->segments.ptr) {
+            NK_MEMCPY(table, b->segments.ptr, b->segment_count * sizeof(void*));
+            b->pool.free(b->pool.userdata, b->segments.ptr);
+        }
+        b->segments.ptr = table;
+        b->segments.size = capacity * sizeof(void*);
+    }
+    segment = b->pool.alloc(b->pool.userdata, 0, b->segment_size);
+    NK_ASSERT(segment);
+    if (!segment) return nk_false;
+
+    segments = (void**)b->segments.ptr;
+    segments[b->segment_count++] = segment;
+    b->memory.size += b->segment_size;
+    b->size = b->memory.size;
+    return nk_true;
+}
+NK_INTERN void*
+nk_buffer_alloc_segmented(struct nk_buffer *b, enum nk_buffer_allocation_type type,
+    nk_size size, nk_size align)
+{
+    nk_size alignment = 0;
+    void *memory = 0;
+
+    /* segments are only filled front to back and allocations never cross
+     * segment borders so every offset stays valid until the buffer is cleared */
+    NK_ASSERT(type == NK_BUFFER_FRONT);
+    NK_ASSERT(size <= b->segment_size);
+    if (type != NK_BUFFER_FRONT || size > b->segment_size)
+        return 0;
+    b->needed += size;
+
+    for (;;) {
+        nk_size index = b->allocated / b->segment_size;
+        nk_size offset = b->allocated % b->segment_size;
+        void *unaligned;
+
+        if (index >= b->segment_count && !nk_buffer_add_segment(b))
+            return 0;
+        unaligned = nk_ptr_add(void, ((void**)b->segments.ptr)[index], offset);
+        memory = nk_buffer_align(unaligned, align, &alignment, type);
+        if (offset + alignment + size <= b->segment_size)
+            break;
+        if (!offset) return 0;
+        /* continue at the beginning of the next segment */
+        b->allocated = (index + 1) * b->segment_size;
+    }
+    b->allocated += size + alignment;
+    b->needed += alignment;
+    b->calls++;
+    return memory;
+}
+NK_LIB nk_size
+nk_buffer_segment_left(const struct nk_buffer *b)
+{
+    NK_ASSERT(b->type == NK_BUFFER_SEGMENTED);
+    return b->segment_size - (b->allocated % b->segment_size);
+}
+NK_LIB nk_size
+nk_buffer_segment_next(struct nk_buffer *b)
+{
+    NK_ASSERT(b->type == NK_BUFFER_SEGMENTED);
+    b->allocated = (b->allocated / b->segment_size + 1) * b->segment_size;
+    return b->allocated;
+}
+NK_LIB void*
+nk_buffer_memory_at(const struct nk_buffer *b, nk_size offset)
+{
+    NK_ASSERT(b);
+    if (b->type == NK_BUFFER_SEGMENTED) {
+        void **segments = (void**)b->segments.ptr;
+        NK_ASSERT(offset / b->segment_size < b->segment_count);
+        return nk_ptr_add(void, segments[offset / b->segment_size], offset % b->segment_size);
+    }
+    return nk_ptr_add(void, b->memory.ptr, offset);
+}
 NK_LIB void*
 nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type,
     nk_size size, nk_size align)
@@ -142,6 +251,8 @@ nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type,
     NK_ASSERT(b);
     NK_ASSERT(size);
     if (!b || !size) return 0;
+    if (b->type == NK_BUFFER_SEGMENTED)
+        return nk_buffer_alloc_segmented(b, type, size, align);
     b->needed += size;
 
     /* calculate total size with needed alignment + size */
@@ -235,7 +346,20 @@ NK_API void
 nk_buffer_free(struct nk_buffer *b)
 {
     NK_ASSERT(b);
-    if (!b || !b->memory.ptr) return;
+    if (!b) return;
+    if (b->type == NK_BUFFER_SEGMENTED) {
+        nk_size i;
+        void **segments = (void**)b->segments.ptr;
+        if (!b->pool.free || !segments) return;
+        for (i = 0; i < b->segment_count; ++i)
+            b->pool.free(b->pool.userdata, segments[i]);
+        b->pool.free(b->pool.userdata, segments);
+        b->segments.ptr = 0;
+        b->segments.size = 0;
+        b->segment_count = 0;
+        return;
+    }
+    if (!b->memory.ptr) return;
     if (b->type == NK_BUFFER_FIXED) return;
     if (!b->pool.free) return;
     NK_ASSERT(b->pool.free);
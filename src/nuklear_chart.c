@@ -266,6 +266,191 @@ nk_chart_push(struct nk_context *ctx, float value)
 {
     return nk_chart_push_slot(ctx, value, 0);
 }
+struct nk_chart_series {
+    const float *values;
+    int stride;
+    float(*getter)(void*, int);
+    void *userdata;
+    int offset;
+};
+NK_INTERN float
+nk_chart_series_value(const struct nk_chart_series *series, int index)
+{
+    if (series->getter)
+        return series->getter(series->userdata, series->offset + index);
+    return *(const float*)(const void*)((const char*)series->values + index * series->stride);
+}
+NK_INTERN float
+nk_chart_series_y(const struct nk_chart *g, const struct nk_chart_slot *slot, float value)
+{
+    float ratio = (slot->range != 0) ? (value - slot->min) / slot->range: 0;
+    return (g->y + g->h) - ratio * g->h;
+}
+NK_INTERN nk_flags
+nk_chart_push_line_series(struct nk_context *ctx, struct nk_window *win,
+    struct nk_chart *g, const struct nk_chart_series *series, int count, int slot,
+    int *hovered)
+{
+    struct nk_chart_slot *s = &g->slots[slot];
+    struct nk_command_buffer *out = &win->buffer;
+    const struct nk_input *in = ctx->current->widgets_disabled ? 0 : &ctx->input;
+    struct nk_command_polyline *cmd = 0;
+    nk_flags ret = 0;
+    float step;
+    int first = s->index;
+    int columns;
+    int index = -1;
+    int i;
+
+    NK_ASSERT(slot >= 0 && slot < NK_CHART_MAX_SLOT);
+    if (hovered) *hovered = -1;
+    if (count <= 0 || s->count <= 0) return 0;
+    step = g->w / (float)s->count;
+
+    /* at most four points per pixel column (first, min, max, last) are needed to
+     * draw the same outline, so dense series are reduced before drawing */
+    columns = NK_MAX(nk_iceilf(step * (float)count), 1);
+    columns = NK_MIN(columns, 16000);
+    {const struct nk_rect *c = &out->clip;
+    if (!out->use_clipping || NK_INTERSECT(g->x, g->y, g->w, g->h, c->x, c->y, c->w, c->h)) {
+        nk_size size = sizeof(*cmd) + sizeof(short) * 2 * (nk_size)(NK_MIN(count, 4 * columns) + 1);
+        cmd = (struct nk_command_polyline*)nk_command_buffer_push(out, NK_COMMAND_POLYLINE, size);
+    }}
+    if (cmd) {
+        int n = 0;
+        cmd->color = s->color;
+        cmd->line_thickness = 1;
+        if (first) {
+            /* connect with the points pushed before */
+            cmd->points[n].x = (short)s->last.x;
+            cmd->points[n++].y = (short)s->last.y;
+        }
+        if (count <= 4 * columns) {
+            for (i = 0; i < count; ++i) {
+                cmd->points[n].x = (short)(g->x + step * (float)(first + i));
+                cmd->points[n++].y = (short)nk_chart_series_y(g, s, nk_chart_series_value(series, i));
+            }
+        } else {
+            float column_width = (step * (float)count) / (float)columns;
+            int column = 0;
+            int lo = 0, hi = 0, begin = 0;
+            float lo_value, hi_value;
+            lo_value = hi_value = nk_chart_series_value(series, 0);
+            for (i = 1; i <= count; ++i) {
+                float value = 0;
+                int c = columns;
+                if (i < count) {
+                    value = nk_chart_series_value(series, i);
+                    c = NK_MIN((int)((step * (float)i) / column_width), columns - 1);
+                }
+                if (c == column) {
+                    if (value < lo_value) {lo = i; lo_value = value;}
+                    if (value > hi_value) {hi = i; hi_value = value;}
+                    continue;
+                }
+                {/* emit first, min, max and last sample of the column in order */
+                int pick[4], k, p = 0;
+                pick[p++] = begin;
+                if (lo < hi) {pick[p++] = lo; pick[p++] = hi;}
+                else {pick[p++] = hi; pick[p++] = lo;}
+                pick[p++] = i - 1;
+                for (k = 0; k < p; ++k) {
+                    if (k && pick[k] == pick[k-1]) continue;
+                    cmd->points[n].x = (short)(g->x + step * (float)(first + pick[k]));
+                    cmd->points[n++].y = (short)nk_chart_series_y(g, s, nk_chart_series_value(series, pick[k]));
+                }}
+                column = c;
+                begin = lo = hi = i;
+                lo_value = hi_value = value;
+            }
+        }
+        cmd->point_count = (unsigned short)n;
+    }
+
+    /* hit test only samples inside the marker box around the mouse */
+    if (!(win->layout->flags & NK_WINDOW_ROM) && in &&
+        NK_INBOX(in->mouse.pos.x, in->mouse.pos.y, g->x - 3, g->y - 3, g->w + 6, g->h + 6)) {
+        float dx = in->mouse.pos.x - g->x;
+        int lo = NK_MAX(nk_iceilf((dx - 3) / step) - first, 0);
+        int hi = NK_MIN((int)((dx + 3) / step) - first, count - 1);
+        float best = 3;
+        for (i = lo; i <= hi; ++i) {
+            float y = nk_chart_series_y(g, s, nk_chart_series_value(series, i));
+            float dy = NK_ABS(in->mouse.pos.y - y);
+            if (dy <= best) {best = dy; index = i;}
+        }
+        if (index >= 0) {
+            ret = NK_CHART_HOVERING;
+            ret |= (!in->mouse.buttons[NK_BUTTON_LEFT].down &&
+                in->mouse.buttons[NK_BUTTON_LEFT].clicked) ? NK_CHART_CLICKED: 0;
+            if (hovered) *hovered = first + index;
+        }
+    }
+
+    /* markers are drawn for every sample unless the series was decimated,
+     * in which case only the hovered sample is marked */
+    if (s->show_markers) {
+        int begin = (count <= 4 * columns) ? 0: index;
+        int end = (count <= 4 * columns) ? count: index + 1;
+        for (i = NK_MAX(begin, 0); i < end; ++i) {
+            float x = g->x + step * (float)(first + i);
+            float y = nk_chart_series_y(g, s, nk_chart_series_value(series, i));
+            nk_fill_rect(out, nk_rect(x - 2, y - 2, 4, 4), 0,
+                (i == index) ? s->highlight: s->color);
+        }
+    }
+
+    /* save last data point position */
+    s->last.x = g->x + step * (float)(first + count - 1);
+    s->last.y = nk_chart_series_y(g, s, nk_chart_series_value(series, count - 1));
+    s->index += count;
+    return ret;
+}
+NK_INTERN nk_flags
+nk_chart_push_series(struct nk_context *ctx, const struct nk_chart_series *series,
+    int count, int slot, int *hovered)
+{
+    struct nk_window *win;
+    struct nk_chart *chart;
+    nk_flags flags = 0;
+    int i;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(slot >= 0 && slot < NK_CHART_MAX_SLOT);
+    if (hovered) *hovered = -1;
+    if (!ctx || !ctx->current || slot < 0 || slot >= NK_CHART_MAX_SLOT) return 0;
+    win = ctx->current;
+    chart = &win->layout->chart;
+    if (slot >= chart->slot) return 0;
+
+    if (chart->slots[slot].type == NK_CHART_LINES)
+        return nk_chart_push_line_series(ctx, win, chart, series, count, slot, hovered);
+    for (i = 0; i < count; ++i) {
+        nk_flags ret = nk_chart_push_slot(ctx, nk_chart_series_value(series, i), slot);
+        if (ret && hovered) *hovered = chart->slots[slot].index - 1;
+        flags |= ret;
+    }
+    return flags;
+}
+NK_API nk_flags
+nk_chart_push_slot_values(struct nk_context *ctx, const float *values, int count,
+    int stride, int slot, int *hovered)
+{
+    struct nk_chart_series series;
+    NK_ASSERT(values);
+    if (!values) return 0;
+    nk_zero_struct(series);
+    series.values = values;
+    series.stride = (stride) ? stride: (int)sizeof(float);
+    return nk_chart_push_series(ctx, &series, count, slot, hovered);
+}
+NK_API nk_flags
+nk_chart_push_values(struct nk_context *ctx, const float *values, int count,
+    int stride, int *hovered)
+{
+    return nk_chart_push_slot_values(ctx, values, count, stride, 0, hovered);
+}
 NK_API void
 nk_chart_end(struct nk_context *ctx)
 {
@@ -302,8 +487,7 @@ nk_plot(struct nk_context *ctx, enum nk_chart_type type, const float *values,
     }
 
     if (nk_chart_begin(ctx, type, count, min_value, max_value)) {
-        for (i = 0; i < count; ++i)
-            nk_chart_push(ctx, values[i + offset]);
+        nk_chart_push_values(ctx, values + offset, count, 0, 0);
         nk_chart_end(ctx);
     }
 }
@@ -327,9 +511,280 @@ nk_plot_function(struct nk_context *ctx, enum nk_chart_type type, void *userdata
     }
 
     if (nk_chart_begin(ctx, type, count, min_value, max_value)) {
-        for (i = 0; i < count; ++i)
-            nk_chart_push(ctx, value_getter(userdata, i + offset));
+        struct nk_chart_series series;
+        nk_zero_struct(series);
+        series.getter = value_getter;
+        series.userdata = userdata;
+        series.offset = offset;
+        nk_chart_push_series(ctx, &series, count, 0, 0);
         nk_chart_end(ctx);
     }
 }
 
+NK_LIB void
+nk_free_chart_stream(struct nk_context *ctx, struct nk_window *win,
+    struct nk_chart_stream *stream)
+{
+    union nk_page_data *pd = NK_CONTAINER_OF(stream, union nk_page_data, stream);
+    struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
+    if (stream->values)
+        ctx->pool.alloc.free(ctx->pool.alloc.userdata, stream->values);
+    if (win->streams == stream)
+        win->streams = stream->next;
+    if (stream->next)
+        stream->next->prev = stream->prev;
+    if (stream->prev)
+        stream->prev->next = stream->next;
+    nk_free_page_element(ctx, pe, NK_PAGE_ELEMENT_STREAM);
+}
+NK_INTERN struct nk_chart_stream*
+nk_chart_stream_find(struct nk_context *ctx, struct nk_window *win,
+    const char *name, int series, int capacity)
+{
+    nk_hash hash = nk_murmur_hash(name, (int)nk_strlen(name), NK_PAGE_ELEMENT_STREAM);
+    struct nk_chart_stream *stream = win->streams;
+    while (stream && stream->name != hash)
+        stream = stream->next;
+    if (!stream) {
+        struct nk_page_element *elem;
+        if (!series || !ctx->use_pool || ctx->pool.type != NK_BUFFER_DYNAMIC)
+            return 0;
+        elem = nk_create_page_element(ctx, NK_PAGE_ELEMENT_STREAM);
+        if (!elem) return 0;
+        stream = &elem->data.stream;
+        stream->name = hash;
+        stream->next = win->streams;
+        if (win->streams)
+            win->streams->prev = stream;
+        win->streams = stream;
+    }
+    if (series) {
+        /* every series gets `capacity` samples rounded up to whole buckets */
+        capacity = (capacity > 0) ? capacity: NK_CHART_STREAM_CAPACITY;
+        capacity += (NK_CHART_STREAM_BUCKET - capacity % NK_CHART_STREAM_BUCKET) % NK_CHART_STREAM_BUCKET;
+        if (stream->series != series || stream->capacity != capacity) {
+            nk_size size = (nk_size)series * (nk_size)capacity * sizeof(float);
+            size += size / NK_CHART_STREAM_BUCKET * 2;
+            if (stream->values)
+                ctx->pool.alloc.free(ctx->pool.alloc.userdata, stream->values);
+            stream->values = (float*)ctx->pool.alloc.alloc(ctx->pool.alloc.userdata, 0, size);
+            stream->buckets = 0;
+            stream->series = stream->capacity = 0;
+            stream->head = stream->count = 0;
+            if (!stream->values) return 0;
+            stream->buckets = stream->values + series * capacity;
+            stream->series = series;
+            stream->capacity = capacity;
+        }
+    }
+    stream->seq = win->seq;
+    return stream;
+}
+NK_API nk_bool
+nk_chart_stream_push(struct nk_context *ctx, const char *name,
+    const float *values, int series, int capacity)
+{
+    struct nk_chart_stream *stream;
+    int at, i;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(name);
+    NK_ASSERT(values);
+    NK_ASSERT(series > 0 && series <= NK_CHART_STREAM_MAX_SERIES);
+    if (!ctx || !ctx->current || !name || !values) return nk_false;
+    if (series <= 0 || series > NK_CHART_STREAM_MAX_SERIES) return nk_false;
+    stream = nk_chart_stream_find(ctx, ctx->current, name, series, capacity);
+    if (!stream) return nk_false;
+
+    at = stream->head + stream->count;
+    if (at >= stream->capacity)
+        at -= stream->capacity;
+    if (stream->count < stream->capacity)
+        stream->count++;
+    else if (++stream->head == stream->capacity)
+        stream->head = 0;
+
+    for (i = 0; i < series; ++i) {
+        int slot = i * stream->capacity + at;
+        float *bucket = stream->buckets + slot / NK_CHART_STREAM_BUCKET * 2;
+        stream->values[slot] = values[i];
+        if (at % NK_CHART_STREAM_BUCKET == 0) {
+            /* entering a bucket overwrites its oldest samples */
+            bucket[0] = bucket[1] = values[i];
+        } else {
+            bucket[0] = NK_MIN(bucket[0], values[i]);
+            bucket[1] = NK_MAX(bucket[1], values[i]);
+        }
+    }
+    return nk_true;
+}
+NK_INTERN float
+nk_chart_stream_value(const struct nk_chart_stream *stream, int series, int index)
+{
+    int at = stream->head + index;
+    if (at >= stream->capacity)
+        at -= stream->capacity;
+    return stream->values[series * stream->capacity + at];
+}
+NK_INTERN void
+nk_chart_stream_range(const struct nk_chart_stream *stream, int series,
+    int begin, int end, float *lo, float *hi)
+{
+    /* whole buckets inside [begin, end) are read from the bucket summary. The
+     * bucket which is currently overwritten can never lie completely inside
+     * the range since it holds both the oldest and the newest samples */
+    const float *values = stream->values + series * stream->capacity;
+    const int first_bucket = series * stream->capacity / NK_CHART_STREAM_BUCKET;
+    int at = stream->head + begin;
+    if (at >= stream->capacity)
+        at -= stream->capacity;
+    *lo = *hi = values[at];
+    while (begin < end) {
+        if (at % NK_CHART_STREAM_BUCKET == 0 && begin + NK_CHART_STREAM_BUCKET <= end) {
+            const float *bucket = stream->buckets + (first_bucket + at / NK_CHART_STREAM_BUCKET) * 2;
+            *lo = NK_MIN(*lo, bucket[0]);
+            *hi = NK_MAX(*hi, bucket[1]);
+            begin += NK_CHART_STREAM_BUCKET;
+            at += NK_CHART_STREAM_BUCKET;
+        } else {
+            *lo = NK_MIN(*lo, values[at]);
+            *hi = NK_MAX(*hi, values[at]);
+            begin++;
+            at++;
+        }
+        if (at == stream->capacity)
+            at = 0;
+    }
+}
+NK_INTERN void
+nk_chart_stream_draw(struct nk_command_buffer *out, const struct nk_chart *g,
+    const struct nk_chart_slot *slot, const struct nk_chart_stream *stream, int series)
+{
+    const int count = stream->count;
+    const float step = g->w / (float)stream->capacity;
+    const float right = g->x + g->w;
+    struct nk_command_polyline *cmd;
+    int columns, n = 0, i;
+    nk_size size;
+
+    columns = NK_MAX(nk_iceilf(step * (float)count), 1);
+    columns = NK_MIN(columns, 16000);
+    size = sizeof(*cmd) + sizeof(short) * 2 * (nk_size)NK_MIN(count, 4 * columns);
+    cmd = (struct nk_command_polyline*)nk_command_buffer_push(out, NK_COMMAND_POLYLINE, size);
+    if (!cmd) return;
+    cmd->color = slot->color;
+    cmd->line_thickness = 1;
+
+    if (count <= 4 * columns) {
+        for (i = 0; i < count; ++i) {
+            cmd->points[n].x = (short)(right - step * (float)(count - 1 - i));
+            cmd->points[n++].y = (short)nk_chart_series_y(g, slot, nk_chart_stream_value(stream, series, i));
+        }
+    } else {
+        /* reduce each pixel column to its first, min, max and last sample */
+        for (i = 0; i < columns; ++i) {
+            const int begin = (int)(((nk_size)i * (nk_size)count) / (nk_size)columns);
+            const int end = (int)(((nk_size)(i + 1) * (nk_size)count) / (nk_size)columns);
+            float first = nk_chart_stream_value(stream, series, begin);
+            float last = nk_chart_stream_value(stream, series, end - 1);
+            float x = right - step * (float)(count - 1 - begin);
+            float lo, hi, y[4];
+            int k;
+
+            nk_chart_stream_range(stream, series, begin, end, &lo, &hi);
+            y[0] = first;
+            if (first - lo < hi - first) {y[1] = lo; y[2] = hi;}
+            else {y[1] = hi; y[2] = lo;}
+            y[3] = last;
+            for (k = 0; k < 4; ++k) {
+                if (k && y[k] == y[k-1]) continue;
+                if (k == 3) x = right - step * (float)(count - end);
+                cmd->points[n].x = (short)x;
+                cmd->points[n++].y = (short)nk_chart_series_y(g, slot, y[k]);
+            }
+        }
+    }
+    cmd->point_count = (unsigned short)n;
+}
+NK_API nk_flags
+nk_chart_stream(struct nk_context *ctx, const char *name,
+    const struct nk_color *colors, float min, float max,
+    int *series, int *index)
+{
+    struct nk_window *win;
+    struct nk_chart_stream *stream;
+    struct nk_chart *g;
+    const struct nk_input *in;
+    struct nk_chart_slot slot;
+    nk_flags ret = 0;
+    int i;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(name);
+    if (series) *series = -1;
+    if (index) *index = -1;
+    if (!ctx || !ctx->current || !ctx->current->layout || !name) return 0;
+
+    win = ctx->current;
+    stream = nk_chart_stream_find(ctx, win, name, 0, 0);
+    if (stream && stream->count && min == max) {
+        for (i = 0; i < stream->series; ++i) {
+            float lo, hi;
+            nk_chart_stream_range(stream, i, 0, stream->count, &lo, &hi);
+            min = (i) ? NK_MIN(min, lo): lo;
+            max = (i) ? NK_MAX(max, hi): hi;
+        }
+    }
+    if (!nk_chart_begin(ctx, NK_CHART_LINES, (stream && stream->capacity) ? stream->capacity: 1, min, max))
+        return 0;
+    g = &win->layout->chart;
+    slot = g->slots[0];
+    if (!stream || !stream->count) {
+        nk_chart_end(ctx);
+        return 0;
+    }
+
+    {const struct nk_rect *c = &win->buffer.clip;
+    if (!win->buffer.use_clipping || NK_INTERSECT(g->x, g->y, g->w, g->h, c->x, c->y, c->w, c->h)) {
+        for (i = 0; i < stream->series; ++i) {
+            if (colors) slot.color = nk_rgb_factor(colors[i], ctx->style.chart.color_factor);
+            nk_chart_stream_draw(&win->buffer, g, &slot, stream, i);
+        }
+    }}
+
+    /* hit test only samples inside the marker box around the mouse */
+    in = win->widgets_disabled ? 0 : &ctx->input;
+    if (!(win->layout->flags & NK_WINDOW_ROM) && in &&
+        NK_INBOX(in->mouse.pos.x, in->mouse.pos.y, g->x - 3, g->y - 3, g->w + 6, g->h + 6)) {
+        const float step = g->w / (float)stream->capacity;
+        const float dx = g->x + g->w - in->mouse.pos.x;
+        const int last = stream->count - 1;
+        int lo = NK_MAX(last - (int)((dx + 3) / step), 0);
+        int hi = NK_MIN(last - nk_iceilf((dx - 3) / step), last);
+        int hit = -1, hit_series = -1, j;
+        float best = 3;
+        for (i = 0; i < stream->series; ++i) {
+            for (j = lo; j <= hi; ++j) {
+                float y = nk_chart_series_y(g, &slot, nk_chart_stream_value(stream, i, j));
+                float dy = NK_ABS(in->mouse.pos.y - y);
+                if (dy <= best) {best = dy; hit = j; hit_series = i;}
+            }
+        }
+        if (hit >= 0) {
+            struct nk_vec2 p;
+            p.x = g->x + g->w - step * (float)(last - hit);
+            p.y = nk_chart_series_y(g, &slot, nk_chart_stream_value(stream, hit_series, hit));
+            ret = NK_CHART_HOVERING;
+            ret |= (!in->mouse.buttons[NK_BUTTON_LEFT].down &&
+                in->mouse.buttons[NK_BUTTON_LEFT].clicked) ? NK_CHART_CLICKED: 0;
+            if (slot.show_markers)
+                nk_fill_rect(&win->buffer, nk_rect(p.x - 2, p.y - 2, 4, 4), 0, slot.highlight);
+            if (series) *series = hit_series;
+            if (index) *index = hit;
+        }
+    }
+    nk_chart_end(ctx);
+    return ret;
+}
@@ -701,6 +701,25 @@ NK_API void nk_combo_close(struct nk_context *ctx)
 {
     nk_contextual_close(ctx);
 }
+NK_INTERN void
+nk_combo_rows_begin(struct nk_context *ctx, int count, int *begin, int *end)
+{
+    /* only rows overlapping the visible part of the popup are laid out and
+     * drawn. All rows above are skipped by moving the layout cursor */
+    struct nk_panel *layout = ctx->current->layout;
+    float row_height = NK_MAX(layout->row.height, 1.0f);
+    float offset = (float)*layout->offset_y;
+    *begin = NK_CLAMP(0, (int)(offset / row_height), count);
+    *end = NK_CLAMP(*begin, nk_iceilf((offset + layout->clip.h) / row_height) + 1, count);
+    layout->at_y += row_height * (float)*begin;
+}
+NK_INTERN void
+nk_combo_rows_end(struct nk_context *ctx, int count, int end)
+{
+    /* skip rows below so the scrollbar still covers all items */
+    struct nk_panel *layout = ctx->current->layout;
+    layout->at_y += layout->row.height * (float)(count - end);
+}
 NK_API int
 nk_combo(struct nk_context *ctx, const char *const *items, int count,
     int selected, int item_height, struct nk_vec2 size)
@@ -722,15 +741,28 @@ nk_combo(struct nk_context *ctx, const char *const *items, int count,
     max_height += (int)item_spacing.y * 2 + (int)window_padding.y * 2;
     size.y = NK_MIN(size.y, (float)max_height);
     if (nk_combo_begin_label(ctx, items[selected], size)) {
+        int begin, end;
         nk_layout_row_dynamic(ctx, (float)item_height, 1);
-        for (i = 0; i < count; ++i) {
+        nk_combo_rows_begin(ctx, count, &begin, &end);
+        for (i = begin; i < end; ++i) {
             if (nk_combo_item_label(ctx, items[i], NK_TEXT_LEFT))
                 selected = i;
         }
+        nk_combo_rows_end(ctx, count, end);
         nk_combo_end(ctx);
     }
     return selected;
 }
+NK_INTERN const char*
+nk_combo_separator_seek(const char *item, int separator, int from, int to)
+{
+    /* walk item by item from a known item start */
+    for (; from < to; ++from) {
+        while (*item && *item != separator) item++;
+        if (*item == (char)separator) item++;
+    }
+    return item;
+}
 NK_API int
 nk_combo_separator(struct nk_context *ctx, const char *items_separated_by_separator,
     int separator, int selected, int count, int item_height, struct nk_vec2 size)
@@ -741,6 +773,7 @@ nk_combo_separator(struct nk_context *ctx, const char *items_separated_by_separa
     struct nk_vec2 window_padding;
     const char *current_item;
     const char *iter;
+    int current;
     int length = 0;
 
     NK_ASSERT(ctx);
@@ -755,27 +788,34 @@ nk_combo_separator(struct nk_context *ctx, const char *items_separated_by_separa
     max_height += (int)item_spacing.y * 2 + (int)window_padding.y * 2;
     size.y = NK_MIN(size.y, (float)max_height);
 
-    /* find selected item */
-    current_item = items_separated_by_separator;
-    for (i = 0; i < count; ++i) {
-        iter = current_item;
-        while (*iter && *iter != separator) iter++;
-        length = (int)(iter - current_item);
-        if (i == selected) break;
-        current_item = iter + 1;
-    }
+    /* find selected item. Item offsets are not kept across frames since the
+     * caller may rewrite the string in place and validating a stored offset
+     * costs as much as the scan itself. */
+    current = NK_CLAMP(0, selected, count-1);
+    current_item = nk_combo_separator_seek(items_separated_by_separator,
+        separator, 0, current);
+    iter = current_item;
+    while (*iter && *iter != separator) iter++;
+    length = (int)(iter - current_item);
 
     if (nk_combo_begin_text(ctx, current_item, length, size)) {
-        current_item = items_separated_by_separator;
+        int begin, end;
         nk_layout_row_dynamic(ctx, (float)item_height, 1);
-        for (i = 0; i < count; ++i) {
+        nk_combo_rows_begin(ctx, count, &begin, &end);
+        /* continue from the selected item if the first visible row follows it */
+        if (begin >= current)
+            current_item = nk_combo_separator_seek(current_item, separator, current, begin);
+        else current_item = nk_combo_separator_seek(items_separated_by_separator,
+            separator, 0, begin);
+        for (i = begin; i < end; ++i) {
             iter = current_item;
             while (*iter && *iter != separator) iter++;
             length = (int)(iter - current_item);
             if (nk_combo_item_text(ctx, current_item, length, NK_TEXT_LEFT))
                 selected = i;
-            current_item = current_item + length + 1;
+            current_item = (*iter == (char)separator) ? iter + 1: iter;
         }
+        nk_combo_rows_end(ctx, count, end);
         nk_combo_end(ctx);
     }
     return selected;
@@ -810,12 +850,15 @@ nk_combo_callback(struct nk_context *ctx, void(*item_getter)(void*, int, const c
 
     item_getter(userdata, selected, &item);
     if (nk_combo_begin_label(ctx, item, size)) {
+        int begin, end;
         nk_layout_row_dynamic(ctx, (float)item_height, 1);
-        for (i = 0; i < count; ++i) {
+        nk_combo_rows_begin(ctx, count, &begin, &end);
+        for (i = begin; i < end; ++i) {
             item_getter(userdata, i, &item);
             if (nk_combo_item_label(ctx, item, NK_TEXT_LEFT))
                 selected = i;
         }
+        nk_combo_rows_end(ctx, count, end);
         nk_combo_end(ctx);
     } return selected;
 }
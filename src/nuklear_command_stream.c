@@ -0,0 +1,1114 @@
+#include "nuklear.h"
+#include "nuklear_internal.h"
+
+/* ===============================================================
+ *
+ *                          COMMAND STREAM
+ *
+ * ===============================================================*/
+#ifdef NK_INCLUDE_COMMAND_STREAM
+/* A packet starts with a four byte magic, a version byte, a flags byte and
+ * the frame number, followed by one record per window range reported by
+ * `nk_frame_delta` and an end record. A window record names the window of
+ * the previous frame and how many commands at its front and back are kept,
+ * followed by one record for each changed command. Each record begins with
+ * a tag byte holding the command type in the lower five bits. Coordinates
+ * are zig-zag varint deltas to the previous point, sizes unsigned varints
+ * and floats little endian 32-bit words. */
+NK_GLOBAL const nk_byte nk_command_stream_magic[5] = {'N','K','C','S',1};
+
+enum nk_command_stream_record {
+    NK_COMMAND_STREAM_FONT = 24,
+    NK_COMMAND_STREAM_IMAGE = 25,
+    NK_COMMAND_STREAM_WINDOW = 26,
+    NK_COMMAND_STREAM_END = 31
+};
+enum nk_command_stream_tag_flags {
+    NK_COMMAND_STREAM_TYPE_MASK = 0x1F,
+    NK_COMMAND_STREAM_SAME_COLOR = NK_FLAG(5),  /* color equals the previous color */
+    NK_COMMAND_STREAM_FONT_HEIGHT = NK_FLAG(6)  /* text height equals the font height */
+};
+enum nk_command_stream_packet_flags {
+    NK_COMMAND_STREAM_KEY_FRAME = NK_FLAG(0)
+};
+
+/* ---------------------------------------------------------------
+ *                          SHARED STATE
+ * ---------------------------------------------------------------*/
+NK_INTERN void
+nk_command_stream_strings_clear(struct nk_command_stream_strings *s)
+{
+    nk_buffer_clear(&s->text);
+    nk_zero_struct(s->slots);
+    s->count = 0;
+}
+NK_INTERN int
+nk_command_stream_equal(const char *a, const char *b, int len)
+{
+    while (len--)
+        if (*a++ != *b++) return nk_false;
+    return nk_true;
+}
+NK_INTERN int
+nk_command_stream_strings_find(const struct nk_command_stream_strings *s,
+    const char *str, int len, nk_hash hash)
+{
+    const int mask = (int)NK_LEN(s->slots) - 1;
+    int slot = (int)(hash & (nk_hash)mask);
+    while (s->slots[slot]) {
+        const int index = s->slots[slot] - 1;
+        if (s->hash[index] == hash && s->length[index] == len &&
+            nk_command_stream_equal((const char*)nk_buffer_memory_at(&s->text, s->offset[index]), str, len))
+            return index;
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+NK_INTERN void
+nk_command_stream_strings_add(struct nk_command_stream_strings *s,
+    const char *str, int len, nk_hash hash)
+{
+    const int mask = (int)NK_LEN(s->slots) - 1;
+    int slot = (int)(hash & (nk_hash)mask);
+    void *mem;
+
+    if (s->count >= NK_COMMAND_STREAM_MAX_STRINGS) return;
+    mem = nk_buffer_alloc(&s->text, NK_BUFFER_FRONT, (nk_size)len, 1);
+    if (!mem) return;
+    NK_MEMCPY(mem, str, (nk_size)len);
+    s->hash[s->count] = hash;
+    s->offset[s->count] = s->text.allocated - (nk_size)len;
+    s->length[s->count] = len;
+    while (s->slots[slot])
+        slot = (slot + 1) & mask;
+    s->slots[slot] = (unsigned short)++s->count;
+}
+NK_INTERN void
+nk_command_stream_state_init(struct nk_command_stream_state *state,
+    const struct nk_allocator *alloc)
+{
+    nk_zero(state, sizeof(*state));
+    nk_buffer_init(&state->strings[0].text, alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    nk_buffer_init(&state->strings[1].text, alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+}
+NK_INTERN void
+nk_command_stream_state_free(struct nk_command_stream_state *state)
+{
+    nk_buffer_free(&state->strings[0].text);
+    nk_buffer_free(&state->strings[1].text);
+}
+NK_INTERN void
+nk_command_stream_state_reset(struct nk_command_stream_state *state)
+{
+    nk_command_stream_strings_clear(&state->strings[0]);
+    nk_command_stream_strings_clear(&state->strings[1]);
+    state->font_count = 0;
+    state->image_count = 0;
+}
+NK_INTERN void
+nk_command_stream_state_begin(struct nk_command_stream_state *state)
+{
+    /* strings of the previous frame stay referencable for one more frame */
+    state->current = !state->current;
+    nk_command_stream_strings_clear(&state->strings[state->current]);
+    state->x = state->y = 0;
+    state->color = nk_rgba(0,0,0,0);
+}
+NK_INTERN int
+nk_command_stream_same_color(struct nk_color a, struct nk_color b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+/* ---------------------------------------------------------------
+ *                          ENCODER
+ * ---------------------------------------------------------------*/
+struct nk_command_stream_writer {
+    struct nk_buffer *out;
+    nk_byte record[96];
+    int len;
+    int failed;
+};
+NK_INTERN void
+nk_command_stream_flush(struct nk_command_stream_writer *w)
+{
+    void *mem;
+    if (!w->len || w->failed) {
+        w->len = 0;
+        return;
+    }
+    mem = nk_buffer_alloc(w->out, NK_BUFFER_FRONT, (nk_size)w->len, 1);
+    if (mem) NK_MEMCPY(mem, w->record, (nk_size)w->len);
+    else w->failed = nk_true;
+    w->len = 0;
+}
+NK_INTERN void
+nk_command_stream_put_byte(struct nk_command_stream_writer *w, nk_byte b)
+{
+    if (w->len >= (int)sizeof(w->record))
+        nk_command_stream_flush(w);
+    w->record[w->len++] = b;
+}
+NK_INTERN void
+nk_command_stream_put_uint(struct nk_command_stream_writer *w, nk_ptr u)
+{
+    while (u >= 0x80) {
+        nk_command_stream_put_byte(w, (nk_byte)(u | 0x80));
+        u >>= 7;
+    }
+    nk_command_stream_put_byte(w, (nk_byte)u);
+}
+NK_INTERN void
+nk_command_stream_put_int(struct nk_command_stream_writer *w, int value)
+{
+    nk_command_stream_put_uint(w, (value < 0) ?
+        (((nk_ptr)(-(value + 1))) << 1) | 1u: ((nk_ptr)value) << 1);
+}
+NK_INTERN void
+nk_command_stream_put_float(struct nk_command_stream_writer *w, float value)
+{
+    nk_uint u;
+    NK_MEMCPY(&u, &value, sizeof(u));
+    nk_command_stream_put_byte(w, (nk_byte)(u & 0xFF));
+    nk_command_stream_put_byte(w, (nk_byte)((u >> 8) & 0xFF));
+    nk_command_stream_put_byte(w, (nk_byte)((u >> 16) & 0xFF));
+    nk_command_stream_put_byte(w, (nk_byte)((u >> 24) & 0xFF));
+}
+NK_INTERN void
+nk_command_stream_put_color(struct nk_command_stream_writer *w, struct nk_color c)
+{
+    nk_command_stream_put_byte(w, c.r);
+    nk_command_stream_put_byte(w, c.g);
+    nk_command_stream_put_byte(w, c.b);
+    nk_command_stream_put_byte(w, c.a);
+}
+NK_INTERN void
+nk_command_stream_put_point(struct nk_command_stream_writer *w,
+    short *x, short *y, short nx, short ny)
+{
+    nk_command_stream_put_int(w, (int)nx - (int)*x);
+    nk_command_stream_put_int(w, (int)ny - (int)*y);
+    *x = nx; *y = ny;
+}
+NK_INTERN void
+nk_command_stream_put_rect(struct nk_command_stream_writer *w,
+    struct nk_command_stream_state *state, short x, short y,
+    unsigned short width, unsigned short height)
+{
+    nk_command_stream_put_point(w, &state->x, &state->y, x, y);
+    nk_command_stream_put_uint(w, width);
+    nk_command_stream_put_uint(w, height);
+}
+NK_INTERN void
+nk_command_stream_put_points(struct nk_command_stream_writer *w,
+    struct nk_command_stream_state *state, const struct nk_vec2i *points, int count)
+{
+    short x, y;
+    int i;
+    if (!count) return;
+    nk_command_stream_put_point(w, &state->x, &state->y, points[0].x, points[0].y);
+    x = state->x; y = state->y;
+    for (i = 1; i < count; ++i)
+        nk_command_stream_put_point(w, &x, &y, points[i].x, points[i].y);
+}
+NK_INTERN void
+nk_command_stream_put_tag(struct nk_command_stream_writer *w,
+    struct nk_command_stream_state *state, enum nk_command_type type,
+    struct nk_color color)
+{
+    /* the color itself follows the tag byte if it changed */
+    if (nk_command_stream_same_color(color, state->color)) {
+        nk_command_stream_put_byte(w, (nk_byte)(type | NK_COMMAND_STREAM_SAME_COLOR));
+    } else {
+        nk_command_stream_put_byte(w, (nk_byte)type);
+        nk_command_stream_put_color(w, color);
+        state->color = color;
+    }
+}
+NK_INTERN int
+nk_command_stream_font(struct nk_command_stream_encoder *enc,
+    struct nk_command_stream_writer *w, const struct nk_user_font *font)
+{
+    struct nk_command_stream_state *state = &enc->state;
+    int i;
+    for (i = 0; i < state->font_count; ++i)
+        if (enc->fonts[i] == font) return i;
+    if (state->font_count >= NK_COMMAND_STREAM_MAX_FONTS)
+        return -1;
+    enc->fonts[state->font_count] = font;
+    state->font_height[state->font_count] = font->height;
+    nk_command_stream_put_byte(w, NK_COMMAND_STREAM_FONT);
+    nk_command_stream_put_float(w, font->height);
+    nk_command_stream_put_uint(w, (nk_ptr)font->userdata.ptr);
+    return state->font_count++;
+}
+NK_INTERN int
+nk_command_stream_image(struct nk_command_stream_state *state,
+    struct nk_command_stream_writer *w, nk_handle handle)
+{
+    int i;
+    for (i = 0; i < state->image_count; ++i)
+        if (state->images[i].ptr == handle.ptr) return i;
+    if (state->image_count >= NK_COMMAND_STREAM_MAX_IMAGES)
+        return -1;
+    state->images[state->image_count] = handle;
+    nk_command_stream_put_byte(w, NK_COMMAND_STREAM_IMAGE);
+    nk_command_stream_put_uint(w, (nk_ptr)handle.ptr);
+    return state->image_count++;
+}
+NK_INTERN void
+nk_command_stream_put_string(struct nk_command_stream_writer *w,
+    struct nk_command_stream_state *state, const char *str, int len)
+{
+    struct nk_command_stream_strings *cur = &state->strings[state->current];
+    struct nk_command_stream_strings *prev = &state->strings[!state->current];
+    const nk_hash hash = nk_murmur_hash(str, len, 0);
+    int i;
+
+    /* 0 is a new string, otherwise an index into the current or previous frame */
+    if ((i = nk_command_stream_strings_find(cur, str, len, hash)) >= 0) {
+        nk_command_stream_put_uint(w, ((nk_ptr)i << 1) + 1);
+        return;
+    }
+    if ((i = nk_command_stream_strings_find(prev, str, len, hash)) >= 0) {
+        nk_command_stream_put_uint(w, ((nk_ptr)i << 1) + 2);
+    } else {
+        nk_command_stream_put_uint(w, 0);
+        nk_command_stream_put_uint(w, (nk_ptr)len);
+        for (i = 0; i < len; ++i)
+            nk_command_stream_put_byte(w, (nk_byte)str[i]);
+    }
+    nk_command_stream_strings_add(cur, str, len, hash);
+}
+NK_INTERN int
+nk_command_stream_encode_command(struct nk_command_stream_encoder *enc,
+    struct nk_command_stream_writer *w, const struct nk_command *cmd)
+{
+    struct nk_command_stream_state *state = &enc->state;
+    switch (cmd->type) {
+    case NK_COMMAND_NOP: break;
+    case NK_COMMAND_SCISSOR: {
+        const struct nk_command_scissor *s = (const struct nk_command_scissor*)cmd;
+        nk_command_stream_put_byte(w, (nk_byte)cmd->type);
+        nk_command_stream_put_rect(w, state, s->x, s->y, s->w, s->h);
+    } break;
+    case NK_COMMAND_LINE: {
+        const struct nk_command_line *l = (const struct nk_command_line*)cmd;
+        short x, y;
+        nk_command_stream_put_tag(w, state, cmd->type, l->color);
+        nk_command_stream_put_uint(w, l->line_thickness);
+        nk_command_stream_put_point(w, &state->x, &state->y, l->begin.x, l->begin.y);
+        x = state->x; y = state->y;
+        nk_command_stream_put_point(w, &x, &y, l->end.x, l->end.y);
+    } break;
+    case NK_COMMAND_CURVE: {
+        const struct nk_command_curve *q = (const struct nk_command_curve*)cmd;
+        short x, y;
+        nk_command_stream_put_tag(w, state, cmd->type, q->color);
+        nk_command_stream_put_uint(w, q->line_thickness);
+        nk_command_stream_put_point(w, &state->x, &state->y, q->begin.x, q->begin.y);
+        x = state->x; y = state->y;
+        nk_command_stream_put_point(w, &x, &y, q->ctrl[0].x, q->ctrl[0].y);
+        nk_command_stream_put_point(w, &x, &y, q->ctrl[1].x, q->ctrl[1].y);
+        nk_command_stream_put_point(w, &x, &y, q->end.x, q->end.y);
+    } break;
+    case NK_COMMAND_RECT: {
+        const struct nk_command_rect *r = (const struct nk_command_rect*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, r->color);
+        nk_command_stream_put_uint(w, r->rounding);
+        nk_command_stream_put_uint(w, r->line_thickness);
+        nk_command_stream_put_rect(w, state, r->x, r->y, r->w, r->h);
+    } break;
+    case NK_COMMAND_RECT_FILLED: {
+        const struct nk_command_rect_filled *r = (const struct nk_command_rect_filled*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, r->color);
+        nk_command_stream_put_uint(w, r->rounding);
+        nk_command_stream_put_rect(w, state, r->x, r->y, r->w, r->h);
+    } break;
+    case NK_COMMAND_RECT_MULTI_COLOR: {
+        const struct nk_command_rect_multi_color *r = (const struct nk_command_rect_multi_color*)cmd;
+        nk_command_stream_put_byte(w, (nk_byte)cmd->type);
+        nk_command_stream_put_rect(w, state, r->x, r->y, r->w, r->h);
+        nk_command_stream_put_color(w, r->left);
+        nk_command_stream_put_color(w, r->top);
+        nk_command_stream_put_color(w, r->bottom);
+        nk_command_stream_put_color(w, r->right);
+    } break;
+    case NK_COMMAND_CIRCLE: {
+        const struct nk_command_circle *c = (const struct nk_command_circle*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, c->color);
+        nk_command_stream_put_uint(w, c->line_thickness);
+        nk_command_stream_put_rect(w, state, c->x, c->y, c->w, c->h);
+    } break;
+    case NK_COMMAND_CIRCLE_FILLED: {
+        const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, c->color);
+        nk_command_stream_put_rect(w, state, c->x, c->y, c->w, c->h);
+    } break;
+    case NK_COMMAND_ARC: {
+        const struct nk_command_arc *a = (const struct nk_command_arc*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, a->color);
+        nk_command_stream_put_uint(w, a->line_thickness);
+        nk_command_stream_put_point(w, &state->x, &state->y, a->cx, a->cy);
+        nk_command_stream_put_uint(w, a->r);
+        nk_command_stream_put_float(w, a->a[0]);
+        nk_command_stream_put_float(w, a->a[1]);
+    } break;
+    case NK_COMMAND_ARC_FILLED: {
+        const struct nk_command_arc_filled *a = (const struct nk_command_arc_filled*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, a->color);
+        nk_command_stream_put_point(w, &state->x, &state->y, a->cx, a->cy);
+        nk_command_stream_put_uint(w, a->r);
+        nk_command_stream_put_float(w, a->a[0]);
+        nk_command_stream_put_float(w, a->a[1]);
+    } break;
+    case NK_COMMAND_TRIANGLE: {
+        const struct nk_command_triangle *t = (const struct nk_command_triangle*)cmd;
+        struct nk_vec2i p[3];
+        p[0] = t->a; p[1] = t->b; p[2] = t->c;
+        nk_command_stream_put_tag(w, state, cmd->type, t->color);
+        nk_command_stream_put_uint(w, t->line_thickness);
+        nk_command_stream_put_points(w, state, p, 3);
+    } break;
+    case NK_COMMAND_TRIANGLE_FILLED: {
+        const struct nk_command_triangle_filled *t = (const struct nk_command_triangle_filled*)cmd;
+        struct nk_vec2i p[3];
+        p[0] = t->a; p[1] = t->b; p[2] = t->c;
+        nk_command_stream_put_tag(w, state, cmd->type, t->color);
+        nk_command_stream_put_points(w, state, p, 3);
+    } break;
+    case NK_COMMAND_POLYGON:
+    case NK_COMMAND_POLYLINE: {
+        /* both share the same layout */
+        const struct nk_command_polygon *p = (const struct nk_command_polygon*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, p->color);
+        nk_command_stream_put_uint(w, p->line_thickness);
+        nk_command_stream_put_uint(w, p->point_count);
+        nk_command_stream_put_points(w, state, p->points, p->point_count);
+    } break;
+    case NK_COMMAND_POLYGON_FILLED: {
+        const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled*)cmd;
+        nk_command_stream_put_tag(w, state, cmd->type, p->color);
+        nk_command_stream_put_uint(w, p->point_count);
+        nk_command_stream_put_points(w, state, p->points, p->point_count);
+    } break;
+    case NK_COMMAND_TEXT: {
+        const struct nk_command_text *t = (const struct nk_command_text*)cmd;
+        const int font = nk_command_stream_font(enc, w, t->font);
+        nk_byte flags = 0;
+        if (font < 0) return nk_false;
+        if (t->height == state->font_height[font])
+            flags |= NK_COMMAND_STREAM_FONT_HEIGHT;
+        if (nk_command_stream_same_color(t->foreground, state->color))
+            flags |= NK_COMMAND_STREAM_SAME_COLOR;
+        nk_command_stream_put_byte(w, (nk_byte)(cmd->type | flags));
+        if (!(flags & NK_COMMAND_STREAM_SAME_COLOR)) {
+            nk_command_stream_put_color(w, t->foreground);
+            state->color = t->foreground;
+        }
+        nk_command_stream_put_uint(w, (nk_ptr)font);
+        nk_command_stream_put_color(w, t->background);
+        nk_command_stream_put_rect(w, state, t->x, t->y, t->w, t->h);
+        if (!(flags & NK_COMMAND_STREAM_FONT_HEIGHT))
+            nk_command_stream_put_float(w, t->height);
+        nk_command_stream_put_string(w, state, t->string, t->length);
+    } break;
+    case NK_COMMAND_IMAGE: {
+        const struct nk_command_image *i = (const struct nk_command_image*)cmd;
+        const int image = nk_command_stream_image(state, w, i->img.handle);
+        if (image < 0) return nk_false;
+        nk_command_stream_put_tag(w, state, cmd->type, i->col);
+        nk_command_stream_put_uint(w, (nk_ptr)image);
+        nk_command_stream_put_uint(w, i->img.w);
+        nk_command_stream_put_uint(w, i->img.h);
+        nk_command_stream_put_uint(w, i->img.region[0]);
+        nk_command_stream_put_uint(w, i->img.region[1]);
+        nk_command_stream_put_uint(w, i->img.region[2]);
+        nk_command_stream_put_uint(w, i->img.region[3]);
+        nk_command_stream_put_rect(w, state, i->x, i->y, i->w, i->h);
+    } break;
+    case NK_COMMAND_CUSTOM:
+    default: return nk_false;
+    }
+    return nk_true;
+}
+NK_API void
+nk_command_stream_encoder_init(struct nk_command_stream_encoder *enc,
+    const struct nk_allocator *alloc)
+{
+    NK_ASSERT(enc);
+    NK_ASSERT(alloc);
+    if (!enc || !alloc) return;
+    nk_zero(enc, sizeof(*enc));
+    nk_command_stream_state_init(&enc->state, alloc);
+    nk_frame_delta_init(&enc->delta, alloc);
+}
+#ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
+NK_API void
+nk_command_stream_encoder_init_default(struct nk_command_stream_encoder *enc)
+{
+    struct nk_allocator alloc;
+    alloc.userdata.ptr = 0;
+    alloc.alloc = nk_malloc;
+    alloc.free = nk_mfree;
+    nk_command_stream_encoder_init(enc, &alloc);
+}
+#endif
+NK_API void
+nk_command_stream_encoder_reset(struct nk_command_stream_encoder *enc)
+{
+    NK_ASSERT(enc);
+    if (!enc) return;
+    enc->state.synced = nk_false;
+}
+NK_API void
+nk_command_stream_encoder_free(struct nk_command_stream_encoder *enc)
+{
+    NK_ASSERT(enc);
+    if (!enc) return;
+    nk_command_stream_state_free(&enc->state);
+    nk_frame_delta_free(&enc->delta);
+}
+NK_INTERN void
+nk_command_stream_put_window(struct nk_command_stream_writer *w,
+    struct nk_command_stream_state *state, const struct nk_window_delta *win)
+{
+    nk_command_stream_put_byte(w, NK_COMMAND_STREAM_WINDOW);
+    nk_command_stream_put_uint(w, (nk_ptr)(win->prev_index + 1));
+    if (win->prev_index >= 0) {
+        nk_command_stream_put_uint(w, win->keep_front);
+        nk_command_stream_put_uint(w, win->keep_back);
+    }
+    /* windows do not depend on the commands of other windows */
+    state->x = state->y = 0;
+    state->color = nk_rgba(0,0,0,0);
+}
+NK_API nk_bool
+nk_command_stream_encode(struct nk_command_stream_encoder *enc,
+    struct nk_context *ctx, struct nk_buffer *out)
+{
+    struct nk_command_stream_writer w;
+    const struct nk_window_delta *windows;
+    const struct nk_command *cmd;
+    int window_count, window = -1;
+    unsigned int index = 0;
+    nk_size start;
+    unsigned int i;
+
+    NK_ASSERT(enc);
+    NK_ASSERT(ctx);
+    NK_ASSERT(out);
+    if (!enc || !ctx || !out) return nk_false;
+
+    w.out = out;
+    w.len = 0;
+    w.failed = nk_false;
+    start = out->allocated;
+    enc->skipped = 0;
+    if (!enc->state.synced) {
+        nk_command_stream_state_reset(&enc->state);
+        nk_frame_delta_reset(&enc->delta);
+    }
+    windows = nk_frame_delta(&enc->delta, ctx, &window_count);
+    if (!windows) {
+        enc->state.synced = nk_false;
+        return nk_false;
+    }
+    nk_command_stream_state_begin(&enc->state);
+
+    for (i = 0; i < sizeof(nk_command_stream_magic); ++i)
+        nk_command_stream_put_byte(&w, nk_command_stream_magic[i]);
+    nk_command_stream_put_byte(&w, (nk_byte)(enc->state.synced ? 0: NK_COMMAND_STREAM_KEY_FRAME));
+    nk_command_stream_put_uint(&w, enc->state.frame);
+    nk_foreach(cmd, ctx) {
+        const struct nk_window_delta *win;
+        if (cmd->type == NK_COMMAND_NOP) continue;
+        while (window < 0 || index >= windows[window].count) {
+            NK_ASSERT(window + 1 < window_count);
+            if (window + 1 >= window_count) break;
+            nk_command_stream_put_window(&w, &enc->state, &windows[++window]);
+            index = 0;
+        }
+        if (window < 0 || index >= windows[window].count) break;
+        /* only commands that differ from the previous frame are sent */
+        win = &windows[window];
+        if (index >= win->keep_front && index < win->count - win->keep_back &&
+            !nk_command_stream_encode_command(enc, &w, cmd)) {
+            nk_command_stream_put_byte(&w, NK_COMMAND_NOP);
+            enc->skipped++;
+        }
+        index++;
+    }
+    while (++window < window_count && windows[window].status != NK_WINDOW_DELTA_REMOVED)
+        nk_command_stream_put_window(&w, &enc->state, &windows[window]);
+    nk_command_stream_put_byte(&w, NK_COMMAND_STREAM_END);
+    nk_command_stream_flush(&w);
+
+    if (w.failed) {
+        /* the decoder would not be able to follow, so start over next frame */
+        out->allocated = start;
+        enc->state.synced = nk_false;
+        return nk_false;
+    }
+    enc->state.synced = nk_true;
+    enc->state.frame++;
+    return nk_true;
+}
+
+/* ---------------------------------------------------------------
+ *                          DECODER
+ * ---------------------------------------------------------------*/
+struct nk_command_stream_reader {
+    const nk_byte *data;
+    nk_size size;
+    nk_size offset;
+    int failed;
+};
+NK_INTERN nk_byte
+nk_command_stream_get_byte(struct nk_command_stream_reader *r)
+{
+    if (r->offset >= r->size) {
+        r->failed = nk_true;
+        return 0;
+    }
+    return r->data[r->offset++];
+}
+NK_INTERN nk_ptr
+nk_command_stream_get_uint(struct nk_command_stream_reader *r)
+{
+    nk_ptr u = 0;
+    unsigned shift = 0;
+    nk_byte b;
+    do {
+        b = nk_command_stream_get_byte(r);
+        if (shift < sizeof(nk_ptr) * 8)
+            u |= (nk_ptr)(b & 0x7F) << shift;
+        shift += 7;
+    } while ((b & 0x80) && !r->failed);
+    return u;
+}
+NK_INTERN int
+nk_command_stream_get_int(struct nk_command_stream_reader *r)
+{
+    const nk_ptr u = nk_command_stream_get_uint(r);
+    return (u & 1) ? -(int)(u >> 1) - 1: (int)(u >> 1);
+}
+NK_INTERN unsigned short
+nk_command_stream_get_ushort(struct nk_command_stream_reader *r)
+{
+    return (unsigned short)nk_command_stream_get_uint(r);
+}
+NK_INTERN float
+nk_command_stream_get_float(struct nk_command_stream_reader *r)
+{
+    nk_uint u;
+    float value;
+    u = (nk_uint)nk_command_stream_get_byte(r);
+    u |= (nk_uint)nk_command_stream_get_byte(r) << 8;
+    u |= (nk_uint)nk_command_stream_get_byte(r) << 16;
+    u |= (nk_uint)nk_command_stream_get_byte(r) << 24;
+    NK_MEMCPY(&value, &u, sizeof(value));
+    return value;
+}
+NK_INTERN struct nk_color
+nk_command_stream_get_color(struct nk_command_stream_reader *r)
+{
+    struct nk_color c;
+    c.r = nk_command_stream_get_byte(r);
+    c.g = nk_command_stream_get_byte(r);
+    c.b = nk_command_stream_get_byte(r);
+    c.a = nk_command_stream_get_byte(r);
+    return c;
+}
+NK_INTERN void
+nk_command_stream_get_point(struct nk_command_stream_reader *r,
+    short *x, short *y)
+{
+    *x = (short)((int)*x + nk_command_stream_get_int(r));
+    *y = (short)((int)*y + nk_command_stream_get_int(r));
+}
+NK_INTERN struct nk_color
+nk_command_stream_get_tag_color(struct nk_command_stream_reader *r,
+    struct nk_command_stream_state *state, nk_byte tag)
+{
+    if (!(tag & NK_COMMAND_STREAM_SAME_COLOR))
+        state->color = nk_command_stream_get_color(r);
+    return state->color;
+}
+NK_INTERN void
+nk_command_stream_get_points(struct nk_command_stream_reader *r,
+    struct nk_command_stream_state *state, struct nk_vec2i *points, int count)
+{
+    short x, y;
+    int i;
+    if (!count) return;
+    nk_command_stream_get_point(r, &state->x, &state->y);
+    points[0].x = x = state->x;
+    points[0].y = y = state->y;
+    for (i = 1; i < count; ++i) {
+        nk_command_stream_get_point(r, &x, &y);
+        points[i].x = x;
+        points[i].y = y;
+    }
+}
+struct nk_command_stream_pushed {
+    void *cmd;
+    nk_size size;
+};
+NK_INTERN void*
+nk_command_stream_push(struct nk_command_buffer *out,
+    struct nk_command_stream_pushed *pushed, enum nk_command_type type, nk_size size)
+{
+    pushed->cmd = nk_command_buffer_push(out, type, size);
+    pushed->size = size;
+    return pushed->cmd;
+}
+#define NK_COMMAND_STREAM_PUSH(T, type, size)\
+    (struct T*)nk_command_stream_push(out, pushed, type, size);\
+    if (!cmd) return nk_false
+NK_INTERN int
+nk_command_stream_decode_command(struct nk_command_stream_decoder *dec,
+    struct nk_command_stream_reader *r, nk_byte tag, struct nk_command_buffer *out,
+    struct nk_command_stream_pushed *pushed)
+{
+    struct nk_command_stream_state *state = &dec->state;
+    const enum nk_command_type type = (enum nk_command_type)(tag & NK_COMMAND_STREAM_TYPE_MASK);
+    switch ((int)type) {
+    case NK_COMMAND_STREAM_FONT: {
+        const struct nk_user_font *font = 0;
+        nk_handle remote;
+        float height = nk_command_stream_get_float(r);
+        remote.ptr = (void*)nk_command_stream_get_uint(r);
+        if (state->font_count >= NK_COMMAND_STREAM_MAX_FONTS) return nk_false;
+        if (dec->font) font = dec->font(dec->userdata, remote, height);
+        dec->fonts[state->font_count] = font ? font: dec->default_font;
+        state->font_height[state->font_count++] = height;
+    } break;
+    case NK_COMMAND_STREAM_IMAGE: {
+        nk_handle handle;
+        handle.ptr = (void*)nk_command_stream_get_uint(r);
+        if (state->image_count >= NK_COMMAND_STREAM_MAX_IMAGES) return nk_false;
+        state->images[state->image_count++] = handle;
+    } break;
+    case NK_COMMAND_SCISSOR: {
+        struct nk_command_scissor *cmd = NK_COMMAND_STREAM_PUSH(nk_command_scissor, type, sizeof(*cmd));
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    case NK_COMMAND_LINE: {
+        struct nk_command_line *cmd = NK_COMMAND_STREAM_PUSH(nk_command_line, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->begin.x = cmd->end.x = state->x;
+        cmd->begin.y = cmd->end.y = state->y;
+        nk_command_stream_get_point(r, &cmd->end.x, &cmd->end.y);
+    } break;
+    case NK_COMMAND_CURVE: {
+        short x, y;
+        struct nk_command_curve *cmd = NK_COMMAND_STREAM_PUSH(nk_command_curve, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->begin.x = x = state->x;
+        cmd->begin.y = y = state->y;
+        nk_command_stream_get_point(r, &x, &y);
+        cmd->ctrl[0].x = x; cmd->ctrl[0].y = y;
+        nk_command_stream_get_point(r, &x, &y);
+        cmd->ctrl[1].x = x; cmd->ctrl[1].y = y;
+        nk_command_stream_get_point(r, &x, &y);
+        cmd->end.x = x; cmd->end.y = y;
+    } break;
+    case NK_COMMAND_RECT: {
+        struct nk_command_rect *cmd = NK_COMMAND_STREAM_PUSH(nk_command_rect, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->rounding = nk_command_stream_get_ushort(r);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    case NK_COMMAND_RECT_FILLED: {
+        struct nk_command_rect_filled *cmd = NK_COMMAND_STREAM_PUSH(nk_command_rect_filled, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->rounding = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    case NK_COMMAND_RECT_MULTI_COLOR: {
+        struct nk_command_rect_multi_color *cmd = NK_COMMAND_STREAM_PUSH(nk_command_rect_multi_color, type, sizeof(*cmd));
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+        cmd->left = nk_command_stream_get_color(r);
+        cmd->top = nk_command_stream_get_color(r);
+        cmd->bottom = nk_command_stream_get_color(r);
+        cmd->right = nk_command_stream_get_color(r);
+    } break;
+    case NK_COMMAND_CIRCLE: {
+        struct nk_command_circle *cmd = NK_COMMAND_STREAM_PUSH(nk_command_circle, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    case NK_COMMAND_CIRCLE_FILLED: {
+        struct nk_command_circle_filled *cmd = NK_COMMAND_STREAM_PUSH(nk_command_circle_filled, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    case NK_COMMAND_ARC: {
+        struct nk_command_arc *cmd = NK_COMMAND_STREAM_PUSH(nk_command_arc, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->cx = state->x; cmd->cy = state->y;
+        cmd->r = nk_command_stream_get_ushort(r);
+        cmd->a[0] = nk_command_stream_get_float(r);
+        cmd->a[1] = nk_command_stream_get_float(r);
+    } break;
+    case NK_COMMAND_ARC_FILLED: {
+        struct nk_command_arc_filled *cmd = NK_COMMAND_STREAM_PUSH(nk_command_arc_filled, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->cx = state->x; cmd->cy = state->y;
+        cmd->r = nk_command_stream_get_ushort(r);
+        cmd->a[0] = nk_command_stream_get_float(r);
+        cmd->a[1] = nk_command_stream_get_float(r);
+    } break;
+    case NK_COMMAND_TRIANGLE: {
+        struct nk_vec2i p[3];
+        struct nk_command_triangle *cmd = NK_COMMAND_STREAM_PUSH(nk_command_triangle, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        cmd->line_thickness = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_points(r, state, p, 3);
+        cmd->a = p[0]; cmd->b = p[1]; cmd->c = p[2];
+    } break;
+    case NK_COMMAND_TRIANGLE_FILLED: {
+        struct nk_vec2i p[3];
+        struct nk_command_triangle_filled *cmd = NK_COMMAND_STREAM_PUSH(nk_command_triangle_filled, type, sizeof(*cmd));
+        cmd->color = nk_command_stream_get_tag_color(r, state, tag);
+        nk_command_stream_get_points(r, state, p, 3);
+        cmd->a = p[0]; cmd->b = p[1]; cmd->c = p[2];
+    } break;
+    case NK_COMMAND_POLYGON:
+    case NK_COMMAND_POLYLINE: {
+        struct nk_command_polygon *cmd;
+        const struct nk_color color = nk_command_stream_get_tag_color(r, state, tag);
+        const unsigned short thickness = nk_command_stream_get_ushort(r);
+        const unsigned short count = nk_command_stream_get_ushort(r);
+        /* every point takes at least two bytes, so this also bounds the allocation */
+        if (r->failed || (nk_size)count * 2 > r->size - r->offset) return nk_false;
+        cmd = NK_COMMAND_STREAM_PUSH(nk_command_polygon, type,
+            sizeof(*cmd) + sizeof(short) * 2 * (nk_size)count);
+        cmd->color = color;
+        cmd->line_thickness = thickness;
+        cmd->point_count = count;
+        nk_command_stream_get_points(r, state, cmd->points, count);
+    } break;
+    case NK_COMMAND_POLYGON_FILLED: {
+        struct nk_command_polygon_filled *cmd;
+        const struct nk_color color = nk_command_stream_get_tag_color(r, state, tag);
+        const unsigned short count = nk_command_stream_get_ushort(r);
+        if (r->failed || (nk_size)count * 2 > r->size - r->offset) return nk_false;
+        cmd = NK_COMMAND_STREAM_PUSH(nk_command_polygon_filled, type,
+            sizeof(*cmd) + sizeof(short) * 2 * (nk_size)count);
+        cmd->color = color;
+        cmd->point_count = count;
+        nk_command_stream_get_points(r, state, cmd->points, count);
+    } break;
+    case NK_COMMAND_TEXT: {
+        struct nk_command_stream_strings *cur = &state->strings[state->current];
+        struct nk_command_stream_strings *prev = &state->strings[!state->current];
+        struct nk_command_text *cmd;
+        struct nk_command_text text;
+        const char *str;
+        nk_ptr code;
+        nk_ptr font;
+        int len;
+
+        text.foreground = nk_command_stream_get_tag_color(r, state, tag);
+        font = nk_command_stream_get_uint(r);
+        if (font >= (nk_ptr)state->font_count) return nk_false;
+        text.font = dec->fonts[font];
+        text.background = nk_command_stream_get_color(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        text.x = state->x; text.y = state->y;
+        text.w = nk_command_stream_get_ushort(r);
+        text.h = nk_command_stream_get_ushort(r);
+        text.height = (tag & NK_COMMAND_STREAM_FONT_HEIGHT) ?
+            state->font_height[font]: nk_command_stream_get_float(r);
+
+        code = nk_command_stream_get_uint(r);
+        if (r->failed) return nk_false;
+        if (!code) {
+            const nk_ptr length = nk_command_stream_get_uint(r);
+            if (r->failed || length > r->size - r->offset || !length) return nk_false;
+            len = (int)length;
+            str = (const char*)r->data + r->offset;
+            r->offset += (nk_size)len;
+        } else {
+            const struct nk_command_stream_strings *s = (code & 1) ? cur: prev;
+            const nk_ptr index = (code - 1) >> 1;
+            if (index >= (nk_ptr)s->count) return nk_false;
+            len = s->length[index];
+            str = (const char*)nk_buffer_memory_at(&s->text, s->offset[index]);
+        }
+        if (!(code & 1)) {
+            /* remember new strings and strings of the previous frame
+             * exactly like the encoder did */
+            nk_command_stream_strings_add(cur, str, len,
+                nk_murmur_hash(str, len, 0));
+        }
+        if (!text.font) break;
+        cmd = NK_COMMAND_STREAM_PUSH(nk_command_text, type, sizeof(*cmd) + (nk_size)(len + 1));
+        cmd->font = text.font;
+        cmd->background = text.background;
+        cmd->foreground = text.foreground;
+        cmd->x = text.x; cmd->y = text.y;
+        cmd->w = text.w; cmd->h = text.h;
+        cmd->height = text.height;
+        cmd->length = len;
+        NK_MEMCPY(cmd->string, str, (nk_size)len);
+        cmd->string[len] = '\0';
+    } break;
+    case NK_COMMAND_IMAGE: {
+        nk_ptr image;
+        struct nk_command_image *cmd = NK_COMMAND_STREAM_PUSH(nk_command_image, type, sizeof(*cmd));
+        cmd->col = nk_command_stream_get_tag_color(r, state, tag);
+        image = nk_command_stream_get_uint(r);
+        if (image >= (nk_ptr)state->image_count) return nk_false;
+        cmd->img.handle = state->images[image];
+        cmd->img.w = nk_command_stream_get_ushort(r);
+        cmd->img.h = nk_command_stream_get_ushort(r);
+        cmd->img.region[0] = nk_command_stream_get_ushort(r);
+        cmd->img.region[1] = nk_command_stream_get_ushort(r);
+        cmd->img.region[2] = nk_command_stream_get_ushort(r);
+        cmd->img.region[3] = nk_command_stream_get_ushort(r);
+        nk_command_stream_get_point(r, &state->x, &state->y);
+        cmd->x = state->x; cmd->y = state->y;
+        cmd->w = nk_command_stream_get_ushort(r);
+        cmd->h = nk_command_stream_get_ushort(r);
+    } break;
+    default: return nk_false;
+    }
+    return !r->failed;
+}
+#undef NK_COMMAND_STREAM_PUSH
+NK_API void
+nk_command_stream_decoder_init(struct nk_command_stream_decoder *dec,
+    const struct nk_allocator *alloc, const struct nk_user_font *font)
+{
+    int i;
+    NK_ASSERT(dec);
+    NK_ASSERT(alloc);
+    if (!dec || !alloc) return;
+    nk_zero(dec, sizeof(*dec));
+    nk_command_stream_state_init(&dec->state, alloc);
+    for (i = 0; i < 2; ++i) {
+        nk_buffer_init(&dec->commands[i], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+        nk_buffer_init(&dec->records[i], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+        nk_buffer_init(&dec->windows[i], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    }
+    dec->default_font = font;
+}
+#ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
+NK_API void
+nk_command_stream_decoder_init_default(struct nk_command_stream_decoder *dec,
+    const struct nk_user_font *font)
+{
+    struct nk_allocator alloc;
+    alloc.userdata.ptr = 0;
+    alloc.alloc = nk_malloc;
+    alloc.free = nk_mfree;
+    nk_command_stream_decoder_init(dec, &alloc, font);
+}
+#endif
+NK_API void
+nk_command_stream_decoder_free(struct nk_command_stream_decoder *dec)
+{
+    int i;
+    NK_ASSERT(dec);
+    if (!dec) return;
+    nk_command_stream_state_free(&dec->state);
+    for (i = 0; i < 2; ++i) {
+        nk_buffer_free(&dec->commands[i]);
+        nk_buffer_free(&dec->records[i]);
+        nk_buffer_free(&dec->windows[i]);
+    }
+}
+/* each decoded command is copied so unchanged commands can be taken from
+ * the previous frame. Skipped commands keep a record with size zero */
+struct nk_command_stream_copy {
+    nk_size offset;
+    nk_size size;
+};
+struct nk_command_stream_window {
+    nk_size first;
+    nk_size count;
+};
+NK_INTERN int
+nk_command_stream_retain(struct nk_command_stream_decoder *dec,
+    const void *cmd, nk_size size)
+{
+    const int cur = dec->state.current;
+    struct nk_command_stream_copy *copy;
+    struct nk_command_stream_window *win;
+
+    copy = (struct nk_command_stream_copy*)nk_buffer_alloc(&dec->records[cur],
+        NK_BUFFER_FRONT, sizeof(*copy), NK_ALIGNOF(struct nk_command_stream_copy));
+    if (!copy) return nk_false;
+    copy->offset = 0;
+    copy->size = size;
+    if (size) {
+        void *mem = nk_buffer_alloc(&dec->commands[cur], NK_BUFFER_FRONT, size,
+            NK_ALIGNOF(struct nk_command));
+        if (!mem) return nk_false;
+        NK_MEMCPY(mem, cmd, size);
+        copy->offset = dec->commands[cur].allocated - size;
+    }
+    win = (struct nk_command_stream_window*)nk_buffer_memory(&dec->windows[cur]);
+    win[dec->windows[cur].allocated / sizeof(*win) - 1].count++;
+    return nk_true;
+}
+NK_INTERN int
+nk_command_stream_keep(struct nk_command_stream_decoder *dec,
+    struct nk_command_buffer *out, const struct nk_command_stream_window *prev,
+    nk_size begin, nk_size end, nk_bool *scissor)
+{
+    const int old = !dec->state.current;
+    for (; begin < end; ++begin) {
+        const struct nk_command_stream_copy *copy = (const struct nk_command_stream_copy*)
+            nk_buffer_memory_const(&dec->records[old]) + prev->first + begin;
+        const struct nk_command *src = 0;
+        if (copy->size) {
+            struct nk_command *cmd;
+            src = (const struct nk_command*)nk_ptr_add_const(void,
+                nk_buffer_memory_const(&dec->commands[old]), copy->offset);
+            cmd = (struct nk_command*)nk_command_buffer_push(out, src->type, copy->size);
+            if (!cmd) return nk_false;
+            NK_MEMCPY(cmd + 1, src + 1, copy->size - sizeof(*cmd));
+            *scissor = *scissor || src->type == NK_COMMAND_SCISSOR;
+        }
+        if (!nk_command_stream_retain(dec, src, copy->size))
+            return nk_false;
+    }
+    return nk_true;
+}
+NK_API nk_bool
+nk_command_stream_decode(struct nk_command_stream_decoder *dec,
+    const void *packet, nk_size size, struct nk_command_buffer *out)
+{
+    const struct nk_command_stream_window *prev = 0;
+    struct nk_command_stream_reader r;
+    struct nk_rect clip;
+    nk_size allocated, end, last;
+    nk_size prev_count, keep_back = 0;
+    nk_bool scissor = nk_false;
+    nk_byte flags;
+    nk_ptr frame;
+    unsigned int i;
+    int cur;
+
+    NK_ASSERT(dec);
+    NK_ASSERT(packet);
+    NK_ASSERT(out);
+    if (!dec || !packet || !out || !out->base) return nk_false;
+
+    r.data = (const nk_byte*)packet;
+    r.size = size;
+    r.offset = 0;
+    r.failed = nk_false;
+    for (i = 0; i < sizeof(nk_command_stream_magic); ++i)
+        if (nk_command_stream_get_byte(&r) != nk_command_stream_magic[i])
+            return nk_false;
+    flags = nk_command_stream_get_byte(&r);
+    frame = nk_command_stream_get_uint(&r);
+    if (r.failed) return nk_false;
+    if (flags & NK_COMMAND_STREAM_KEY_FRAME) {
+        nk_command_stream_state_reset(&dec->state);
+        dec->state.synced = nk_true;
+    } else if (!dec->state.synced || frame != (nk_ptr)dec->state.frame) {
+        dec->state.synced = nk_false;
+        return nk_false;
+    }
+    dec->state.frame = (unsigned int)frame;
+    nk_command_stream_state_begin(&dec->state);
+    cur = dec->state.current;
+    nk_buffer_clear(&dec->commands[cur]);
+    nk_buffer_clear(&dec->records[cur]);
+    nk_buffer_clear(&dec->windows[cur]);
+    if (flags & NK_COMMAND_STREAM_KEY_FRAME)
+        nk_buffer_clear(&dec->windows[!cur]);
+    prev_count = dec->windows[!cur].allocated / sizeof(*prev);
+
+    clip = out->clip;
+    allocated = out->base->allocated;
+    end = out->end;
+    last = out->last;
+    for (;;) {
+        const nk_byte tag = nk_command_stream_get_byte(&r);
+        struct nk_command_stream_pushed pushed;
+        if (r.failed) break;
+        if (tag == NK_COMMAND_STREAM_END || tag == NK_COMMAND_STREAM_WINDOW) {
+            struct nk_command_stream_window *win;
+            nk_size index, keep_front = 0;
+            /* finish the previous window with its unchanged trailing commands */
+            if (prev && !nk_command_stream_keep(dec, out, prev,
+                prev->count - keep_back, prev->count, &scissor)) break;
+            if (tag == NK_COMMAND_STREAM_END) {
+                if (scissor) nk_push_scissor(out, clip);
+                dec->state.frame++;
+                return nk_true;
+            }
+            win = (struct nk_command_stream_window*)nk_buffer_alloc(&dec->windows[cur],
+                NK_BUFFER_FRONT, sizeof(*win), NK_ALIGNOF(struct nk_command_stream_window));
+            if (!win) break;
+            win->first = dec->records[cur].allocated / sizeof(struct nk_command_stream_copy);
+            win->count = 0;
+            index = (nk_size)nk_command_stream_get_uint(&r);
+            prev = 0;
+            keep_back = 0;
+            if (index) {
+                if (index > prev_count) break;
+                prev = (const struct nk_command_stream_window*)
+                    nk_buffer_memory_const(&dec->windows[!cur]) + (index - 1);
+                keep_front = (nk_size)nk_command_stream_get_uint(&r);
+                keep_back = (nk_size)nk_command_stream_get_uint(&r);
+                if (r.failed || keep_front + keep_back > prev->count) break;
+                if (!nk_command_stream_keep(dec, out, prev, 0, keep_front, &scissor)) break;
+            }
+            dec->state.x = dec->state.y = 0;
+            dec->state.color = nk_rgba(0,0,0,0);
+            continue;
+        }
+        if (!dec->windows[cur].allocated) break;
+        pushed.cmd = 0;
+        pushed.size = 0;
+        if (tag != NK_COMMAND_NOP && !nk_command_stream_decode_command(dec, &r, tag, out, &pushed))
+            break;
+        if ((tag & NK_COMMAND_STREAM_TYPE_MASK) < NK_COMMAND_STREAM_FONT &&
+            !nk_command_stream_retain(dec, pushed.cmd, pushed.cmd ? pushed.size: 0))
+            break;
+        scissor = scissor || (tag & NK_COMMAND_STREAM_TYPE_MASK) == NK_COMMAND_SCISSOR;
+    }
+    /* drop everything decoded from the damaged packet */
+    out->base->allocated = allocated;
+    out->end = end;
+    out->last = last;
+    out->clip = clip;
+    dec->state.synced = nk_false;
+    return nk_false;
+}
+#endif
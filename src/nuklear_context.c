@@ -90,8 +90,16 @@ nk_free(struct nk_context *ctx)
     NK_ASSERT(ctx);
     if (!ctx) return;
     nk_buffer_free(&ctx->memory);
-    if (ctx->use_pool)
+    if (ctx->use_pool) {
+        /* chart stream rings are allocated outside of the pool pages */
+        struct nk_window *iter = ctx->begin, *next;
+        while (iter) {
+            next = iter->next;
+            nk_free_window(ctx, iter);
+            iter = next;
+        }
         nk_pool_free(&ctx->pool);
+    }
 
     nk_zero(&ctx->input, sizeof(ctx->input));
     nk_zero(&ctx->style, sizeof(ctx->style));
@@ -103,7 +111,7 @@ nk_free(struct nk_context *ctx)
     ctx->end = 0;
     ctx->active = 0;
     ctx->current = 0;
-    ctx->freelist = 0;
+    nk_zero(ctx->freelist, sizeof(ctx->freelist));
     ctx->count = 0;
 }
 NK_API void
@@ -114,6 +122,9 @@ nk_clear(struct nk_context *ctx)
     NK_ASSERT(ctx);
 
     if (!ctx) return;
+#ifdef NK_INCLUDE_FRAME_STATS
+    nk_stats_clear(ctx);
+#endif
     if (ctx->use_pool)
         nk_buffer_clear(&ctx->memory);
     else nk_buffer_reset(&ctx->memory, NK_BUFFER_FRONT);
@@ -123,6 +134,8 @@ nk_clear(struct nk_context *ctx)
     ctx->last_widget_state = 0;
     ctx->style.cursor_active = ctx->style.cursors[NK_CURSOR_ARROW];
     NK_MEMSET(&ctx->overlay, 0, sizeof(ctx->overlay));
+    NK_MEMSET(&ctx->merged, 0, sizeof(ctx->merged));
+    ctx->worker_state = 0;
 
     /* garbage collector */
     iter = ctx->begin;
@@ -156,12 +169,23 @@ nk_clear(struct nk_context *ctx)
             n = it->next;
             if (it->seq != ctx->seq) {
                 nk_remove_table(iter, it);
-                nk_zero(it, sizeof(union nk_page_data));
+                nk_zero(it, sizeof(*it));
                 nk_free_table(ctx, it);
                 if (it == iter->tables)
                     iter->tables = n;
             } it = n;
         }}
+        /* remove chart streams that were neither pushed nor drawn */
+        {struct nk_chart_stream *n, *it = iter->streams;
+        while (it) {
+            n = it->next;
+            if (it->seq != ctx->seq)
+                nk_free_chart_stream(ctx, iter, it);
+            it = n;
+        }}
+        /* remove the text cache if no value widget was drawn */
+        if (iter->text_cache && iter->text_cache->seq != ctx->seq)
+            nk_free_text_cache(ctx, iter);
         /* window itself is not used anymore so free */
         if (iter->seq != ctx->seq || iter->flags & NK_WINDOW_CLOSED) {
             next = iter->next;
@@ -172,6 +196,13 @@ nk_clear(struct nk_context *ctx)
     }
     ctx->seq++;
 }
+NK_API void
+nk_trim(struct nk_context *ctx)
+{
+    NK_ASSERT(ctx);
+    if (!ctx || !ctx->use_pool) return;
+    nk_pool_trim(&ctx->pool, ctx->freelist);
+}
 NK_LIB void
 nk_start_buffer(struct nk_context *ctx, struct nk_command_buffer *buffer)
 {
@@ -231,7 +262,6 @@ nk_finish(struct nk_context *ctx, struct nk_window *win)
 {
     struct nk_popup_buffer *buf;
     struct nk_command *parent_last;
-    void *memory;
 
     NK_ASSERT(ctx);
     NK_ASSERT(win);
@@ -240,8 +270,7 @@ nk_finish(struct nk_context *ctx, struct nk_window *win)
     if (!win->popup.buf.active) return;
 
     buf = &win->popup.buf;
-    memory = ctx->memory.memory.ptr;
-    parent_last = nk_ptr_add(struct nk_command, memory, buf->parent);
+    parent_last = (struct nk_command*)nk_buffer_memory_at(&ctx->memory, buf->parent);
     parent_last->next = buf->end;
 }
 NK_LIB void
@@ -249,7 +278,6 @@ nk_build(struct nk_context *ctx)
 {
     struct nk_window *it = 0;
     struct nk_command *cmd = 0;
-    nk_byte *buffer = 0;
 
     /* draw cursor overlay */
     if (!ctx->style.cursor_active)
@@ -270,14 +298,13 @@ nk_build(struct nk_context *ctx)
     }
     /* build one big draw command list out of all window buffers */
     it = ctx->begin;
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
     while (it != 0) {
         struct nk_window *next = it->next;
         if (it->buffer.last == it->buffer.begin || (it->flags & NK_WINDOW_HIDDEN)||
             it->seq != ctx->seq)
             goto cont;
 
-        cmd = nk_ptr_add(struct nk_command, buffer, it->buffer.last);
+        cmd = (struct nk_command*)nk_buffer_memory_at(&ctx->memory, it->buffer.last);
         while (next && ((next->buffer.last == next->buffer.begin) ||
             (next->flags & NK_WINDOW_HIDDEN) || next->seq != ctx->seq))
             next = next->next; /* skip empty command buffers */
@@ -295,10 +322,15 @@ nk_build(struct nk_context *ctx)
 
         buf = &it->popup.buf;
         cmd->next = buf->begin;
-        cmd = nk_ptr_add(struct nk_command, buffer, buf->last);
+        cmd = (struct nk_command*)nk_buffer_memory_at(&ctx->memory, buf->last);
         buf->active = nk_false;
         skip: it = next;
     }
+    /* append commands of worker contexts */
+    if (ctx->merged.end != ctx->merged.begin) {
+        if (cmd) cmd->next = ctx->merged.begin;
+        cmd = (struct nk_command*)nk_buffer_memory_at(&ctx->memory, ctx->merged.last);
+    }
     if (cmd) {
         /* append overlay commands */
         if (ctx->overlay.end != ctx->overlay.begin)
@@ -310,12 +342,10 @@ NK_API const struct nk_command*
 nk__begin(struct nk_context *ctx)
 {
     struct nk_window *iter;
-    nk_byte *buffer;
     NK_ASSERT(ctx);
     if (!ctx) return 0;
-    if (!ctx->count) return 0;
+    if (!ctx->count && ctx->merged.end == ctx->merged.begin) return 0;
 
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
     if (!ctx->build) {
         nk_build(ctx);
         ctx->build = nk_true;
@@ -324,21 +354,123 @@ nk__begin(struct nk_context *ctx)
     while (iter && ((iter->buffer.begin == iter->buffer.end) ||
         (iter->flags & NK_WINDOW_HIDDEN) || iter->seq != ctx->seq))
         iter = iter->next;
-    if (!iter) return 0;
-    return nk_ptr_add_const(struct nk_command, buffer, iter->buffer.begin);
+    if (!iter) {
+        if (ctx->merged.end == ctx->merged.begin) return 0;
+        return (const struct nk_command*)nk_buffer_memory_at(&ctx->memory, ctx->merged.begin);
+    }
+    return (const struct nk_command*)nk_buffer_memory_at(&ctx->memory, iter->buffer.begin);
 }
 
 NK_API const struct nk_command*
 nk__next(struct nk_context *ctx, const struct nk_command *cmd)
 {
-    nk_byte *buffer;
-    const struct nk_command *next;
     NK_ASSERT(ctx);
-    if (!ctx || !cmd || !ctx->count) return 0;
+    if (!ctx || !cmd) return 0;
     if (cmd->next >= ctx->memory.allocated) return 0;
-    buffer = (nk_byte*)ctx->memory.memory.ptr;
-    next = nk_ptr_add_const(struct nk_command, buffer, cmd->next);
-    return next;
+    return (const struct nk_command*)nk_buffer_memory_at(&ctx->memory, cmd->next);
+}
+NK_LIB nk_hash
+nk_command_hash(const struct nk_command *cmd, nk_hash hash)
+{
+    /* only hash members since padding inside command memory is not initialized */
+    #define NK_HASH_MEMBERS(T, first, last)\
+        nk_murmur_hash(&((const struct T*)cmd)->first, (int)(NK_OFFSETOF(struct T, last) +\
+            sizeof(((const struct T*)cmd)->last) - NK_OFFSETOF(struct T, first)), hash)
+
+    hash = nk_murmur_hash(&cmd->type, (int)sizeof(cmd->type), hash);
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+    hash = nk_murmur_hash(&cmd->userdata, (int)sizeof(cmd->userdata), hash);
+#endif
+    switch (cmd->type) {
+    case NK_COMMAND_NOP: break;
+    case NK_COMMAND_SCISSOR:
+        hash = NK_HASH_MEMBERS(nk_command_scissor, x, h); break;
+    case NK_COMMAND_LINE:
+        hash = NK_HASH_MEMBERS(nk_command_line, line_thickness, color); break;
+    case NK_COMMAND_CURVE:
+        hash = NK_HASH_MEMBERS(nk_command_curve, line_thickness, color); break;
+    case NK_COMMAND_RECT:
+        hash = NK_HASH_MEMBERS(nk_command_rect, rounding, color); break;
+    case NK_COMMAND_RECT_FILLED:
+        hash = NK_HASH_MEMBERS(nk_command_rect_filled, rounding, color); break;
+    case NK_COMMAND_RECT_MULTI_COLOR:
+        hash = NK_HASH_MEMBERS(nk_command_rect_multi_color, x, right); break;
+    case NK_COMMAND_CIRCLE:
+        hash = NK_HASH_MEMBERS(nk_command_circle, x, color); break;
+    case NK_COMMAND_CIRCLE_FILLED:
+        hash = NK_HASH_MEMBERS(nk_command_circle_filled, x, color); break;
+    case NK_COMMAND_ARC:
+        hash = NK_HASH_MEMBERS(nk_command_arc, cx, color); break;
+    case NK_COMMAND_ARC_FILLED:
+        hash = NK_HASH_MEMBERS(nk_command_arc_filled, cx, r);
+        hash = NK_HASH_MEMBERS(nk_command_arc_filled, a, color); break;
+    case NK_COMMAND_TRIANGLE:
+        hash = NK_HASH_MEMBERS(nk_command_triangle, line_thickness, color); break;
+    case NK_COMMAND_TRIANGLE_FILLED:
+        hash = NK_HASH_MEMBERS(nk_command_triangle_filled, a, color); break;
+    case NK_COMMAND_POLYGON:
+    case NK_COMMAND_POLYLINE: {
+        const struct nk_command_polygon *p = (const struct nk_command_polygon*)cmd;
+        hash = NK_HASH_MEMBERS(nk_command_polygon, color, point_count);
+        hash = nk_murmur_hash(p->points, (int)(p->point_count * sizeof(p->points[0])), hash);
+    } break;
+    case NK_COMMAND_POLYGON_FILLED: {
+        const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled*)cmd;
+        hash = NK_HASH_MEMBERS(nk_command_polygon_filled, color, point_count);
+        hash = nk_murmur_hash(p->points, (int)(p->point_count * sizeof(p->points[0])), hash);
+    } break;
+    case NK_COMMAND_TEXT: {
+        const struct nk_command_text *t = (const struct nk_command_text*)cmd;
+        hash = NK_HASH_MEMBERS(nk_command_text, font, length);
+        hash = nk_murmur_hash(t->string, t->length, hash);
+    } break;
+    case NK_COMMAND_IMAGE: {
+        const struct nk_command_image *i = (const struct nk_command_image*)cmd;
+        hash = NK_HASH_MEMBERS(nk_command_image, x, h);
+        hash = nk_murmur_hash(&i->img.handle, (int)sizeof(i->img.handle), hash);
+        hash = nk_murmur_hash(&i->img.w, (int)(NK_OFFSETOF(struct nk_image, region) +
+            sizeof(i->img.region) - NK_OFFSETOF(struct nk_image, w)), hash);
+        hash = nk_murmur_hash(&i->col, (int)sizeof(i->col), hash);
+    } break;
+    case NK_COMMAND_CUSTOM: {
+        const struct nk_command_custom *c = (const struct nk_command_custom*)cmd;
+        hash = NK_HASH_MEMBERS(nk_command_custom, x, callback_data);
+        hash = nk_murmur_hash(&c->callback, (int)sizeof(c->callback), hash);
+    } break;
+    }
+    #undef NK_HASH_MEMBERS
+    return hash;
+}
+NK_API nk_flags
+nk_frame_status(struct nk_context *ctx)
+{
+    const struct nk_command *cmd;
+    struct nk_window *iter;
+    nk_hash hash = 0;
+    nk_flags status = NK_FRAME_UNCHANGED;
+
+    NK_ASSERT(ctx);
+    if (!ctx) return NK_FRAME_CHANGED;
+    /* repeated calls inside the same frame return the same result */
+    if (ctx->frame_seq == ctx->seq)
+        return ctx->frame_status;
+
+    nk_foreach(cmd, ctx)
+        hash = nk_command_hash(cmd, hash);
+    if (hash != ctx->frame_hash || !ctx->frame_seq)
+        status |= NK_FRAME_CHANGED;
+
+    /* windows with any panel waiting to auto hide its scrollbar */
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        if (iter->seq != ctx->seq || (iter->flags & (NK_WINDOW_HIDDEN|NK_WINDOW_CLOSED)))
+            continue;
+        if (iter->scrollbar_hiding_seq == ctx->seq)
+            status |= NK_FRAME_ANIMATING;
+    }
+    ctx->frame_hash = hash;
+    ctx->frame_status = status;
+    ctx->frame_seq = ctx->seq;
+    return status;
 }
 
 
@@ -18,6 +18,9 @@ nk_command_buffer_init(struct nk_command_buffer *cb,
     cb->begin = b->allocated;
     cb->end = b->allocated;
     cb->last = b->allocated;
+#ifdef NK_INCLUDE_FRAME_STATS
+    cb->stats = 0;
+#endif
 }
 NK_LIB void
 nk_command_buffer_reset(struct nk_command_buffer *b)
@@ -45,11 +48,27 @@ nk_command_buffer_push(struct nk_command_buffer* b,
     NK_ASSERT(b);
     NK_ASSERT(b->base);
     if (!b) return 0;
+    if (b->base->type == NK_BUFFER_SEGMENTED) {
+        /* commands cannot cross segment borders. Therefore each segment always
+         * keeps enough space for a NOP command linking to the next segment */
+        const nk_size link_size = sizeof(struct nk_command) + align;
+        if (size + align + link_size > b->base->segment_size)
+            return 0;
+        if (nk_buffer_segment_left(b->base) < size + align + link_size) {
+            cmd = (struct nk_command*)nk_buffer_alloc(b->base, NK_BUFFER_FRONT, sizeof(*cmd), align);
+            if (!cmd) return 0;
+            cmd->type = NK_COMMAND_NOP;
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+            cmd->userdata = b->userdata;
+#endif
+            cmd->next = nk_buffer_segment_next(b->base);
+        }
+    }
     cmd = (struct nk_command*)nk_buffer_alloc(b->base,NK_BUFFER_FRONT,size,align);
     if (!cmd) return 0;
 
     /* make sure the offset to the next command is aligned */
-    b->last = (nk_size)((nk_byte*)cmd - (nk_byte*)b->base->memory.ptr);
+    b->last = b->base->allocated - size;
     unaligned = (nk_byte*)cmd + size;
     memory = NK_ALIGN_PTR(unaligned, align);
     alignment = (nk_size)((nk_byte*)memory - (nk_byte*)unaligned);
@@ -63,8 +82,48 @@ nk_command_buffer_push(struct nk_command_buffer* b,
     cmd->userdata = b->userdata;
 #endif
     b->end = cmd->next;
+#ifdef NK_INCLUDE_FRAME_STATS
+    if (b->stats) {
+        b->stats->commands[t]++;
+        b->stats->command_bytes += size;
+    }
+#endif
     return cmd;
 }
+NK_LIB nk_size
+nk_command_size(const struct nk_command *cmd)
+{
+    /* same sizes as passed to `nk_command_buffer_push` by the draw functions */
+    switch (cmd->type) {
+    case NK_COMMAND_SCISSOR: return sizeof(struct nk_command_scissor);
+    case NK_COMMAND_LINE: return sizeof(struct nk_command_line);
+    case NK_COMMAND_CURVE: return sizeof(struct nk_command_curve);
+    case NK_COMMAND_RECT: return sizeof(struct nk_command_rect);
+    case NK_COMMAND_RECT_FILLED: return sizeof(struct nk_command_rect_filled);
+    case NK_COMMAND_RECT_MULTI_COLOR: return sizeof(struct nk_command_rect_multi_color);
+    case NK_COMMAND_CIRCLE: return sizeof(struct nk_command_circle);
+    case NK_COMMAND_CIRCLE_FILLED: return sizeof(struct nk_command_circle_filled);
+    case NK_COMMAND_ARC: return sizeof(struct nk_command_arc);
+    case NK_COMMAND_ARC_FILLED: return sizeof(struct nk_command_arc_filled);
+    case NK_COMMAND_TRIANGLE: return sizeof(struct nk_command_triangle);
+    case NK_COMMAND_TRIANGLE_FILLED: return sizeof(struct nk_command_triangle_filled);
+    case NK_COMMAND_POLYGON:
+        return sizeof(struct nk_command_polygon) + sizeof(short) * 2 *
+            (nk_size)((const struct nk_command_polygon*)cmd)->point_count;
+    case NK_COMMAND_POLYGON_FILLED:
+        return sizeof(struct nk_command_polygon_filled) + sizeof(short) * 2 *
+            (nk_size)((const struct nk_command_polygon_filled*)cmd)->point_count;
+    case NK_COMMAND_POLYLINE:
+        return sizeof(struct nk_command_polyline) + sizeof(short) * 2 *
+            (nk_size)((const struct nk_command_polyline*)cmd)->point_count;
+    case NK_COMMAND_TEXT:
+        return sizeof(struct nk_command_text) +
+            (nk_size)(((const struct nk_command_text*)cmd)->length + 1);
+    case NK_COMMAND_IMAGE: return sizeof(struct nk_command_image);
+    case NK_COMMAND_CUSTOM: return sizeof(struct nk_command_custom);
+    default: return sizeof(struct nk_command);
+    }
+}
 NK_API void
 nk_push_scissor(struct nk_command_buffer *b, struct nk_rect r)
 {
@@ -519,7 +578,13 @@ nk_draw_text(struct nk_command_buffer *b, struct nk_rect r,
     const char *string, int length, const struct nk_user_font *font,
     struct nk_color bg, struct nk_color fg)
 {
-    float text_width = 0;
+    nk_draw_text_measured(b, r, string, length, -1.0f, font, bg, fg);
+}
+NK_LIB void
+nk_draw_text_measured(struct nk_command_buffer *b, struct nk_rect r,
+    const char *string, int length, float text_width,
+    const struct nk_user_font *font, struct nk_color bg, struct nk_color fg)
+{
     struct nk_command_text *cmd;
 
     NK_ASSERT(b);
@@ -531,12 +596,16 @@ nk_draw_text(struct nk_command_buffer *b, struct nk_rect r,
             return;
     }
 
-    /* make sure text fits inside bounds */
-    text_width = font->width(font->userdata, font->height, string, length);
+    /* make sure text fits inside bounds, a negative width is measured here */
+    if (text_width < 0) {
+        text_width = font->width(font->userdata, font->height, string, length);
+        NK_STATS_ADD(b, text_measurements, 1);
+    }
     if (text_width > r.w){
         int glyphs = 0;
         float txt_width = (float)text_width;
         length = nk_text_clamp(font, string, length, r.w, &glyphs, &txt_width, 0,0);
+        NK_STATS_ADD(b, text_measurements, glyphs);
     }
 
     if (!length) return;
@@ -130,6 +130,7 @@ nk_edit_draw_text(struct nk_command_buffer *out,
             continue;
         }
         glyph_width = font->width(font->userdata, font->height, text+text_len, glyph_len);
+        NK_STATS_ADD(out, text_measurements, 1);
         line_width += (float)glyph_width;
         text_len += glyph_len;
         glyph_len = nk_utf_decode(text + text_len, &unicode, byte_len-text_len);
@@ -398,6 +399,7 @@ nk_do_edit(nk_flags *state, struct nk_command_buffer *out,
                                 &out_offset, &glyph_offset, NK_STOP_ON_NEW_LINE);
                     cursor_pos.x = row_size.x;
                     cursor_ptr = text + text_len;
+                    NK_STATS_ADD(out, text_measurements, glyph_offset);
                 }
 
                 /* set start selection 2D position and line */
@@ -416,6 +418,7 @@ nk_do_edit(nk_flags *state, struct nk_command_buffer *out,
                                 &out_offset, &glyph_offset, NK_STOP_ON_NEW_LINE);
                     selection_offset_start.x = row_size.x;
                     select_begin_ptr = text + text_len;
+                    NK_STATS_ADD(out, text_measurements, glyph_offset);
                 }
 
                 /* set end selection 2D position and line */
@@ -434,6 +437,7 @@ nk_do_edit(nk_flags *state, struct nk_command_buffer *out,
                                 &out_offset, &glyph_offset, NK_STOP_ON_NEW_LINE);
                     selection_offset_end.x = row_size.x;
                     select_end_ptr = text + text_len;
+                    NK_STATS_ADD(out, text_measurements, glyph_offset);
                 }
                 if (unicode == '\n') {
                     text_size.x = NK_MAX(text_size.x, line_width);
@@ -456,6 +460,7 @@ nk_do_edit(nk_flags *state, struct nk_command_buffer *out,
                     text+text_len, glyph_len);
                 continue;
             }
+            NK_STATS_ADD(out, text_measurements, glyphs + 1);
             text_size.y = (float)total_lines * row_height;
 
             /* handle case when cursor is at end of text buffer */
@@ -632,6 +637,7 @@ nk_do_edit(nk_flags *state, struct nk_command_buffer *out,
                 label.x = area.x + cursor_pos.x - edit->scrollbar.x;
                 label.y = area.y + cursor_pos.y - edit->scrollbar.y;
                 label.w = font->width(font->userdata, font->height, cursor_ptr, glyph_len);
+                NK_STATS_ADD(out, text_measurements, 1);
                 label.h = row_height;
 
                 txt.padding = nk_vec2(0,0);
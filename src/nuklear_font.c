@@ -446,10 +446,10 @@ nk_font_bake_convert(void *out_memory, int img_width, int img_height,
 NK_INTERN float
 nk_font_text_width(nk_handle handle, float height, const char *text, int len)
 {
-    nk_rune unicode;
+    nk_rune runes[NK_UTF_RUN];
     int text_len  = 0;
     float text_width = 0;
-    int glyph_len = 0;
+    int run_len = 0;
     float scale = 0;
 
     struct nk_font *font = (struct nk_font*)handle.ptr;
@@ -459,19 +459,17 @@ nk_font_text_width(nk_handle handle, float height, const char *text, int len)
         return 0;
 
     scale = height/font->info.height;
-    glyph_len = text_len = nk_utf_decode(text, &unicode, (int)len);
-    if (!glyph_len) return 0;
-    while (text_len <= (int)len && glyph_len) {
-        const struct nk_font_glyph *g;
-        if (unicode == NK_UTF_INVALID) break;
-
-        /* query currently drawn glyph information */
-        g = nk_font_find_glyph(font, unicode);
-        text_width += g->xadvance * scale;
-
-        /* offset next glyph */
-        glyph_len = nk_utf_decode(text + text_len, &unicode, (int)len - text_len);
-        text_len += glyph_len;
+    while (text_len < len) {
+        int i, count;
+        count = nk_utf_decode_run(text + text_len, len - text_len, runes,
+            (int)NK_LEN(runes), &run_len);
+        for (i = 0; i < count; ++i) {
+            if (runes[i] == NK_UTF_INVALID)
+                return text_width;
+            text_width += nk_font_find_glyph(font, runes[i])->xadvance * scale;
+        }
+        if (!run_len) break;
+        text_len += run_len;
     }
     return text_width;
 }
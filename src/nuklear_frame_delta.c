@@ -0,0 +1,360 @@
+#include "nuklear.h"
+#include "nuklear_internal.h"
+
+/* ===============================================================
+ *
+ *                          FRAME DELTA
+ *
+ * ===============================================================*/
+NK_INTERN struct nk_rect
+nk_delta_points_bounds(const struct nk_vec2i *points, int count, float pad)
+{
+    short x0, y0, x1, y1;
+    int i;
+    if (!count) return nk_rect(0,0,0,0);
+    x0 = x1 = points[0].x;
+    y0 = y1 = points[0].y;
+    for (i = 1; i < count; ++i) {
+        x0 = NK_MIN(x0, points[i].x); x1 = NK_MAX(x1, points[i].x);
+        y0 = NK_MIN(y0, points[i].y); y1 = NK_MAX(y1, points[i].y);
+    }
+    return nk_rect((float)x0 - pad, (float)y0 - pad,
+        (float)(x1 - x0) + 2 * pad, (float)(y1 - y0) + 2 * pad);
+}
+NK_INTERN struct nk_rect
+nk_delta_rect_bounds(short x, short y, unsigned short w, unsigned short h, float pad)
+{
+    return nk_rect((float)x - pad, (float)y - pad, (float)w + 2 * pad, (float)h + 2 * pad);
+}
+NK_LIB struct nk_rect
+nk_command_bounds(const struct nk_command *cmd)
+{
+    /* strokes are padded by their thickness plus one pixel of anti-aliasing */
+    switch (cmd->type) {
+    case NK_COMMAND_SCISSOR: {
+        const struct nk_command_scissor *s = (const struct nk_command_scissor*)cmd;
+        return nk_delta_rect_bounds(s->x, s->y, s->w, s->h, 0);
+    }
+    case NK_COMMAND_LINE: {
+        const struct nk_command_line *l = (const struct nk_command_line*)cmd;
+        struct nk_vec2i p[2];
+        p[0] = l->begin; p[1] = l->end;
+        return nk_delta_points_bounds(p, 2, l->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_CURVE: {
+        const struct nk_command_curve *q = (const struct nk_command_curve*)cmd;
+        struct nk_vec2i p[4];
+        p[0] = q->begin; p[1] = q->ctrl[0]; p[2] = q->ctrl[1]; p[3] = q->end;
+        return nk_delta_points_bounds(p, 4, q->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_RECT: {
+        const struct nk_command_rect *r = (const struct nk_command_rect*)cmd;
+        return nk_delta_rect_bounds(r->x, r->y, r->w, r->h, r->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_RECT_FILLED: {
+        const struct nk_command_rect_filled *r = (const struct nk_command_rect_filled*)cmd;
+        return nk_delta_rect_bounds(r->x, r->y, r->w, r->h, 1.0f);
+    }
+    case NK_COMMAND_RECT_MULTI_COLOR: {
+        const struct nk_command_rect_multi_color *r = (const struct nk_command_rect_multi_color*)cmd;
+        return nk_delta_rect_bounds(r->x, r->y, r->w, r->h, 1.0f);
+    }
+    case NK_COMMAND_CIRCLE: {
+        const struct nk_command_circle *c = (const struct nk_command_circle*)cmd;
+        return nk_delta_rect_bounds(c->x, c->y, c->w, c->h, c->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_CIRCLE_FILLED: {
+        const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled*)cmd;
+        return nk_delta_rect_bounds(c->x, c->y, c->w, c->h, 1.0f);
+    }
+    case NK_COMMAND_ARC: {
+        const struct nk_command_arc *a = (const struct nk_command_arc*)cmd;
+        return nk_delta_rect_bounds((short)(a->cx - a->r), (short)(a->cy - a->r),
+            (unsigned short)(a->r * 2), (unsigned short)(a->r * 2), a->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_ARC_FILLED: {
+        const struct nk_command_arc_filled *a = (const struct nk_command_arc_filled*)cmd;
+        return nk_delta_rect_bounds((short)(a->cx - a->r), (short)(a->cy - a->r),
+            (unsigned short)(a->r * 2), (unsigned short)(a->r * 2), 1.0f);
+    }
+    case NK_COMMAND_TRIANGLE: {
+        const struct nk_command_triangle *t = (const struct nk_command_triangle*)cmd;
+        struct nk_vec2i p[3];
+        p[0] = t->a; p[1] = t->b; p[2] = t->c;
+        return nk_delta_points_bounds(p, 3, t->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_TRIANGLE_FILLED: {
+        const struct nk_command_triangle_filled *t = (const struct nk_command_triangle_filled*)cmd;
+        struct nk_vec2i p[3];
+        p[0] = t->a; p[1] = t->b; p[2] = t->c;
+        return nk_delta_points_bounds(p, 3, 1.0f);
+    }
+    case NK_COMMAND_POLYGON:
+    case NK_COMMAND_POLYLINE: {
+        const struct nk_command_polygon *p = (const struct nk_command_polygon*)cmd;
+        return nk_delta_points_bounds(p->points, p->point_count, p->line_thickness + 1.0f);
+    }
+    case NK_COMMAND_POLYGON_FILLED: {
+        const struct nk_command_polygon_filled *p = (const struct nk_command_polygon_filled*)cmd;
+        return nk_delta_points_bounds(p->points, p->point_count, 1.0f);
+    }
+    case NK_COMMAND_TEXT: {
+        const struct nk_command_text *t = (const struct nk_command_text*)cmd;
+        return nk_delta_rect_bounds(t->x, t->y, t->w, t->h, 1.0f);
+    }
+    case NK_COMMAND_IMAGE: {
+        const struct nk_command_image *i = (const struct nk_command_image*)cmd;
+        return nk_delta_rect_bounds(i->x, i->y, i->w, i->h, 1.0f);
+    }
+    case NK_COMMAND_CUSTOM: {
+        const struct nk_command_custom *c = (const struct nk_command_custom*)cmd;
+        return nk_delta_rect_bounds(c->x, c->y, c->w, c->h, 1.0f);
+    }
+    default: break;
+    }
+    return nk_rect(0,0,0,0);
+}
+NK_INTERN void
+nk_delta_merge(struct nk_rect *a, struct nk_rect b)
+{
+    float x1, y1;
+    if (b.w <= 0 || b.h <= 0) return;
+    if (a->w <= 0 || a->h <= 0) {
+        *a = b;
+        return;
+    }
+    x1 = NK_MAX(a->x + a->w, b.x + b.w);
+    y1 = NK_MAX(a->y + a->h, b.y + b.h);
+    a->x = NK_MIN(a->x, b.x);
+    a->y = NK_MIN(a->y, b.y);
+    a->w = x1 - a->x;
+    a->h = y1 - a->y;
+}
+NK_API void
+nk_frame_delta_init(struct nk_frame_delta *delta, const struct nk_allocator *alloc)
+{
+    NK_ASSERT(delta);
+    NK_ASSERT(alloc);
+    if (!delta || !alloc) return;
+    nk_zero(delta, sizeof(*delta));
+    nk_buffer_init(&delta->commands[0], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    nk_buffer_init(&delta->commands[1], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    nk_buffer_init(&delta->windows[0], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    nk_buffer_init(&delta->windows[1], alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+    nk_buffer_init(&delta->deltas, alloc, NK_BUFFER_DEFAULT_INITIAL_SIZE);
+}
+#ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
+NK_API void
+nk_frame_delta_init_default(struct nk_frame_delta *delta)
+{
+    struct nk_allocator alloc;
+    alloc.userdata.ptr = 0;
+    alloc.alloc = nk_malloc;
+    alloc.free = nk_mfree;
+    nk_frame_delta_init(delta, &alloc);
+}
+#endif
+NK_API void
+nk_frame_delta_reset(struct nk_frame_delta *delta)
+{
+    NK_ASSERT(delta);
+    if (!delta) return;
+    delta->synced = nk_false;
+}
+NK_API void
+nk_frame_delta_free(struct nk_frame_delta *delta)
+{
+    NK_ASSERT(delta);
+    if (!delta) return;
+    nk_buffer_free(&delta->commands[0]);
+    nk_buffer_free(&delta->commands[1]);
+    nk_buffer_free(&delta->windows[0]);
+    nk_buffer_free(&delta->windows[1]);
+    nk_buffer_free(&delta->deltas);
+}
+NK_INTERN int
+nk_delta_add_window(struct nk_buffer *windows, nk_hash id, nk_size begin, nk_size last)
+{
+    struct nk_delta_window *win = (struct nk_delta_window*)nk_buffer_alloc(windows,
+        NK_BUFFER_FRONT, sizeof(*win), NK_ALIGNOF(struct nk_delta_window));
+    if (!win) return nk_false;
+    win->id = id;
+    win->begin = begin;
+    win->last = last;
+    win->first = 0;
+    win->count = 0;
+    win->matched = nk_false;
+    return nk_true;
+}
+NK_INTERN int
+nk_delta_collect(struct nk_frame_delta *delta, struct nk_context *ctx,
+    struct nk_buffer *windows, struct nk_buffer *commands)
+{
+    const struct nk_command *cmd;
+    struct nk_delta_window *win;
+    struct nk_window *iter;
+    nk_size offset, count, index = 0;
+    int ok = nk_true;
+
+    /* ranges in the order `nk_build` links them together. Popups are only
+     * linked if they were drawn, so they are matched by their first command */
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        if (iter->buffer.last == iter->buffer.begin || (iter->flags & NK_WINDOW_HIDDEN) ||
+            iter->seq != ctx->seq) continue;
+        ok = ok && nk_delta_add_window(windows, iter->name, iter->buffer.begin, iter->buffer.last);
+    }
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        if (!iter->popup.win || iter->popup.win->seq != ctx->seq) continue;
+        ok = ok && nk_delta_add_window(windows, nk_murmur_hash(&iter->popup.win->name,
+            (int)sizeof(nk_hash), iter->name), iter->popup.buf.begin, iter->popup.buf.last);
+    }
+    if (ctx->merged.end != ctx->merged.begin)
+        ok = ok && nk_delta_add_window(windows, 1, ctx->merged.begin, ctx->merged.last);
+    if (ctx->overlay.end != ctx->overlay.begin)
+        ok = ok && nk_delta_add_window(windows, 0, ctx->overlay.begin, ctx->overlay.last);
+    if (!ok) return nk_false;
+
+    count = windows->allocated / sizeof(*win);
+    win = (struct nk_delta_window*)nk_buffer_memory(windows);
+    cmd = nk__begin(ctx);
+    if (!cmd || !count) return nk_true;
+
+    offset = win[0].begin;
+    while (cmd) {
+        if (cmd->type != NK_COMMAND_NOP) {
+            struct nk_delta_command *c = (struct nk_delta_command*)nk_buffer_alloc(commands,
+                NK_BUFFER_FRONT, sizeof(*c), NK_ALIGNOF(struct nk_delta_command));
+            if (!c) return nk_false;
+            c->hash = nk_command_hash(cmd, 0);
+            c->bounds = nk_command_bounds(cmd);
+            win[index].count++;
+            delta->command_count++;
+        }
+        if (offset == win[index].last && index + 1 < count) {
+            /* the next range is the one starting where this one links to */
+            nk_size next = index + 1;
+            while (next < count && win[next].begin != cmd->next) next++;
+            if (next < count) {
+                win[next].first = win[index].first + win[index].count;
+                index = next;
+            }
+        }
+        offset = cmd->next;
+        cmd = nk__next(ctx, cmd);
+    }
+    return nk_true;
+}
+NK_API const struct nk_window_delta*
+nk_frame_delta(struct nk_frame_delta *delta, struct nk_context *ctx, int *count)
+{
+    struct nk_buffer *cur_windows, *prev_windows;
+    struct nk_delta_window *cur, *prev;
+    struct nk_delta_command *cur_cmds, *prev_cmds;
+    struct nk_window_delta *out;
+    nk_size cur_count, prev_count, i;
+    int last_match = -1;
+
+    NK_ASSERT(delta);
+    NK_ASSERT(ctx);
+    NK_ASSERT(count);
+    if (!delta || !ctx || !count) return 0;
+    *count = 0;
+
+    delta->current = !delta->current;
+    cur_windows = &delta->windows[delta->current];
+    prev_windows = &delta->windows[!delta->current];
+    nk_buffer_clear(cur_windows);
+    nk_buffer_clear(&delta->commands[delta->current]);
+    nk_buffer_clear(&delta->deltas);
+    delta->command_count = 0;
+    delta->changed_count = 0;
+    delta->damage = nk_rect(0,0,0,0);
+    if (!nk_delta_collect(delta, ctx, cur_windows, &delta->commands[delta->current])) {
+        /* without a complete frame there is nothing to compare against */
+        nk_buffer_clear(cur_windows);
+        delta->synced = nk_false;
+        return 0;
+    }
+
+    cur_count = cur_windows->allocated / sizeof(*cur);
+    cur = (struct nk_delta_window*)nk_buffer_memory(cur_windows);
+    cur_cmds = (struct nk_delta_command*)nk_buffer_memory(&delta->commands[delta->current]);
+    prev_count = delta->synced ? prev_windows->allocated / sizeof(*prev): 0;
+    prev = (struct nk_delta_window*)nk_buffer_memory(prev_windows);
+    prev_cmds = (struct nk_delta_command*)nk_buffer_memory(&delta->commands[!delta->current]);
+
+    out = (struct nk_window_delta*)nk_buffer_alloc(&delta->deltas, NK_BUFFER_FRONT,
+        sizeof(*out) * (cur_count + prev_count + 1), NK_ALIGNOF(struct nk_window_delta));
+    if (!out) {
+        delta->synced = nk_false;
+        return 0;
+    }
+    for (i = 0; i < cur_count; ++i) {
+        struct nk_window_delta *d = &out[*count];
+        const struct nk_delta_command *a = cur_cmds + cur[i].first;
+        const struct nk_delta_command *b;
+        nk_size p = (i < prev_count && prev[i].id == cur[i].id) ? i: 0;
+        unsigned int j, end;
+
+        /* most windows keep their place in the drawing order */
+        if (p < prev_count && prev[p].id != cur[i].id) {
+            for (p = 0; p < prev_count; ++p)
+                if (prev[p].id == cur[i].id && !prev[p].matched) break;
+        }
+        d->id = cur[i].id;
+        d->count = cur[i].count;
+        d->bounds = nk_rect(0,0,0,0);
+        d->keep_front = d->keep_back = 0;
+        if (p >= prev_count) {
+            d->status = NK_WINDOW_DELTA_ADDED;
+            d->prev_index = -1;
+            d->prev_count = 0;
+        } else {
+            b = prev_cmds + prev[p].first;
+            prev[p].matched = nk_true;
+            d->prev_index = (int)p;
+            d->prev_count = prev[p].count;
+            if ((int)p > last_match) {
+                /* windows moved to the front change everything they overlap */
+                last_match = (int)p;
+                while (d->keep_front < d->count && d->keep_front < d->prev_count &&
+                    a[d->keep_front].hash == b[d->keep_front].hash)
+                    d->keep_front++;
+                while (d->keep_front + d->keep_back < d->count &&
+                    d->keep_front + d->keep_back < d->prev_count &&
+                    a[d->count - d->keep_back - 1].hash == b[d->prev_count - d->keep_back - 1].hash)
+                    d->keep_back++;
+            }
+            d->status = (d->keep_front == d->count && d->count == d->prev_count) ?
+                NK_WINDOW_DELTA_UNCHANGED: NK_WINDOW_DELTA_CHANGED;
+            for (j = d->keep_front, end = d->prev_count - d->keep_back; j < end; ++j)
+                nk_delta_merge(&d->bounds, b[j].bounds);
+        }
+        for (j = d->keep_front, end = d->count - d->keep_back; j < end; ++j)
+            nk_delta_merge(&d->bounds, a[j].bounds);
+        delta->changed_count += d->count - d->keep_front - d->keep_back;
+        if (d->prev_count)
+            delta->changed_count += d->prev_count - d->keep_front - d->keep_back;
+        nk_delta_merge(&delta->damage, d->bounds);
+        (*count)++;
+    }
+    for (i = 0; i < prev_count; ++i) {
+        struct nk_window_delta *d = &out[*count];
+        const struct nk_delta_command *b = prev_cmds + prev[i].first;
+        unsigned int j;
+        if (prev[i].matched) continue;
+        d->id = prev[i].id;
+        d->status = NK_WINDOW_DELTA_REMOVED;
+        d->prev_index = (int)i;
+        d->count = d->keep_front = d->keep_back = 0;
+        d->prev_count = prev[i].count;
+        d->bounds = nk_rect(0,0,0,0);
+        for (j = 0; j < d->prev_count; ++j)
+            nk_delta_merge(&d->bounds, b[j].bounds);
+        delta->changed_count += d->prev_count;
+        nk_delta_merge(&delta->damage, d->bounds);
+        (*count)++;
+    }
+    delta->synced = nk_true;
+    return out;
+}
@@ -13,6 +13,7 @@ nk_input_begin(struct nk_context *ctx)
     struct nk_input *in;
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_BEGIN, 0, 0, 0, 0, 0);
     in = &ctx->input;
     for (i = 0; i < NK_BUTTON_MAX; ++i)
         in->mouse.buttons[i].clicked = 0;
@@ -32,6 +33,7 @@ nk_input_end(struct nk_context *ctx)
     struct nk_input *in;
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_END, 0, 0, 0, 0, 0);
     in = &ctx->input;
     if (in->mouse.grab)
         in->mouse.grab = 0;
@@ -47,6 +49,7 @@ nk_input_motion(struct nk_context *ctx, int x, int y)
     struct nk_input *in;
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_MOTION, 0, x, y, 0, 0);
     in = &ctx->input;
     in->mouse.pos.x = (float)x;
     in->mouse.pos.y = (float)y;
@@ -59,6 +62,7 @@ nk_input_key(struct nk_context *ctx, enum nk_keys key, nk_bool down)
     struct nk_input *in;
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_KEY, down, (int)key, 0, 0, 0);
     in = &ctx->input;
 #ifdef NK_KEYSTATE_BASED_INPUT
     if (in->keyboard.keys[key].down != down)
@@ -75,6 +79,7 @@ nk_input_button(struct nk_context *ctx, enum nk_buttons id, int x, int y, nk_boo
     struct nk_input *in;
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_BUTTON, ((int)id << 1) | (down ? 1: 0), x, y, 0, 0);
     in = &ctx->input;
     if (in->mouse.buttons[id].down == down) return;
 
@@ -100,6 +105,7 @@ nk_input_scroll(struct nk_context *ctx, struct nk_vec2 val)
 {
     NK_ASSERT(ctx);
     if (!ctx) return;
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_SCROLL, 0, 0, 0, &val, 0);
     ctx->input.mouse.scroll_delta.x += val.x;
     ctx->input.mouse.scroll_delta.y += val.y;
 }
@@ -115,6 +121,7 @@ nk_input_glyph(struct nk_context *ctx, const nk_glyph glyph)
     in = &ctx->input;
 
     len = nk_utf_decode(glyph, &unicode, NK_UTF_SIZE);
+    NK_INPUT_LOG(ctx, NK_INPUT_LOG_GLYPH, len, 0, 0, glyph, len);
     if (len && ((in->keyboard.text_len + len) < NK_INPUT_MAX)) {
         nk_utf_encode(unicode, &in->keyboard.text[in->keyboard.text_len],
             NK_INPUT_MAX - in->keyboard.text_len);
@@ -0,0 +1,219 @@
+#include "nuklear.h"
+#include "nuklear_internal.h"
+
+/* ===============================================================
+ *
+ *                          INPUT LOG
+ *
+ * ===============================================================*/
+#ifdef NK_INCLUDE_INPUT_RECORDING
+/* A log starts with a four byte magic and a version byte followed by one
+ * record per input call. Each record begins with a tag byte holding the
+ * event in the lower and a small argument (key/button state, glyph length)
+ * in the upper four bits. Mouse positions are stored as zig-zag varint
+ * deltas to the previously recorded position, floats as little endian
+ * 32-bit words. */
+NK_GLOBAL const nk_byte nk_input_log_magic[5] = {'N','K','I','L',1};
+
+NK_INTERN int
+nk_input_log_put_int(nk_byte *out, int value)
+{
+    nk_uint u = (value < 0) ? (((nk_uint)(-(value + 1))) << 1) | 1u: ((nk_uint)value) << 1;
+    int n = 0;
+    while (u >= 0x80) {
+        out[n++] = (nk_byte)(u | 0x80);
+        u >>= 7;
+    }
+    out[n++] = (nk_byte)u;
+    return n;
+}
+NK_INTERN int
+nk_input_log_put_float(nk_byte *out, float value)
+{
+    nk_uint u;
+    NK_MEMCPY(&u, &value, sizeof(u));
+    out[0] = (nk_byte)(u & 0xFF);
+    out[1] = (nk_byte)((u >> 8) & 0xFF);
+    out[2] = (nk_byte)((u >> 16) & 0xFF);
+    out[3] = (nk_byte)((u >> 24) & 0xFF);
+    return 4;
+}
+NK_LIB void
+nk_input_log(struct nk_context *ctx, enum nk_input_log_event event,
+    int arg, int x, int y, const void *data, int len)
+{
+    nk_byte record[32];
+    int n = 0;
+
+    NK_ASSERT(ctx->input_log);
+    if (event == NK_INPUT_LOG_GLYPH && (len <= 0 || len > NK_UTF_SIZE))
+        return;
+    if (event == NK_INPUT_LOG_END && ctx->delta_time_seconds != ctx->input_log_delta_time) {
+        /* frame time is part of the input for time based widget state */
+        record[n++] = (nk_byte)NK_INPUT_LOG_DELTA_TIME;
+        n += nk_input_log_put_float(&record[n], ctx->delta_time_seconds);
+        ctx->input_log_delta_time = ctx->delta_time_seconds;
+    }
+    record[n++] = (nk_byte)(((arg & 0x0F) << 4) | (int)event);
+    switch (event) {
+    case NK_INPUT_LOG_MOTION:
+    case NK_INPUT_LOG_BUTTON:
+        n += nk_input_log_put_int(&record[n], x - ctx->input_log_x);
+        n += nk_input_log_put_int(&record[n], y - ctx->input_log_y);
+        ctx->input_log_x = x;
+        ctx->input_log_y = y;
+        break;
+    case NK_INPUT_LOG_KEY:
+        record[n++] = (nk_byte)x;
+        break;
+    case NK_INPUT_LOG_SCROLL: {
+        const struct nk_vec2 *val = (const struct nk_vec2*)data;
+        n += nk_input_log_put_float(&record[n], val->x);
+        n += nk_input_log_put_float(&record[n], val->y);
+    } break;
+    case NK_INPUT_LOG_GLYPH:
+        NK_MEMCPY(&record[n], data, (nk_size)len);
+        n += len;
+        break;
+    default: break;
+    }
+    nk_buffer_push(ctx->input_log, NK_BUFFER_FRONT, record, (nk_size)n, 1);
+}
+NK_API nk_bool
+nk_input_record_begin(struct nk_context *ctx, struct nk_buffer *log)
+{
+    void *header;
+    NK_ASSERT(ctx);
+    NK_ASSERT(log);
+    /* the log is handed to `nk_input_replay_begin` as one block of memory */
+    NK_ASSERT(log->type != NK_BUFFER_SEGMENTED);
+    if (!ctx || !log || log->type == NK_BUFFER_SEGMENTED) return nk_false;
+    ctx->input_log = 0;
+    header = nk_buffer_alloc(log, NK_BUFFER_FRONT, sizeof(nk_input_log_magic), 1);
+    if (!header) return nk_false;
+    NK_MEMCPY(header, nk_input_log_magic, sizeof(nk_input_log_magic));
+    ctx->input_log = log;
+    ctx->input_log_x = ctx->input_log_y = 0;
+    ctx->input_log_delta_time = 0;
+    return nk_true;
+}
+NK_API void
+nk_input_record_end(struct nk_context *ctx)
+{
+    NK_ASSERT(ctx);
+    if (!ctx) return;
+    ctx->input_log = 0;
+}
+NK_API nk_bool
+nk_input_replay_begin(struct nk_input_replay *replay, const void *log, nk_size size)
+{
+    nk_size i;
+    NK_ASSERT(replay);
+    NK_ASSERT(log);
+    if (!replay || !log) return nk_false;
+    nk_zero(replay, sizeof(*replay));
+    if (size < sizeof(nk_input_log_magic)) return nk_false;
+    for (i = 0; i < sizeof(nk_input_log_magic); ++i)
+        if (((const nk_byte*)log)[i] != nk_input_log_magic[i])
+            return nk_false;
+    replay->data = (const nk_byte*)log;
+    replay->size = size;
+    replay->offset = sizeof(nk_input_log_magic);
+    return nk_true;
+}
+NK_INTERN nk_bool
+nk_input_replay_int(struct nk_input_replay *replay, int *value)
+{
+    nk_uint u = 0;
+    int shift = 0;
+    while (replay->offset < replay->size && shift < 35) {
+        nk_byte b = replay->data[replay->offset++];
+        u |= (nk_uint)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            *value = (u & 1) ? -(int)(u >> 1) - 1: (int)(u >> 1);
+            return nk_true;
+        }
+        shift += 7;
+    }
+    return nk_false;
+}
+NK_INTERN nk_bool
+nk_input_replay_float(struct nk_input_replay *replay, float *value)
+{
+    const nk_byte *p = replay->data + replay->offset;
+    nk_uint u;
+    if (replay->size - replay->offset < 4) return nk_false;
+    u = (nk_uint)p[0] | ((nk_uint)p[1] << 8) | ((nk_uint)p[2] << 16) | ((nk_uint)p[3] << 24);
+    NK_MEMCPY(value, &u, sizeof(*value));
+    replay->offset += 4;
+    return nk_true;
+}
+NK_API nk_bool
+nk_input_replay_frame(struct nk_context *ctx, struct nk_input_replay *replay)
+{
+    NK_ASSERT(ctx);
+    NK_ASSERT(replay);
+    if (!ctx || !replay || !replay->data) return nk_false;
+    if (replay->offset >= replay->size ||
+        replay->data[replay->offset] != NK_INPUT_LOG_BEGIN)
+        return nk_false;
+
+    replay->offset++;
+    nk_input_begin(ctx);
+    while (replay->offset < replay->size) {
+        const nk_byte tag = replay->data[replay->offset++];
+        const int arg = tag >> 4;
+        switch (tag & 0x0F) {
+        case NK_INPUT_LOG_END:
+            nk_input_end(ctx);
+            replay->frame++;
+            return nk_true;
+        case NK_INPUT_LOG_MOTION:
+        case NK_INPUT_LOG_BUTTON: {
+            int dx, dy;
+            if (!nk_input_replay_int(replay, &dx) || !nk_input_replay_int(replay, &dy))
+                break;
+            replay->x += dx;
+            replay->y += dy;
+            if ((tag & 0x0F) == NK_INPUT_LOG_MOTION)
+                nk_input_motion(ctx, replay->x, replay->y);
+            else if ((arg >> 1) < NK_BUTTON_MAX)
+                nk_input_button(ctx, (enum nk_buttons)(arg >> 1), replay->x, replay->y, arg & 1);
+            continue;
+        }
+        case NK_INPUT_LOG_KEY:
+            if (replay->offset >= replay->size) break;
+            if (replay->data[replay->offset] < NK_KEY_MAX)
+                nk_input_key(ctx, (enum nk_keys)replay->data[replay->offset], arg & 1);
+            replay->offset++;
+            continue;
+        case NK_INPUT_LOG_SCROLL: {
+            struct nk_vec2 val;
+            if (!nk_input_replay_float(replay, &val.x) || !nk_input_replay_float(replay, &val.y))
+                break;
+            nk_input_scroll(ctx, val);
+            continue;
+        }
+        case NK_INPUT_LOG_GLYPH: {
+            nk_glyph glyph = {0};
+            if (arg < 1 || arg > NK_UTF_SIZE || replay->size - replay->offset < (nk_size)arg)
+                break;
+            NK_MEMCPY(glyph, replay->data + replay->offset, (nk_size)arg);
+            replay->offset += (nk_size)arg;
+            nk_input_glyph(ctx, glyph);
+            continue;
+        }
+        case NK_INPUT_LOG_DELTA_TIME:
+            if (!nk_input_replay_float(replay, &ctx->delta_time_seconds))
+                break;
+            continue;
+        default: break;
+        }
+        break;
+    }
+    /* damaged or truncated log */
+    nk_input_end(ctx);
+    replay->offset = replay->size;
+    return nk_false;
+}
+#endif
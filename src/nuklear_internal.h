@@ -13,6 +13,10 @@
 #define NK_BUFFER_DEFAULT_INITIAL_SIZE (4*1024)
 #endif
 
+/* bytes checked at once for plain ASCII and runes decoded per run */
+#define NK_UTF_BLOCK 16
+#define NK_UTF_RUN 64
+
 /* standard library headers */
 #ifdef NK_INCLUDE_DEFAULT_ALLOCATOR
 #include <stdlib.h> /* malloc, free */
@@ -78,7 +82,6 @@ NK_STATIC_ASSERT(sizeof(nk_bool) == 4);
 #endif
 
 NK_GLOBAL const struct nk_rect nk_null_rect = {-8192.0f, -8192.0f, 16384, 16384};
-#define NK_FLOAT_PRECISION 0.00000000000001
 
 NK_GLOBAL const struct nk_color nk_red = {255,0,0,255};
 NK_GLOBAL const struct nk_color nk_green = {0,255,0,255};
@@ -113,11 +116,8 @@ NK_LIB nk_uint nk_round_up_pow2(nk_uint v);
 NK_LIB struct nk_rect nk_shrink_rect(struct nk_rect r, float amount);
 NK_LIB struct nk_rect nk_pad_rect(struct nk_rect r, struct nk_vec2 pad);
 NK_LIB void nk_unify(struct nk_rect *clip, const struct nk_rect *a, float x0, float y0, float x1, float y1);
-NK_LIB double nk_pow(double x, int n);
-NK_LIB int nk_ifloord(double x);
 NK_LIB int nk_ifloorf(float x);
 NK_LIB int nk_iceilf(float x);
-NK_LIB int nk_log10(double n);
 NK_LIB float nk_roundf(float x);
 
 /* util */
@@ -136,8 +136,14 @@ NK_LIB void nk_memset(void *ptr, int c0, nk_size size);
 NK_LIB void nk_zero(void *ptr, nk_size size);
 NK_LIB char *nk_itoa(char *s, long n);
 NK_LIB int nk_string_float_limit(char *string, int prec);
+#define NK_DTOA_DIGITS 17
+enum nk_dtoa_mode {NK_DTOA_SHORTEST, NK_DTOA_FIXED, NK_DTOA_PRECISION};
+NK_LIB int nk_dtoa_digits(char *digits, int max, int *point, double n, enum nk_dtoa_mode mode, int prec);
+NK_LIB int nk_dtoa_fixed(char *s, double n, int prec);
 #ifndef NK_DTOA
 NK_LIB char *nk_dtoa(char *s, double n);
+#else
+#define NK_DTOA_USER_DEFINED
 #endif
 NK_LIB int nk_text_clamp(const struct nk_user_font *font, const char *text, int text_len, float space, int *glyphs, float *text_width, nk_rune *sep_list, int sep_count);
 NK_LIB struct nk_vec2 nk_text_calculate_text_bounds(const struct nk_user_font *font, const char *begin, int byte_len, float row_height, const char **remaining, struct nk_vec2 *out_offset, int *glyphs, int op);
@@ -156,11 +162,16 @@ NK_LIB void nk_mfree(nk_handle unused, void *ptr);
 NK_LIB void* nk_buffer_align(void *unaligned, nk_size align, nk_size *alignment, enum nk_buffer_allocation_type type);
 NK_LIB void* nk_buffer_alloc(struct nk_buffer *b, enum nk_buffer_allocation_type type, nk_size size, nk_size align);
 NK_LIB void* nk_buffer_realloc(struct nk_buffer *b, nk_size capacity, nk_size *size);
+NK_LIB void* nk_buffer_memory_at(const struct nk_buffer *b, nk_size offset);
+NK_LIB nk_size nk_buffer_segment_left(const struct nk_buffer *b);
+NK_LIB nk_size nk_buffer_segment_next(struct nk_buffer *b);
 
 /* draw */
 NK_LIB void nk_command_buffer_init(struct nk_command_buffer *cb, struct nk_buffer *b, enum nk_command_clipping clip);
 NK_LIB void nk_command_buffer_reset(struct nk_command_buffer *b);
 NK_LIB void* nk_command_buffer_push(struct nk_command_buffer* b, enum nk_command_type t, nk_size size);
+NK_LIB nk_size nk_command_size(const struct nk_command *cmd);
+NK_LIB void nk_draw_text_measured(struct nk_command_buffer *b, struct nk_rect r, const char *string, int length, float text_width, const struct nk_user_font *font, struct nk_color bg, struct nk_color fg);
 NK_LIB void nk_draw_symbol(struct nk_command_buffer *out, enum nk_symbol_type type, struct nk_rect content, struct nk_color background, struct nk_color foreground, float border_width, const struct nk_user_font *font);
 
 /* buffering */
@@ -171,6 +182,21 @@ NK_LIB void nk_finish_popup(struct nk_context *ctx, struct nk_window*);
 NK_LIB void nk_finish_buffer(struct nk_context *ctx, struct nk_command_buffer *b);
 NK_LIB void nk_finish(struct nk_context *ctx, struct nk_window *w);
 NK_LIB void nk_build(struct nk_context *ctx);
+NK_LIB nk_hash nk_command_hash(const struct nk_command *cmd, nk_hash hash);
+
+/* frame delta */
+struct nk_delta_command {
+    nk_hash hash;
+    struct nk_rect bounds;
+};
+struct nk_delta_window {
+    nk_hash id;
+    nk_size begin, last; /* command memory offsets of the first and last command */
+    nk_size first; /* index of the first command */
+    unsigned int count;
+    int matched;
+};
+NK_LIB struct nk_rect nk_command_bounds(const struct nk_command *cmd);
 
 /* text editor */
 NK_LIB void nk_textedit_clear_state(struct nk_text_edit *state, enum nk_text_edit_type type, nk_plugin_filter filter);
@@ -189,16 +215,48 @@ NK_LIB void nk_free_window(struct nk_context *ctx, struct nk_window *win);
 NK_LIB struct nk_window *nk_find_window(const struct nk_context *ctx, nk_hash hash, const char *name);
 NK_LIB void nk_insert_window(struct nk_context *ctx, struct nk_window *win, enum nk_window_insert_location loc);
 
+/* frame stats */
+#ifdef NK_INCLUDE_FRAME_STATS
+#define NK_STATS_ADD(b, counter, n) do {if ((b)->stats) (b)->stats->counter += (unsigned int)(n);} while (0)
+NK_LIB void nk_stats_panel_begin(struct nk_context *ctx, struct nk_window *win, const char *title, enum nk_panel_type type);
+NK_LIB void nk_stats_panel_end(struct nk_context *ctx, struct nk_window *win);
+NK_LIB struct nk_panel_stats *nk_stats_panel_at(struct nk_context *ctx, nk_size offset);
+NK_LIB void nk_stats_clear(struct nk_context *ctx);
+#else
+#define NK_STATS_ADD(b, counter, n) ((void)0)
+#endif
+
+/* input log */
+#ifdef NK_INCLUDE_INPUT_RECORDING
+enum nk_input_log_event {
+    NK_INPUT_LOG_BEGIN,
+    NK_INPUT_LOG_END,
+    NK_INPUT_LOG_MOTION,
+    NK_INPUT_LOG_KEY,
+    NK_INPUT_LOG_BUTTON,
+    NK_INPUT_LOG_SCROLL,
+    NK_INPUT_LOG_GLYPH,
+    NK_INPUT_LOG_DELTA_TIME
+};
+NK_LIB void nk_input_log(struct nk_context *ctx, enum nk_input_log_event event, int arg, int x, int y, const void *data, int len);
+#define NK_INPUT_LOG(ctx, event, arg, x, y, data, len) do {if ((ctx)->input_log) nk_input_log(ctx, event, arg, x, y, data, len);} while (0)
+#else
+#define NK_INPUT_LOG(ctx, event, arg, x, y, data, len) ((void)0)
+#endif
+
 /* pool */
 NK_LIB void nk_pool_init(struct nk_pool *pool, const struct nk_allocator *alloc, unsigned int capacity);
 NK_LIB void nk_pool_free(struct nk_pool *pool);
 NK_LIB void nk_pool_init_fixed(struct nk_pool *pool, void *memory, nk_size size);
-NK_LIB struct nk_page_element *nk_pool_alloc(struct nk_pool *pool);
+NK_LIB nk_size nk_pool_element_size(enum nk_page_element_type type);
+NK_LIB struct nk_page_element *nk_pool_alloc(struct nk_pool *pool, enum nk_page_element_type type);
+NK_LIB void nk_pool_trim(struct nk_pool *pool, struct nk_page_element **freelist);
 
 /* page-element */
-NK_LIB struct nk_page_element* nk_create_page_element(struct nk_context *ctx);
-NK_LIB void nk_link_page_element_into_freelist(struct nk_context *ctx, struct nk_page_element *elem);
-NK_LIB void nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem);
+NK_LIB struct nk_page_element* nk_create_page_element(struct nk_context *ctx, enum nk_page_element_type type);
+NK_LIB struct nk_page_element* nk_try_create_page_element(struct nk_context *ctx, enum nk_page_element_type type);
+NK_LIB void nk_link_page_element_into_freelist(struct nk_context *ctx, struct nk_page_element *elem, enum nk_page_element_type type);
+NK_LIB void nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem, enum nk_page_element_type type);
 
 /* table */
 NK_LIB struct nk_table* nk_create_table(struct nk_context *ctx);
@@ -208,6 +266,31 @@ NK_LIB void nk_push_table(struct nk_window *win, struct nk_table *tbl);
 NK_LIB nk_uint *nk_add_value(struct nk_context *ctx, struct nk_window *win, nk_hash name, nk_uint value);
 NK_LIB nk_uint *nk_find_value(const struct nk_window *win, nk_hash name);
 
+/* chart */
+NK_LIB void nk_free_chart_stream(struct nk_context *ctx, struct nk_window *win, struct nk_chart_stream *stream);
+
+/* text cache */
+enum nk_text_cache_kind {
+    NK_TEXT_CACHE_LABEL = 1,
+    NK_TEXT_CACHE_BOOL,
+    NK_TEXT_CACHE_INT,
+    NK_TEXT_CACHE_UINT,
+    NK_TEXT_CACHE_FLOAT,
+    NK_TEXT_CACHE_COLOR_BYTE,
+    NK_TEXT_CACHE_COLOR_FLOAT,
+    NK_TEXT_CACHE_COLOR_HEX,
+    NK_TEXT_CACHE_PROPERTY_INT,
+    NK_TEXT_CACHE_PROPERTY_FLOAT,
+    NK_TEXT_CACHE_PROPERTY_DOUBLE
+};
+NK_LIB struct nk_text_cache *nk_text_cache_get(struct nk_context *ctx, struct nk_window *win);
+NK_LIB void nk_free_text_cache(struct nk_context *ctx, struct nk_window *win);
+#ifdef NK_INCLUDE_STANDARD_VARARGS
+NK_LIB nk_hash nk_text_cache_key(struct nk_text_cache *cache, const char *str, int len);
+#endif
+NK_LIB struct nk_text_cache_entry *nk_text_cache_find(struct nk_text_cache *cache, nk_hash key, const nk_uint *value, const struct nk_user_font *font);
+NK_LIB struct nk_text_cache_entry *nk_text_cache_store(struct nk_text_cache *cache, nk_hash key, const nk_uint *value, const struct nk_user_font *font, const char *text, int len, float width);
+
 /* panel */
 NK_LIB void *nk_create_panel(struct nk_context *ctx);
 NK_LIB void nk_free_panel(struct nk_context*, struct nk_panel *pan);
@@ -239,6 +322,7 @@ struct nk_text {
     struct nk_color text;
 };
 NK_LIB void nk_widget_text(struct nk_command_buffer *o, struct nk_rect b, const char *string, int len, const struct nk_text *t, nk_flags a, const struct nk_user_font *f);
+NK_LIB void nk_widget_text_measured(struct nk_command_buffer *o, struct nk_rect b, const char *string, int len, float width, const struct nk_text *t, nk_flags a, const struct nk_user_font *f);
 NK_LIB void nk_widget_text_wrap(struct nk_command_buffer *o, struct nk_rect b, const char *string, int len, const struct nk_text *t, const struct nk_user_font *f);
 
 /* button */
@@ -329,8 +413,8 @@ NK_LIB struct nk_property_variant nk_property_variant_double(double value, doubl
 
 NK_LIB void nk_drag_behavior(nk_flags *state, const struct nk_input *in, struct nk_rect drag, struct nk_property_variant *variant, float inc_per_pixel);
 NK_LIB void nk_property_behavior(nk_flags *ws, const struct nk_input *in, struct nk_rect property,  struct nk_rect label, struct nk_rect edit, struct nk_rect empty, int *state, struct nk_property_variant *variant, float inc_per_pixel);
-NK_LIB void nk_draw_property(struct nk_command_buffer *out, const struct nk_style_property *style, const struct nk_rect *bounds, const struct nk_rect *label, nk_flags state, const char *name, int len, const struct nk_user_font *font);
-NK_LIB void nk_do_property(nk_flags *ws, struct nk_command_buffer *out, struct nk_rect property, const char *name, struct nk_property_variant *variant, float inc_per_pixel, char *buffer, int *len, int *state, int *cursor, int *select_begin, int *select_end, const struct nk_style_property *style, enum nk_property_filter filter, struct nk_input *in, const struct nk_user_font *font, struct nk_text_edit *text_edit, enum nk_button_behavior behavior);
+NK_LIB void nk_draw_property(struct nk_command_buffer *out, const struct nk_style_property *style, const struct nk_rect *bounds, const struct nk_rect *label, nk_flags state, const char *name, int len, float name_width, const struct nk_user_font *font);
+NK_LIB void nk_do_property(nk_flags *ws, struct nk_command_buffer *out, struct nk_rect property, const char *name, struct nk_property_variant *variant, float inc_per_pixel, char *buffer, int *len, int *state, int *cursor, int *select_begin, int *select_end, const struct nk_style_property *style, enum nk_property_filter filter, struct nk_input *in, const struct nk_user_font *font, struct nk_text_edit *text_edit, enum nk_button_behavior behavior, struct nk_text_cache *cache, nk_hash hash);
 NK_LIB void nk_property(struct nk_context *ctx, const char *name, struct nk_property_variant *variant, float inc_per_pixel, const enum nk_property_filter filter);
 
 #ifdef NK_INCLUDE_FONT_BAKING
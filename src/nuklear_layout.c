@@ -500,6 +500,46 @@ nk_layout_widget_bounds(const struct nk_context *ctx)
     ret.h = layout->row.height;
     return ret;
 }
+NK_API void
+nk_layout_skip(struct nk_context *ctx, float height)
+{
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(ctx->current->layout);
+    if (!ctx || !ctx->current || !ctx->current->layout)
+        return;
+    ctx->current->layout->at_y += NK_MAX(height, 0);
+}
+NK_API void
+nk_layout_skip_rows(struct nk_context *ctx, int rows)
+{
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(ctx->current->layout);
+    if (!ctx || !ctx->current || !ctx->current->layout)
+        return;
+    nk_layout_skip(ctx, ctx->current->layout->row.height * (float)rows);
+}
+NK_API void
+nk_layout_visible_range(const struct nk_context *ctx, float *top, float *bottom)
+{
+    const struct nk_panel *layout;
+    float next;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(ctx->current->layout);
+    NK_ASSERT(top);
+    NK_ASSERT(bottom);
+    if (!ctx || !ctx->current || !ctx->current->layout || !top || !bottom)
+        return;
+
+    /* `at_y` is unscrolled while the clip rectangle is in screen space */
+    layout = ctx->current->layout;
+    next = layout->at_y + layout->row.height;
+    *top = layout->clip.y + (float)*layout->offset_y - next;
+    *bottom = *top + layout->clip.h;
+}
 NK_API struct nk_vec2
 nk_layout_space_to_screen(const struct nk_context *ctx, struct nk_vec2 ret)
 {
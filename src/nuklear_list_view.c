@@ -49,6 +49,11 @@ nk_list_view_begin(struct nk_context *ctx, struct nk_list_view *view,
 
     *y_offset = 0;
     result = nk_group_scrolled_offset_begin(ctx, x_offset, y_offset, title, flags);
+    if (!result) {
+        /* group was clipped and nk_list_view_end will not restore the offset */
+        *y_offset = view->scroll_value;
+        return 0;
+    }
     win = ctx->current;
     layout = win->layout;
 
@@ -60,6 +65,52 @@ nk_list_view_begin(struct nk_context *ctx, struct nk_list_view *view,
     view->ctx = ctx;
     return result;
 }
+NK_INTERN int
+nk_list_view_find_row(const float *offsets, int row_count, float spacing, float y)
+{
+    /* first row which ends below `y` */
+    int lo = 0, hi = row_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (offsets[mid+1] + spacing * (float)(mid+1) <= y)
+            lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+NK_API nk_bool
+nk_list_view_begin_variable(struct nk_context *ctx, struct nk_list_view *view,
+    const char *title, nk_flags flags, const float *offsets, int row_count)
+{
+    struct nk_panel *layout;
+    float spacing, top, bottom;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(view);
+    NK_ASSERT(title);
+    NK_ASSERT(offsets);
+    if (!ctx || !view || !title || !offsets) return 0;
+
+    nk_zero(view, sizeof(*view));
+    if (!nk_group_begin(ctx, title, flags))
+        return 0;
+
+    /* rows are laid out at their real position inside the scrolled group, so
+     * unlike uniform list views the scrollbar offset is left untouched */
+    layout = ctx->current->layout;
+    spacing = ctx->style.window.spacing.y;
+    row_count = NK_MAX(row_count, 0);
+    nk_layout_visible_range(ctx, &top, &bottom);
+    view->begin = nk_list_view_find_row(offsets, row_count, spacing, top);
+    view->end = nk_list_view_find_row(offsets, row_count, spacing, bottom);
+    view->end = NK_MIN(view->end + 1, row_count);
+    view->count = view->end - view->begin;
+    view->total_height = nk_iceilf(layout->at_y + layout->row.height - layout->bounds.y +
+        offsets[row_count] + spacing * (float)row_count);
+    view->ctx = ctx;
+    nk_layout_skip(ctx, offsets[view->begin] + spacing * (float)view->begin);
+    return 1;
+}
 NK_API void
 nk_list_view_end(struct nk_list_view *view)
 {
@@ -69,14 +120,19 @@ nk_list_view_end(struct nk_list_view *view)
 
     NK_ASSERT(view);
     NK_ASSERT(view->ctx);
-    NK_ASSERT(view->scroll_pointer);
     if (!view || !view->ctx) return;
 
     ctx = view->ctx;
     win = ctx->current;
     layout = win->layout;
-    layout->at_y = layout->bounds.y + (float)view->total_height;
-    *view->scroll_pointer = *view->scroll_pointer + view->scroll_value;
+    if (view->scroll_pointer) {
+        layout->at_y = layout->bounds.y + (float)view->total_height;
+        *view->scroll_pointer = *view->scroll_pointer + view->scroll_value;
+    } else {
+        /* skip all rows below the visible ones, the last laid out row
+         * is added by the panel itself */
+        layout->at_y = layout->bounds.y + (float)view->total_height - layout->row.height;
+    }
     nk_group_end(view->ctx);
 }
 
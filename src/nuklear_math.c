@@ -142,27 +142,6 @@ nk_round_up_pow2(nk_uint v)
     v++;
     return v;
 }
-NK_LIB double
-nk_pow(double x, int n)
-{
-    /*  check the sign of n */
-    double r = 1;
-    int plus = n >= 0;
-    n = (plus) ? n : -n;
-    while (n > 0) {
-        if ((n & 1) == 1)
-            r *= x;
-        n /= 2;
-        x *= x;
-    }
-    return plus ? r : 1.0 / r;
-}
-NK_LIB int
-nk_ifloord(double x)
-{
-    x = (double)((int)x - ((x < 0.0) ? 1 : 0));
-    return (int)x;
-}
 NK_LIB int
 nk_ifloorf(float x)
 {
@@ -181,22 +160,6 @@ nk_iceilf(float x)
         return (r > 0.0f) ? t+1: t;
     }
 }
-NK_LIB int
-nk_log10(double n)
-{
-    int neg;
-    int ret;
-    int exp = 0;
-
-    neg = (n < 0) ? 1 : 0;
-    ret = (neg) ? (int)-n : (int)n;
-    while ((ret / 10) > 0) {
-        ret /= 10;
-        exp++;
-    }
-    if (neg) exp = -exp;
-    return exp;
-}
 NK_LIB float
 nk_roundf(float x)
 {
@@ -7,56 +7,63 @@
  *
  * ===============================================================*/
 NK_LIB struct nk_page_element*
-nk_create_page_element(struct nk_context *ctx)
+nk_create_page_element(struct nk_context *ctx, enum nk_page_element_type type)
 {
+    struct nk_page_element *elem = nk_try_create_page_element(ctx, type);
+    NK_ASSERT(elem);
+    return elem;
+}
+NK_LIB struct nk_page_element*
+nk_try_create_page_element(struct nk_context *ctx, enum nk_page_element_type type)
+{
+    /* same as `nk_create_page_element` but out of memory is not an error,
+     * for optional state the caller can do without */
     struct nk_page_element *elem;
-    if (ctx->freelist) {
+    const nk_size size = nk_pool_element_size(type);
+    if (ctx->freelist[type]) {
         /* unlink page element from free list */
-        elem = ctx->freelist;
-        ctx->freelist = elem->next;
+        elem = ctx->freelist[type];
+        ctx->freelist[type] = elem->next;
     } else if (ctx->use_pool) {
         /* allocate page element from memory pool */
-        elem = nk_pool_alloc(&ctx->pool);
-        NK_ASSERT(elem);
+        elem = nk_pool_alloc(&ctx->pool, type);
         if (!elem) return 0;
     } else {
         /* allocate new page element from back of fixed size memory buffer */
-        NK_STORAGE const nk_size size = sizeof(struct nk_page_element);
         NK_STORAGE const nk_size align = NK_ALIGNOF(struct nk_page_element);
         elem = (struct nk_page_element*)nk_buffer_alloc(&ctx->memory, NK_BUFFER_BACK, size, align);
-        NK_ASSERT(elem);
         if (!elem) return 0;
     }
-    nk_zero_struct(*elem);
+    nk_zero(elem, size);
     elem->next = 0;
     elem->prev = 0;
     return elem;
 }
 NK_LIB void
 nk_link_page_element_into_freelist(struct nk_context *ctx,
-    struct nk_page_element *elem)
+    struct nk_page_element *elem, enum nk_page_element_type type)
 {
     /* link table into freelist */
-    if (!ctx->freelist) {
-        ctx->freelist = elem;
+    if (!ctx->freelist[type]) {
+        ctx->freelist[type] = elem;
     } else {
-        elem->next = ctx->freelist;
-        ctx->freelist = elem;
+        elem->next = ctx->freelist[type];
+        ctx->freelist[type] = elem;
     }
 }
 NK_LIB void
-nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem)
+nk_free_page_element(struct nk_context *ctx, struct nk_page_element *elem,
+    enum nk_page_element_type type)
 {
     /* we have a pool so just add to free list */
     if (ctx->use_pool) {
-        nk_link_page_element_into_freelist(ctx, elem);
+        nk_link_page_element_into_freelist(ctx, elem, type);
         return;
     }
     /* if possible remove last element from back of fixed memory buffer */
-    {void *elem_end = (void*)(elem + 1);
-    void *buffer_end = (nk_byte*)ctx->memory.memory.ptr + ctx->memory.size;
-    if (elem_end == buffer_end)
-        ctx->memory.size -= sizeof(struct nk_page_element);
-    else nk_link_page_element_into_freelist(ctx, elem);}
+    {void *buffer_back = (nk_byte*)ctx->memory.memory.ptr + ctx->memory.size;
+    if ((void*)elem == buffer_back)
+        ctx->memory.size += nk_pool_element_size(type);
+    else nk_link_page_element_into_freelist(ctx, elem, type);}
 }
 
@@ -10,9 +10,8 @@ NK_LIB void*
 nk_create_panel(struct nk_context *ctx)
 {
     struct nk_page_element *elem;
-    elem = nk_create_page_element(ctx);
+    elem = nk_create_page_element(ctx, NK_PAGE_ELEMENT_PANEL);
     if (!elem) return 0;
-    nk_zero_struct(*elem);
     return &elem->data.pan;
 }
 NK_LIB void
@@ -20,7 +19,7 @@ nk_free_panel(struct nk_context *ctx, struct nk_panel *pan)
 {
     union nk_page_data *pd = NK_CONTAINER_OF(pan, union nk_page_data, pan);
     struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
-    nk_free_page_element(ctx, pe);
+    nk_free_page_element(ctx, pe, NK_PAGE_ELEMENT_PANEL);
 }
 NK_LIB nk_bool
 nk_panel_has_header(nk_flags flags, const char *title)
@@ -115,6 +114,9 @@ nk_panel_begin(struct nk_context *ctx, const char *title, enum nk_panel_type pan
     in = (win->flags & NK_WINDOW_NO_INPUT) ? 0: &ctx->input;
 #ifdef NK_INCLUDE_COMMAND_USERDATA
     win->buffer.userdata = ctx->userdata;
+#endif
+#ifdef NK_INCLUDE_FRAME_STATS
+    nk_stats_panel_begin(ctx, win, title, panel_type);
 #endif
     /* pull style configuration into local stack */
     scrollbar_size = style->window.scrollbar_size;
@@ -282,6 +284,7 @@ nk_panel_begin(struct nk_context *ctx, const char *title, enum nk_panel_type pan
         int text_len = nk_strlen(title);
         struct nk_rect label = {0,0,0,0};
         float t = font->width(font->userdata, font->height, title, text_len);
+        NK_STATS_ADD(out, text_measurements, 1);
         text.padding = nk_vec2(0,0);
 
         label.x = header.x + style->window.header.padding.x;
@@ -492,6 +495,17 @@ nk_panel_end(struct nk_context *ctx)
         if ((!has_input && is_window_hovered) || (!is_window_hovered && !any_item_active))
             window->scrollbar_hiding_timer += ctx->delta_time_seconds;
         else window->scrollbar_hiding_timer = 0;
+
+        /* popups report a running timer to their root window. Groups are ended
+         * through a temporary window which restarts the timer every frame, so
+         * their scrollbar never fades and does not keep the frame animating */
+        if (window->seq == ctx->seq &&
+            window->scrollbar_hiding_timer < NK_SCROLLBAR_HIDING_TIMEOUT) {
+            struct nk_window *root = window;
+            while (root->parent)
+                root = root->parent;
+            root->scrollbar_hiding_seq = ctx->seq;
+        }
     } else window->scrollbar_hiding_timer = 0;
 
     /* window border */
@@ -6,6 +6,22 @@
  *                              POOL
  *
  * ===============================================================*/
+NK_LIB nk_size
+nk_pool_element_size(enum nk_page_element_type type)
+{
+    NK_STORAGE const nk_size align = NK_ALIGNOF(struct nk_page_element);
+    nk_size size = NK_OFFSETOF(struct nk_page_element, data);
+    switch (type) {
+    default:
+    case NK_PAGE_ELEMENT_WINDOW: size += sizeof(struct nk_window); break;
+    case NK_PAGE_ELEMENT_PANEL: size += sizeof(struct nk_panel); break;
+    case NK_PAGE_ELEMENT_TABLE: size += sizeof(struct nk_table); break;
+    case NK_PAGE_ELEMENT_STREAM: size += sizeof(struct nk_chart_stream); break;
+    case NK_PAGE_ELEMENT_TEXT: size += sizeof(struct nk_text_cache); break;
+    }
+    /* keep the following element in a page aligned */
+    return (size + (align - 1)) & ~(align - 1);
+}
 NK_LIB void
 nk_pool_init(struct nk_pool *pool, const struct nk_allocator *alloc,
     unsigned int capacity)
@@ -15,52 +31,95 @@ nk_pool_init(struct nk_pool *pool, const struct nk_allocator *alloc,
     pool->alloc = *alloc;
     pool->capacity = capacity;
     pool->type = NK_BUFFER_DYNAMIC;
-    pool->pages = 0;
 }
 NK_LIB void
 nk_pool_free(struct nk_pool *pool)
 {
-    struct nk_page *iter;
+    int type;
     if (!pool) return;
-    iter = pool->pages;
     if (pool->type == NK_BUFFER_FIXED) return;
-    while (iter) {
-        struct nk_page *next = iter->next;
-        pool->alloc.free(pool->alloc.userdata, iter);
-        iter = next;
+    for (type = 0; type < NK_PAGE_ELEMENT_TYPE_COUNT; ++type) {
+        struct nk_page *iter = pool->pages[type];
+        while (iter) {
+            struct nk_page *next = iter->next;
+            pool->alloc.free(pool->alloc.userdata, iter);
+            iter = next;
+        }
+        pool->pages[type] = 0;
     }
+    pool->page_count = 0;
 }
 NK_LIB void
 nk_pool_init_fixed(struct nk_pool *pool, void *memory, nk_size size)
 {
     nk_zero(pool, sizeof(*pool));
-    NK_ASSERT(size >= sizeof(struct nk_page));
-    if (size < sizeof(struct nk_page)) return;
-    /* first nk_page_element is embedded in nk_page, additional elements follow in adjacent space */
-    pool->capacity = (unsigned)(1 + (size - sizeof(struct nk_page)) / sizeof(struct nk_page_element));
-    pool->pages = (struct nk_page*)memory;
+    NK_ASSERT(memory);
+    if (!memory) return;
+    /* all element types are carved front to back out of the memory block */
+    pool->memory = memory;
     pool->type = NK_BUFFER_FIXED;
     pool->size = size;
 }
 NK_LIB struct nk_page_element*
-nk_pool_alloc(struct nk_pool *pool)
+nk_pool_alloc(struct nk_pool *pool, enum nk_page_element_type type)
 {
-    if (!pool->pages || pool->pages->size >= pool->capacity) {
+    const nk_size elem_size = nk_pool_element_size(type);
+    struct nk_page *page;
+    if (pool->type == NK_BUFFER_FIXED) {
+        NK_STORAGE const nk_size align = NK_ALIGNOF(struct nk_page_element);
+        void *unaligned = nk_ptr_add(void, pool->memory, pool->allocated);
+        void *memory = NK_ALIGN_PTR(unaligned, align);
+        nk_size offset = (nk_size)((nk_byte*)memory - (nk_byte*)pool->memory);
+        if (offset + elem_size > pool->size) return 0;
+        pool->allocated = offset + elem_size;
+        return (struct nk_page_element*)memory;
+    }
+    page = pool->pages[type];
+    if (!page || page->size >= pool->capacity) {
         /* allocate new page */
-        struct nk_page *page;
-        if (pool->type == NK_BUFFER_FIXED) {
-            NK_ASSERT(pool->pages);
-            if (!pool->pages) return 0;
-            NK_ASSERT(pool->pages->size < pool->capacity);
-            return 0;
-        } else {
-            nk_size size = sizeof(struct nk_page);
-            size += (pool->capacity - 1) * sizeof(struct nk_page_element);
-            page = (struct nk_page*)pool->alloc.alloc(pool->alloc.userdata,0, size);
-            page->next = pool->pages;
-            pool->pages = page;
-            page->size = 0;
+        nk_size size = NK_OFFSETOF(struct nk_page, win);
+        size += pool->capacity * elem_size;
+        page = (struct nk_page*)pool->alloc.alloc(pool->alloc.userdata,0, size);
+        if (!page) return 0;
+        page->next = pool->pages[type];
+        page->size = 0;
+        pool->pages[type] = page;
+        pool->page_count++;
+    }
+    return nk_ptr_add(struct nk_page_element, page->win, elem_size * page->size++);
+}
+NK_LIB void
+nk_pool_trim(struct nk_pool *pool, struct nk_page_element **freelist)
+{
+    int type;
+    if (pool->type != NK_BUFFER_DYNAMIC) return;
+    for (type = 0; type < NK_PAGE_ELEMENT_TYPE_COUNT; ++type) {
+        const nk_size elem_size = nk_pool_element_size((enum nk_page_element_type)type);
+        struct nk_page **page = &pool->pages[type];
+        while (*page) {
+            struct nk_page *iter = *page;
+            nk_ptr begin = (nk_ptr)iter->win;
+            nk_ptr end = begin + elem_size * iter->size;
+            unsigned int unused = 0;
+            struct nk_page_element **elem;
+
+            /* only pages without any element in use can be released */
+            for (elem = &freelist[type]; *elem; elem = &(*elem)->next)
+                if ((nk_ptr)*elem >= begin && (nk_ptr)*elem < end) unused++;
+            if (unused != iter->size) {
+                page = &iter->next;
+                continue;
+            }
+            elem = &freelist[type];
+            while (*elem) {
+                if ((nk_ptr)*elem >= begin && (nk_ptr)*elem < end)
+                    *elem = (*elem)->next;
+                else elem = &(*elem)->next;
+            }
+            *page = iter->next;
+            pool->alloc.free(pool->alloc.userdata, iter);
+            pool->page_count--;
         }
-    } return &pool->pages->win[pool->pages->size++];
+    }
 }
 
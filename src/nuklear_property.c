@@ -68,7 +68,7 @@ nk_property_behavior(nk_flags *ws, const struct nk_input *in,
 NK_LIB void
 nk_draw_property(struct nk_command_buffer *out, const struct nk_style_property *style,
     const struct nk_rect *bounds, const struct nk_rect *label, nk_flags state,
-    const char *name, int len, const struct nk_user_font *font)
+    const char *name, int len, float name_width, const struct nk_user_font *font)
 {
     struct nk_text text;
     const struct nk_style_item *background;
@@ -107,7 +107,7 @@ nk_draw_property(struct nk_command_buffer *out, const struct nk_style_property *
     /* draw label */
     text.padding = nk_vec2(0,0);
     if (name && name[0] != '#') {
-        nk_widget_text(out, *label, name, len, &text, NK_TEXT_CENTERED, font);
+        nk_widget_text_measured(out, *label, name, len, name_width, &text, NK_TEXT_CENTERED, font);
     }
 }
 NK_LIB void
@@ -119,7 +119,7 @@ nk_do_property(nk_flags *ws,
     const struct nk_style_property *style,
     enum nk_property_filter filter, struct nk_input *in,
     const struct nk_user_font *font, struct nk_text_edit *text_edit,
-    enum nk_button_behavior behavior)
+    enum nk_button_behavior behavior, struct nk_text_cache *cache, nk_hash hash)
 {
     const nk_plugin_filter filters[] = {
         nk_filter_decimal,
@@ -128,7 +128,9 @@ nk_do_property(nk_flags *ws,
     nk_bool active, old;
     int num_len = 0, name_len = 0;
     char string[NK_MAX_NUMBER_BUFFER];
-    float size;
+    float size, name_width;
+    struct nk_text_cache_entry *cached = 0;
+    nk_uint value[3];
 
     char *dst = 0;
     int *length;
@@ -149,9 +151,32 @@ nk_do_property(nk_flags *ws,
     if (name && name[0] != '#') {
         name_len = nk_strlen(name);
     }
-    size = font->width(font->userdata, font->height, name, name_len);
+    if (cache && *state != NK_PROPERTY_EDIT) {
+        /* the hash includes the name so its width is cached alongside */
+        value[1] = value[2] = 0;
+        switch (variant->kind) {
+        default:
+        case NK_PROPERTY_INT:
+            value[0] = NK_TEXT_CACHE_PROPERTY_INT;
+            value[1] = (nk_uint)variant->value.i; break;
+        case NK_PROPERTY_FLOAT:
+            value[0] = NK_TEXT_CACHE_PROPERTY_FLOAT;
+            NK_MEMCPY(&value[1], &variant->value.f, sizeof(float)); break;
+        case NK_PROPERTY_DOUBLE:
+            value[0] = NK_TEXT_CACHE_PROPERTY_DOUBLE;
+            NK_MEMCPY(&value[1], &variant->value.d, sizeof(double)); break;
+        }
+        cached = nk_text_cache_find(cache, hash, value, font);
+    }
+    if (cached) {
+        name_width = cached->label_width;
+        NK_STATS_ADD(out, text_cache_hits, 1);
+    } else {
+        name_width = font->width(font->userdata, font->height, name, name_len);
+        NK_STATS_ADD(out, text_measurements, 1);
+    }
     label.x = left.x + left.w + style->padding.x;
-    label.w = (float)size + 2 * style->padding.x;
+    label.w = name_width + 2 * style->padding.x;
     label.y = property.y + style->border + style->padding.y;
     label.h = property.h - (2 * style->border + 2 * style->padding.y);
 
@@ -164,9 +189,16 @@ nk_do_property(nk_flags *ws,
     /* edit */
     if (*state == NK_PROPERTY_EDIT) {
         size = font->width(font->userdata, font->height, buffer, *len);
+        NK_STATS_ADD(out, text_measurements, 1);
         size += style->edit.cursor_size;
         length = len;
         dst = buffer;
+    } else if (cached) {
+        num_len = cached->length;
+        NK_MEMCPY(string, cached->text, (nk_size)num_len);
+        size = cached->width;
+        dst = string;
+        length = &num_len;
     } else {
         switch (variant->kind) {
         default: break;
@@ -175,15 +207,18 @@ nk_do_property(nk_flags *ws,
             num_len = nk_strlen(string);
             break;
         case NK_PROPERTY_FLOAT:
-            NK_DTOA(string, (double)variant->value.f);
-            num_len = nk_string_float_limit(string, NK_MAX_FLOAT_PRECISION);
+            num_len = nk_dtoa_fixed(string, (double)variant->value.f, NK_MAX_FLOAT_PRECISION);
             break;
         case NK_PROPERTY_DOUBLE:
-            NK_DTOA(string, variant->value.d);
-            num_len = nk_string_float_limit(string, NK_MAX_FLOAT_PRECISION);
+            num_len = nk_dtoa_fixed(string, variant->value.d, NK_MAX_FLOAT_PRECISION);
             break;
         }
         size = font->width(font->userdata, font->height, string, num_len);
+        NK_STATS_ADD(out, text_measurements, 1);
+        if (cache) {
+            cached = nk_text_cache_store(cache, hash, value, font, string, num_len, size);
+            if (cached) cached->label_width = name_width;
+        }
         dst = string;
         length = &num_len;
     }
@@ -206,7 +241,7 @@ nk_do_property(nk_flags *ws,
 
     /* draw property */
     if (style->draw_begin) style->draw_begin(out, style->userdata);
-    nk_draw_property(out, style, &property, &label, *ws, name, name_len, font);
+    nk_draw_property(out, style, &property, &label, *ws, name, name_len, name_width, font);
     if (style->draw_end) style->draw_end(out, style->userdata);
 
     /* execute right button  */
@@ -393,7 +428,7 @@ nk_property(struct nk_context *ctx, const char *name, struct nk_property_variant
     nk_do_property(&ctx->last_widget_state, &win->buffer, bounds, name,
         variant, inc_per_pixel, buffer, len, state, cursor, select_begin,
         select_end, &style->property, filter, in, style->font, &ctx->text_edit,
-        ctx->button_behavior);
+        ctx->button_behavior, nk_text_cache_get(ctx, win), hash);
 
     if (in && *state != NK_PROPERTY_DEFAULT && !win->property.active) {
         /* current property is now hot */
@@ -0,0 +1,196 @@
+#include "nuklear.h"
+#include "nuklear_internal.h"
+
+/* ===============================================================
+ *
+ *                          FRAME STATS
+ *
+ * ===============================================================*/
+#ifdef NK_INCLUDE_FRAME_STATS
+NK_LIB void
+nk_stats_panel_begin(struct nk_context *ctx, struct nk_window *win,
+    const char *title, enum nk_panel_type type)
+{
+    struct nk_frame_stats *stats = &ctx->stats;
+    struct nk_panel *layout = win->layout;
+    struct nk_panel_stats *panel;
+    const char *name;
+    int len;
+
+    /* window buffers still point to last frame so only sub panels have a parent */
+    layout->stats_parent = nk_panel_is_sub(type) ? win->buffer.stats : 0;
+    if (stats->panel_count >= NK_FRAME_STATS_MAX_PANELS) {
+        /* out of records so everything is counted into the parent */
+        stats->dropped_panels++;
+        layout->stats = 0;
+        win->buffer.stats = layout->stats_parent;
+        return;
+    }
+    panel = &stats->panels[stats->panel_count++];
+    panel->type = type;
+    panel->parent = (layout->stats_parent) ? (int)(layout->stats_parent - stats->panels): -1;
+    panel->begin = ctx->memory.allocated;
+    panel->end = panel->begin;
+
+    name = (title) ? title: (type == NK_PANEL_WINDOW) ? win->name_string: "";
+    len = NK_MIN((int)nk_strlen(name), NK_WINDOW_MAX_NAME-1);
+    NK_MEMCPY(panel->name, name, (nk_size)len);
+    panel->name[len] = '\0';
+
+    layout->stats = panel;
+    win->buffer.stats = panel;
+}
+NK_LIB void
+nk_stats_panel_end(struct nk_context *ctx, struct nk_window *win)
+{
+    struct nk_panel *layout = win->layout;
+    if (layout->stats)
+        layout->stats->end = ctx->memory.allocated;
+    win->buffer.stats = layout->stats_parent;
+}
+NK_LIB struct nk_panel_stats*
+nk_stats_panel_at(struct nk_context *ctx, nk_size offset)
+{
+    /* nested panels are recorded after their parents so search backwards */
+    int i = ctx->stats.panel_count;
+    while (i-- > 0) {
+        struct nk_panel_stats *panel = &ctx->stats.panels[i];
+        if (panel->begin <= offset && offset < panel->end)
+            return panel;
+    }
+    return 0;
+}
+NK_INTERN nk_size
+nk_stats_pool_memory(const struct nk_context *ctx)
+{
+    const struct nk_pool *pool = &ctx->pool;
+    nk_size size = 0;
+    int type;
+
+    if (!ctx->use_pool)
+        return ctx->memory.memory.size - ctx->memory.size;
+    if (pool->type == NK_BUFFER_FIXED)
+        return pool->allocated;
+    for (type = 0; type < NK_PAGE_ELEMENT_TYPE_COUNT; ++type) {
+        const struct nk_page *iter = pool->pages[type];
+        nk_size elem_size = nk_pool_element_size((enum nk_page_element_type)type);
+        for (; iter; iter = iter->next)
+            size += NK_OFFSETOF(struct nk_page, win) + pool->capacity * elem_size;
+    }
+    return size;
+}
+NK_LIB void
+nk_stats_clear(struct nk_context *ctx)
+{
+    struct nk_frame_stats *stats = &ctx->stats;
+    struct nk_memory_stats *max = &stats->high_water;
+
+    stats->memory.commands = ctx->memory.allocated;
+    stats->memory.pool = nk_stats_pool_memory(ctx);
+    max->commands = NK_MAX(max->commands, stats->memory.commands);
+    max->pool = NK_MAX(max->pool, stats->memory.pool);
+    max->draw_commands = NK_MAX(max->draw_commands, stats->memory.draw_commands);
+    max->vertices = NK_MAX(max->vertices, stats->memory.vertices);
+    max->elements = NK_MAX(max->elements, stats->memory.elements);
+
+    /* publish finished frame and start a new one only keeping high-water marks */
+    ctx->last_stats = *stats;
+    nk_zero_struct(*stats);
+    stats->high_water = ctx->last_stats.high_water;
+}
+NK_API const struct nk_frame_stats*
+nk_frame_stats(const struct nk_context *ctx)
+{
+    NK_ASSERT(ctx);
+    if (!ctx) return 0;
+    return &ctx->last_stats;
+}
+NK_INTERN void
+nk_stats_label(struct nk_context *ctx, nk_size value)
+{
+    char buffer[32];
+    nk_itoa(buffer, (long)value);
+    nk_label(ctx, buffer, NK_TEXT_RIGHT);
+}
+NK_API nk_bool
+nk_frame_stats_window(struct nk_context *ctx, const char *title,
+    struct nk_rect bounds, nk_flags flags)
+{
+    NK_STORAGE const float memory_ratio[] = {0.4f, 0.3f, 0.3f};
+    NK_STORAGE const float panel_ratio[] = {0.24f, 0.1f, 0.12f, 0.1f, 0.1f, 0.1f, 0.12f, 0.12f};
+    const struct nk_frame_stats *stats;
+    nk_bool visible;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(title);
+    if (!ctx || !title) return 0;
+
+    /* show the last finished frame since the current one is still recorded */
+    stats = &ctx->last_stats;
+    visible = nk_begin(ctx, title, bounds, flags);
+    if (visible) {
+        int i;
+        nk_layout_row(ctx, NK_DYNAMIC, 0, 3, memory_ratio);
+        nk_label(ctx, "memory", NK_TEXT_LEFT);
+        nk_label(ctx, "frame", NK_TEXT_RIGHT);
+        nk_label(ctx, "peak", NK_TEXT_RIGHT);
+        nk_label(ctx, "commands", NK_TEXT_LEFT);
+        nk_stats_label(ctx, stats->memory.commands);
+        nk_stats_label(ctx, stats->high_water.commands);
+        nk_label(ctx, "pool", NK_TEXT_LEFT);
+        nk_stats_label(ctx, stats->memory.pool);
+        nk_stats_label(ctx, stats->high_water.pool);
+        nk_label(ctx, "draw commands", NK_TEXT_LEFT);
+        nk_stats_label(ctx, stats->memory.draw_commands);
+        nk_stats_label(ctx, stats->high_water.draw_commands);
+        nk_label(ctx, "vertices", NK_TEXT_LEFT);
+        nk_stats_label(ctx, stats->memory.vertices);
+        nk_stats_label(ctx, stats->high_water.vertices);
+        nk_label(ctx, "elements", NK_TEXT_LEFT);
+        nk_stats_label(ctx, stats->memory.elements);
+        nk_stats_label(ctx, stats->high_water.elements);
+
+        nk_layout_row(ctx, NK_DYNAMIC, 0, 8, panel_ratio);
+        nk_label(ctx, "panel", NK_TEXT_LEFT);
+        nk_label(ctx, "cmds", NK_TEXT_RIGHT);
+        nk_label(ctx, "bytes", NK_TEXT_RIGHT);
+        nk_label(ctx, "vtx", NK_TEXT_RIGHT);
+        nk_label(ctx, "idx", NK_TEXT_RIGHT);
+        nk_label(ctx, "tbl", NK_TEXT_RIGHT);
+        nk_label(ctx, "text", NK_TEXT_RIGHT);
+        nk_label(ctx, "cached", NK_TEXT_RIGHT);
+        for (i = 0; i < stats->panel_count; ++i) {
+            const struct nk_panel_stats *panel = &stats->panels[i];
+            char name[NK_WINDOW_MAX_NAME + 16];
+            nk_size commands = 0;
+            int depth = 0, parent, len = 0, n;
+
+            for (parent = panel->parent; parent >= 0 && depth < 8; ++depth)
+                parent = stats->panels[parent].parent;
+            while (len < depth * 2) name[len++] = ' ';
+            n = nk_strlen(panel->name);
+            NK_MEMCPY(&name[len], panel->name, (nk_size)n);
+            name[len + n] = '\0';
+            for (n = 0; n < NK_COMMAND_TYPE_COUNT; ++n)
+                commands += panel->commands[n];
+
+            nk_label(ctx, name, NK_TEXT_LEFT);
+            nk_stats_label(ctx, commands);
+            nk_stats_label(ctx, panel->command_bytes);
+            nk_stats_label(ctx, panel->vertices);
+            nk_stats_label(ctx, panel->indices);
+            nk_stats_label(ctx, panel->table_lookups);
+            nk_stats_label(ctx, panel->text_measurements);
+            nk_stats_label(ctx, panel->text_cache_hits);
+        }
+        if (stats->dropped_panels) {
+            nk_layout_row_dynamic(ctx, 0, 2);
+            nk_label(ctx, "untracked panels", NK_TEXT_LEFT);
+            nk_stats_label(ctx, stats->dropped_panels);
+        }
+    }
+    nk_end(ctx);
+    return visible;
+}
+#endif
+
@@ -10,9 +10,8 @@ NK_LIB struct nk_table*
 nk_create_table(struct nk_context *ctx)
 {
     struct nk_page_element *elem;
-    elem = nk_create_page_element(ctx);
+    elem = nk_create_page_element(ctx, NK_PAGE_ELEMENT_TABLE);
     if (!elem) return 0;
-    nk_zero_struct(*elem);
     return &elem->data.tbl;
 }
 NK_LIB void
@@ -20,7 +19,7 @@ nk_free_table(struct nk_context *ctx, struct nk_table *tbl)
 {
     union nk_page_data *pd = NK_CONTAINER_OF(tbl, union nk_page_data, tbl);
     struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
-    nk_free_page_element(ctx, pe);
+    nk_free_page_element(ctx, pe, NK_PAGE_ELEMENT_TABLE);
 }
 NK_LIB void
 nk_push_table(struct nk_window *win, struct nk_table *tbl)
@@ -74,6 +73,7 @@ NK_LIB nk_uint*
 nk_find_value(const struct nk_window *win, nk_hash name)
 {
     struct nk_table *iter = win->tables;
+    NK_STATS_ADD(&win->buffer, table_lookups, 1);
     while (iter) {
         unsigned int i = 0;
         unsigned int size = iter->size;
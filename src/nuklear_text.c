@@ -10,6 +10,13 @@ NK_LIB void
 nk_widget_text(struct nk_command_buffer *o, struct nk_rect b,
     const char *string, int len, const struct nk_text *t,
     nk_flags a, const struct nk_user_font *f)
+{
+    nk_widget_text_measured(o, b, string, len, -1.0f, t, a, f);
+}
+NK_LIB void
+nk_widget_text_measured(struct nk_command_buffer *o, struct nk_rect b,
+    const char *string, int len, float width, const struct nk_text *t,
+    nk_flags a, const struct nk_user_font *f)
 {
     struct nk_rect label;
     float text_width;
@@ -23,8 +30,12 @@ nk_widget_text(struct nk_command_buffer *o, struct nk_rect b,
     label.y = b.y + t->padding.y;
     label.h = NK_MIN(f->height, b.h - 2 * t->padding.y);
 
-    text_width = f->width(f->userdata, f->height, (const char*)string, len);
-    text_width += (2.0f * t->padding.x);
+    /* the width is measured once and handed on to `nk_draw_text` */
+    if (width < 0) {
+        width = f->width(f->userdata, f->height, (const char*)string, len);
+        NK_STATS_ADD(o, text_measurements, 1);
+    }
+    text_width = width + (2.0f * t->padding.x);
 
     /* align in x-axis */
     if (a & NK_TEXT_ALIGN_LEFT) {
@@ -49,7 +60,7 @@ nk_widget_text(struct nk_command_buffer *o, struct nk_rect b,
         label.y = b.y + b.h - f->height;
         label.h = f->height;
     }
-    nk_draw_text(o, label, (const char*)string, len, f, t->background, t->text);
+    nk_draw_text_measured(o, label, (const char*)string, len, width, f, t->background, t->text);
 }
 NK_LIB void
 nk_widget_text_wrap(struct nk_command_buffer *o, struct nk_rect b,
@@ -82,17 +93,145 @@ nk_widget_text_wrap(struct nk_command_buffer *o, struct nk_rect b,
     line.h = 2 * t->padding.y + f->height;
 
     fitting = nk_text_clamp(f, string, len, line.w, &glyphs, &width, seperator,NK_LEN(seperator));
+    NK_STATS_ADD(o, text_measurements, glyphs);
     while (done < len) {
         if (!fitting || line.y + line.h >= (b.y + b.h)) break;
         nk_widget_text(o, line, &string[done], fitting, &text, NK_TEXT_LEFT, f);
         done += fitting;
         line.y += f->height + 2 * t->padding.y;
         fitting = nk_text_clamp(f, &string[done], len - done, line.w, &glyphs, &width, seperator,NK_LEN(seperator));
+        NK_STATS_ADD(o, text_measurements, glyphs);
     }
 }
-NK_API void
-nk_text_colored(struct nk_context *ctx, const char *str, int len,
-    nk_flags alignment, struct nk_color color)
+NK_LIB struct nk_text_cache*
+nk_text_cache_get(struct nk_context *ctx, struct nk_window *win)
+{
+    struct nk_text_cache *cache = win->text_cache;
+    if (!cache) {
+        /* the cache is optional: fixed memory contexts go without and a
+         * failed allocation falls back to formatting every frame */
+        struct nk_page_element *elem;
+        if (!ctx->use_pool || ctx->pool.type != NK_BUFFER_DYNAMIC)
+            return 0;
+        elem = nk_try_create_page_element(ctx, NK_PAGE_ELEMENT_TEXT);
+        if (!elem) return 0;
+        cache = &elem->data.text;
+        nk_zero(cache, sizeof(*cache));
+        cache->alloc = ctx->pool.alloc;
+        win->text_cache = cache;
+    }
+    if (cache->seq != win->seq) {
+        /* first use this frame so restart counting value widgets */
+        cache->seq = win->seq;
+        cache->counter = 0;
+    }
+    return cache;
+}
+NK_LIB void
+nk_free_text_cache(struct nk_context *ctx, struct nk_window *win)
+{
+    union nk_page_data *pd = NK_CONTAINER_OF(win->text_cache, union nk_page_data, text);
+    struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
+    if (win->text_cache->entries)
+        win->text_cache->alloc.free(win->text_cache->alloc.userdata, win->text_cache->entries);
+    win->text_cache = 0;
+    nk_free_page_element(ctx, pe, NK_PAGE_ELEMENT_TEXT);
+}
+#ifdef NK_INCLUDE_STANDARD_VARARGS
+NK_LIB nk_hash
+nk_text_cache_key(struct nk_text_cache *cache, const char *str, int len)
+{
+    /* like number properties, widgets without an id are told apart by order */
+    return nk_murmur_hash(str, len, cache->counter++);
+}
+#endif
+NK_INTERN struct nk_text_cache_entry*
+nk_text_cache_slot(struct nk_text_cache *cache, nk_hash key)
+{
+    /* empty entries have no font and the table is never full */
+    const int mask = cache->capacity - 1;
+    int i = (int)(key & (nk_hash)mask);
+    while (cache->entries[i].font && cache->entries[i].key != key)
+        i = (i + 1) & mask;
+    return &cache->entries[i];
+}
+NK_INTERN nk_bool
+nk_text_cache_rebuild(struct nk_text_cache *cache)
+{
+    /* keep entries used in this or the previous frame and leave room for
+     * as many new ones */
+    struct nk_text_cache_entry *entries;
+    int capacity = NK_TEXT_CACHE_SIZE;
+    int live = 0, i;
+    for (i = 0; i < cache->capacity; ++i) {
+        const struct nk_text_cache_entry *entry = &cache->entries[i];
+        if (entry->font && cache->seq - entry->seq <= 1) live++;
+    }
+    while (capacity < 2 * (live + 1))
+        capacity *= 2;
+    entries = (struct nk_text_cache_entry*)cache->alloc.alloc(cache->alloc.userdata,
+        0, sizeof(*entries) * (nk_size)capacity);
+    if (!entries) return nk_false;
+    NK_MEMSET(entries, 0, sizeof(*entries) * (nk_size)capacity);
+    {struct nk_text_cache old = *cache;
+    cache->entries = entries;
+    cache->capacity = capacity;
+    cache->count = live;
+    for (i = 0; i < old.capacity; ++i) {
+        const struct nk_text_cache_entry *entry = &old.entries[i];
+        if (entry->font && cache->seq - entry->seq <= 1)
+            *nk_text_cache_slot(cache, entry->key) = *entry;
+    }
+    if (old.entries)
+        cache->alloc.free(cache->alloc.userdata, old.entries);}
+    return nk_true;
+}
+NK_LIB struct nk_text_cache_entry*
+nk_text_cache_find(struct nk_text_cache *cache, nk_hash key,
+    const nk_uint *value, const struct nk_user_font *font)
+{
+    struct nk_text_cache_entry *entry;
+    if (!cache->capacity) return 0;
+    entry = nk_text_cache_slot(cache, key);
+    if (!entry->font) return 0;
+    entry->seq = cache->seq;
+    if (entry->font != font || entry->height != font->height ||
+        entry->value[0] != value[0] || entry->value[1] != value[1] ||
+        entry->value[2] != value[2])
+        return 0;
+    return entry;
+}
+NK_LIB struct nk_text_cache_entry*
+nk_text_cache_store(struct nk_text_cache *cache, nk_hash key,
+    const nk_uint *value, const struct nk_user_font *font,
+    const char *text, int len, float width)
+{
+    struct nk_text_cache_entry *entry;
+    if (len >= NK_TEXT_CACHE_MAX_TEXT) return 0;
+    if (4 * (cache->count + 1) > 3 * cache->capacity) {
+        /* if the table cannot be rebuilt keep one entry empty for probing */
+        if (!nk_text_cache_rebuild(cache) && cache->count + 1 >= cache->capacity)
+            return 0;
+    }
+    entry = nk_text_cache_slot(cache, key);
+    if (!entry->font) cache->count++;
+    entry->key = key;
+    entry->seq = cache->seq;
+    entry->value[0] = value[0];
+    entry->value[1] = value[1];
+    entry->value[2] = value[2];
+    entry->font = font;
+    entry->height = font->height;
+    entry->width = width;
+    entry->label_width = 0;
+    entry->length = len;
+    NK_MEMCPY(entry->text, text, (nk_size)len);
+    entry->text[len] = '\0';
+    return entry;
+}
+NK_INTERN void
+nk_text_colored_measured(struct nk_context *ctx, const char *str, int len,
+    float width, nk_flags alignment, struct nk_color color)
 {
     struct nk_window *win;
     const struct nk_style *style;
@@ -115,7 +254,13 @@ nk_text_colored(struct nk_context *ctx, const char *str, int len,
     text.padding.y = item_padding.y;
     text.background = style->window.background;
     text.text = nk_rgb_factor(color, style->text.color_factor);
-    nk_widget_text(&win->buffer, bounds, str, len, &text, alignment, style->font);
+    nk_widget_text_measured(&win->buffer, bounds, str, len, width, &text, alignment, style->font);
+}
+NK_API void
+nk_text_colored(struct nk_context *ctx, const char *str, int len,
+    nk_flags alignment, struct nk_color color)
+{
+    nk_text_colored_measured(ctx, str, len, -1.0f, alignment, color);
 }
 NK_API void
 nk_text_wrap_colored(struct nk_context *ctx, const char *str,
@@ -145,6 +290,87 @@ nk_text_wrap_colored(struct nk_context *ctx, const char *str,
     nk_widget_text_wrap(&win->buffer, bounds, str, len, &text, style->font);
 }
 #ifdef NK_INCLUDE_STANDARD_VARARGS
+NK_INTERN void
+nk_label_cached(struct nk_context *ctx, const char *fmt, const char *str,
+    nk_flags align, struct nk_color color)
+{
+    /* labels are formatted anyway but only measured if the text changed */
+    const struct nk_user_font *font;
+    struct nk_text_cache *cache;
+    struct nk_text_cache_entry *entry;
+    nk_uint value[3];
+    nk_hash key;
+    float width;
+    int len, i = 0;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(ctx->current->layout);
+    if (!ctx || !ctx->current || !ctx->current->layout) return;
+
+    len = nk_strlen(str);
+    cache = nk_text_cache_get(ctx, ctx->current);
+    if (!cache) {
+        nk_text_colored(ctx, str, len, align, color);
+        return;
+    }
+    font = ctx->style.font;
+    value[0] = NK_TEXT_CACHE_LABEL;
+    value[1] = value[2] = 0;
+    key = nk_text_cache_key(cache, fmt, nk_strlen(fmt));
+    entry = nk_text_cache_find(cache, key, value, font);
+    if (entry && entry->length == len)
+        while (i < len && entry->text[i] == str[i]) ++i;
+    if (entry && entry->length == len && i == len) {
+        width = entry->width;
+        NK_STATS_ADD(&ctx->current->buffer, text_cache_hits, 1);
+    } else {
+        width = font->width(font->userdata, font->height, str, len);
+        NK_STATS_ADD(&ctx->current->buffer, text_measurements, 1);
+        nk_text_cache_store(cache, key, value, font, str, len, width);
+    }
+    nk_text_colored_measured(ctx, str, len, width, align, color);
+}
+NK_INTERN void
+nk_value_cached(struct nk_context *ctx, const char *prefix,
+    const nk_uint *value, const char *fmt, ...)
+{
+    /* values skip formatting as well as long as the value is unchanged */
+    const struct nk_user_font *font;
+    struct nk_text_cache *cache;
+    struct nk_text_cache_entry *entry = 0;
+    nk_hash key = 0;
+    char buf[256];
+    float width;
+    va_list args;
+    int len;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(ctx->current);
+    NK_ASSERT(ctx->current->layout);
+    if (!ctx || !ctx->current || !ctx->current->layout) return;
+
+    font = ctx->style.font;
+    cache = nk_text_cache_get(ctx, ctx->current);
+    if (cache) {
+        key = nk_text_cache_key(cache, prefix, nk_strlen(prefix));
+        entry = nk_text_cache_find(cache, key, value, font);
+    }
+    if (entry) {
+        NK_STATS_ADD(&ctx->current->buffer, text_cache_hits, 1);
+        nk_text_colored_measured(ctx, entry->text, entry->length, entry->width,
+            NK_TEXT_LEFT, ctx->style.text.color);
+        return;
+    }
+    va_start(args, fmt);
+    nk_strfmt(buf, NK_LEN(buf), fmt, args);
+    va_end(args);
+    len = nk_strlen(buf);
+    width = font->width(font->userdata, font->height, buf, len);
+    NK_STATS_ADD(&ctx->current->buffer, text_measurements, 1);
+    if (cache) nk_text_cache_store(cache, key, value, font, buf, len, width);
+    nk_text_colored_measured(ctx, buf, len, width, NK_TEXT_LEFT, ctx->style.text.color);
+}
 NK_API void
 nk_labelf_colored(struct nk_context *ctx, nk_flags flags,
     struct nk_color color, const char *fmt, ...)
@@ -185,7 +411,7 @@ nk_labelfv_colored(struct nk_context *ctx, nk_flags flags,
 {
     char buf[256];
     nk_strfmt(buf, NK_LEN(buf), fmt, args);
-    nk_label_colored(ctx, buf, flags, color);
+    nk_label_cached(ctx, fmt, buf, flags, color);
 }
 
 NK_API void
@@ -202,7 +428,9 @@ nk_labelfv(struct nk_context *ctx, nk_flags flags, const char *fmt, va_list args
 {
     char buf[256];
     nk_strfmt(buf, NK_LEN(buf), fmt, args);
-    nk_label(ctx, buf, flags);
+    NK_ASSERT(ctx);
+    if (!ctx) return;
+    nk_label_cached(ctx, fmt, buf, flags, ctx->style.text.color);
 }
 
 NK_API void
@@ -216,42 +444,58 @@ nk_labelfv_wrap(struct nk_context *ctx, const char *fmt, va_list args)
 NK_API void
 nk_value_bool(struct nk_context *ctx, const char *prefix, int value)
 {
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: %s", prefix, ((value) ? "true": "false"));
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_BOOL; key[1] = (value != 0); key[2] = 0;
+    nk_value_cached(ctx, prefix, key, "%s: %s", prefix, ((value) ? "true": "false"));
 }
 NK_API void
 nk_value_int(struct nk_context *ctx, const char *prefix, int value)
 {
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: %d", prefix, value);
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_INT; key[1] = (nk_uint)value; key[2] = 0;
+    nk_value_cached(ctx, prefix, key, "%s: %d", prefix, value);
 }
 NK_API void
 nk_value_uint(struct nk_context *ctx, const char *prefix, unsigned int value)
 {
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: %u", prefix, value);
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_UINT; key[1] = value; key[2] = 0;
+    nk_value_cached(ctx, prefix, key, "%s: %u", prefix, value);
 }
 NK_API void
 nk_value_float(struct nk_context *ctx, const char *prefix, float value)
 {
     double double_value = (double)value;
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: %.3f", prefix, double_value);
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_FLOAT; key[2] = 0;
+    NK_MEMCPY(&key[1], &value, sizeof(value));
+    nk_value_cached(ctx, prefix, key, "%s: %.3f", prefix, double_value);
 }
 NK_API void
 nk_value_color_byte(struct nk_context *ctx, const char *p, struct nk_color c)
 {
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: (%d, %d, %d, %d)", p, c.r, c.g, c.b, c.a);
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_COLOR_BYTE; key[1] = nk_color_u32(c); key[2] = 0;
+    nk_value_cached(ctx, p, key, "%s: (%d, %d, %d, %d)", p, c.r, c.g, c.b, c.a);
 }
 NK_API void
 nk_value_color_float(struct nk_context *ctx, const char *p, struct nk_color color)
 {
-    double c[4]; nk_color_dv(c, color);
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: (%.2f, %.2f, %.2f, %.2f)",
+    double c[4];
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_COLOR_FLOAT; key[1] = nk_color_u32(color); key[2] = 0;
+    nk_color_dv(c, color);
+    nk_value_cached(ctx, p, key, "%s: (%.2f, %.2f, %.2f, %.2f)",
         p, c[0], c[1], c[2], c[3]);
 }
 NK_API void
 nk_value_color_hex(struct nk_context *ctx, const char *prefix, struct nk_color color)
 {
     char hex[16];
+    nk_uint key[3];
+    key[0] = NK_TEXT_CACHE_COLOR_HEX; key[1] = nk_color_u32(color); key[2] = 0;
     nk_color_hex_rgba(hex, color);
-    nk_labelf(ctx, NK_TEXT_LEFT, "%s: %s", prefix, hex);
+    nk_value_cached(ctx, prefix, key, "%s: %s", prefix, hex);
 }
 #endif
 NK_API void
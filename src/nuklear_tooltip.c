@@ -80,6 +80,7 @@ nk_tooltip(struct nk_context *ctx, const char *text)
     text_len = nk_strlen(text);
     text_width = style->font->width(style->font->userdata,
                     style->font->height, text, text_len);
+    NK_STATS_ADD(&ctx->current->buffer, text_measurements, 1);
     text_width += (4 * padding.x);
     text_height = (style->font->height + 2 * padding.y);
 
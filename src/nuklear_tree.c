@@ -7,6 +7,21 @@
  *
  * ===============================================================*/
 NK_INTERN int
+nk_tree_indent(struct nk_context *ctx, struct nk_rect header,
+    enum nk_collapse_states state)
+{
+    /* increase x-axis cursor widget position pointer */
+    const struct nk_style *style = &ctx->style;
+    struct nk_panel *layout = ctx->current->layout;
+    if (state == NK_MAXIMIZED) {
+        layout->at_x = header.x + (float)*layout->offset_x + style->tab.indent;
+        layout->bounds.w = NK_MAX(layout->bounds.w, style->tab.indent);
+        layout->bounds.w -= (style->tab.indent + style->window.padding.x);
+        layout->row.tree_depth++;
+        return nk_true;
+    } else return nk_false;
+}
+NK_INTERN int
 nk_tree_state_base(struct nk_context *ctx, enum nk_tree_type type,
     struct nk_image *img, const char *title, enum nk_collapse_states *state)
 {
@@ -47,6 +62,11 @@ nk_tree_state_base(struct nk_context *ctx, enum nk_tree_type type,
     nk_layout_reset_min_row_height(ctx);
 
     widget_state = nk_widget(&header, ctx);
+    if (widget_state == NK_WIDGET_INVALID) {
+        /* header is clipped away so only the node state is kept. Open nodes
+         * still return true since their height is only known after layout */
+        return nk_tree_indent(ctx, header, *state);
+    }
     if (type == NK_TREE_TAB) {
         const struct nk_style_item *background = &style->tab.background;
 
@@ -110,14 +130,7 @@ nk_tree_state_base(struct nk_context *ctx, enum nk_tree_type type,
     nk_widget_text(out, label, title, nk_strlen(title), &text,
         NK_TEXT_LEFT, style->font);}
 
-    /* increase x-axis cursor widget position pointer */
-    if (*state == NK_MAXIMIZED) {
-        layout->at_x = header.x + (float)*layout->offset_x + style->tab.indent;
-        layout->bounds.w = NK_MAX(layout->bounds.w, style->tab.indent);
-        layout->bounds.w -= (style->tab.indent + style->window.padding.x);
-        layout->row.tree_depth++;
-        return nk_true;
-    } else return nk_false;
+    return nk_tree_indent(ctx, header, *state);
 }
 NK_INTERN int
 nk_tree_base(struct nk_context *ctx, enum nk_tree_type type,
@@ -237,6 +250,11 @@ nk_tree_element_image_push_hashed_base(struct nk_context *ctx, enum nk_tree_type
     nk_layout_reset_min_row_height(ctx);
 
     widget_state = nk_widget(&header, ctx);
+    if (widget_state == NK_WIDGET_INVALID) {
+        /* header is clipped away so only the node state is kept. Open nodes
+         * still return true since their height is only known after layout */
+        return nk_tree_indent(ctx, header, *state);
+    }
     if (type == NK_TREE_TAB) {
         const struct nk_style_item *background = &style->tab.background;
 
@@ -284,6 +302,7 @@ nk_tree_element_image_push_hashed_base(struct nk_context *ctx, enum nk_tree_type
     /* calculate size of the text and tooltip */
     text_len = nk_strlen(title);
     text_width = style->font->width(style->font->userdata, style->font->height, title, text_len);
+    NK_STATS_ADD(out, text_measurements, 1);
     text_width += (4 * padding.x);
 
     header.w = NK_MAX(header.w, sym.w + item_spacing.x);
@@ -298,14 +317,7 @@ nk_tree_element_image_push_hashed_base(struct nk_context *ctx, enum nk_tree_type
     } else nk_do_selectable(&dummy, &win->buffer, label, title, title_len, NK_TEXT_LEFT,
             selected, &style->selectable, in, style->font);
     }
-    /* increase x-axis cursor widget position pointer */
-    if (*state == NK_MAXIMIZED) {
-        layout->at_x = header.x + (float)*layout->offset_x + style->tab.indent;
-        layout->bounds.w = NK_MAX(layout->bounds.w, style->tab.indent);
-        layout->bounds.w -= (style->tab.indent + style->window.padding.x);
-        layout->row.tree_depth++;
-        return nk_true;
-    } else return nk_false;
+    return nk_tree_indent(ctx, header, *state);
 }
 NK_INTERN int
 nk_tree_element_base(struct nk_context *ctx, enum nk_tree_type type,
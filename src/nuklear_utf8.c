@@ -44,6 +44,10 @@ nk_utf_decode(const char *c, nk_rune *u, int clen)
 
     if (!c || !u) return 0;
     if (!clen) return 0;
+    if (!((nk_byte)c[0] & 0x80)) {
+        *u = (nk_byte)c[0];
+        return 1;
+    }
     *u = NK_UTF_INVALID;
 
     udecoded = nk_utf_decode_byte(c[0], &len);
@@ -61,6 +65,44 @@ nk_utf_decode(const char *c, nk_rune *u, int clen)
     nk_utf_validate(u, len);
     return len;
 }
+NK_INTERN int
+nk_utf_ascii_block(const char *c)
+{
+    /* written as a plain reduction so compilers can vectorize it */
+    nk_byte bits = 0;
+    int i;
+    for (i = 0; i < NK_UTF_BLOCK; ++i)
+        bits |= (nk_byte)c[i];
+    return !(bits & 0x80);
+}
+NK_API int
+nk_utf_decode_run(const char *text, int byte_len, nk_rune *runes,
+    int max_runes, int *decoded_len)
+{
+    int count = 0, len = 0, glyph_len, i;
+
+    NK_ASSERT(text);
+    NK_ASSERT(runes);
+    NK_ASSERT(decoded_len);
+
+    if (!text || !runes || !decoded_len) return 0;
+    while (count < max_runes && len < byte_len) {
+        if (max_runes - count >= NK_UTF_BLOCK && byte_len - len >= NK_UTF_BLOCK &&
+            nk_utf_ascii_block(text + len)) {
+            for (i = 0; i < NK_UTF_BLOCK; ++i)
+                runes[count + i] = (nk_byte)text[len + i];
+            count += NK_UTF_BLOCK;
+            len += NK_UTF_BLOCK;
+            continue;
+        }
+        glyph_len = nk_utf_decode(text + len, &runes[count], byte_len - len);
+        if (!glyph_len) break;
+        len += glyph_len;
+        if (runes[count++] == NK_UTF_INVALID) break;
+    }
+    *decoded_len = len;
+    return count;
+}
 NK_INTERN char
 nk_utf_encode_byte(nk_rune u, int i)
 {
@@ -84,23 +126,19 @@ nk_utf_encode(nk_rune u, char *c, int clen)
 NK_API int
 nk_utf_len(const char *str, int len)
 {
-    const char *text;
+    nk_rune runes[NK_UTF_RUN];
     int glyphs = 0;
-    int text_len;
-    int glyph_len;
     int src_len = 0;
-    nk_rune unicode;
+    int run_len;
 
     NK_ASSERT(str);
     if (!str || !len) return 0;
 
-    text = str;
-    text_len = len;
-    glyph_len = nk_utf_decode(text, &unicode, text_len);
-    while (glyph_len && src_len < len) {
-        glyphs++;
-        src_len = src_len + glyph_len;
-        glyph_len = nk_utf_decode(text + src_len, &unicode, text_len - src_len);
+    while (src_len < len) {
+        glyphs += nk_utf_decode_run(str + src_len, len - src_len, runes,
+            (int)NK_LEN(runes), &run_len);
+        if (!run_len) break;
+        src_len += run_len;
     }
     return glyphs;
 }
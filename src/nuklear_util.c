@@ -164,62 +164,636 @@ nk_strtoi(const char *str, char **endptr)
         *endptr = (char *)p;
     return neg*value;
 }
+/* Binary <-> decimal conversion. Doubles are split into an integer significand
+ * and binary exponent using power-of-two scaling only and every decimal digit
+ * is taken from an exact ratio of big integers (Steele & White, Burger &
+ * Dybvig), so there is no dependency on a 64-bit integer type or the layout
+ * of `double`. Numbers in the usual UI range only need a handful of limbs. */
+#define NK_BIGNUM_LIMBS 76
+struct nk_bignum {
+    int n;
+    nk_ushort d[NK_BIGNUM_LIMBS];
+};
+NK_GLOBAL const double nk_pow10_table[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+NK_INTERN void
+nk_bignum_trim(struct nk_bignum *b)
+{
+    while (b->n > 0 && !b->d[b->n-1])
+        b->n--;
+}
+NK_INTERN void
+nk_bignum_set(struct nk_bignum *b, nk_uint hi, nk_uint lo)
+{
+    b->d[0] = (nk_ushort)(lo & 0xFFFF);
+    b->d[1] = (nk_ushort)(lo >> 16);
+    b->d[2] = (nk_ushort)(hi & 0xFFFF);
+    b->d[3] = (nk_ushort)(hi >> 16);
+    b->n = 4;
+    nk_bignum_trim(b);
+}
+NK_INTERN int
+nk_bignum_bits(const struct nk_bignum *b)
+{
+    nk_uint top;
+    int bits;
+    if (!b->n) return 0;
+    top = b->d[b->n-1];
+    for (bits = (b->n-1) * 16; top; top >>= 1)
+        bits++;
+    return bits;
+}
+NK_INTERN void
+nk_bignum_mul(struct nk_bignum *b, nk_uint m)
+{
+    /* `m` has to fit into a single limb */
+    nk_uint carry = 0;
+    int i;
+    NK_ASSERT(m <= 0xFFFF);
+    for (i = 0; i < b->n; ++i) {
+        carry += (nk_uint)b->d[i] * m;
+        b->d[i] = (nk_ushort)(carry & 0xFFFF);
+        carry >>= 16;
+    }
+    if (carry) {
+        NK_ASSERT(b->n < NK_BIGNUM_LIMBS);
+        b->d[b->n++] = (nk_ushort)carry;
+    }
+}
+NK_INTERN void
+nk_bignum_mul_pow10(struct nk_bignum *b, int k)
+{
+    NK_ASSERT(k >= 0);
+    for (; k >= 4; k -= 4)
+        nk_bignum_mul(b, 10000);
+    if (k) nk_bignum_mul(b, (nk_uint)nk_pow10_table[k]);
+}
+NK_INTERN void
+nk_bignum_shl(struct nk_bignum *b, int bits)
+{
+    int i, limbs = bits / 16;
+    bits %= 16;
+    if (!b->n) return;
+    if (bits) {
+        nk_uint carry = 0;
+        for (i = 0; i < b->n; ++i) {
+            carry |= (nk_uint)b->d[i] << bits;
+            b->d[i] = (nk_ushort)(carry & 0xFFFF);
+            carry >>= 16;
+        }
+        if (carry) {
+            NK_ASSERT(b->n < NK_BIGNUM_LIMBS);
+            b->d[b->n++] = (nk_ushort)carry;
+        }
+    }
+    if (limbs) {
+        NK_ASSERT(b->n + limbs <= NK_BIGNUM_LIMBS);
+        for (i = b->n-1; i >= 0; --i)
+            b->d[i + limbs] = b->d[i];
+        for (i = 0; i < limbs; ++i)
+            b->d[i] = 0;
+        b->n += limbs;
+    }
+}
+NK_INTERN int
+nk_bignum_cmp(const struct nk_bignum *a, const struct nk_bignum *b)
+{
+    int i;
+    if (a->n != b->n)
+        return (a->n < b->n) ? -1: 1;
+    for (i = a->n-1; i >= 0; --i) {
+        if (a->d[i] != b->d[i])
+            return (a->d[i] < b->d[i]) ? -1: 1;
+    }
+    return 0;
+}
+NK_INTERN void
+nk_bignum_add(struct nk_bignum *r, const struct nk_bignum *a, const struct nk_bignum *b)
+{
+    nk_uint carry = 0;
+    int i, n = NK_MAX(a->n, b->n);
+    for (i = 0; i < n; ++i) {
+        if (i < a->n) carry += a->d[i];
+        if (i < b->n) carry += b->d[i];
+        r->d[i] = (nk_ushort)(carry & 0xFFFF);
+        carry >>= 16;
+    }
+    if (carry) {
+        NK_ASSERT(n < NK_BIGNUM_LIMBS);
+        r->d[n++] = (nk_ushort)carry;
+    }
+    r->n = n;
+}
+NK_INTERN void
+nk_bignum_sub(struct nk_bignum *a, const struct nk_bignum *b)
+{
+    /* `a` has to be larger than or equal to `b` */
+    nk_int borrow = 0;
+    int i;
+    for (i = 0; i < a->n && (i < b->n || borrow); ++i) {
+        nk_int t = (nk_int)a->d[i] - borrow;
+        if (i < b->n) t -= b->d[i];
+        borrow = (t < 0);
+        a->d[i] = (nk_ushort)(t + (borrow << 16));
+    }
+    nk_bignum_trim(a);
+}
+NK_INTERN int
+nk_bignum_digit(struct nk_bignum *r, const struct nk_bignum *s)
+{
+    /* returns floor(r/s) for r < 10*s and leaves the remainder in `r`. With
+     * the top bit of `s` set the quotient estimate is at most two short. */
+    nk_uint top, q, carry = 0;
+    nk_int borrow = 0;
+    int i, n = s->n;
+    NK_ASSERT(n > 0);
+    if (r->n < n) return 0;
+    top = r->d[n-1];
+    if (r->n > n) top |= (nk_uint)r->d[n] << 16;
+    q = top / ((nk_uint)s->d[n-1] + 1);
+    if (q) {
+        for (i = 0; i < r->n; ++i) {
+            nk_int t;
+            if (i < n) carry += (nk_uint)s->d[i] * q;
+            t = (nk_int)r->d[i] - (nk_int)(carry & 0xFFFF) - borrow;
+            carry >>= 16;
+            borrow = (t < 0);
+            r->d[i] = (nk_ushort)(t + (borrow << 16));
+        }
+        nk_bignum_trim(r);
+    }
+    while (nk_bignum_cmp(r, s) >= 0) {
+        nk_bignum_sub(r, s);
+        q++;
+    }
+    return (int)q;
+}
+NK_INTERN int
+nk_bignum_norm(const struct nk_bignum *s)
+{
+    /* number of bits to shift `s` up by until its top limb has the high bit set */
+    nk_uint top = s->d[s->n-1];
+    int bits = 0;
+    for (; !(top & 0x8000); top <<= 1)
+        bits++;
+    return bits;
+}
+NK_INTERN int
+nk_dtoa_estimate(int e)
+{
+    /* ceil(e * log10(2)): for a value in [2^e, 2^(e+1)) this is either its
+     * decimal exponent or one short of it */
+    double x = (double)e * 0.30102999566398114 - 1e-10;
+    int k = (int)x;
+    return ((double)k < x) ? k + 1: k;
+}
+NK_INTERN void
+nk_dtoa_pow2(double *pow2)
+{
+    /* pow2[i] = 2^(2^i) up to 2^512 */
+    int i;
+    pow2[0] = 2.0;
+    for (i = 1; i < 10; ++i)
+        pow2[i] = pow2[i-1] * pow2[i-1];
+}
+NK_INTERN int
+nk_dtoa_split(double v, nk_uint *hi, nk_uint *lo)
+{
+    /* splits finite `v` > 0 into f * 2^e with f < 2^53, returns e. f is at
+     * least 2^52 unless `v` is subnormal in which case e is -1074. */
+    const double lo_bound = 4503599627370496.0; /* 2^52 */
+    const double hi_bound = 9007199254740992.0; /* 2^53 */
+    double pow2[10];
+    int i, e = 0;
+
+    nk_dtoa_pow2(pow2);
+    if (v * pow2[9] * (pow2[9] / 4.0) < 1.0) {
+        const double scale = pow2[9] * pow2[4] * pow2[3] * pow2[0]; /* 2^537 */
+        v = v * scale * scale;
+        e = -1074;
+    } else if (v >= lo_bound) {
+        for (i = 9; i >= 0; --i) {
+            while (v >= lo_bound * pow2[i]) {
+                v /= pow2[i];
+                e += 1 << i;
+            }
+        }
+    } else {
+        for (i = 9; i >= 0; --i) {
+            while (v * pow2[i] < hi_bound) {
+                v *= pow2[i];
+                e -= 1 << i;
+            }
+        }
+    }
+    *hi = (nk_uint)(v / 4294967296.0);
+    *lo = (nk_uint)(v - (double)*hi * 4294967296.0);
+    return e;
+}
+NK_INTERN int
+nk_dtoa_signbit(double n)
+{
+    /* 1.0 and -1.0 only differ in the sign bit, which finds it without
+     * knowing the byte order and also works for zero and nan */
+    NK_STORAGE const double pos = 1.0, neg = -1.0;
+    unsigned char a[sizeof(double)], b[sizeof(double)], c[sizeof(double)];
+    int i;
+    NK_MEMCPY(a, &pos, sizeof(double));
+    NK_MEMCPY(b, &neg, sizeof(double));
+    NK_MEMCPY(c, &n, sizeof(double));
+    for (i = 0; i < (int)sizeof(double); ++i)
+        if (a[i] != b[i]) return (c[i] & (a[i] ^ b[i])) != 0;
+    return n < 0;
+}
+NK_INTERN double
+nk_dtoa_join(nk_uint hi, nk_uint lo, int e)
+{
+    /* f * 2^e: exact for every double and infinity once it does not fit */
+    double pow2[10];
+    double v = (double)hi * 4294967296.0 + (double)lo;
+    int i;
+    nk_dtoa_pow2(pow2);
+    for (i = 9; i >= 0; --i) {
+        for (; e >= (1 << i); e -= 1 << i)
+            v *= pow2[i];
+        for (; -e >= (1 << i); e += 1 << i)
+            v /= pow2[i];
+    }
+    return v;
+}
+NK_INTERN int
+nk_dtoa_round(double *y)
+{
+    /* rounds 0 <= y < 2^52 to the nearest integer, fails on an exact tie */
+    nk_uint hi = (nk_uint)(*y / 4294967296.0);
+    double i = (double)hi * 4294967296.0;
+    double frac;
+    i += (double)(nk_uint)(*y - i);
+    frac = *y - i;
+    if (frac == 0.5) return 0;
+    *y = (frac > 0.5) ? i + 1.0: i;
+    return 1;
+}
+NK_INTERN int
+nk_dtoa_integer(char *digits, double y)
+{
+    /* decimal digits of the integer 0 < y < 2^53 */
+    char tmp[20];
+    double top = (double)(nk_uint)(y / 1e9);
+    double rest = y - top * 1e9;
+    nk_uint hi, lo;
+    int i, n = 0;
+    if (rest < 0) {
+        top -= 1.0;
+        rest += 1e9;
+    } else if (rest >= 1e9) {
+        top += 1.0;
+        rest -= 1e9;
+    }
+    hi = (nk_uint)top;
+    lo = (nk_uint)rest;
+    for (; lo || (hi && n < 9); lo /= 10)
+        tmp[n++] = (char)('0' + lo % 10);
+    for (; hi; hi /= 10)
+        tmp[n++] = (char)('0' + hi % 10);
+    for (i = 0; i < n; ++i)
+        digits[i] = tmp[n-1-i];
+    return n;
+}
+NK_INTERN int
+nk_dtoa_fast(char *digits, int *point, double n, enum nk_dtoa_mode mode, int prec)
+{
+    /* A single correctly rounded multiplication or division by an exact power
+     * of ten stays on the same side of every half-integer as the exact scaled
+     * value unless it lands on one, so rounding it to an integer gives the
+     * correctly rounded digits. Returns -1 wherever that does not apply. */
+    const double limit = 4503599627370496.0; /* 2^52 */
+    int i, k = 0, count, scale = prec;
+    double y;
+
+    if (mode == NK_DTOA_PRECISION) {
+        /* 10^(k-1) <= n < 10^k, estimated here and corrected below */
+        if (prec > 15) return -1;
+        if (n >= 1.0) {
+            for (k = 1; k < 23 && n >= nk_pow10_table[k]; ++k);
+        } else {
+            for (k = 0; k > -22 && n * nk_pow10_table[1-k] < 1.0; --k);
+        }
+        scale = prec - k;
+    }
+    for (i = 0; i < 3; ++i) {
+        if (scale > 22 || scale < -22) return -1;
+        if (scale >= 0)
+            y = n * nk_pow10_table[scale];
+        else y = n / nk_pow10_table[-scale];
+        if (y >= limit || !nk_dtoa_round(&y)) return -1;
+        if (mode != NK_DTOA_PRECISION) break;
+        if (y < nk_pow10_table[prec-1]) scale++;
+        else if (y > nk_pow10_table[prec]) scale--;
+        else break;
+    }
+    if (i == 3) return -1;
+    if (y == 0) return 0;
+    count = nk_dtoa_integer(digits, y);
+    *point = count - scale;
+    /* a carry into a new leading digit only adds a trailing zero */
+    return (mode == NK_DTOA_PRECISION) ? NK_MIN(count, prec): count;
+}
+NK_LIB int
+nk_dtoa_digits(char *digits, int max, int *point, double n,
+    enum nk_dtoa_mode mode, int prec)
+{
+    struct nk_bignum r, s, mp, mm, t;
+    nk_uint hi, lo;
+    int i, d, e, k, even, count = 0;
+
+    NK_ASSERT(digits);
+    NK_ASSERT(point);
+    NK_ASSERT(n >= 0);
+    NK_ASSERT(max >= 17 || mode != NK_DTOA_SHORTEST);
+    *point = 1;
+    if (n <= 0) return 0;
+    if (mode != NK_DTOA_SHORTEST) {
+        count = nk_dtoa_fast(digits, point, n, mode, prec);
+        if (count >= 0 && count <= max) return count;
+    }
+
+    /* n = r/s with the distance to both neighbours at mm/s and mp/s. The gap
+     * below the smallest significand of a binade is half the one above it. */
+    e = nk_dtoa_split(n, &hi, &lo);
+    even = !(lo & 1);
+    nk_bignum_set(&r, hi, lo);
+    k = nk_dtoa_estimate(e + nk_bignum_bits(&r) - 1);
+    nk_bignum_set(&s, 0, 1);
+    nk_bignum_set(&mp, 0, 1);
+    if (e >= 0) nk_bignum_shl(&mp, e);
+    mm = mp;
+    if (hi == 0x100000 && !lo && e > -1074) {
+        nk_bignum_shl(&r, 2);
+        nk_bignum_shl(&s, 2);
+        nk_bignum_shl(&mp, 1);
+    } else {
+        nk_bignum_shl(&r, 1);
+        nk_bignum_shl(&s, 1);
+    }
+    if (e >= 0) nk_bignum_shl(&r, e);
+    else nk_bignum_shl(&s, -e);
+
+    /* scale by the estimated decimal exponent and correct it if short */
+    if (k >= 0) nk_bignum_mul_pow10(&s, k);
+    else {
+        nk_bignum_mul_pow10(&r, -k);
+        if (mode == NK_DTOA_SHORTEST) {
+            nk_bignum_mul_pow10(&mp, -k);
+            nk_bignum_mul_pow10(&mm, -k);
+        }
+    }
+    if (mode == NK_DTOA_SHORTEST)
+        nk_bignum_add(&t, &r, &mp);
+    else t = r;
+    d = nk_bignum_cmp(&t, &s);
+    if (d > 0 || (d == 0 && (even || mode != NK_DTOA_SHORTEST))) {
+        nk_bignum_mul(&s, 10);
+        k++;
+    }
+    d = nk_bignum_norm(&s);
+    nk_bignum_shl(&s, d);
+    nk_bignum_shl(&r, d);
+    *point = k;
+
+    if (mode == NK_DTOA_SHORTEST) {
+        /* stop as soon as the digits emitted so far identify `n` */
+        int low, high;
+        nk_bignum_shl(&mp, d);
+        nk_bignum_shl(&mm, d);
+        for (;;) {
+            nk_bignum_mul(&r, 10);
+            nk_bignum_mul(&mp, 10);
+            nk_bignum_mul(&mm, 10);
+            d = nk_bignum_digit(&r, &s);
+            i = nk_bignum_cmp(&r, &mm);
+            low = (i < 0 || (i == 0 && even));
+            nk_bignum_add(&t, &r, &mp);
+            i = nk_bignum_cmp(&t, &s);
+            high = (i > 0 || (i == 0 && even));
+            if (low || high) break;
+            digits[count++] = (char)('0' + d);
+        }
+        if (high && low) {
+            nk_bignum_shl(&r, 1);
+            high = (nk_bignum_cmp(&r, &s) >= 0);
+        }
+        digits[count++] = (char)('0' + d + high);
+        return count;
+    }
+
+    /* fixed number of digits, rounded half to even on the exact remainder.
+     * Digits past `max` are rounded away and read back as zeros. */
+    count = (mode == NK_DTOA_FIXED) ? k + prec: prec;
+    count = NK_MIN(count, max);
+    if (count < 0) return 0;
+    for (i = 0; i < count; ++i) {
+        nk_bignum_mul(&r, 10);
+        digits[i] = (char)('0' + nk_bignum_digit(&r, &s));
+    }
+    nk_bignum_shl(&r, 1);
+    d = nk_bignum_cmp(&r, &s);
+    if (d > 0 || (d == 0 && count && (digits[count-1] & 1))) {
+        for (i = count-1; i >= 0 && digits[i] == '9'; --i)
+            digits[i] = '0';
+        if (i >= 0) digits[i]++;
+        else {
+            /* carried out of the first digit */
+            *point = k + 1;
+            if (!count || (mode == NK_DTOA_FIXED && count < max))
+                digits[count++] = '0';
+            digits[0] = '1';
+        }
+    }
+    return count;
+}
+NK_INTERN int
+nk_strtod_cmp(const char *digits, int count, int exp10, struct nk_bignum *r, int e)
+{
+    /* compares 0.d1d2..dn * 10^exp10 with r * 2^e exactly by generating the
+     * decimal expansion of the latter until the two differ */
+    struct nk_bignum s;
+    int i, d, c, k;
+
+    k = nk_dtoa_estimate(e + nk_bignum_bits(r) - 1);
+    nk_bignum_set(&s, 0, 1);
+    if (e >= 0) nk_bignum_shl(r, e);
+    else nk_bignum_shl(&s, -e);
+    if (k >= 0) nk_bignum_mul_pow10(&s, k);
+    else nk_bignum_mul_pow10(r, -k);
+    if (nk_bignum_cmp(r, &s) >= 0) {
+        nk_bignum_mul(&s, 10);
+        k++;
+    }
+    if (k != exp10)
+        return (exp10 > k) ? 1: -1;
+
+    d = nk_bignum_norm(&s);
+    nk_bignum_shl(&s, d);
+    nk_bignum_shl(r, d);
+    for (i = 0; i < count; ++i, ++digits) {
+        if (*digits == '.') digits++;
+        nk_bignum_mul(r, 10);
+        d = nk_bignum_digit(r, &s);
+        c = *digits - '0';
+        if (c != d) return (c > d) ? 1: -1;
+    }
+    return r->n ? -1: 0;
+}
+NK_INTERN double
+nk_strtod_slow(const char *digits, int count, int exp10, double approx)
+{
+    /* walks a close approximation one ulp at a time until the decimal input
+     * lies between the midpoints to both of its neighbours */
+    struct nk_bignum m;
+    nk_uint hi, lo, phi, plo;
+    int e, c;
+
+    if (approx == 0) {
+        hi = lo = 0;
+        e = -1074;
+    } else if (approx - approx != 0) {
+        hi = 0x1FFFFF; lo = 0xFFFFFFFF;
+        e = 971;
+    } else e = nk_dtoa_split(approx, &hi, &lo);
+
+    for (;;) {
+        /* upper midpoint: (2f + 1) * 2^(e-1) */
+        nk_bignum_set(&m, hi << 1 | lo >> 31, lo << 1 | 1);
+        c = nk_strtod_cmp(digits, count, exp10, &m, e - 1);
+        if (c > 0 || (c == 0 && (lo & 1))) {
+            if (!++lo) hi++;
+            if (hi == 0x200000) {
+                hi = 0x100000;
+                e++;
+            }
+            if (e > 971) break;
+            continue;
+        }
+        if (!hi && !lo) break;
+
+        /* lower midpoint: (2f - 1) * 2^(e-1) or (4f - 1) * 2^(e-2) */
+        plo = lo - 1;
+        phi = lo ? hi: hi - 1;
+        if (hi == 0x100000 && !lo && e > -1074) {
+            nk_bignum_set(&m, phi << 2 | plo >> 30, plo << 2 | 3);
+            c = nk_strtod_cmp(digits, count, exp10, &m, e - 2);
+        } else {
+            nk_bignum_set(&m, phi << 1 | plo >> 31, plo << 1 | 1);
+            c = nk_strtod_cmp(digits, count, exp10, &m, e - 1);
+        }
+        if (c < 0 || (c == 0 && (lo & 1))) {
+            if (hi == 0x100000 && !lo && e > -1074) {
+                hi = 0x1FFFFF; lo = 0xFFFFFFFF;
+                e--;
+            } else {
+                hi = phi; lo = plo;
+            }
+            continue;
+        }
+        break;
+    }
+    return nk_dtoa_join(hi, lo, e);
+}
 NK_API double
 nk_strtod(const char *str, char **endptr)
 {
-    double m;
-    double neg = 1.0;
-    char *p = (char *)str;
-    double value = 0;
-    double number = 0;
+    const char *p = str, *digits = 0;
+    double value = 0, mant = 0, exact = 0;
+    int neg = 0, dot = 0, any = 0;
+    int total = 0, count = 0, exp10 = 0;
 
     NK_ASSERT(str);
     if (!str) return 0;
 
     /* skip whitespace */
     while (*p == ' ') p++;
-    if (*p == '-') {
-        neg = -1.0;
-        p++;
-    }
+    if (*p == '-' || *p == '+')
+        neg = (*p++ == '-');
 
-    while (*p && *p != '.' && *p != 'e') {
-        value = value * 10.0 + (double) (*p - '0');
-        p++;
-    }
-
-    if (*p == '.') {
-        p++;
-        for(m = 0.1; *p && *p != 'e'; p++ ) {
-            value = value + (double) (*p - '0') * m;
-            m *= 0.1;
+    /* significant digits: 0.d1d2..dn * 10^exp10 with trailing zeros cut */
+    for (;; ++p) {
+        if (*p == '.' && !dot) {
+            dot = 1;
+            continue;
+        }
+        if (*p < '0' || *p > '9') break;
+        any = 1;
+        if (!digits) {
+            if (*p == '0') {
+                exp10 -= dot;
+                continue;
+            }
+            digits = p;
+        }
+        total++;
+        if (!dot) exp10++;
+        if (total <= 19)
+            mant = mant * 10.0 + (double)(*p - '0');
+        if (*p != '0') {
+            count = total;
+            exact = mant;
         }
     }
-    if (*p == 'e') {
-        int i, pow, div;
-        p++;
-        if (*p == '-') {
-            div = nk_true;
-            p++;
-        } else if (*p == '+') {
-            div = nk_false;
-            p++;
-        } else div = nk_false;
-
-        for (pow = 0; *p; p++)
-            pow = pow * 10 + (int) (*p - '0');
-
-        for (m = 1.0, i = 0; i < pow; i++)
-            m *= 10.0;
-
-        if (div)
-            value /= m;
-        else value *= m;
+    if (!any) {
+        /* no digits: infinity, nan or no conversion at all */
+        if (!nk_stricmpn(p, "inf", 3)) {
+            p += nk_stricmpn(p + 3, "inity", 5) ? 3: 8;
+            value = nk_dtoa_join(0x100000, 0, 972);
+        } else if (!nk_stricmpn(p, "nan", 3)) {
+            p += 3;
+            value = nk_dtoa_join(0x100000, 0, 972);
+            value -= value;
+            /* infinity minus infinity may come out negative */
+            if (nk_dtoa_signbit(value))
+                value = -value;
+        } else p = str;
+        if (endptr) *endptr = (char*)p;
+        return neg ? -value: value;
+    }
+    if (*p == 'e' || *p == 'E') {
+        const char *q = p + 1;
+        int exp_neg = 0, exp = 0;
+        if (*q == '-' || *q == '+')
+            exp_neg = (*q++ == '-');
+        if (*q >= '0' && *q <= '9') {
+            for (; *q >= '0' && *q <= '9'; ++q)
+                if (exp < 100000) exp = exp * 10 + (*q - '0');
+            exp10 += exp_neg ? -exp: exp;
+            p = q;
+        }
     }
-    number = value * neg;
     if (endptr)
-        *endptr = p;
-    return number;
+        *endptr = (char*)p;
+
+    if (!count || exp10 < -323) {
+        value = 0;
+    } else if (exp10 > 309) {
+        value = nk_dtoa_join(0x100000, 0, 972);
+    } else if (count <= 15 && exp10 - count <= 22 && exp10 - count >= -22) {
+        /* both operands are exact so the single rounding is correct */
+        if (exp10 >= count)
+            value = exact * nk_pow10_table[exp10 - count];
+        else value = exact / nk_pow10_table[count - exp10];
+    } else {
+        int scale = exp10 - NK_MIN(total, 19);
+        for (value = mant; scale > 22; scale -= 22)
+            value *= 1e22;
+        for (; scale < -22; scale += 22)
+            value /= 1e22;
+        if (scale >= 0)
+            value *= nk_pow10_table[scale];
+        else value /= nk_pow10_table[-scale];
+        value = nk_strtod_slow(digits, count, exp10, value);
+    }
+    return neg ? -value: value;
 }
 NK_API float
 nk_strtof(const char *str, char **endptr)
@@ -499,87 +1073,121 @@ nk_itoa(char *s, long n)
     nk_strrev_ascii(s);
     return s;
 }
+NK_INTERN int
+nk_dtoa_special(char *s, double n)
+{
+    /* nan and infinity have no digits to generate */
+    const char *str;
+    int len = 0;
+    if (n != n) str = "nan";
+    else if (n - n == 0) return 0;
+    else str = (n < 0) ? "-inf": "inf";
+    while (*str) s[len++] = *str++;
+    s[len] = '\0';
+    return len;
+}
+NK_INTERN int
+nk_dtoa_plain(char *s, const char *digits, int count, int point, int frac)
+{
+    /* writes 0.d1d2..dn * 10^point with exactly `frac` fractional digits */
+    int i, len = 0;
+    if (point <= 0)
+        s[len++] = '0';
+    for (i = 0; i < point; ++i)
+        s[len++] = (i < count) ? digits[i]: '0';
+    if (frac > 0)
+        s[len++] = '.';
+    for (i = point; i < point + frac; ++i)
+        s[len++] = (i >= 0 && i < count) ? digits[i]: '0';
+    s[len] = '\0';
+    return len;
+}
+NK_INTERN int
+nk_dtoa_exp(char *s, const char *digits, int count, int point, int frac,
+    int dot, char e)
+{
+    /* writes d.dd..e+XX with exactly `frac` fractional digits. The decimal
+     * point is also written without fractional digits if `dot` is set */
+    int i, len = 0;
+    int exp = (count) ? point - 1: 0;
+    s[len++] = (count) ? digits[0]: '0';
+    if (frac > 0 || dot)
+        s[len++] = '.';
+    for (i = 1; i <= frac; ++i)
+        s[len++] = (i < count) ? digits[i]: '0';
+    s[len++] = e;
+    s[len++] = (exp < 0) ? '-': '+';
+    if (exp < 0) exp = -exp;
+    if (exp >= 100)
+        s[len++] = (char)('0' + exp / 100);
+    s[len++] = (char)('0' + exp / 10 % 10);
+    s[len++] = (char)('0' + exp % 10);
+    s[len] = '\0';
+    return len;
+}
 #ifndef NK_DTOA
 #define NK_DTOA nk_dtoa
 NK_LIB char*
 nk_dtoa(char *s, double n)
 {
-    int useExp = 0;
-    int digit = 0, m = 0, m1 = 0;
+    /* shortest string that reads back as `n` */
+    char digits[NK_DTOA_DIGITS];
+    int count, point;
     char *c = s;
-    int neg = 0;
 
     NK_ASSERT(s);
     if (!s) return 0;
-
-    if (n == 0.0) {
-        s[0] = '0'; s[1] = '\0';
+    if (nk_dtoa_special(s, n))
         return s;
+    if (n < 0) {
+        *(c++) = '-';
+        n = -n;
     }
+    count = nk_dtoa_digits(digits, NK_DTOA_DIGITS, &point, n, NK_DTOA_SHORTEST, 0);
+    if (point > 14 || point < -7)
+        nk_dtoa_exp(c, digits, count, point, count-1, nk_false, 'e');
+    else nk_dtoa_plain(c, digits, count, point, NK_MAX(count - point, 0));
+    return s;
+}
+#endif
+NK_LIB int
+nk_dtoa_fixed(char *s, double n, int prec)
+{
+    /* `n` correctly rounded to at most `prec` fractional digits without
+     * trailing zeros. Magnitudes of 1e15 and up are left to NK_DTOA. */
+#ifdef NK_DTOA_USER_DEFINED
+    /* a user supplied conversion is only cut down to `prec` digits */
+    NK_ASSERT(s);
+    if (!s) return 0;
+    NK_DTOA(s, n);
+    return nk_string_float_limit(s, prec);
+#else
+    char digits[NK_MAX_NUMBER_BUFFER];
+    int len = 0, count, point;
 
-    neg = (n < 0);
-    if (neg) n = -n;
-
-    /* calculate magnitude */
-    m = nk_log10(n);
-    useExp = (m >= 14 || (neg && m >= 9) || m <= -9);
-    if (neg) *(c++) = '-';
-
-    /* set up for scientific notation */
-    if (useExp) {
-        if (m < 0)
-           m -= 1;
-        n = n / (double)nk_pow(10.0, m);
-        m1 = m;
-        m = 0;
-    }
-    if (m < 1.0) {
-        m = 0;
+    NK_ASSERT(s);
+    NK_ASSERT(prec >= 0 && prec <= NK_MAX_NUMBER_BUFFER - 20);
+    if (!s) return 0;
+    if ((len = nk_dtoa_special(s, n)) != 0)
+        return len;
+    if (n >= 1e15 || n <= -1e15) {
+        NK_DTOA(s, n);
+        return nk_strlen(s);
     }
-
-    /* convert the number */
-    while (n > NK_FLOAT_PRECISION || m >= 0) {
-        double weight = nk_pow(10.0, m);
-        if (weight > 0) {
-            double t = (double)n / weight;
-            digit = nk_ifloord(t);
-            n -= ((double)digit * weight);
-            *(c++) = (char)('0' + (char)digit);
-        }
-        if (m == 0 && n > 0)
-            *(c++) = '.';
-        m--;
+    if (n < 0) {
+        s[len++] = '-';
+        n = -n;
     }
-
-    if (useExp) {
-        /* convert the exponent */
-        int i, j;
-        *(c++) = 'e';
-        if (m1 > 0) {
-            *(c++) = '+';
-        } else {
-            *(c++) = '-';
-            m1 = -m1;
-        }
-        m = 0;
-        while (m1 > 0) {
-            *(c++) = (char)('0' + (char)(m1 % 10));
-            m1 /= 10;
-            m++;
-        }
-        c -= m;
-        for (i = 0, j = m-1; i<j; i++, j--) {
-            /* swap without temporary */
-            c[i] ^= c[j];
-            c[j] ^= c[i];
-            c[i] ^= c[j];
-        }
-        c += m;
+    count = nk_dtoa_digits(digits, (int)sizeof(digits), &point, n, NK_DTOA_FIXED, prec);
+    while (count > 0 && digits[count-1] == '0')
+        count--;
+    if (!count) {
+        s[0] = '0'; s[1] = '\0';
+        return 1;
     }
-    *(c) = '\0';
-    return s;
-}
+    return len + nk_dtoa_plain(s + len, digits, count, point, NK_MAX(count - point, 0));
 #endif
+}
 #ifdef NK_INCLUDE_STANDARD_VARARGS
 #ifndef NK_INCLUDE_STANDARD_IO
 NK_INTERN int
@@ -827,31 +1435,69 @@ nk_vsnprintf(char *buf, int buf_size, const char *fmt, va_list args)
                 while ((padding-- > 0) && (len < buf_size))
                     buf[len++] = ' ';
             }
-        } else if (*iter == 'f') {
-            /* floating point */
-            const char *num_iter;
-            int cur_precision = (precision < 0) ? 6: precision;
-            int prefix, cur_width = NK_MAX(width, 0);
+        } else if (*iter == 'f' || *iter == 'e' || *iter == 'E' ||
+                   *iter == 'g' || *iter == 'G') {
+            /* floating point: digits are correctly rounded, numbers that do
+             * not fit the number buffer in `f` notation fall back to `e` */
+            char digits[NK_MAX_NUMBER_BUFFER];
+            const char *num_iter = number_buffer;
+            int cur_precision = (precision < 0) ? 6: NK_MIN(precision, NK_MAX_NUMBER_BUFFER/2);
+            int cur_width = NK_MAX(width, 0);
             double value = va_arg(args, double);
-            int num_len = 0, frac_len = 0, dot = 0;
-            int padding = 0;
+            int num_len = 0, count, point, padding;
+            char spec = *iter;
 
             NK_ASSERT(arg_type == NK_ARG_TYPE_DEFAULT);
-            NK_DTOA(number_buffer, value);
-            num_len = nk_strlen(number_buffer);
-
-            /* calculate padding */
-            num_iter = number_buffer;
-            while (*num_iter && *num_iter != '.')
-                num_iter++;
-
-            prefix = (*num_iter == '.')?(int)(num_iter - number_buffer)+1:0;
-            padding = NK_MAX(cur_width - (prefix + NK_MIN(cur_precision, num_len - prefix)) , 0);
-            if ((flag & NK_ARG_FLAG_PLUS) || (flag & NK_ARG_FLAG_SPACE))
-                padding = NK_MAX(padding-1, 0);
+            if (nk_dtoa_signbit(value)) {
+                /* includes negative zero */
+                number_buffer[num_len++] = '-';
+                value = -value;
+            } else if (flag & NK_ARG_FLAG_PLUS) {
+                number_buffer[num_len++] = '+';
+            } else if (flag & NK_ARG_FLAG_SPACE) {
+                number_buffer[num_len++] = ' ';
+            }
+            if (nk_dtoa_special(number_buffer + num_len, value)) {
+                num_len = nk_strlen(number_buffer);
+                flag &= ~(nk_flags)NK_ARG_FLAG_ZERO;
+            } else if (spec == 'f' && value < 1e25) {
+                count = nk_dtoa_digits(digits, NK_MAX_NUMBER_BUFFER, &point, value, NK_DTOA_FIXED, cur_precision);
+                num_len += nk_dtoa_plain(number_buffer + num_len, digits, count, point, cur_precision);
+                if (!cur_precision && (flag & NK_ARG_FLAG_NUM)) {
+                    number_buffer[num_len++] = '.';
+                    number_buffer[num_len] = '\0';
+                }
+            } else if (spec == 'g' || spec == 'G') {
+                int sig = NK_MAX(cur_precision, 1), exp;
+                count = nk_dtoa_digits(digits, NK_MAX_NUMBER_BUFFER, &point, value, NK_DTOA_PRECISION, sig);
+                exp = point - 1;
+                if (!(flag & NK_ARG_FLAG_NUM)) {
+                    while (count > 0 && digits[count-1] == '0')
+                        count--;
+                }
+                if (exp < -4 || exp >= sig) {
+                    num_len += nk_dtoa_exp(number_buffer + num_len, digits, count, point,
+                        (flag & NK_ARG_FLAG_NUM) ? sig - 1: NK_MAX(count - 1, 0),
+                        (flag & NK_ARG_FLAG_NUM) != 0, (spec == 'G') ? 'E': 'e');
+                } else {
+                    num_len += nk_dtoa_plain(number_buffer + num_len, digits, count, point,
+                        (flag & NK_ARG_FLAG_NUM) ? sig - 1 - exp: NK_MAX(count - point, 0));
+                    if (sig - 1 == exp && (flag & NK_ARG_FLAG_NUM)) {
+                        number_buffer[num_len++] = '.';
+                        number_buffer[num_len] = '\0';
+                    }
+                }
+            } else {
+                count = nk_dtoa_digits(digits, NK_MAX_NUMBER_BUFFER, &point, value, NK_DTOA_PRECISION, cur_precision + 1);
+                num_len += nk_dtoa_exp(number_buffer + num_len, digits, count, point,
+                    cur_precision, (flag & NK_ARG_FLAG_NUM) != 0, (spec == 'E') ? 'E': 'e');
+            }
+            padding = NK_MAX(cur_width - num_len, 0);
 
             /* fill left padding up to a total of `width` characters */
             if (!(flag & NK_ARG_FLAG_LEFT)) {
+                if ((flag & NK_ARG_FLAG_ZERO) && (*num_iter < '0') && (len < buf_size))
+                    buf[len++] = *num_iter++;
                 while (padding-- > 0 && (len < buf_size)) {
                     if (flag & NK_ARG_FLAG_ZERO)
                         buf[len++] = '0';
@@ -860,30 +1506,8 @@ nk_vsnprintf(char *buf, int buf_size, const char *fmt, va_list args)
             }
 
             /* copy string value representation into buffer */
-            num_iter = number_buffer;
-            if ((flag & NK_ARG_FLAG_PLUS) && (value >= 0) && (len < buf_size))
-                buf[len++] = '+';
-            else if ((flag & NK_ARG_FLAG_SPACE) && (value >= 0) && (len < buf_size))
-                buf[len++] = ' ';
-            while (*num_iter) {
-                if (dot) frac_len++;
-                if (len < buf_size)
-                    buf[len++] = *num_iter;
-                if (*num_iter == '.') dot = 1;
-                if (frac_len >= cur_precision) break;
-                num_iter++;
-            }
-
-            /* fill number up to precision */
-            while (frac_len < cur_precision) {
-                if (!dot && len < buf_size) {
-                    buf[len++] = '.';
-                    dot = 1;
-                }
-                if (len < buf_size)
-                    buf[len++] = '0';
-                frac_len++;
-            }
+            while (*num_iter && (len < buf_size))
+                buf[len++] = *num_iter++;
 
             /* fill right padding up to width characters */
             if (flag & NK_ARG_FLAG_LEFT) {
@@ -891,7 +1515,7 @@ nk_vsnprintf(char *buf, int buf_size, const char *fmt, va_list args)
                     buf[len++] = ' ';
             }
         } else {
-            /* Specifier not supported: g,G,e,E,p,z */
+            /* Specifier not supported: p,z */
             NK_ASSERT(0 && "specifier is not supported!");
             return result;
         }
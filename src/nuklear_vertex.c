@@ -14,11 +14,13 @@ nk_draw_list_init(struct nk_draw_list *list)
     NK_ASSERT(list);
     if (!list) return;
     nk_zero(list, sizeof(*list));
-    for (i = 0; i < NK_LEN(list->circle_vtx); ++i) {
-        const float a = ((float)i / (float)NK_LEN(list->circle_vtx)) * 2 * NK_PI;
-        list->circle_vtx[i].x = (float)NK_COS(a);
-        list->circle_vtx[i].y = (float)NK_SIN(a);
+    for (i = 0; i < NK_LEN(list->circle_table); ++i) {
+        const float a = ((float)i / (float)NK_LEN(list->circle_table)) * 2 * NK_PI;
+        list->circle_table[i].x = (float)NK_COS(a);
+        list->circle_table[i].y = (float)NK_SIN(a);
     }
+    for (i = 0; i < NK_LEN(list->circle_vtx); ++i)
+        list->circle_vtx[i] = list->circle_table[i * (NK_LEN(list->circle_table)/NK_LEN(list->circle_vtx))];
 }
 NK_API void
 nk_draw_list_setup(struct nk_draw_list *canvas, const struct nk_convert_config *config,
@@ -819,6 +821,100 @@ nk_draw_list_path_arc_to_fast(struct nk_draw_list *list, struct nk_vec2 center,
         }
     }
 }
+NK_INTERN float
+nk_draw_list_circle_error_segments(const struct nk_draw_list *list, float radius)
+{
+    /* A chord spanning the angle `a` deviates at most r*(1-cos(a/2)) <= r*a*a/8
+     * from its circle, so PI*sqrt(r/(2*e)) segments per full circle keep the
+     * outline within the configured error `e`. */
+    float n;
+    NK_ASSERT(list->config.max_segment_error > 0.0f);
+    if (radius <= 0.0f) return 1.0f;
+    n = radius / (2.0f * list->config.max_segment_error);
+    return NK_PI * n * NK_INV_SQRT(n);
+}
+NK_INTERN unsigned int
+nk_draw_list_circle_table_stride(const struct nk_draw_list *list, float radius,
+    unsigned int span)
+{
+    /* returns the distance in circle table entries between two points so that
+     * `span` entries are split into evenly spaced segments which still stay
+     * within the configured error. At least three segments are used so tiny
+     * circles and corners do not collapse into a point or a line */
+    unsigned int count;
+    float n = nk_draw_list_circle_error_segments(list, radius);
+    n = n * (float)span / (float)NK_DRAW_LIST_CIRCLE_TABLE_SIZE;
+    n = NK_MIN(n, (float)span);
+    count = (n < 3.0f) ? 3: (unsigned int)n + (((float)(unsigned int)n < n) ? 1: 0);
+    count = NK_MIN(count, span);
+    for (; count < span; ++count)
+        if (span % count == 0) return span / count;
+    return 1;
+}
+NK_INTERN void
+nk_draw_list_path_arc_to_table(struct nk_draw_list *list, struct nk_vec2 center,
+    float radius, unsigned int first, unsigned int count, unsigned int stride)
+{
+    unsigned int i;
+    struct nk_vec2 *points;
+    const struct nk_vec2 *table = list->circle_table;
+    NK_ASSERT(count);
+    if (!count) return;
+
+    first %= NK_DRAW_LIST_CIRCLE_TABLE_SIZE;
+    nk_draw_list_path_line_to(list, nk_vec2(center.x + table[first].x * radius,
+        center.y + table[first].y * radius));
+    if (count == 1) return;
+
+    points = nk_draw_list_alloc_path(list, (int)count - 1);
+    if (!points) return;
+    for (i = 1; i < count; ++i) {
+        const struct nk_vec2 c = table[(first + i * stride) % NK_DRAW_LIST_CIRCLE_TABLE_SIZE];
+        points[i-1].x = center.x + c.x * radius;
+        points[i-1].y = center.y + c.y * radius;
+    }
+}
+NK_INTERN unsigned int
+nk_draw_list_circle_segments(const struct nk_draw_list *list, float radius,
+    unsigned int segments)
+{
+    if (list->config.max_segment_error <= 0.0f)
+        return segments;
+    return NK_DRAW_LIST_CIRCLE_TABLE_SIZE /
+        nk_draw_list_circle_table_stride(list, radius, NK_DRAW_LIST_CIRCLE_TABLE_SIZE);
+}
+NK_INTERN unsigned int
+nk_draw_list_arc_segments(const struct nk_draw_list *list, float radius,
+    float a_min, float a_max, unsigned int segments)
+{
+    float n;
+    if (list->config.max_segment_error <= 0.0f)
+        return segments;
+    n = nk_draw_list_circle_error_segments(list, radius);
+    n = n * NK_ABS(a_max - a_min) / (2.0f * NK_PI);
+    n = NK_MIN(n, (float)(NK_DRAW_LIST_CIRCLE_TABLE_SIZE - 1));
+    return (unsigned int)n + 1;
+}
+NK_INTERN unsigned int
+nk_draw_list_curve_segments(const struct nk_draw_list *list, struct nk_vec2 p0,
+    struct nk_vec2 p1, struct nk_vec2 p2, struct nk_vec2 p3, unsigned int segments)
+{
+    /* Wang's formula: a cubic bezier split into n uniform steps stays within `e`
+     * of the curve for n >= sqrt(3/4 * M / e) with M being the largest second
+     * difference of its control points. */
+    float dx0, dy0, dx1, dy1, m, n;
+    if (list->config.max_segment_error <= 0.0f)
+        return segments;
+    dx0 = p0.x - 2.0f * p1.x + p2.x; dy0 = p0.y - 2.0f * p1.y + p2.y;
+    dx1 = p1.x - 2.0f * p2.x + p3.x; dy1 = p1.y - 2.0f * p2.y + p3.y;
+    m = NK_MAX(dx0*dx0 + dy0*dy0, dx1*dx1 + dy1*dy1);
+    if (m <= 0.0f) return 1;
+    m = m * NK_INV_SQRT(m);
+    n = 0.75f * m / list->config.max_segment_error;
+    n = n * NK_INV_SQRT(n);
+    n = NK_MIN(n, (float)(NK_DRAW_LIST_CIRCLE_TABLE_SIZE - 1));
+    return (unsigned int)n + 1;
+}
 NK_API void
 nk_draw_list_path_arc_to(struct nk_draw_list *list, struct nk_vec2 center,
     float radius, float a_min, float a_max, unsigned int segments)
@@ -880,6 +976,14 @@ nk_draw_list_path_rect_to(struct nk_draw_list *list, struct nk_vec2 a,
         nk_draw_list_path_line_to(list, nk_vec2(b.x,a.y));
         nk_draw_list_path_line_to(list, b);
         nk_draw_list_path_line_to(list, nk_vec2(a.x,b.y));
+    } else if (list->config.max_segment_error > 0.0f) {
+        const unsigned int quarter = NK_DRAW_LIST_CIRCLE_TABLE_SIZE/4;
+        const unsigned int stride = nk_draw_list_circle_table_stride(list, r, quarter);
+        const unsigned int count = quarter / stride + 1;
+        nk_draw_list_path_arc_to_table(list, nk_vec2(a.x + r, a.y + r), r, 2*quarter, count, stride);
+        nk_draw_list_path_arc_to_table(list, nk_vec2(b.x - r, a.y + r), r, 3*quarter, count, stride);
+        nk_draw_list_path_arc_to_table(list, nk_vec2(b.x - r, b.y - r), r, 0, count, stride);
+        nk_draw_list_path_arc_to_table(list, nk_vec2(a.x + r, b.y - r), r, quarter, count, stride);
     } else {
         nk_draw_list_path_arc_to_fast(list, nk_vec2(a.x + r, a.y + r), r, 6, 9);
         nk_draw_list_path_arc_to_fast(list, nk_vec2(b.x - r, a.y + r), r, 9, 12);
@@ -1043,8 +1147,13 @@ nk_draw_list_fill_circle(struct nk_draw_list *list, struct nk_vec2 center,
     float a_max;
     NK_ASSERT(list);
     if (!list || !col.a) return;
-    a_max = NK_PI * 2.0f * ((float)segs - 1.0f) / (float)segs;
-    nk_draw_list_path_arc_to(list, center, radius, 0.0f, a_max, segs);
+    if (segs && NK_DRAW_LIST_CIRCLE_TABLE_SIZE % segs == 0) {
+        nk_draw_list_path_arc_to_table(list, center, radius, 0, segs,
+            NK_DRAW_LIST_CIRCLE_TABLE_SIZE / segs);
+    } else {
+        a_max = NK_PI * 2.0f * ((float)segs - 1.0f) / (float)segs;
+        nk_draw_list_path_arc_to(list, center, radius, 0.0f, a_max, segs);
+    }
     nk_draw_list_path_fill(list, col);
 }
 NK_API void
@@ -1054,8 +1163,13 @@ nk_draw_list_stroke_circle(struct nk_draw_list *list, struct nk_vec2 center,
     float a_max;
     NK_ASSERT(list);
     if (!list || !col.a) return;
-    a_max = NK_PI * 2.0f * ((float)segs - 1.0f) / (float)segs;
-    nk_draw_list_path_arc_to(list, center, radius, 0.0f, a_max, segs);
+    if (segs && NK_DRAW_LIST_CIRCLE_TABLE_SIZE % segs == 0) {
+        nk_draw_list_path_arc_to_table(list, center, radius, 0, segs,
+            NK_DRAW_LIST_CIRCLE_TABLE_SIZE / segs);
+    } else {
+        a_max = NK_PI * 2.0f * ((float)segs - 1.0f) / (float)segs;
+        nk_draw_list_path_arc_to(list, center, radius, 0.0f, a_max, segs);
+    }
     nk_draw_list_path_stroke(list, col, NK_STROKE_CLOSED, thickness);
 }
 NK_API void
@@ -1134,10 +1248,9 @@ nk_draw_list_add_text(struct nk_draw_list *list, const struct nk_user_font *font
 {
     float x = 0;
     int text_len = 0;
-    nk_rune unicode = 0;
-    nk_rune next = 0;
-    int glyph_len = 0;
-    int next_glyph_len = 0;
+    nk_rune runes[NK_UTF_RUN];
+    int run_len = 0;
+    int count, i;
     struct nk_user_font_glyph g;
 
     NK_ASSERT(list);
@@ -1147,34 +1260,39 @@ nk_draw_list_add_text(struct nk_draw_list *list, const struct nk_user_font *font
 
     nk_draw_list_push_image(list, font->texture);
     x = rect.x;
-    glyph_len = nk_utf_decode(text, &unicode, len);
-    if (!glyph_len) return;
+    count = nk_utf_decode_run(text, len, runes, (int)NK_LEN(runes), &run_len);
+    if (!count) return;
 
     /* draw every glyph image */
     fg.a = (nk_byte)((float)fg.a * list->config.global_alpha);
-    while (text_len < len && glyph_len) {
-        float gx, gy, gh, gw;
-        float char_width = 0;
-        if (unicode == NK_UTF_INVALID) break;
-
-        /* query currently drawn glyph information */
-        next_glyph_len = nk_utf_decode(text + text_len + glyph_len, &next, (int)len - text_len);
-        font->query(font->userdata, font_height, &g, unicode,
-                    (next == NK_UTF_INVALID) ? '\0' : next);
-
-        /* calculate and draw glyph drawing rectangle and image */
-        gx = x + g.offset.x;
-        gy = rect.y + g.offset.y;
-        gw = g.width; gh = g.height;
-        char_width = g.xadvance;
-        nk_draw_list_push_rect_uv(list, nk_vec2(gx,gy), nk_vec2(gx + gw, gy+ gh),
-            g.uv[0], g.uv[1], fg);
-
-        /* offset next glyph */
-        text_len += glyph_len;
-        x += char_width;
-        glyph_len = next_glyph_len;
-        unicode = next;
+    while (count) {
+        for (i = 0; i < count; ++i) {
+            float gx, gy, gh, gw;
+            nk_rune next = 0;
+            if (runes[i] == NK_UTF_INVALID) return;
+
+            /* the last rune of a run looks ahead into the next one */
+            if (i + 1 < count) next = runes[i+1];
+            else nk_utf_decode(text + text_len + run_len, &next, len - text_len - run_len);
+
+            /* query currently drawn glyph information */
+            font->query(font->userdata, font_height, &g, runes[i],
+                        (next == NK_UTF_INVALID) ? '\0' : next);
+
+            /* calculate and draw glyph drawing rectangle and image */
+            gx = x + g.offset.x;
+            gy = rect.y + g.offset.y;
+            gw = g.width; gh = g.height;
+            nk_draw_list_push_rect_uv(list, nk_vec2(gx,gy), nk_vec2(gx + gw, gy+ gh),
+                g.uv[0], g.uv[1], fg);
+
+            /* offset next glyph */
+            x += g.xadvance;
+        }
+        text_len += run_len;
+        if (!run_len || text_len >= len) break;
+        count = nk_utf_decode_run(text + text_len, len - text_len, runes,
+            (int)NK_LEN(runes), &run_len);
     }
 }
 NK_API nk_flags
@@ -1184,6 +1302,9 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
 {
     nk_flags res = NK_CONVERT_SUCCESS;
     const struct nk_command *cmd;
+#ifdef NK_INCLUDE_FRAME_STATS
+    nk_size offset = 0;
+#endif
     NK_ASSERT(ctx);
     NK_ASSERT(cmds);
     NK_ASSERT(vertices);
@@ -1196,8 +1317,21 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
 
     nk_draw_list_setup(&ctx->draw_list, config, cmds, vertices, elements,
         config->line_AA, config->shape_AA);
+#ifdef NK_INCLUDE_FRAME_STATS
+    /* commands start inside the first visible window buffer like in nk__begin */
+    {const struct nk_window *iter = ctx->begin;
+    while (iter && ((iter->buffer.begin == iter->buffer.end) ||
+        (iter->flags & NK_WINDOW_HIDDEN) || iter->seq != ctx->seq))
+        iter = iter->next;
+    if (iter) offset = iter->buffer.begin;}
+#endif
     nk_foreach(cmd, ctx)
     {
+#ifdef NK_INCLUDE_FRAME_STATS
+        struct nk_panel_stats *stats = nk_stats_panel_at(ctx, offset);
+        unsigned int vertex_count = ctx->draw_list.vertex_count;
+        unsigned int element_count = ctx->draw_list.element_count;
+#endif
 #ifdef NK_INCLUDE_COMMAND_USERDATA
         ctx->draw_list.userdata = cmd->userdata;
 #endif
@@ -1217,7 +1351,10 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
             nk_draw_list_stroke_curve(&ctx->draw_list, nk_vec2(q->begin.x, q->begin.y),
                 nk_vec2(q->ctrl[0].x, q->ctrl[0].y), nk_vec2(q->ctrl[1].x,
                 q->ctrl[1].y), nk_vec2(q->end.x, q->end.y), q->color,
-                config->curve_segment_count, q->line_thickness);
+                nk_draw_list_curve_segments(&ctx->draw_list, nk_vec2(q->begin.x, q->begin.y),
+                    nk_vec2(q->ctrl[0].x, q->ctrl[0].y), nk_vec2(q->ctrl[1].x, q->ctrl[1].y),
+                    nk_vec2(q->end.x, q->end.y), config->curve_segment_count),
+                q->line_thickness);
         } break;
         case NK_COMMAND_RECT: {
             const struct nk_command_rect *r = (const struct nk_command_rect*)cmd;
@@ -1238,26 +1375,30 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
             const struct nk_command_circle *c = (const struct nk_command_circle*)cmd;
             nk_draw_list_stroke_circle(&ctx->draw_list, nk_vec2((float)c->x + (float)c->w/2,
                 (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
-                config->circle_segment_count, c->line_thickness);
+                nk_draw_list_circle_segments(&ctx->draw_list, (float)c->w/2,
+                    config->circle_segment_count), c->line_thickness);
         } break;
         case NK_COMMAND_CIRCLE_FILLED: {
             const struct nk_command_circle_filled *c = (const struct nk_command_circle_filled *)cmd;
             nk_draw_list_fill_circle(&ctx->draw_list, nk_vec2((float)c->x + (float)c->w/2,
                 (float)c->y + (float)c->h/2), (float)c->w/2, c->color,
-                config->circle_segment_count);
+                nk_draw_list_circle_segments(&ctx->draw_list, (float)c->w/2,
+                    config->circle_segment_count));
         } break;
         case NK_COMMAND_ARC: {
             const struct nk_command_arc *c = (const struct nk_command_arc*)cmd;
             nk_draw_list_path_line_to(&ctx->draw_list, nk_vec2(c->cx, c->cy));
             nk_draw_list_path_arc_to(&ctx->draw_list, nk_vec2(c->cx, c->cy), c->r,
-                c->a[0], c->a[1], config->arc_segment_count);
+                c->a[0], c->a[1], nk_draw_list_arc_segments(&ctx->draw_list, c->r,
+                    c->a[0], c->a[1], config->arc_segment_count));
             nk_draw_list_path_stroke(&ctx->draw_list, c->color, NK_STROKE_CLOSED, c->line_thickness);
         } break;
         case NK_COMMAND_ARC_FILLED: {
             const struct nk_command_arc_filled *c = (const struct nk_command_arc_filled*)cmd;
             nk_draw_list_path_line_to(&ctx->draw_list, nk_vec2(c->cx, c->cy));
             nk_draw_list_path_arc_to(&ctx->draw_list, nk_vec2(c->cx, c->cy), c->r,
-                c->a[0], c->a[1], config->arc_segment_count);
+                c->a[0], c->a[1], nk_draw_list_arc_segments(&ctx->draw_list, c->r,
+                    c->a[0], c->a[1], config->arc_segment_count));
             nk_draw_list_path_fill(&ctx->draw_list, c->color);
         } break;
         case NK_COMMAND_TRIANGLE: {
@@ -1313,7 +1454,19 @@ nk_convert(struct nk_context *ctx, struct nk_buffer *cmds,
         } break;
         default: break;
         }
+#ifdef NK_INCLUDE_FRAME_STATS
+        if (stats) {
+            stats->vertices += ctx->draw_list.vertex_count - vertex_count;
+            stats->indices += ctx->draw_list.element_count - element_count;
+        }
+        offset = cmd->next;
+#endif
     }
+#ifdef NK_INCLUDE_FRAME_STATS
+    ctx->stats.memory.draw_commands = cmds->needed;
+    ctx->stats.memory.vertices = vertices->needed;
+    ctx->stats.memory.elements = elements->needed;
+#endif
     res |= (cmds->needed > cmds->allocated + (cmds->memory.size - cmds->size)) ? NK_CONVERT_COMMAND_BUFFER_FULL: 0;
     res |= (vertices->needed > vertices->allocated) ? NK_CONVERT_VERTEX_BUFFER_FULL: 0;
     res |= (elements->needed > elements->allocated) ? NK_CONVERT_ELEMENT_BUFFER_FULL: 0;
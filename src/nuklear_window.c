@@ -10,7 +10,7 @@ NK_LIB void*
 nk_create_window(struct nk_context *ctx)
 {
     struct nk_page_element *elem;
-    elem = nk_create_page_element(ctx);
+    elem = nk_create_page_element(ctx, NK_PAGE_ELEMENT_WINDOW);
     if (!elem) return 0;
     elem->data.win.seq = ctx->seq;
     return &elem->data.win;
@@ -37,10 +37,15 @@ nk_free_window(struct nk_context *ctx, struct nk_window *win)
         it = n;
     }
 
+    while (win->streams)
+        nk_free_chart_stream(ctx, win, win->streams);
+    if (win->text_cache)
+        nk_free_text_cache(ctx, win);
+
     /* link windows into freelist */
     {union nk_page_data *pd = NK_CONTAINER_OF(win, union nk_page_data, win);
     struct nk_page_element *pe = NK_CONTAINER_OF(pd, struct nk_page_element, data);
-    nk_free_page_element(ctx, pe);}
+    nk_free_page_element(ctx, pe, NK_PAGE_ELEMENT_WINDOW);}
 }
 NK_LIB struct nk_window*
 nk_find_window(const struct nk_context *ctx, nk_hash hash, const char *name)
@@ -308,6 +313,9 @@ nk_end(struct nk_context *ctx)
         return;
     }
     nk_panel_end(ctx);
+#ifdef NK_INCLUDE_FRAME_STATS
+    nk_stats_panel_end(ctx, ctx->current);
+#endif
     nk_free_panel(ctx, ctx->current->layout);
     ctx->current = 0;
 }
@@ -448,6 +456,8 @@ nk_window_is_any_hovered(const struct nk_context *ctx)
     struct nk_window *iter;
     NK_ASSERT(ctx);
     if (!ctx) return 0;
+    if (ctx->worker_state & NK_WIDGET_STATE_HOVER)
+        return 1;
     iter = ctx->begin;
     while (iter) {
         /* check if window is being hovered */
@@ -473,7 +483,7 @@ NK_API nk_bool
 nk_item_is_any_active(const struct nk_context *ctx)
 {
     int any_hovered = nk_window_is_any_hovered(ctx);
-    int any_active = (ctx->last_widget_state & NK_WIDGET_STATE_MODIFIED);
+    int any_active = ((ctx->last_widget_state | ctx->worker_state) & NK_WIDGET_STATE_MODIFIED);
     return any_hovered || any_active;
 }
 NK_API nk_bool
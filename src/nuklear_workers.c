@@ -0,0 +1,157 @@
+#include "nuklear.h"
+#include "nuklear_internal.h"
+
+/* ==============================================================
+ *
+ *                          WORKERS
+ *
+ * ===============================================================*/
+NK_INTERN nk_bool
+nk_workers_hovered(const struct nk_context *ctx, struct nk_vec2 pos)
+{
+    /* same as `nk_window_is_any_hovered` but for bounds of the previous
+     * frame and a mouse position the context itself might never see */
+    const struct nk_window *iter;
+    for (iter = ctx->begin; iter; iter = iter->next) {
+        struct nk_rect bounds = iter->bounds;
+        if (iter->flags & NK_WINDOW_HIDDEN) continue;
+        if (iter->popup.active && iter->popup.win &&
+            NK_INBOX(pos.x, pos.y, iter->popup.win->bounds.x, iter->popup.win->bounds.y,
+                iter->popup.win->bounds.w, iter->popup.win->bounds.h))
+            return nk_true;
+        if (iter->flags & NK_WINDOW_MINIMIZED)
+            bounds.h = ctx->style.font->height + 2 * ctx->style.window.header.padding.y;
+        if (NK_INBOX(pos.x, pos.y, bounds.x, bounds.y, bounds.w, bounds.h))
+            return nk_true;
+    }
+    return nk_false;
+}
+NK_INTERN void
+nk_workers_mask_mouse(struct nk_mouse *mouse)
+{
+    /* keep the pointer far away from any window */
+    const struct nk_vec2 outside = nk_vec2(-65536.0f, -65536.0f);
+    int i;
+    for (i = 0; i < NK_BUTTON_MAX; ++i) {
+        mouse->buttons[i].down = nk_false;
+        mouse->buttons[i].clicked = 0;
+        mouse->buttons[i].clicked_pos = outside;
+    }
+    mouse->pos = mouse->prev = outside;
+#ifdef NK_BUTTON_TRIGGER_ON_RELEASE
+    mouse->down_pos = outside;
+#endif
+    mouse->delta = nk_vec2(0,0);
+    mouse->scroll_delta = nk_vec2(0,0);
+}
+NK_INTERN void
+nk_workers_mask_keyboard(struct nk_keyboard *keyboard)
+{
+    nk_zero(keyboard->keys, sizeof(keyboard->keys));
+    keyboard->text_len = 0;
+}
+NK_API void
+nk_workers_begin(struct nk_context *ctx, struct nk_context *workers, int count)
+{
+    nk_bool held = nk_false, pressed = nk_false;
+    int i, owner;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(workers || !count);
+    NK_ASSERT(count >= 0);
+    if (!ctx || (!workers && count) || count < 0) return;
+
+    /* the mouse stays with the context that saw the button going down */
+    for (i = 0; i < NK_BUTTON_MAX; ++i) {
+        const struct nk_mouse_button *button = &ctx->input.mouse.buttons[i];
+        held = held || (button->down ^ (button->clicked & 1));
+        pressed = pressed || (button->down && button->clicked);
+    }
+    owner = ctx->mouse_owner;
+    if (!held || owner > count) {
+        /* contexts are layered in order with `ctx` at the bottom */
+        for (owner = count; owner > 0; --owner)
+            if (nk_workers_hovered(&workers[owner-1], ctx->input.mouse.pos)) break;
+    }
+    if (pressed) ctx->keyboard_owner = owner;
+    if (ctx->keyboard_owner > count) ctx->keyboard_owner = 0;
+    ctx->mouse_owner = owner;
+
+    for (i = 0; i < count; ++i) {
+        struct nk_context *worker = &workers[i];
+        worker->input = ctx->input;
+        if (owner != i + 1)
+            nk_workers_mask_mouse(&worker->input.mouse);
+        if (ctx->keyboard_owner != i + 1)
+            nk_workers_mask_keyboard(&worker->input.keyboard);
+        worker->style = ctx->style;
+        worker->style.cursor_visible = nk_false;
+        worker->clip = ctx->clip;
+        worker->button_behavior = ctx->button_behavior;
+        worker->delta_time_seconds = ctx->delta_time_seconds;
+    }
+    /* input for workers is held back from `ctx` until `nk_workers_merge` */
+    if (ctx->mouse_owner) {
+        ctx->worker_mouse = ctx->input.mouse;
+        nk_workers_mask_mouse(&ctx->input.mouse);
+    }
+    if (ctx->keyboard_owner) {
+        ctx->worker_keyboard = ctx->input.keyboard;
+        nk_workers_mask_keyboard(&ctx->input.keyboard);
+    }
+    ctx->worker_count = count;
+}
+NK_API nk_bool
+nk_workers_merge(struct nk_context *ctx, struct nk_context *workers, int count)
+{
+    nk_bool ok = nk_true;
+    int i;
+
+    NK_ASSERT(ctx);
+    NK_ASSERT(workers || !count);
+    NK_ASSERT(count == ctx->worker_count);
+    if (!ctx || (!workers && count) || count != ctx->worker_count) return nk_false;
+
+    if (ctx->mouse_owner) {
+        const struct nk_context *owner = &workers[ctx->mouse_owner-1];
+        ctx->input.mouse = ctx->worker_mouse;
+        ctx->input.mouse.grab = owner->input.mouse.grab;
+        ctx->input.mouse.grabbed = owner->input.mouse.grabbed;
+        ctx->input.mouse.ungrab = owner->input.mouse.ungrab;
+        ctx->style.cursor_active = owner->style.cursor_active;
+        if (nk_window_is_any_hovered(owner))
+            ctx->worker_state |= NK_WIDGET_STATE_HOVER;
+    }
+    if (ctx->keyboard_owner)
+        ctx->input.keyboard = ctx->worker_keyboard;
+    ctx->worker_count = 0;
+
+    if (!ctx->merged.base) {
+        nk_command_buffer_init(&ctx->merged, &ctx->memory, NK_CLIPPING_OFF);
+        nk_start_buffer(ctx, &ctx->merged);
+    }
+    for (i = 0; i < count; ++i) {
+        struct nk_context *worker = &workers[i];
+        const struct nk_command *cmd;
+        /* commands are copied since each worker has its own command memory */
+        nk_foreach(cmd, worker) {
+            nk_size size;
+            struct nk_command *copy;
+            if (cmd->type == NK_COMMAND_NOP || !ok) continue;
+            size = nk_command_size(cmd);
+            copy = (struct nk_command*)nk_command_buffer_push(&ctx->merged, cmd->type, size);
+            if (!copy) {
+                ok = nk_false;
+                continue;
+            }
+            NK_MEMCPY(copy + 1, cmd + 1, size - sizeof(*copy));
+#ifdef NK_INCLUDE_COMMAND_USERDATA
+            copy->userdata = cmd->userdata;
+#endif
+        }
+        ctx->worker_state |= worker->last_widget_state & NK_WIDGET_STATE_MODIFIED;
+        nk_clear(worker);
+    }
+    nk_finish_buffer(ctx, &ctx->merged);
+    return ok;
+}